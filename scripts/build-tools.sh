@@ -16,9 +16,10 @@ Attention: the list below is _not_ exhaustive. To re-build _everything_
 from scratch don't select any particular target; this will build the
 CMake's default target "ALL".
 
-usage: $0 [-c|-f|-h|-l|-p|-t|-T]
+usage: $0 [-b|-c|-f|-h|-l|-p|-t|-T]
        -h Display help
 
+       -b Rebuild tplg_budget/
        -c Rebuild ctl/
        -f Rebuild fuzzer/  # deprecated, see fuzzer/README.md
        -l Rebuild logger/
@@ -44,6 +45,11 @@ reconfigure_build()
         ( cd "$BUILD_TOOLS_DIR/fuzzer"
           cmake -DCMAKE_BUILD_TYPE="$CMAKE_BUILD_TYPE" "${SOF_REPO}/tools/fuzzer"
         )
+
+        mkdir "$BUILD_TOOLS_DIR/tplg_budget"
+        ( cd "$BUILD_TOOLS_DIR/tplg_budget"
+          cmake -DCMAKE_BUILD_TYPE="$CMAKE_BUILD_TYPE" "${SOF_REPO}/tools/tplg_budget"
+        )
 }
 
 make_tool()
@@ -65,6 +71,13 @@ make_fuzzer()
         )
 }
 
+make_budget()
+{
+        ( set -x
+        cmake --build "$BUILD_TOOLS_DIR"/tplg_budget  --  -j "$NO_PROCESSORS"
+        )
+}
+
 print_build_info()
 {
        cat <<EOFUSAGE
@@ -78,6 +91,7 @@ Build commands for respective tools:
                (or ./tools/test/topology/tplg-build.sh directly)
 
         fuzzer:     make -C "$BUILD_TOOLS_DIR/fuzzer"
+        budget:     make -C "$BUILD_TOOLS_DIR/tplg_budget"
 
         list of targets:
                     make -C "$BUILD_TOOLS_DIR/" help
@@ -86,7 +100,7 @@ EOFUSAGE
 
 main()
 {
-        local DO_BUILD_ctl DO_BUILD_fuzzer DO_BUILD_logger DO_BUILD_probes \
+        local DO_BUILD_budget DO_BUILD_ctl DO_BUILD_fuzzer DO_BUILD_logger DO_BUILD_probes \
                 DO_BUILD_tests DO_BUILD_topologies SCRIPT_DIR SOF_REPO CMAKE_ONLY \
                 BUILD_ALL
         SCRIPT_DIR=$(cd "$(dirname "$0")" && pwd)
@@ -99,6 +113,7 @@ main()
                 BUILD_ALL=true
         fi
 
+        DO_BUILD_budget=false
         DO_BUILD_ctl=false
         DO_BUILD_fuzzer=false
         DO_BUILD_logger=false
@@ -109,8 +124,9 @@ main()
 
         # eval is a sometimes necessary evil
         # shellcheck disable=SC2034
-        while getopts "cfhlptTC" OPTION; do
+        while getopts "bcfhlptTC" OPTION; do
                 case "$OPTION" in
+                b) DO_BUILD_budget=true ;;
                 c) DO_BUILD_ctl=true ;;
                 f) DO_BUILD_fuzzer=true ;;
                 l) DO_BUILD_logger=true ;;
@@ -135,6 +151,7 @@ main()
                 make_tool # trust set -e
 
                 make_fuzzer
+                make_budget
                 exit $?
         fi
 
@@ -154,6 +171,10 @@ main()
         if "$DO_BUILD_fuzzer"; then
                 make_fuzzer
         fi
+
+        if "$DO_BUILD_budget"; then
+                make_budget
+        fi
 }
 
 main "$@"
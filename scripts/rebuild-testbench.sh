@@ -8,9 +8,11 @@ set -e
 print_usage()
 {
     cat <<EOFUSAGE
-usage: $0 [-f]
+usage: $0 [-f] [-c defconfig]
        -f Build testbench with compiler provided by fuzzer
           (default path: $HOME/sof/work/AFL/afl-gcc)
+       -c Initial .config of the SOF library, e.g. library_test_defconfig
+          (default: library_defconfig)
 EOFUSAGE
 }
 
@@ -23,7 +25,7 @@ rebuild_testbench()
     mkdir build_testbench
     cd build_testbench
 
-    cmake -DCMAKE_INSTALL_PREFIX=install  ..
+    cmake -DCMAKE_INSTALL_PREFIX=install -DTESTBENCH_DEFCONFIG="$DEFCONFIG" ..
 
     cmake --build .  --  -j"$(nproc)" install
 }
@@ -40,10 +42,12 @@ main()
     SOF_REPO=$(dirname "$SCRIPT_DIR")
     BUILD_TESTBENCH_DIR="$SOF_REPO"/tools/testbench
     : "${SOF_AFL:=$HOME/sof/work/AFL/afl-gcc}"
+    DEFCONFIG=library_defconfig
 
-    while getopts "fh" OPTION; do
+    while getopts "fc:h" OPTION; do
 	case "$OPTION" in
 	    f) export_CC_with_afl;;
+	    c) DEFCONFIG="$OPTARG";;
 	    h) print_usage; exit 1;;
 	    *) print_usage; exit 1;;
 	esac
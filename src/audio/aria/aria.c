@@ -76,10 +76,11 @@ static int aria_algo_init(struct comp_dev *dev, void *buffer_desc, void *buf_in,
 int aria_algo_buffer_data(struct comp_dev *dev, int32_t *__restrict data, size_t size)
 {
 	struct aria_data *cd = comp_get_drvdata(dev);
-	size_t min_buff = MIN(cd->buff_size - cd->buff_pos - cd->offset, size);
+	/* writes wrap at the full buffer size like the reads in aria_algo_get_data() */
+	size_t min_buff = MIN(cd->buff_size - cd->buff_pos, size);
 	int ret;
 
-	ret = memcpy_s(&cd->data[cd->buff_pos], cd->buff_size * sizeof(int32_t),
+	ret = memcpy_s(&cd->data[cd->buff_pos], (cd->buff_size - cd->buff_pos) * sizeof(int32_t),
 		       data, min_buff * sizeof(int32_t));
 	if (ret < 0)
 		return ret;
@@ -97,6 +98,7 @@ int aria_process_data(struct comp_dev *dev,
 		      int32_t *__restrict src, size_t src_size)
 {
 	struct aria_data *cd = comp_get_drvdata(dev);
+	size_t read_pos;
 	size_t min_buff;
 	int ret;
 
@@ -106,13 +108,13 @@ int aria_process_data(struct comp_dev *dev,
 		aria_algo_get_data(dev, dst, dst_size);
 	} else {
 		/* bypass processing gets unprocessed data from buffer */
-		min_buff = MIN(cd->buff_size - cd->buff_pos - cd->offset, dst_size);
-		ret = memcpy_s(dst, cd->buff_size * sizeof(int32_t),
-			       &cd->data[cd->buff_pos + cd->offset],
+		read_pos = (cd->buff_pos + cd->offset) % cd->buff_size;
+		min_buff = MIN(cd->buff_size - read_pos, dst_size);
+		ret = memcpy_s(dst, dst_size * sizeof(int32_t), &cd->data[read_pos],
 			       min_buff * sizeof(int32_t));
 		if (ret < 0)
 			return ret;
-		ret = memcpy_s(&dst[min_buff], cd->buff_size * sizeof(int32_t),
+		ret = memcpy_s(&dst[min_buff], (dst_size - min_buff) * sizeof(int32_t),
 			       cd->data, (dst_size - min_buff) * sizeof(int32_t));
 		if (ret < 0)
 			return ret;
@@ -149,7 +151,8 @@ static int init_aria(struct comp_dev *dev, struct comp_ipc_config *config,
 	ibs = cd->base.ibs;
 	chc = cd->base.audio_fmt.channels_count;
 	sgs = (cd->base.audio_fmt.valid_bit_depth >> 3) * chc;
-	sgc = ibs / sgs;
+	/* sample groups of a look-ahead block, the delay line holds one block */
+	sgc = MAX(ibs / sgs / CONFIG_COMP_ARIA_LOOKAHEAD_DIV, 1);
 	req_mem = get_required_emory(chc, sgc);
 	att = aria->attenuation;
 
@@ -272,9 +275,12 @@ static int aria_copy(struct comp_dev *dev)
 	struct aria_data *cd;
 	uint32_t source_bytes;
 	uint32_t sink_bytes;
-	uint32_t frag = 0;
+	uint32_t samples;
+	uint32_t base;
+	uint32_t done;
+	uint32_t n;
 	int32_t *destp;
-	int32_t i, channel;
+	int32_t i;
 
 	cd = comp_get_drvdata(dev);
 
@@ -297,29 +303,25 @@ static int aria_copy(struct comp_dev *dev)
 
 	buffer_stream_invalidate(source_c, source_bytes);
 
-	for (i = 0; i < c.frames; i++) {
-		for (channel = 0; channel < sink_c->stream.channels; channel++) {
-			cd->buf_in[frag] = *(int32_t *)audio_stream_read_frag_s32(&source_c->stream,
-										  frag);
-
-			frag++;
-		}
-	}
-	dcache_writeback_region((__sparse_force void __sparse_cache *)cd->buf_in,
-				c.frames * sink_c->stream.channels * sizeof(int32_t));
-
-	aria_process_data(dev, cd->buf_out, sink_bytes / sizeof(uint32_t),
-			  cd->buf_in, source_bytes / sizeof(uint32_t));
-
-	dcache_writeback_region((__sparse_force void __sparse_cache *)cd->buf_out,
-				c.frames * sink_c->stream.channels * sizeof(int32_t));
-	frag = 0;
-	for (i = 0; i < c.frames; i++) {
-		for (channel = 0; channel < sink_c->stream.channels; channel++) {
-			destp = audio_stream_write_frag_s32(&sink_c->stream, frag);
-			*destp = cd->buf_out[frag];
-
-			frag++;
+	/* the delay line holds one look-ahead block, process at most that much at once */
+	for (done = 0; done < c.frames; done += n) {
+		n = MIN(c.frames - done, cd->smpl_group_cnt);
+		samples = n * sink_c->stream.channels;
+		base = done * sink_c->stream.channels;
+
+		for (i = 0; i < samples; i++)
+			cd->buf_in[i] = *(int32_t *)audio_stream_read_frag_s32(&source_c->stream,
+									       base + i);
+		dcache_writeback_region((__sparse_force void __sparse_cache *)cd->buf_in,
+					samples * sizeof(int32_t));
+
+		aria_process_data(dev, cd->buf_out, samples, cd->buf_in, samples);
+
+		dcache_writeback_region((__sparse_force void __sparse_cache *)cd->buf_out,
+					samples * sizeof(int32_t));
+		for (i = 0; i < samples; i++) {
+			destp = audio_stream_write_frag_s32(&sink_c->stream, base + i);
+			*destp = cd->buf_out[i];
 		}
 	}
 
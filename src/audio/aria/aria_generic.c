@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <sof/audio/aria/aria.h>
+
+#ifdef ARIA_GENERIC
+
+#include <sof/audio/format.h>
+#include <sof/math/numbers.h>
+
+/*
+ * Generic versions of the HiFi3 kernels. They follow the sample order
+ * of the HiFi3 code, including its handling of odd channels counts and
+ * of a delay line position that isn't 8 bytes aligned, so both paths
+ * produce the same output.
+ */
+
+void aria_algo_calc_gain(struct comp_dev *dev, size_t gain_idx,
+			 int32_t *__restrict data, const size_t src_size)
+{
+	struct aria_data *cd = comp_get_drvdata(dev);
+	uint64_t gain = (1ULL << (cd->att + 32)) - 1;
+	uint32_t max_data = 0;
+	uint32_t abs_data;
+	size_t i;
+
+	/* detecting maximum value in data chunk, abs saturates like AE_MAXABS32S */
+	for (i = 0; i < src_size; i++) {
+		abs_data = data[i] == INT32_MIN ? INT32_MAX : ABS(data[i]);
+		max_data = MAX(max_data, abs_data);
+	}
+
+	/* currently att_ value is checked on initialization and is in range <0;3>
+	 * so eventual zero check for max_data is not needed (prevention from division by 0)
+	 */
+	if (max_data > (0x7fffffffUL >> cd->att))
+		gain = (0x7fffffffULL << 32) / max_data;
+
+	/* normalization by attenuation factor to obtain fractional range <1 / (2 pow att), 1> */
+	cd->gains[gain_idx] = (int32_t)(gain >> (cd->att + 1));
+}
+
+/* applies the normalized gain and the denormalization of one sample */
+static inline int32_t aria_apply_gain(int32_t gain, int32_t sample, size_t att)
+{
+	int32_t y = q_multsr_sat_32x32(gain, sample, 31);
+
+	return sat_int32((int64_t)y << att);
+}
+
+void aria_algo_get_data(struct comp_dev *dev, int32_t *__restrict data, size_t size)
+{
+	struct aria_data *cd = comp_get_drvdata(dev);
+	/* do linear approximation between points gain_begin and gain_end */
+	int32_t gain_begin = cd->gains[(cd->gain_state + 2) % ARIA_MAX_GAIN_STATES];
+	int32_t gain_end = cd->gains[(cd->gain_state + 3) % ARIA_MAX_GAIN_STATES];
+	const size_t smpl_groups = size / cd->chan_cnt;
+	const size_t chan_pairs = cd->chan_cnt >> 1;
+	size_t pos = (cd->buff_pos + cd->offset) % cd->buff_size;
+	int32_t *out = data;
+	int32_t next_gain;
+	int32_t prev_gain;
+	int32_t gain;
+	int32_t step;
+	/* variable for odd sample detection, detection when exceeded */
+	size_t odd_detect = ALIGN_DOWN(size, 2);
+	/* variable accumulates samples being processed, helps to identify odd sample */
+	size_t acc = 0;
+	size_t idx, ch;
+
+	for (idx = 1; idx < ARIA_MAX_GAIN_STATES - 1; ++idx) {
+		gain_begin = MIN(gain_begin, cd->gains[(cd->gain_state + idx + 2) %
+						ARIA_MAX_GAIN_STATES]);
+		gain_end = MIN(gain_end, cd->gains[(cd->gain_state + idx + 3) %
+						ARIA_MAX_GAIN_STATES]);
+	}
+
+	step = smpl_groups ? (gain_end - gain_begin) / (int32_t)smpl_groups : 0;
+	gain = gain_begin;
+	prev_gain = gain_begin;
+
+	/* the HiFi3 code starts with a single sample when not 8 bytes aligned */
+	if (pos % 2) {
+		*out++ = aria_apply_gain(gain, cd->data[pos], cd->att);
+		pos = (pos + 1) % cd->buff_size;
+		/* acc overflow expected and used as a condition later in loop */
+		acc = (size_t)(-cd->chan_cnt);
+		odd_detect = ALIGN_DOWN(size - 1, 2);
+	}
+
+	for (idx = 0; idx < smpl_groups; ++idx) {
+		/* channel pairs from current sample group are amplified with the same gain */
+		for (ch = 0; ch < 2 * chan_pairs; ++ch) {
+			*out++ = aria_apply_gain(gain, cd->data[pos], cd->att);
+			pos = (pos + 1) % cd->buff_size;
+		}
+		acc += cd->chan_cnt;
+		next_gain = gain_begin + (idx + 1) * step;
+		/* with odd channels count a pair spans the current and the next
+		 * sample group, each sample takes the gain of its own group
+		 */
+		if ((acc % 2) && !(acc > odd_detect)) {
+			*out++ = aria_apply_gain(prev_gain, cd->data[pos], cd->att);
+			pos = (pos + 1) % cd->buff_size;
+			*out++ = aria_apply_gain(next_gain, cd->data[pos], cd->att);
+			pos = (pos + 1) % cd->buff_size;
+		}
+		gain = next_gain;
+		prev_gain = next_gain;
+	}
+
+	/* maintains odd sample if any left */
+	if (acc > odd_detect)
+		*out = aria_apply_gain(gain, cd->data[pos], cd->att);
+
+	cd->gain_state = (cd->gain_state + 1) % ARIA_MAX_GAIN_STATES;
+}
+
+#endif /* ARIA_GENERIC */
@@ -3,6 +3,9 @@
 // Copyright(c) 2021 Intel Corporation. All rights reserved.
 
 #include <sof/audio/aria/aria.h>
+
+#ifdef ARIA_HIFI3
+
 #include <xtensa/config/defs.h>
 #include <xtensa/tie/xt_hifi3.h>
 
@@ -136,3 +139,5 @@ void aria_algo_get_data(struct comp_dev *dev, int32_t *__restrict  data, size_t
 	}
 	cd->gain_state = (cd->gain_state + 1) % ARIA_MAX_GAIN_STATES;
 }
+
+#endif /* ARIA_HIFI3 */
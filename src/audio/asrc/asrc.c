@@ -1076,6 +1076,15 @@ static int asrc_reset(struct comp_dev *dev)
 	return 0;
 }
 
+/* the source and sink frames and the drift tracking are set up in params */
+static int asrc_set_attribute(struct comp_dev *dev, uint32_t type, void *value)
+{
+	if (type == COMP_ATTR_PERIOD)
+		comp_err(dev, "asrc_set_attribute(): period can't change after params");
+
+	return -EINVAL;
+}
+
 static const struct comp_driver comp_asrc = {
 	.type = SOF_COMP_ASRC,
 	.uid = SOF_RT_UUID(asrc_uuid),
@@ -1089,6 +1098,7 @@ static const struct comp_driver comp_asrc = {
 		.copy = asrc_copy,
 		.prepare = asrc_prepare,
 		.reset = asrc_reset,
+		.set_attribute = asrc_set_attribute,
 #if CONFIG_IPC_MAJOR_4
 		.get_attribute = asrc_get_attribute,
 #endif
@@ -195,6 +195,66 @@ void buffer_free(struct comp_buffer *buffer)
 	rfree(buffer);
 }
 
+#if CONFIG_BUFFER_CALIBRATION
+static void buffer_calib_produce(struct comp_buffer __sparse_cache *buffer, uint32_t bytes)
+{
+	struct buffer_calib *calib = &buffer->calib;
+	uint32_t avail = audio_stream_get_avail_bytes(&buffer->stream);
+
+	if (!calib->produces++) {
+		calib->produce_min = bytes;
+		calib->produce_max = bytes;
+	} else {
+		calib->produce_min = MIN(calib->produce_min, bytes);
+		calib->produce_max = MAX(calib->produce_max, bytes);
+	}
+
+	calib->fill_max = MAX(calib->fill_max, avail);
+	if (!audio_stream_get_free_bytes(&buffer->stream))
+		calib->full++;
+}
+
+static void buffer_calib_consume(struct comp_buffer __sparse_cache *buffer, uint32_t bytes)
+{
+	struct buffer_calib *calib = &buffer->calib;
+	uint32_t avail = audio_stream_get_avail_bytes(&buffer->stream);
+
+	if (!calib->consumes++) {
+		calib->consume_min = bytes;
+		calib->consume_max = bytes;
+		calib->fill_min = avail;
+	} else {
+		calib->consume_min = MIN(calib->consume_min, bytes);
+		calib->consume_max = MAX(calib->consume_max, bytes);
+		calib->fill_min = MIN(calib->fill_min, avail);
+	}
+}
+
+/*
+ * The highest fill level is what the buffer needed in this run. The
+ * producer and consumer could have lined up worse than they did, so the
+ * larger of their jitter spans is added on top. A buffer that got full
+ * may have held its producer back, so its real need is unknown and the
+ * current size is kept.
+ */
+uint32_t buffer_calib_size(struct comp_buffer __sparse_cache *buffer)
+{
+	struct buffer_calib *calib = &buffer->calib;
+	uint32_t frame_bytes = audio_stream_frame_bytes(&buffer->stream);
+	uint32_t jitter;
+	uint32_t size;
+
+	if (!calib->produces || calib->full || !frame_bytes)
+		return buffer->stream.size;
+
+	jitter = MAX(calib->produce_max - calib->produce_min,
+		     calib->consumes ? calib->consume_max - calib->consume_min : 0);
+	size = DIV_ROUND_UP(calib->fill_max + jitter, frame_bytes) * frame_bytes;
+
+	return MIN(size, buffer->stream.size);
+}
+#endif
+
 /*
  * comp_update_buffer_produce() and comp_update_buffer_consume() send
  * NOTIFIER_ID_BUFFER_PRODUCE and NOTIFIER_ID_BUFFER_CONSUME notifier events
@@ -227,6 +287,10 @@ void comp_update_buffer_produce(struct comp_buffer __sparse_cache *buffer, uint3
 
 	audio_stream_produce(&buffer->stream, bytes);
 
+#if CONFIG_BUFFER_CALIBRATION
+	buffer_calib_produce(buffer, bytes);
+#endif
+
 	/* Notifier looks for the pointer value to match it against registration */
 	notifier_event(buffer, NOTIFIER_ID_BUFFER_PRODUCE,
 		       NOTIFIER_TARGET_CORE_LOCAL, &cb_data, sizeof(cb_data));
@@ -260,6 +324,10 @@ void comp_update_buffer_consume(struct comp_buffer __sparse_cache *buffer, uint3
 
 	audio_stream_consume(&buffer->stream, bytes);
 
+#if CONFIG_BUFFER_CALIBRATION
+	buffer_calib_consume(buffer, bytes);
+#endif
+
 	notifier_event(buffer, NOTIFIER_ID_BUFFER_CONSUME,
 		       NOTIFIER_TARGET_CORE_LOCAL, &cb_data, sizeof(cb_data));
 
@@ -31,13 +31,53 @@ DECLARE_SOF_UUID("component", comp_uuid, 0x7c42ce8b, 0x0108, 0x43d0,
 
 DECLARE_TR_CTX(comp_tr, SOF_UUID(comp_uuid), LOG_LEVEL_INFO);
 
+/* FNV-1a over the UUID bytes, folded to the table size */
+static uint32_t comp_driver_uuid_hash(const uint8_t *uuid)
+{
+	uint32_t hash = 2166136261u;
+	int i;
+
+	for (i = 0; i < UUID_SIZE; i++) {
+		hash ^= uuid[i];
+		hash *= 16777619u;
+	}
+
+	return (hash ^ (hash >> 16)) & (COMP_DRIVER_HASH_SIZE - 1);
+}
+
+static uint32_t comp_driver_type_hash(uint32_t type)
+{
+	return type & (COMP_DRIVER_HASH_SIZE - 1);
+}
+
 int comp_register(struct comp_driver_info *drv)
 {
 	struct comp_driver_list *drivers = comp_drivers_get();
+	uint32_t uuid_hash = comp_driver_uuid_hash((const uint8_t *)drv->drv->uid);
+	uint32_t type_hash = comp_driver_type_hash(drv->drv->type);
+	struct comp_driver_info *info;
 	k_spinlock_key_t key;
 
 	key = k_spin_lock(&drivers->lock);
+
+	/* registering twice would link the driver to itself */
+	for (info = drivers->uuid_hash[uuid_hash]; info; info = info->uuid_next) {
+		if (info == drv) {
+			k_spin_unlock(&drivers->lock, key);
+			return -EEXIST;
+		}
+	}
+
 	list_item_prepend(&drv->list, &drivers->list);
+
+	/* The last registered driver comes first, like on the list. The
+	 * driver is linked to the chain before the chain head points to it,
+	 * a lookup sees either the old or the new chain.
+	 */
+	drv->uuid_next = drivers->uuid_hash[uuid_hash];
+	drv->type_next = drivers->type_hash[type_hash];
+	drivers->uuid_hash[uuid_hash] = drv;
+	drivers->type_hash[type_hash] = drv;
 	k_spin_unlock(&drivers->lock, key);
 
 	return 0;
@@ -46,11 +86,82 @@ int comp_register(struct comp_driver_info *drv)
 void comp_unregister(struct comp_driver_info *drv)
 {
 	struct comp_driver_list *drivers = comp_drivers_get();
+	uint32_t uuid_hash = comp_driver_uuid_hash((const uint8_t *)drv->drv->uid);
+	uint32_t type_hash = comp_driver_type_hash(drv->drv->type);
+	struct comp_driver_info **item;
 	k_spinlock_key_t key;
 
 	key = k_spin_lock(&drivers->lock);
 	list_item_del(&drv->list);
+
+	/* Only the chain is unlinked, a lookup at the driver still follows
+	 * its next pointers to the rest of the chain.
+	 */
+
+	for (item = &drivers->uuid_hash[uuid_hash]; *item; item = &(*item)->uuid_next) {
+		if (*item == drv) {
+			*item = drv->uuid_next;
+			break;
+		}
+	}
+
+	for (item = &drivers->type_hash[type_hash]; *item; item = &(*item)->type_next) {
+		if (*item == drv) {
+			*item = drv->type_next;
+			break;
+		}
+	}
+
 	k_spin_unlock(&drivers->lock, key);
+
+	/* wait for the lookups that may still be at the driver */
+	while (atomic_read(&drivers->readers))
+		;
+
+	drv->uuid_next = NULL;
+	drv->type_next = NULL;
+}
+
+const struct comp_driver *comp_driver_find_uuid(const uint8_t *uuid)
+{
+	struct comp_driver_list *drivers = comp_drivers_get();
+	const struct comp_driver *drv = NULL;
+	struct comp_driver_info *info;
+
+	atomic_add(&drivers->readers, 1);
+
+	for (info = drivers->uuid_hash[comp_driver_uuid_hash(uuid)]; info;
+	     info = info->uuid_next) {
+		if (!memcmp(info->drv->uid, uuid, UUID_SIZE)) {
+			drv = info->drv;
+			break;
+		}
+	}
+
+	atomic_sub(&drivers->readers, 1);
+
+	return drv;
+}
+
+const struct comp_driver *comp_driver_find_type(uint32_t type)
+{
+	struct comp_driver_list *drivers = comp_drivers_get();
+	const struct comp_driver *drv = NULL;
+	struct comp_driver_info *info;
+
+	atomic_add(&drivers->readers, 1);
+
+	for (info = drivers->type_hash[comp_driver_type_hash(type)]; info;
+	     info = info->type_next) {
+		if (info->drv->type == type) {
+			drv = info->drv;
+			break;
+		}
+	}
+
+	atomic_sub(&drivers->readers, 1);
+
+	return drv;
 }
 
 /* NOTE: Keep the component state diagram up to date:
@@ -145,6 +256,7 @@ void sys_comp_init(struct sof *sof)
 
 	list_init(&sof->comp_drivers->list);
 	k_spinlock_init(&sof->comp_drivers->lock);
+	atomic_init(&sof->comp_drivers->readers, 0);
 }
 
 void comp_get_copy_limits(struct comp_buffer __sparse_cache *source,
@@ -169,6 +281,81 @@ void comp_get_copy_limits_frame_aligned(const struct comp_buffer __sparse_cache
 	cl->sink_bytes = cl->frames * cl->sink_frame_bytes;
 }
 
+/* the copy of the bypass needs the same format and channels, otherwise it mutes */
+/* the input can only be copied to the output in the same format */
+static bool comp_bypass_check(struct comp_dev *dev)
+{
+	struct comp_buffer __sparse_cache *source_c, *sink_c;
+	struct comp_buffer *source, *sink;
+	bool ret;
+
+	if (list_is_empty(&dev->bsource_list) || list_is_empty(&dev->bsink_list) ||
+	    dev->bsource_list.next != dev->bsource_list.prev ||
+	    dev->bsink_list.next != dev->bsink_list.prev)
+		return false;
+
+	source = list_first_item(&dev->bsource_list, struct comp_buffer, sink_list);
+	sink = list_first_item(&dev->bsink_list, struct comp_buffer, source_list);
+	source_c = buffer_acquire(source);
+	sink_c = buffer_acquire(sink);
+
+	ret = source_c->stream.rate == sink_c->stream.rate &&
+	      source_c->stream.frame_fmt == sink_c->stream.frame_fmt &&
+	      source_c->stream.channels == sink_c->stream.channels;
+
+	buffer_release(sink_c);
+	buffer_release(source_c);
+
+	return ret;
+}
+
+bool comp_can_bypass(struct comp_dev *dev)
+{
+	return comp_bypass_check(dev);
+}
+
+bool comp_can_shed(struct comp_dev *dev)
+{
+	if (dev->drv->shed_tier == COMP_SHED_NONE)
+		return false;
+
+	return dev->drv->ops.shed || comp_bypass_check(dev);
+}
+
+int comp_copy_bypass(struct comp_dev *dev)
+{
+	struct comp_buffer __sparse_cache *source_c, *sink_c;
+	struct comp_buffer *source, *sink;
+	struct comp_copy_limits cl;
+
+	/* new params may have changed the format, process rather than drop */
+	if (!comp_bypass_check(dev)) {
+		comp_warn(dev, "comp_copy_bypass(), formats differ, processing again");
+		dev->bypass = false;
+		return comp_copy(dev);
+	}
+
+	source = list_first_item(&dev->bsource_list, struct comp_buffer, sink_list);
+	sink = list_first_item(&dev->bsink_list, struct comp_buffer, source_list);
+	source_c = buffer_acquire(source);
+	sink_c = buffer_acquire(sink);
+
+	comp_get_copy_limits(source_c, sink_c, &cl);
+	audio_stream_copy(&source_c->stream, 0, &sink_c->stream, 0,
+			  cl.frames * source_c->stream.channels);
+
+	comp_update_buffer_consume(source_c, cl.source_bytes);
+	comp_update_buffer_produce(sink_c, cl.sink_bytes);
+
+	buffer_release(sink_c);
+	buffer_release(source_c);
+
+	/* components that wait for each other mustn't wait for this one */
+	comp_set_attribute(dev, COMP_ATTR_BYPASS, NULL);
+
+	return 0;
+}
+
 int audio_stream_copy(const struct audio_stream __sparse_cache *source, uint32_t ioffset,
 		      struct audio_stream __sparse_cache *sink, uint32_t ooffset, uint32_t samples)
 {
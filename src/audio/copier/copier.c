@@ -518,6 +518,7 @@ static void copier_free(struct comp_dev *dev)
 		buffer_free(cd->endpoint_buffer[i]);
 	}
 
+	copier_frontend_free(cd);
 	rfree(cd);
 	rfree(dev);
 }
@@ -590,6 +591,18 @@ static int copier_prepare(struct comp_dev *dev)
 			if (ret < 0)
 				break;
 		}
+
+		if (!ret && copier_frontend_active(cd)) {
+			struct comp_buffer __sparse_cache *source_c, *sink_c;
+			struct comp_buffer *sink;
+
+			sink = list_first_item(&dev->bsink_list, struct comp_buffer, source_list);
+			source_c = buffer_acquire(cd->endpoint_buffer[IPC4_COPIER_GATEWAY_PIN]);
+			sink_c = buffer_acquire(sink);
+			ret = copier_frontend_prepare(dev, cd, &source_c->stream, &sink_c->stream);
+			buffer_release(sink_c);
+			buffer_release(source_c);
+		}
 	} else {
 		/* set up format conversion function */
 		cd->converter[0] = get_converter_func(&cd->config.base.audio_fmt,
@@ -764,8 +777,12 @@ static int do_conversion_copy(struct comp_dev *dev,
 	i = IPC4_SINK_QUEUE_ID(sink->id);
 	buffer_stream_invalidate(src, processed_data->source_bytes);
 
-	cd->converter[i](&src->stream, 0, &sink->stream, 0,
-			 processed_data->frames * sink->stream.channels);
+	/* the capture front-end does the conversion together with its processing */
+	if (copier_frontend_active(cd))
+		copier_frontend_process(cd, &src->stream, &sink->stream, processed_data->frames);
+	else
+		cd->converter[i](&src->stream, 0, &sink->stream, 0,
+				 processed_data->frames * sink->stream.channels);
 
 	if (cd->attenuation) {
 		ret = apply_attenuation(dev, cd, sink, processed_data->frames);
@@ -1075,6 +1092,8 @@ static int copier_set_large_config(struct comp_dev *dev, uint32_t param_id,
 		return copier_set_sink_fmt(dev, data, data_offset);
 	case IPC4_COPIER_MODULE_CFG_ATTENUATION:
 		return set_attenuation(dev, data_offset, data);
+	case IPC4_COPIER_MODULE_CFG_CAPTURE_FRONTEND:
+		return copier_frontend_set_config(dev, comp_get_drvdata(dev), data, data_offset);
 	default:
 		return -EINVAL;
 	}
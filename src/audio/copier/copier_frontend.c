@@ -0,0 +1,277 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+/*
+ * Capture front-end stage of the DAI copier. Capture topologies usually
+ * put a selector and a DC blocking filter right after the DAI, each of
+ * them reading and writing a full period. This stage does the channel
+ * selection, the DC removal and the format conversion in the single
+ * pass the copier makes anyway from the DAI buffer to its sink.
+ */
+
+#include <ipc4/copier.h>
+#include <sof/audio/audio_stream.h>
+#include <sof/audio/buffer.h>
+#include <sof/audio/component_ext.h>
+#include <sof/audio/dcblock/dcblock.h>
+#include <sof/audio/format.h>
+#include <sof/common.h>
+#include <sof/lib/alloc.h>
+#include <sof/lib/cache.h>
+#include <sof/string.h>
+#include <sof/trace/trace.h>
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+LOG_MODULE_DECLARE(copier, CONFIG_SOF_LOG_LEVEL);
+
+typedef void (*copier_frontend_func)(struct copier_frontend *fe,
+				     const struct audio_stream __sparse_cache *source,
+				     struct audio_stream __sparse_cache *sink,
+				     uint32_t frames);
+
+struct copier_frontend {
+	struct ipc4_copier_frontend_cfg config;
+	struct dcblock_state state[IPC4_COPIER_FRONTEND_MAX_CHANNELS];
+	copier_frontend_func func;
+};
+
+/* reads a sample of the DAI buffer as Q1.31 */
+static __always_inline int32_t frontend_read(const void *x, int idx,
+					     const enum sof_ipc_frame fmt)
+{
+	switch (fmt) {
+	case SOF_IPC_FRAME_S16_LE:
+		return (int32_t)((const int16_t *)x)[idx] << 16;
+	case SOF_IPC_FRAME_S24_4LE:
+		return ((const int32_t *)x)[idx] << 8;
+	default:
+		return ((const int32_t *)x)[idx];
+	}
+}
+
+/* writes a Q1.31 sample to the sink buffer */
+static __always_inline void frontend_write(void *y, int idx, int32_t sample,
+					   const enum sof_ipc_frame fmt)
+{
+	switch (fmt) {
+	case SOF_IPC_FRAME_S16_LE:
+		((int16_t *)y)[idx] = sat_int16(Q_SHIFT_RND(sample, 31, 15));
+		break;
+	case SOF_IPC_FRAME_S24_4LE:
+		((int32_t *)y)[idx] = sat_int24(Q_SHIFT_RND(sample, 31, 23));
+		break;
+	default:
+		((int32_t *)y)[idx] = sample;
+		break;
+	}
+}
+
+/*
+ * The core is always inlined with constant formats, so the conversion
+ * of every sample is resolved at build time.
+ */
+static __always_inline void frontend_process(struct copier_frontend *fe,
+					     const struct audio_stream __sparse_cache *source,
+					     struct audio_stream __sparse_cache *sink,
+					     uint32_t frames, const enum sof_ipc_frame in_fmt,
+					     const enum sof_ipc_frame out_fmt)
+{
+	const int in_bytes = in_fmt == SOF_IPC_FRAME_S16_LE ? 2 : 4;
+	const int out_bytes = out_fmt == SOF_IPC_FRAME_S16_LE ? 2 : 4;
+	const int in_frame_bytes = source->channels * in_bytes;
+	const int out_frame_bytes = sink->channels * out_bytes;
+	const uint8_t *ch_map = fe->config.ch_map;
+	uint8_t *x = source->r_ptr;
+	uint8_t *y = sink->w_ptr;
+	int32_t sample;
+	int nch = sink->channels;
+	int n1;
+	int n2;
+	int n;
+	int i;
+	int ch;
+
+	while (frames) {
+		n1 = audio_stream_bytes_without_wrap(source, x) / in_frame_bytes;
+		n2 = audio_stream_bytes_without_wrap(sink, y) / out_frame_bytes;
+		n = MIN(n1, n2);
+		n = MIN(n, frames);
+		for (i = 0; i < n; i++) {
+			for (ch = 0; ch < nch; ch++) {
+				sample = frontend_read(x, ch_map[ch], in_fmt);
+				if (fe->config.dc_block)
+					sample = dcblock_generic(&fe->state[ch],
+								 fe->config.R_coeffs[ch],
+								 sample);
+				frontend_write(y, ch, sample, out_fmt);
+			}
+
+			x += in_frame_bytes;
+			y += out_frame_bytes;
+		}
+
+		frames -= n;
+		x = audio_stream_wrap(source, x);
+		y = audio_stream_wrap(sink, y);
+	}
+}
+
+#define FRONTEND_FUNC(in, in_fmt, out, out_fmt) \
+static void frontend_##in##_to_##out(struct copier_frontend *fe, \
+				     const struct audio_stream __sparse_cache *source, \
+				     struct audio_stream __sparse_cache *sink, \
+				     uint32_t frames) \
+{ \
+	frontend_process(fe, source, sink, frames, in_fmt, out_fmt); \
+}
+
+#if CONFIG_FORMAT_S16LE
+FRONTEND_FUNC(s16, SOF_IPC_FRAME_S16_LE, s16, SOF_IPC_FRAME_S16_LE)
+#endif
+#if CONFIG_FORMAT_S16LE && CONFIG_FORMAT_S24LE
+FRONTEND_FUNC(s16, SOF_IPC_FRAME_S16_LE, s24, SOF_IPC_FRAME_S24_4LE)
+FRONTEND_FUNC(s24, SOF_IPC_FRAME_S24_4LE, s16, SOF_IPC_FRAME_S16_LE)
+#endif
+#if CONFIG_FORMAT_S16LE && CONFIG_FORMAT_S32LE
+FRONTEND_FUNC(s16, SOF_IPC_FRAME_S16_LE, s32, SOF_IPC_FRAME_S32_LE)
+FRONTEND_FUNC(s32, SOF_IPC_FRAME_S32_LE, s16, SOF_IPC_FRAME_S16_LE)
+#endif
+#if CONFIG_FORMAT_S24LE
+FRONTEND_FUNC(s24, SOF_IPC_FRAME_S24_4LE, s24, SOF_IPC_FRAME_S24_4LE)
+#endif
+#if CONFIG_FORMAT_S24LE && CONFIG_FORMAT_S32LE
+FRONTEND_FUNC(s24, SOF_IPC_FRAME_S24_4LE, s32, SOF_IPC_FRAME_S32_LE)
+FRONTEND_FUNC(s32, SOF_IPC_FRAME_S32_LE, s24, SOF_IPC_FRAME_S24_4LE)
+#endif
+#if CONFIG_FORMAT_S32LE
+FRONTEND_FUNC(s32, SOF_IPC_FRAME_S32_LE, s32, SOF_IPC_FRAME_S32_LE)
+#endif
+
+static const struct {
+	enum sof_ipc_frame source;
+	enum sof_ipc_frame sink;
+	copier_frontend_func func;
+} frontend_func_map[] = {
+#if CONFIG_FORMAT_S16LE
+	{ SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S16_LE, frontend_s16_to_s16 },
+#endif
+#if CONFIG_FORMAT_S16LE && CONFIG_FORMAT_S24LE
+	{ SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S24_4LE, frontend_s16_to_s24 },
+	{ SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S16_LE, frontend_s24_to_s16 },
+#endif
+#if CONFIG_FORMAT_S16LE && CONFIG_FORMAT_S32LE
+	{ SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S32_LE, frontend_s16_to_s32 },
+	{ SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S16_LE, frontend_s32_to_s16 },
+#endif
+#if CONFIG_FORMAT_S24LE
+	{ SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S24_4LE, frontend_s24_to_s24 },
+#endif
+#if CONFIG_FORMAT_S24LE && CONFIG_FORMAT_S32LE
+	{ SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S32_LE, frontend_s24_to_s32 },
+	{ SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S24_4LE, frontend_s32_to_s24 },
+#endif
+#if CONFIG_FORMAT_S32LE
+	{ SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S32_LE, frontend_s32_to_s32 },
+#endif
+};
+
+int copier_frontend_set_config(struct comp_dev *dev, struct copier_data *cd,
+			       const char *data, uint32_t size)
+{
+	struct copier_frontend *fe;
+
+	if (size < sizeof(struct ipc4_copier_frontend_cfg)) {
+		comp_err(dev, "copier_frontend_set_config(): config size %u is too small", size);
+		return -EINVAL;
+	}
+
+	/* the stage replaces the conversion from the DAI buffer to the sink */
+	if (cd->endpoint_num != 1 || cd->bsource_buffer ||
+	    comp_get_endpoint_type(cd->endpoint[IPC4_COPIER_GATEWAY_PIN]) != COMP_ENDPOINT_DAI) {
+		comp_err(dev, "copier_frontend_set_config(): only supported for DAI capture");
+		return -EINVAL;
+	}
+
+	/* the processing function is selected in prepare */
+	if (dev->state != COMP_STATE_READY) {
+		comp_err(dev, "copier_frontend_set_config(): invalid state %d", dev->state);
+		return -EBUSY;
+	}
+
+	fe = cd->frontend;
+	if (!fe) {
+		fe = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, sizeof(*fe));
+		if (!fe) {
+			comp_err(dev, "copier_frontend_set_config(): allocation failed");
+			return -ENOMEM;
+		}
+	}
+
+	dcache_invalidate_region((__sparse_force void __sparse_cache *)data, sizeof(fe->config));
+	memcpy_s(&fe->config, sizeof(fe->config), data, sizeof(fe->config));
+	fe->func = NULL;
+	cd->frontend = fe;
+
+	return 0;
+}
+
+int copier_frontend_prepare(struct comp_dev *dev, struct copier_data *cd,
+			    const struct audio_stream __sparse_cache *source,
+			    const struct audio_stream __sparse_cache *sink)
+{
+	struct copier_frontend *fe = cd->frontend;
+	int ch;
+	int i;
+
+	if (!fe)
+		return 0;
+
+	if (sink->channels > IPC4_COPIER_FRONTEND_MAX_CHANNELS) {
+		comp_err(dev, "copier_frontend_prepare(): %u channels isn't supported",
+			 sink->channels);
+		return -EINVAL;
+	}
+
+	for (ch = 0; ch < sink->channels; ch++) {
+		if (fe->config.ch_map[ch] >= source->channels) {
+			comp_err(dev, "copier_frontend_prepare(): channel %d maps to %u, source has %u",
+				 ch, fe->config.ch_map[ch], source->channels);
+			return -EINVAL;
+		}
+	}
+
+	fe->func = NULL;
+	for (i = 0; i < ARRAY_SIZE(frontend_func_map); i++) {
+		if (frontend_func_map[i].source == source->frame_fmt &&
+		    frontend_func_map[i].sink == sink->frame_fmt) {
+			fe->func = frontend_func_map[i].func;
+			break;
+		}
+	}
+
+	if (!fe->func) {
+		comp_err(dev, "copier_frontend_prepare(): no function for source %d sink %d",
+			 source->frame_fmt, sink->frame_fmt);
+		return -EINVAL;
+	}
+
+	memset(fe->state, 0, sizeof(fe->state));
+
+	return 0;
+}
+
+void copier_frontend_process(struct copier_data *cd,
+			     const struct audio_stream __sparse_cache *source,
+			     struct audio_stream __sparse_cache *sink, uint32_t frames)
+{
+	cd->frontend->func(cd->frontend, source, sink, frames);
+}
+
+void copier_frontend_free(struct copier_data *cd)
+{
+	rfree(cd->frontend);
+	cd->frontend = NULL;
+}
@@ -12,6 +12,7 @@
 #include <sof/audio/ipc-config.h>
 #include <sof/audio/crossover/crossover.h>
 #include <sof/audio/crossover/crossover_algorithm.h>
+#include <sof/bit.h>
 #include <sof/common.h>
 #include <sof/debug/panic.h>
 #include <sof/ipc/msg.h>
@@ -178,6 +179,36 @@ static int crossover_assign_sinks(struct comp_dev *dev,
 	return num_sinks;
 }
 
+/**
+ * \brief Returns the mask of the outputs that have a sink connected.
+ *
+ * The split functions don't compute the other outputs, nor the filters
+ * that only feed them.
+ */
+static uint32_t crossover_active_sinks(struct comp_dev *dev,
+				       struct sof_crossover_config *config)
+{
+	struct comp_buffer *sink;
+	struct comp_buffer __sparse_cache *sink_c;
+	struct list_item *sink_list;
+	uint32_t active = 0;
+	uint32_t pipeline_id;
+	int i;
+
+	list_for_item(sink_list, &dev->bsink_list) {
+		sink = container_of(sink_list, struct comp_buffer, source_list);
+		sink_c = buffer_acquire(sink);
+		pipeline_id = sink_c->pipeline_id;
+		buffer_release(sink_c);
+
+		i = crossover_get_stream_index(config, pipeline_id);
+		if (i >= 0)
+			active |= BIT(i);
+	}
+
+	return active;
+}
+
 /**
  * \brief Sets the state of a single LR4 filter.
  *
@@ -364,6 +395,8 @@ static struct comp_dev *crossover_new(const struct comp_driver *drv,
 		goto cd_fail;
 	}
 
+	comp_data_blob_share(cd->model_handler);
+
 	/* Get configuration data and reset Crossover state */
 	ret = comp_init_data_blob(cd->model_handler, bs, ipc_crossover->data);
 	if (ret < 0) {
@@ -614,6 +647,7 @@ static int crossover_copy(struct comp_dev *dev)
 			comp_err(dev, "crossover_copy(), failed Crossover setup");
 			goto out;
 		}
+		cd->active_sinks = crossover_active_sinks(dev, cd->config);
 	}
 
 	/* Check if source is active */
@@ -764,8 +798,12 @@ static int crossover_prepare(struct comp_dev *dev)
 			goto out;
 		}
 
+		cd->active_sinks = crossover_active_sinks(dev, cd->config);
+		comp_info(dev, "crossover_prepare(), active outputs mask 0x%x",
+			  cd->active_sinks);
+
 		cd->crossover_process =
-			crossover_find_proc_func(cd->source_format);
+			crossover_find_proc_func(cd->source_format, source_c->stream.channels);
 		if (!cd->crossover_process) {
 			comp_err(dev, "crossover_prepare(), No processing function matching frame_fmt %i",
 				 cd->source_format);
@@ -829,6 +867,7 @@ static int crossover_reset(struct comp_dev *dev)
 static const struct comp_driver comp_crossover = {
 	.uid	= SOF_RT_UUID(crossover_uuid),
 	.tctx	= &crossover_tr,
+	.any_period	= true,
 	.ops	= {
 		.create		= crossover_new,
 		.free		= crossover_free,
@@ -7,25 +7,72 @@
 #include <stdint.h>
 #include <sof/audio/format.h>
 #include <sof/audio/component.h>
-#include <sof/audio/format.h>
 #include <sof/audio/crossover/crossover.h>
+#include <sof/bit.h>
 #include <sof/math/iir_df2t.h>
+#include <sof/math/numbers.h>
+#include <user/eq.h>
 
 /*
- * \brief Splits x into two based on the coefficients set in the lp
- *        and hp filters. The output of the lp is in y1, the output of
- *        the hp is in y2.
+ * \brief Runs a block of one channel through the LR4 filter, y can be x.
  *
- * As a side effect, this function mutates the delay values of both
- * filters.
+ * An LR4 is a single series of biquads. The generic version runs the
+ * whole block through one biquad at a time, with its coefficients and
+ * delays in local variables. The result is the same as with iir_df2t()
+ * per sample.
  */
-static inline void crossover_generic_lr4_split(struct iir_state_df2t *lp,
-					       struct iir_state_df2t *hp,
-					       int32_t x, int32_t *y1,
-					       int32_t *y2)
+static void crossover_lr4_block(struct iir_state_df2t *lr4, const int32_t *x,
+				int32_t *y, int frames)
 {
-	*y1 = crossover_generic_process_lr4(x, lp);
-	*y2 = crossover_generic_process_lr4(x, hp);
+#if IIR_GENERIC
+	const int32_t *coef = lr4->coef;
+	int64_t *delay = lr4->delay;
+	const int32_t *in = x;
+	int64_t acc, d0, d1;
+	int32_t a2, a1, b2, b1, b0, shift, gain;
+	int32_t tmp;
+	int i, j;
+
+	/* Bypass is set with number of biquads set to zero. */
+	if (!lr4->biquads) {
+		for (i = 0; i < frames; i++)
+			y[i] = x[i];
+		return;
+	}
+
+	/* Coefficients order in coef[] is {a2, a1, b2, b1, b0, shift, gain} */
+	for (j = 0; j < lr4->biquads; j++) {
+		a2 = coef[0];
+		a1 = coef[1];
+		b2 = coef[2];
+		b1 = coef[3];
+		b0 = coef[4];
+		shift = coef[5];
+		gain = coef[6];
+		d0 = delay[0];
+		d1 = delay[1];
+
+		for (i = 0; i < frames; i++) {
+			acc = (int64_t)b0 * in[i] + d0;
+			tmp = (int32_t)sat_int32(Q_SHIFT_RND(acc, 61, 31));
+			d0 = d1 + (int64_t)b1 * in[i] + (int64_t)a1 * tmp;
+			d1 = (int64_t)b2 * in[i] + (int64_t)a2 * tmp;
+			acc = (int64_t)gain * tmp;
+			y[i] = sat_int32(Q_SHIFT_RND(acc, 45 + shift, 31));
+		}
+
+		delay[0] = d0;
+		delay[1] = d1;
+		coef += SOF_EQ_IIR_NBIQUAD_DF2T;
+		delay += IIR_DF2T_NUM_DELAYS;
+		in = y;
+	}
+#else
+	int i;
+
+	for (i = 0; i < frames; i++)
+		y[i] = crossover_generic_process_lr4(x[i], lr4);
+#endif
 }
 
 /*
@@ -37,52 +84,74 @@ static inline void crossover_generic_lr4_split(struct iir_state_df2t *lp,
  * to be out of phase. We need to pass the signal through another set of LR4
  * filters to align back the phase.
  */
-static inline void crossover_generic_lr4_merge(struct iir_state_df2t *lp,
-					       struct iir_state_df2t *hp,
-					       int32_t x, int32_t *y)
+static void crossover_lr4_merge_block(struct iir_state_df2t *lp,
+				      struct iir_state_df2t *hp,
+				      int32_t *x, int32_t *y, int frames)
 {
-	int32_t z1, z2;
+	int i;
 
-	z1 = crossover_generic_process_lr4(x, lp);
-	z2 = crossover_generic_process_lr4(x, hp);
-	*y = sat_int32(((int64_t)z1) + z2);
+	crossover_lr4_block(lp, x, y, frames);
+	crossover_lr4_block(hp, x, x, frames);
+	for (i = 0; i < frames; i++)
+		y[i] = sat_int32((int64_t)y[i] + x[i]);
 }
 
-static void crossover_generic_split_2way(int32_t in,
-					 int32_t out[],
-					 struct crossover_state *state)
+static void crossover_generic_split_2way(struct crossover_state *state,
+					 const int32_t *x,
+					 int32_t y[][CROSSOVER_BLOCK_FRAMES],
+					 uint32_t active, int frames)
 {
-	crossover_generic_lr4_split(&state->lowpass[0], &state->highpass[0],
-				    in, &out[0], &out[1]);
+	if (active & BIT(0))
+		crossover_lr4_block(&state->lowpass[0], x, y[0], frames);
+	if (active & BIT(1))
+		crossover_lr4_block(&state->highpass[0], x, y[1], frames);
 }
 
-static void crossover_generic_split_3way(int32_t in,
-					 int32_t out[],
-					 struct crossover_state *state)
+static void crossover_generic_split_3way(struct crossover_state *state,
+					 const int32_t *x,
+					 int32_t y[][CROSSOVER_BLOCK_FRAMES],
+					 uint32_t active, int frames)
 {
-	int32_t z1, z2;
-
-	crossover_generic_lr4_split(&state->lowpass[0], &state->highpass[0],
-				    in, &z1, &z2);
-	/* Realign the phase of z1 */
-	crossover_generic_lr4_merge(&state->lowpass[1], &state->highpass[1],
-				    z1, &out[0]);
-	crossover_generic_lr4_split(&state->lowpass[2], &state->highpass[2],
-				    z2, &out[1], &out[2]);
+	int32_t z[CROSSOVER_BLOCK_FRAMES];
+
+	if (active & BIT(0)) {
+		crossover_lr4_block(&state->lowpass[0], x, z, frames);
+		/* Realign the phase of z */
+		crossover_lr4_merge_block(&state->lowpass[1], &state->highpass[1],
+					  z, y[0], frames);
+	}
+
+	if (active & (BIT(1) | BIT(2))) {
+		crossover_lr4_block(&state->highpass[0], x, z, frames);
+		if (active & BIT(1))
+			crossover_lr4_block(&state->lowpass[2], z, y[1], frames);
+		if (active & BIT(2))
+			crossover_lr4_block(&state->highpass[2], z, y[2], frames);
+	}
 }
 
-static void crossover_generic_split_4way(int32_t in,
-					 int32_t out[],
-					 struct crossover_state *state)
+static void crossover_generic_split_4way(struct crossover_state *state,
+					 const int32_t *x,
+					 int32_t y[][CROSSOVER_BLOCK_FRAMES],
+					 uint32_t active, int frames)
 {
-	int32_t z1, z2;
-
-	crossover_generic_lr4_split(&state->lowpass[1], &state->highpass[1],
-				    in, &z1, &z2);
-	crossover_generic_lr4_split(&state->lowpass[0], &state->highpass[0],
-				    z1, &out[0], &out[1]);
-	crossover_generic_lr4_split(&state->lowpass[2], &state->highpass[2],
-				    z2, &out[2], &out[3]);
+	int32_t z[CROSSOVER_BLOCK_FRAMES];
+
+	if (active & (BIT(0) | BIT(1))) {
+		crossover_lr4_block(&state->lowpass[1], x, z, frames);
+		if (active & BIT(0))
+			crossover_lr4_block(&state->lowpass[0], z, y[0], frames);
+		if (active & BIT(1))
+			crossover_lr4_block(&state->highpass[0], z, y[1], frames);
+	}
+
+	if (active & (BIT(2) | BIT(3))) {
+		crossover_lr4_block(&state->highpass[1], x, z, frames);
+		if (active & BIT(2))
+			crossover_lr4_block(&state->lowpass[2], z, y[2], frames);
+		if (active & BIT(3))
+			crossover_lr4_block(&state->highpass[2], z, y[3], frames);
+	}
 }
 
 #if CONFIG_FORMAT_S16LE
@@ -134,125 +203,159 @@ static void crossover_s32_default_pass(const struct comp_dev *dev,
 }
 #endif /* CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE */
 
-#if CONFIG_FORMAT_S16LE
-static void crossover_s16_default(const struct comp_dev *dev,
-				  const struct comp_buffer __sparse_cache *source,
-				  struct comp_buffer __sparse_cache *sinks[],
-				  int32_t num_sinks,
-				  uint32_t frames)
+/* reads a sample of the source as Q1.31 */
+static __always_inline int32_t crossover_read(const struct audio_stream __sparse_cache *source,
+					      int idx, const enum sof_ipc_frame fmt)
 {
-	struct comp_data *cd = comp_get_drvdata(dev);
-	struct crossover_state *state;
-	const struct audio_stream __sparse_cache *source_stream = &source->stream;
-	struct audio_stream __sparse_cache *sink_stream;
-	int16_t *x, *y;
-	int ch, i, j;
-	int idx;
-	int nch = source_stream->channels;
-	int32_t out[num_sinks];
-
-	for (ch = 0; ch < nch; ch++) {
-		idx = ch;
-		state = &cd->state[ch];
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s16(source_stream, idx);
-			cd->crossover_split(*x << 16, out, state);
-
-			for (j = 0; j < num_sinks; j++) {
-				if (!sinks[j])
-					continue;
-				sink_stream = &sinks[j]->stream;
-				y = audio_stream_write_frag_s16(sink_stream,
-								idx);
-				*y = sat_int16(Q_SHIFT_RND(out[j], 31, 15));
-			}
+	switch (fmt) {
+	case SOF_IPC_FRAME_S16_LE:
+		return (int32_t)*(int16_t *)audio_stream_read_frag_s16(source, idx) << 16;
+	case SOF_IPC_FRAME_S24_4LE:
+		return *(int32_t *)audio_stream_read_frag_s32(source, idx) << 8;
+	default:
+		return *(int32_t *)audio_stream_read_frag_s32(source, idx);
+	}
+}
 
-			idx += nch;
-		}
+/* writes a Q1.31 sample to a sink */
+static __always_inline void crossover_write(struct audio_stream __sparse_cache *sink,
+					    int idx, int32_t sample,
+					    const enum sof_ipc_frame fmt)
+{
+	int16_t *y16;
+	int32_t *y32;
+
+	switch (fmt) {
+	case SOF_IPC_FRAME_S16_LE:
+		y16 = audio_stream_write_frag_s16(sink, idx);
+		*y16 = sat_int16(Q_SHIFT_RND(sample, 31, 15));
+		break;
+	case SOF_IPC_FRAME_S24_4LE:
+		y32 = audio_stream_write_frag_s32(sink, idx);
+		*y32 = sat_int24(Q_SHIFT_RND(sample, 31, 23));
+		break;
+	default:
+		y32 = audio_stream_write_frag_s32(sink, idx);
+		*y32 = sample;
+		break;
 	}
 }
-#endif /* CONFIG_FORMAT_S16LE */
 
-#if CONFIG_FORMAT_S24LE
-static void crossover_s24_default(const struct comp_dev *dev,
-				  const struct comp_buffer __sparse_cache *source,
-				  struct comp_buffer __sparse_cache *sinks[],
-				  int32_t num_sinks,
-				  uint32_t frames)
+/*
+ * The channels are processed one at a time in blocks of
+ * CROSSOVER_BLOCK_FRAMES, so the LR4 filters can keep their state in
+ * registers over the block. Outputs without a sink are not computed.
+ * The core is always inlined with a constant format, and with a constant
+ * channels count in the variants for the common counts.
+ */
+static __always_inline void crossover_block(const struct comp_dev *dev,
+					    const struct comp_buffer __sparse_cache *source,
+					    struct comp_buffer __sparse_cache *sinks[],
+					    int32_t num_sinks, uint32_t frames,
+					    const enum sof_ipc_frame fmt, const int nch)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
-	struct crossover_state *state;
 	const struct audio_stream __sparse_cache *source_stream = &source->stream;
-	struct audio_stream __sparse_cache *sink_stream;
-	int32_t *x, *y;
+	int32_t x[CROSSOVER_BLOCK_FRAMES];
+	int32_t y[CROSSOVER_4WAY_NUM_SINKS][CROSSOVER_BLOCK_FRAMES];
+	uint32_t active = cd->active_sinks;
+	uint32_t done;
 	int ch, i, j;
 	int idx;
-	int nch = source_stream->channels;
-	int32_t out[num_sinks];
+	int n;
+
+	for (done = 0; done < frames; done += n) {
+		n = MIN(frames - done, CROSSOVER_BLOCK_FRAMES);
+		for (ch = 0; ch < nch; ch++) {
+			idx = done * nch + ch;
+			for (i = 0; i < n; i++) {
+				x[i] = crossover_read(source_stream, idx, fmt);
+				idx += nch;
+			}
 
-	for (ch = 0; ch < nch; ch++) {
-		idx = ch;
-		state = &cd->state[ch];
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s32(source_stream, idx);
-			cd->crossover_split(*x << 8, out, state);
+			cd->crossover_split(&cd->state[ch], x, y, active, n);
 
 			for (j = 0; j < num_sinks; j++) {
-				if (!sinks[j])
+				if (!sinks[j] || !(active & BIT(j)))
 					continue;
-				sink_stream = &sinks[j]->stream;
-				y = audio_stream_write_frag_s32(sink_stream,
-								idx);
-				*y = sat_int24(Q_SHIFT_RND(out[j], 31, 23));
+				idx = done * nch + ch;
+				for (i = 0; i < n; i++) {
+					crossover_write(&sinks[j]->stream, idx, y[j][i], fmt);
+					idx += nch;
+				}
 			}
-
-			idx += nch;
 		}
 	}
 }
+
+#define CROSSOVER_FUNC(fmt, frame_fmt) \
+static void crossover_##fmt##_default(const struct comp_dev *dev, \
+				      const struct comp_buffer __sparse_cache *source, \
+				      struct comp_buffer __sparse_cache *sinks[], \
+				      int32_t num_sinks, uint32_t frames) \
+{ \
+	crossover_block(dev, source, sinks, num_sinks, frames, frame_fmt, \
+			source->stream.channels); \
+}
+
+/* Variants for the common channels counts */
+#define CROSSOVER_NCH_FUNC(fmt, frame_fmt, nch) \
+static void crossover_##fmt##_##nch##ch(const struct comp_dev *dev, \
+					const struct comp_buffer __sparse_cache *source, \
+					struct comp_buffer __sparse_cache *sinks[], \
+					int32_t num_sinks, uint32_t frames) \
+{ \
+	crossover_block(dev, source, sinks, num_sinks, frames, frame_fmt, nch); \
+}
+
+#if CONFIG_FORMAT_S16LE
+CROSSOVER_FUNC(s16, SOF_IPC_FRAME_S16_LE)
+CROSSOVER_NCH_FUNC(s16, SOF_IPC_FRAME_S16_LE, 1)
+CROSSOVER_NCH_FUNC(s16, SOF_IPC_FRAME_S16_LE, 2)
+CROSSOVER_NCH_FUNC(s16, SOF_IPC_FRAME_S16_LE, 4)
+CROSSOVER_NCH_FUNC(s16, SOF_IPC_FRAME_S16_LE, 8)
+#endif /* CONFIG_FORMAT_S16LE */
+
+#if CONFIG_FORMAT_S24LE
+CROSSOVER_FUNC(s24, SOF_IPC_FRAME_S24_4LE)
+CROSSOVER_NCH_FUNC(s24, SOF_IPC_FRAME_S24_4LE, 1)
+CROSSOVER_NCH_FUNC(s24, SOF_IPC_FRAME_S24_4LE, 2)
+CROSSOVER_NCH_FUNC(s24, SOF_IPC_FRAME_S24_4LE, 4)
+CROSSOVER_NCH_FUNC(s24, SOF_IPC_FRAME_S24_4LE, 8)
 #endif /* CONFIG_FORMAT_S24LE */
 
 #if CONFIG_FORMAT_S32LE
-static void crossover_s32_default(const struct comp_dev *dev,
-				  const struct comp_buffer __sparse_cache *source,
-				  struct comp_buffer __sparse_cache *sinks[],
-				  int32_t num_sinks,
-				  uint32_t frames)
-{
-	struct comp_data *cd = comp_get_drvdata(dev);
-	struct crossover_state *state;
-	const struct audio_stream __sparse_cache *source_stream = &source->stream;
-	struct audio_stream __sparse_cache *sink_stream;
-	int32_t *x, *y;
-	int ch, i, j;
-	int idx;
-	int nch = source_stream->channels;
-	int32_t out[num_sinks];
+CROSSOVER_FUNC(s32, SOF_IPC_FRAME_S32_LE)
+CROSSOVER_NCH_FUNC(s32, SOF_IPC_FRAME_S32_LE, 1)
+CROSSOVER_NCH_FUNC(s32, SOF_IPC_FRAME_S32_LE, 2)
+CROSSOVER_NCH_FUNC(s32, SOF_IPC_FRAME_S32_LE, 4)
+CROSSOVER_NCH_FUNC(s32, SOF_IPC_FRAME_S32_LE, 8)
+#endif /* CONFIG_FORMAT_S32LE */
 
-	for (ch = 0; ch < nch; ch++) {
-		idx = ch;
-		state = &cd->state[0];
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s32(source_stream, idx);
-			cd->crossover_split(*x, out, state);
+const struct crossover_proc_fnmap crossover_proc_fnmap[] = {
+/* { SOURCE_FORMAT , PROCESSING FUNCTION, CHANNELS } */
+/* The channels specific variants need to be before the generic ones */
+#if CONFIG_FORMAT_S16LE
+	{ SOF_IPC_FRAME_S16_LE, crossover_s16_1ch, 1 },
+	{ SOF_IPC_FRAME_S16_LE, crossover_s16_2ch, 2 },
+	{ SOF_IPC_FRAME_S16_LE, crossover_s16_4ch, 4 },
+	{ SOF_IPC_FRAME_S16_LE, crossover_s16_8ch, 8 },
+#endif /* CONFIG_FORMAT_S16LE */
 
-			for (j = 0; j < num_sinks; j++) {
-				if (!sinks[j])
-					continue;
-				sink_stream = &sinks[j]->stream;
-				y = audio_stream_write_frag_s32(sink_stream,
-								idx);
-				*y = out[j];
-			}
+#if CONFIG_FORMAT_S24LE
+	{ SOF_IPC_FRAME_S24_4LE, crossover_s24_1ch, 1 },
+	{ SOF_IPC_FRAME_S24_4LE, crossover_s24_2ch, 2 },
+	{ SOF_IPC_FRAME_S24_4LE, crossover_s24_4ch, 4 },
+	{ SOF_IPC_FRAME_S24_4LE, crossover_s24_8ch, 8 },
+#endif /* CONFIG_FORMAT_S24LE */
 
-			idx += nch;
-		}
-	}
-}
+#if CONFIG_FORMAT_S32LE
+	{ SOF_IPC_FRAME_S32_LE, crossover_s32_1ch, 1 },
+	{ SOF_IPC_FRAME_S32_LE, crossover_s32_2ch, 2 },
+	{ SOF_IPC_FRAME_S32_LE, crossover_s32_4ch, 4 },
+	{ SOF_IPC_FRAME_S32_LE, crossover_s32_8ch, 8 },
 #endif /* CONFIG_FORMAT_S32LE */
 
-const struct crossover_proc_fnmap crossover_proc_fnmap[] = {
-/* { SOURCE_FORMAT , PROCESSING FUNCTION } */
 #if CONFIG_FORMAT_S16LE
 	{ SOF_IPC_FRAME_S16_LE, crossover_s16_default },
 #endif /* CONFIG_FORMAT_S16LE */
@@ -282,6 +385,7 @@ const struct crossover_proc_fnmap crossover_proc_fnmap_pass[] = {
 };
 
 const size_t crossover_proc_fncount = ARRAY_SIZE(crossover_proc_fnmap);
+const size_t crossover_proc_fncount_pass = ARRAY_SIZE(crossover_proc_fnmap_pass);
 
 const crossover_split crossover_split_fnmap[] = {
 	crossover_generic_split_2way,
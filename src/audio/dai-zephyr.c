@@ -1161,6 +1161,16 @@ static int dai_copy(struct comp_dev *dev)
 
 	buf_c = buffer_acquire(dd->local_buffer);
 
+	ret = pipeline_xrun_conceal(dev->pipeline, dev, buf_c,
+				    dev->direction == SOF_IPC_STREAM_PLAYBACK ?
+				    avail_bytes : free_bytes, dd->period_bytes,
+				    sampling * buf_c->stream.channels);
+	if (ret < 0) {
+		buffer_release(buf_c);
+		dai_report_xrun(dev, dd->period_bytes);
+		return ret;
+	}
+
 	/* calculate minimum size to copy */
 	if (dev->direction == SOF_IPC_STREAM_PLAYBACK) {
 		src_samples = audio_stream_get_avail_samples(&buf_c->stream);
@@ -1321,6 +1331,37 @@ uint32_t dai_get_init_delay_ms(struct dai *dai)
 	return props->reg_init_delay;
 }
 
+static int dai_set_attribute(struct comp_dev *dev, uint32_t type, void *value)
+{
+	struct dai_data *dd = comp_get_drvdata(dev);
+	struct comp_buffer __sparse_cache *buffer_c;
+	uint32_t period_bytes;
+	uint32_t size;
+
+	if (type != COMP_ATTR_PERIOD)
+		return -EINVAL;
+
+	/* params will size everything for the new period */
+	if (!dd->dma_buffer)
+		return 0;
+
+	buffer_c = buffer_acquire(dd->dma_buffer);
+	period_bytes = dev->frames * audio_stream_frame_bytes(&buffer_c->stream);
+	size = buffer_c->stream.size;
+	buffer_release(buffer_c);
+
+	/* the DMA buffer must hold two periods, topology dma_buffer_size can make it larger */
+	if (!period_bytes || size < 2 * period_bytes) {
+		comp_err(dev, "dai_set_attribute(): dma buffer %u too small for period %u",
+			 size, period_bytes);
+		return -EINVAL;
+	}
+
+	dd->period_bytes = period_bytes;
+
+	return 0;
+}
+
 static uint64_t dai_get_processed_data(struct comp_dev *dev, uint32_t stream_no, bool input)
 {
 	struct dai_data *dd = comp_get_drvdata(dev);
@@ -1355,6 +1396,7 @@ static const struct comp_driver comp_dai = {
 		.dai_ts_start			= dai_ts_start_op,
 		.dai_ts_stop			= dai_ts_stop_op,
 		.dai_ts_get			= dai_ts_get_op,
+		.set_attribute			= dai_set_attribute,
 		.get_total_data_processed	= dai_get_processed_data,
 },
 };
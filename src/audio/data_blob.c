@@ -11,6 +11,9 @@
 #include <ipc/control.h>
 #include <sof/audio/component.h>
 #include <sof/audio/data_blob.h>
+#include <sof/drivers/interrupt.h>
+#include <sof/lib/cpu.h>
+#include <sof/list.h>
 
 LOG_MODULE_REGISTER(data_blob, CONFIG_SOF_LOG_LEVEL);
 
@@ -30,8 +33,135 @@ struct comp_data_blob_handler {
 				  */
 	void *(*alloc)(size_t size);	/**< alternate allocator, maybe null */
 	void (*free)(void *buf);	/**< alternate free(), maybe null */
+#if CONFIG_COMP_DATA_BLOB_SHARE
+	bool share;			/**< data may be shared with others */
+	struct data_blob_shared *shared; /**< shared entry of data, or NULL */
+#endif
 };
 
+#if CONFIG_COMP_DATA_BLOB_SHARE
+/** \brief Blob held by all the handlers on a core with identical data */
+struct data_blob_shared {
+	struct list_item list;	/**< in the cache of the core */
+	void *data;		/**< allocated by the first holder */
+	uint32_t size;
+	uint32_t crc;
+	uint32_t refs;		/**< handlers holding the blob */
+};
+
+/* blobs shared on each core, only that core walks its list */
+static struct list_item data_blob_cache[CONFIG_CORE_COUNT];
+
+static void *default_alloc(size_t size);
+
+static struct list_item *data_blob_cache_get(void)
+{
+	struct list_item *cache = &data_blob_cache[cpu_get_id()];
+
+	if (!cache->next)
+		list_init(cache);
+
+	return cache;
+}
+
+/*
+ * Called when data becomes the current blob. If an identical blob is
+ * already held on this core, data is freed and the held copy is used.
+ */
+static void comp_share_data_blob(struct comp_data_blob_handler *blob_handler)
+{
+	struct data_blob_shared *shared;
+	struct list_item *cache;
+	struct list_item *item;
+	uint32_t flags;
+	uint32_t crc;
+
+	if (!blob_handler->share || !blob_handler->data)
+		return;
+
+	crc = crc32(0, blob_handler->data, blob_handler->data_size);
+
+	irq_local_disable(flags);
+	cache = data_blob_cache_get();
+	list_for_item(item, cache) {
+		shared = container_of(item, struct data_blob_shared, list);
+		if (shared->crc == crc && shared->size == blob_handler->data_size &&
+		    !memcmp(shared->data, blob_handler->data, shared->size)) {
+			shared->refs++;
+			irq_local_enable(flags);
+
+			comp_dbg(blob_handler->dev, "comp_share_data_blob(): crc %x shared %u times",
+				 crc, shared->refs);
+			blob_handler->free(blob_handler->data);
+			blob_handler->data = shared->data;
+			blob_handler->shared = shared;
+			return;
+		}
+	}
+	irq_local_enable(flags);
+
+	/* first holder, without an entry the blob just stays private */
+	shared = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, sizeof(*shared));
+	if (!shared)
+		return;
+
+	shared->data = blob_handler->data;
+	shared->size = blob_handler->data_size;
+	shared->crc = crc;
+	shared->refs = 1;
+	blob_handler->shared = shared;
+
+	irq_local_disable(flags);
+	list_item_prepend(&shared->list, cache);
+	irq_local_enable(flags);
+}
+
+/* frees the current blob, a shared one when its last holder lets it go */
+static void comp_release_data_blob(struct comp_data_blob_handler *blob_handler)
+{
+	struct data_blob_shared *shared = blob_handler->shared;
+	uint32_t flags;
+	bool last;
+
+	blob_handler->shared = NULL;
+	if (!shared) {
+		blob_handler->free(blob_handler->data);
+		blob_handler->data = NULL;
+		return;
+	}
+
+	irq_local_disable(flags);
+	last = !--shared->refs;
+	if (last)
+		list_item_del(&shared->list);
+	irq_local_enable(flags);
+
+	if (last) {
+		blob_handler->free(shared->data);
+		rfree(shared);
+	}
+
+	blob_handler->data = NULL;
+}
+
+void comp_data_blob_share(struct comp_data_blob_handler *blob_handler)
+{
+	/* single blob mode reuses its blob in place for the next one */
+	blob_handler->share = !blob_handler->single_blob &&
+			      blob_handler->alloc == default_alloc;
+}
+#else
+static void comp_share_data_blob(struct comp_data_blob_handler *blob_handler)
+{
+}
+
+static void comp_release_data_blob(struct comp_data_blob_handler *blob_handler)
+{
+	blob_handler->free(blob_handler->data);
+	blob_handler->data = NULL;
+}
+#endif
+
 static void comp_free_data_blob(struct comp_data_blob_handler *blob_handler)
 {
 	assert(blob_handler);
@@ -39,9 +169,8 @@ static void comp_free_data_blob(struct comp_data_blob_handler *blob_handler)
 	if (!blob_handler->data)
 		return;
 
-	blob_handler->free(blob_handler->data);
+	comp_release_data_blob(blob_handler);
 	blob_handler->free(blob_handler->data_new);
-	blob_handler->data = NULL;
 	blob_handler->data_new = NULL;
 	blob_handler->data_size = 0;
 }
@@ -61,7 +190,7 @@ void *comp_get_data_blob(struct comp_data_blob_handler *blob_handler,
 		comp_dbg(blob_handler->dev, "comp_get_data_blob(): new data available");
 
 		/* Free "old" data blob and set data to data_new pointer */
-		blob_handler->free(blob_handler->data);
+		comp_release_data_blob(blob_handler);
 		blob_handler->data = blob_handler->data_new;
 		blob_handler->data_size = blob_handler->new_data_size;
 
@@ -69,6 +198,7 @@ void *comp_get_data_blob(struct comp_data_blob_handler *blob_handler,
 		blob_handler->data_ready = false;
 		blob_handler->new_data_size = 0;
 		blob_handler->data_pos = 0;
+		comp_share_data_blob(blob_handler);
 	}
 
 	/* If data is available we calculate crc32 when crc pointer is given */
@@ -145,6 +275,7 @@ int comp_init_data_blob(struct comp_data_blob_handler *blob_handler,
 	blob_handler->data_new = NULL;
 	blob_handler->data_size = size;
 	blob_handler->new_data_size = 0;
+	comp_share_data_blob(blob_handler);
 
 	return 0;
 }
@@ -244,10 +375,8 @@ int comp_data_blob_set(struct comp_data_blob_handler *blob_handler,
 		 * configuration immediately. When in playback/capture
 		 * the new configuration presence is checked in copy().
 		 */
-		if (blob_handler->dev->state ==  COMP_STATE_READY) {
-			blob_handler->free(blob_handler->data);
-			blob_handler->data = NULL;
-		}
+		if (blob_handler->dev->state ==  COMP_STATE_READY)
+			comp_release_data_blob(blob_handler);
 
 		/* If there is no existing configuration the received
 		 * can be set to current immediately. It will be
@@ -263,6 +392,7 @@ int comp_data_blob_set(struct comp_data_blob_handler *blob_handler,
 			blob_handler->data_ready = false;
 			blob_handler->new_data_size = 0;
 			blob_handler->data_pos = 0;
+			comp_share_data_blob(blob_handler);
 		} else {
 			/* The new configuration is ready to be applied */
 			blob_handler->data_ready = true;
@@ -367,10 +497,8 @@ int comp_data_blob_set_cmd(struct comp_data_blob_handler *blob_handler,
 		 * configuration immediately. When in playback/capture
 		 * the new configuration presence is checked in copy().
 		 */
-		if (blob_handler->dev->state ==  COMP_STATE_READY) {
-			blob_handler->free(blob_handler->data);
-			blob_handler->data = NULL;
-		}
+		if (blob_handler->dev->state ==  COMP_STATE_READY)
+			comp_release_data_blob(blob_handler);
 
 		/* If there is no existing configuration the received
 		 * can be set to current immediately. It will be
@@ -386,6 +514,7 @@ int comp_data_blob_set_cmd(struct comp_data_blob_handler *blob_handler,
 			blob_handler->data_ready = false;
 			blob_handler->new_data_size = 0;
 			blob_handler->data_pos = 0;
+			comp_share_data_blob(blob_handler);
 		} else {
 			/* The new configuration is ready to be applied */
 			blob_handler->data_ready = true;
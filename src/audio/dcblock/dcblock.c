@@ -363,7 +363,7 @@ static int dcblock_prepare(struct comp_dev *dev)
 
 	dcblock_init_state(cd);
 
-	cd->dcblock_func = dcblock_find_func(cd->source_format);
+	cd->dcblock_func = dcblock_find_func(cd->source_format, source_c->stream.channels);
 	if (!cd->dcblock_func) {
 		comp_err(dev, "dcblock_prepare(), No processing function matching frames format");
 		ret = -EINVAL;
@@ -408,6 +408,7 @@ static const struct comp_driver comp_dcblock = {
 	.type = SOF_COMP_DCBLOCK,
 	.uid  = SOF_RT_UUID(dcblock_uuid),
 	.tctx = &dcblock_tr,
+	.any_period = true,
 	.ops  = {
 		 .create	= dcblock_new,
 		 .free		= dcblock_free,
@@ -11,27 +11,6 @@
 
 LOG_MODULE_DECLARE(dcblock, CONFIG_SOF_LOG_LEVEL);
 
-/**
- *
- * Genereric processing function. Input is 32 bits.
- *
- */
-static int32_t dcblock_generic(struct dcblock_state *state,
-			       int64_t R, int32_t x)
-{
-	/*
-	 * R: Q2.30, y_prev: Q1.31
-	 * R * y_prev: Q3.61
-	 */
-	int64_t out = ((int64_t)x) - state->x_prev +
-		      Q_SHIFT_RND(R * state->y_prev, 61, 31);
-
-	state->y_prev = sat_int32(out);
-	state->x_prev = x;
-
-	return state->y_prev;
-}
-
 #if CONFIG_FORMAT_S16LE
 static void dcblock_s16_default(const struct comp_dev *dev,
 				const struct audio_stream __sparse_cache *source,
@@ -152,8 +131,179 @@ static void dcblock_s32_default(const struct comp_dev *dev,
 }
 #endif /* CONFIG_FORMAT_S32LE */
 
+/*
+ * Variants for the common channels counts. The core is always inlined
+ * with a constant channels count, so the loop over channels is unrolled
+ * and the filter states can be kept in registers.
+ */
+#define DCBLOCK_NCH_FUNC(fmt, nch) \
+static void dcblock_##fmt##_##nch##ch(const struct comp_dev *dev, \
+				      const struct audio_stream __sparse_cache *source, \
+				      const struct audio_stream __sparse_cache *sink, \
+				      uint32_t frames) \
+{ \
+	dcblock_##fmt##_nch(dev, source, sink, frames, nch); \
+}
+
+#if CONFIG_FORMAT_S16LE
+static __always_inline void dcblock_s16_nch(const struct comp_dev *dev,
+					    const struct audio_stream __sparse_cache *source,
+					    const struct audio_stream __sparse_cache *sink,
+					    uint32_t frames, const int nch)
+{
+	struct comp_data *cd = comp_get_drvdata(dev);
+	struct dcblock_state state[PLATFORM_MAX_CHANNELS];
+	int16_t *x = source->r_ptr;
+	int16_t *y = sink->w_ptr;
+	int32_t tmp;
+	int ch;
+	int i, n, nmax;
+
+	for (ch = 0; ch < nch; ch++)
+		state[ch] = cd->state[ch];
+
+	while (frames) {
+		nmax = audio_stream_bytes_without_wrap(source, x) / (nch * sizeof(int16_t));
+		n = MIN(frames, nmax);
+		nmax = audio_stream_bytes_without_wrap(sink, y) / (nch * sizeof(int16_t));
+		n = MIN(n, nmax);
+		for (i = 0; i < n; i++) {
+			for (ch = 0; ch < nch; ch++) {
+				tmp = dcblock_generic(&state[ch], cd->R_coeffs[ch], x[ch] << 16);
+				y[ch] = sat_int16(Q_SHIFT_RND(tmp, 31, 15));
+			}
+
+			x += nch;
+			y += nch;
+		}
+		frames -= n;
+		x = audio_stream_wrap(source, x);
+		y = audio_stream_wrap(sink, y);
+	}
+
+	for (ch = 0; ch < nch; ch++)
+		cd->state[ch] = state[ch];
+}
+
+DCBLOCK_NCH_FUNC(s16, 1)
+DCBLOCK_NCH_FUNC(s16, 2)
+DCBLOCK_NCH_FUNC(s16, 4)
+DCBLOCK_NCH_FUNC(s16, 8)
+#endif /* CONFIG_FORMAT_S16LE */
+
+#if CONFIG_FORMAT_S24LE
+static __always_inline void dcblock_s24_nch(const struct comp_dev *dev,
+					    const struct audio_stream __sparse_cache *source,
+					    const struct audio_stream __sparse_cache *sink,
+					    uint32_t frames, const int nch)
+{
+	struct comp_data *cd = comp_get_drvdata(dev);
+	struct dcblock_state state[PLATFORM_MAX_CHANNELS];
+	int32_t *x = source->r_ptr;
+	int32_t *y = sink->w_ptr;
+	int32_t tmp;
+	int ch;
+	int i, n, nmax;
+
+	for (ch = 0; ch < nch; ch++)
+		state[ch] = cd->state[ch];
+
+	while (frames) {
+		nmax = audio_stream_bytes_without_wrap(source, x) / (nch * sizeof(int32_t));
+		n = MIN(frames, nmax);
+		nmax = audio_stream_bytes_without_wrap(sink, y) / (nch * sizeof(int32_t));
+		n = MIN(n, nmax);
+		for (i = 0; i < n; i++) {
+			for (ch = 0; ch < nch; ch++) {
+				tmp = dcblock_generic(&state[ch], cd->R_coeffs[ch], x[ch] << 8);
+				y[ch] = sat_int24(Q_SHIFT_RND(tmp, 31, 23));
+			}
+
+			x += nch;
+			y += nch;
+		}
+		frames -= n;
+		x = audio_stream_wrap(source, x);
+		y = audio_stream_wrap(sink, y);
+	}
+
+	for (ch = 0; ch < nch; ch++)
+		cd->state[ch] = state[ch];
+}
+
+DCBLOCK_NCH_FUNC(s24, 1)
+DCBLOCK_NCH_FUNC(s24, 2)
+DCBLOCK_NCH_FUNC(s24, 4)
+DCBLOCK_NCH_FUNC(s24, 8)
+#endif /* CONFIG_FORMAT_S24LE */
+
+#if CONFIG_FORMAT_S32LE
+static __always_inline void dcblock_s32_nch(const struct comp_dev *dev,
+					    const struct audio_stream __sparse_cache *source,
+					    const struct audio_stream __sparse_cache *sink,
+					    uint32_t frames, const int nch)
+{
+	struct comp_data *cd = comp_get_drvdata(dev);
+	struct dcblock_state state[PLATFORM_MAX_CHANNELS];
+	int32_t *x = source->r_ptr;
+	int32_t *y = sink->w_ptr;
+	int32_t tmp;
+	int ch;
+	int i, n, nmax;
+
+	for (ch = 0; ch < nch; ch++)
+		state[ch] = cd->state[ch];
+
+	while (frames) {
+		nmax = audio_stream_bytes_without_wrap(source, x) / (nch * sizeof(int32_t));
+		n = MIN(frames, nmax);
+		nmax = audio_stream_bytes_without_wrap(sink, y) / (nch * sizeof(int32_t));
+		n = MIN(n, nmax);
+		for (i = 0; i < n; i++) {
+			for (ch = 0; ch < nch; ch++) {
+				tmp = dcblock_generic(&state[ch], cd->R_coeffs[ch], x[ch]);
+				y[ch] = tmp;
+			}
+
+			x += nch;
+			y += nch;
+		}
+		frames -= n;
+		x = audio_stream_wrap(source, x);
+		y = audio_stream_wrap(sink, y);
+	}
+
+	for (ch = 0; ch < nch; ch++)
+		cd->state[ch] = state[ch];
+}
+
+DCBLOCK_NCH_FUNC(s32, 1)
+DCBLOCK_NCH_FUNC(s32, 2)
+DCBLOCK_NCH_FUNC(s32, 4)
+DCBLOCK_NCH_FUNC(s32, 8)
+#endif /* CONFIG_FORMAT_S32LE */
+
 const struct dcblock_func_map dcblock_fnmap[] = {
-/* { SOURCE_FORMAT , PROCESSING FUNCTION } */
+/* { SOURCE_FORMAT , PROCESSING FUNCTION, CHANNELS } */
+/* The channels specific variants need to be before the generic ones */
+#if CONFIG_FORMAT_S16LE
+	{ SOF_IPC_FRAME_S16_LE, dcblock_s16_1ch, 1 },
+	{ SOF_IPC_FRAME_S16_LE, dcblock_s16_2ch, 2 },
+	{ SOF_IPC_FRAME_S16_LE, dcblock_s16_4ch, 4 },
+	{ SOF_IPC_FRAME_S16_LE, dcblock_s16_8ch, 8 },
+#endif /* CONFIG_FORMAT_S16LE */
+#if CONFIG_FORMAT_S24LE
+	{ SOF_IPC_FRAME_S24_4LE, dcblock_s24_1ch, 1 },
+	{ SOF_IPC_FRAME_S24_4LE, dcblock_s24_2ch, 2 },
+	{ SOF_IPC_FRAME_S24_4LE, dcblock_s24_4ch, 4 },
+	{ SOF_IPC_FRAME_S24_4LE, dcblock_s24_8ch, 8 },
+#endif /* CONFIG_FORMAT_S24LE */
+#if CONFIG_FORMAT_S32LE
+	{ SOF_IPC_FRAME_S32_LE, dcblock_s32_1ch, 1 },
+	{ SOF_IPC_FRAME_S32_LE, dcblock_s32_2ch, 2 },
+	{ SOF_IPC_FRAME_S32_LE, dcblock_s32_4ch, 4 },
+	{ SOF_IPC_FRAME_S32_LE, dcblock_s32_8ch, 8 },
+#endif /* CONFIG_FORMAT_S32LE */
 #if CONFIG_FORMAT_S16LE
 	{ SOF_IPC_FRAME_S16_LE, dcblock_s16_default },
 #endif /* CONFIG_FORMAT_S16LE */
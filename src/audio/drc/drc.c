@@ -131,6 +131,11 @@ static int drc_setup(struct drc_comp_data *cd, uint16_t channels, uint32_t rate)
 	if (ret < 0)
 		return ret;
 
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	if (cd->source_format == SOF_IPC_FRAME_FLOAT)
+		drc_setup_float(cd);
+#endif
+
 	/* Set pre-dely time */
 	return drc_set_pre_delay_time(&cd->state, cd->config->params.pre_delay_time, rate);
 }
@@ -180,6 +185,8 @@ static struct comp_dev *drc_new(const struct comp_driver *drv,
 		goto cd_fail;
 	}
 
+	comp_data_blob_share(cd->model_handler);
+
 	/* Get configuration data and reset DRC state */
 	ret = comp_init_data_blob(cd->model_handler, bs, ipc_drc->data);
 	if (ret < 0) {
@@ -463,6 +470,7 @@ static int drc_reset(struct comp_dev *dev)
 static const struct comp_driver comp_drc = {
 	.uid = SOF_RT_UUID(drc_uuid),
 	.tctx = &drc_tr,
+	.any_period = true,
 	.ops = {
 		.create  = drc_new,
 		.free    = drc_free,
@@ -0,0 +1,342 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+/* DRC for float streams. This is the compressor of drc_generic.c with the
+ * same setup blob, the Q format parameters are converted to float once in
+ * drc_setup_float(). The lookahead buffers and their indexes are shared with
+ * the fixed point state.
+ */
+
+#include <sof/audio/component.h>
+#include <sof/audio/drc/drc.h>
+#include <sof/audio/format.h>
+#include <sof/math/numbers.h>
+#include <user/drc.h>
+#include <math.h>
+#include <stdint.h>
+
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+
+#define DRC_PI_OVER_TWO		1.57079632679489661923f
+#define DRC_TWO_OVER_PI		0.63661977236758134308f
+#define DRC_NEG_TWO_DB		0.7943282347242815f	/* -2dB = 10^(-2/20) */
+
+static inline float drc_lin2db_float(float linear)
+{
+	return 20.0f * log10f(linear);
+}
+
+static inline float drc_db2lin_float(float db)
+{
+	return powf(10.0f, 0.05f * db);
+}
+
+void drc_setup_float(struct drc_comp_data *cd)
+{
+	const struct sof_drc_params *p = &cd->config->params;
+	struct drc_params_float *pf = &cd->params_float;
+	struct drc_state_float *sf = &cd->state_float;
+
+	pf->linear_threshold = ldexpf(p->linear_threshold, -30);
+	pf->slope = ldexpf(p->slope, -30);
+	pf->K = ldexpf(p->K, -20);
+	pf->knee_alpha = ldexpf(p->knee_alpha, -24);
+	pf->knee_beta = ldexpf(p->knee_beta, -24);
+	pf->knee_threshold = ldexpf(p->knee_threshold, -24);
+	pf->ratio_base = ldexpf(p->ratio_base, -30);
+	pf->master_linear_gain = ldexpf(p->master_linear_gain, -24);
+	pf->one_over_attack_frames = ldexpf(p->one_over_attack_frames, -30);
+	pf->sat_release_frames_inv_neg = ldexpf(p->sat_release_frames_inv_neg, -30);
+	pf->sat_release_rate_at_neg_two_db = ldexpf(p->sat_release_rate_at_neg_two_db, -30);
+	pf->kSpacingDb = p->kSpacingDb;
+	pf->kA = ldexpf(p->kA, -12);
+	pf->kB = ldexpf(p->kB, -12);
+	pf->kC = ldexpf(p->kC, -12);
+	pf->kD = ldexpf(p->kD, -12);
+	pf->kE = ldexpf(p->kE, -12);
+
+	sf->detector_average = 0.0f;
+	sf->compressor_gain = 1.0f;
+	sf->envelope_rate = 0.0f;
+	sf->scaled_desired_gain = 0.0f;
+	sf->max_attack_compression_diff_db = -INFINITY;
+}
+
+/* Full compression curve with constant ratio after knee. Returns the ratio of
+ * output and input signal.
+ */
+static float drc_volume_gain_float(const struct drc_params_float *pf, float x)
+{
+	if (x < pf->knee_threshold) {
+		if (x < pf->linear_threshold)
+			return 1.0f;
+
+		/* knee_curveK(x) / x, knee_curveK(x) = alpha + beta * exp(-k * x) */
+		return (pf->knee_alpha + pf->knee_beta * expf(-pf->K * x)) / x;
+	}
+
+	/* y/x = ratio_base * x^(s - 1) */
+	return pf->ratio_base * expf(logf(x) * (pf->slope - 1.0f));
+}
+
+/* Update detector_average from the last input division. */
+static void drc_update_detector_average_float(struct drc_comp_data *cd, int nch)
+{
+	const struct drc_params_float *pf = &cd->params_float;
+	struct drc_state *state = &cd->state;
+	float detector_average = cd->state_float.detector_average;
+	float abs_input;
+	float gain;
+	float rate;
+	float *pd;
+	int div_start;
+	int i;
+	int ch;
+
+	/* Calculate the start index of the last input division */
+	if (state->pre_delay_write_index == 0)
+		div_start = CONFIG_DRC_MAX_PRE_DELAY_FRAMES - DRC_DIVISION_FRAMES;
+	else
+		div_start = state->pre_delay_write_index - DRC_DIVISION_FRAMES;
+
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
+		/* The max abs value across all channels for this frame */
+		abs_input = 0.0f;
+		for (ch = 0; ch < nch; ch++) {
+			pd = (float *)state->pre_delay_buffers[ch];
+			abs_input = MAX(abs_input, fabsf(pd[div_start + i]));
+		}
+
+		/* Compute compression amount from un-delayed signal */
+		gain = drc_volume_gain_float(pf, abs_input);
+		if (gain > detector_average) {
+			/* Release, slower below -2 dB */
+			if (gain > DRC_NEG_TWO_DB)
+				rate = pf->sat_release_rate_at_neg_two_db;
+			else
+				rate = drc_db2lin_float(drc_lin2db_float(gain) *
+							pf->sat_release_frames_inv_neg) - 1.0f;
+
+			detector_average += (gain - detector_average) * rate;
+		} else {
+			detector_average = gain;
+		}
+
+		detector_average = MIN(detector_average, 1.0f);
+	}
+
+	cd->state_float.detector_average = detector_average;
+}
+
+/* Updates the envelope_rate used for the next division */
+static void drc_update_envelope_float(struct drc_comp_data *cd)
+{
+	const struct drc_params_float *pf = &cd->params_float;
+	struct drc_state_float *sf = &cd->state_float;
+
+	/* Pre-warp so we get desired_gain after sin() warp below. */
+	float scaled_desired_gain = asinf(sf->detector_average) * DRC_TWO_OVER_PI;
+	int is_releasing = scaled_desired_gain > sf->compressor_gain;
+	int is_bad_db = sf->compressor_gain == 0.0f || scaled_desired_gain == 0.0f;
+	float compression_diff_db = 0.0f;
+	float eff_atten_diff_db;
+	float release_frames;
+	float x, x2, x3, x4;
+
+	/* compression_diff_db is the difference between current compression
+	 * level and the desired level.
+	 */
+	if (!is_bad_db)
+		compression_diff_db = drc_lin2db_float(sf->compressor_gain) -
+			drc_lin2db_float(scaled_desired_gain);
+
+	if (is_releasing) {
+		/* Release mode - compression_diff_db should be negative dB */
+		sf->max_attack_compression_diff_db = -INFINITY;
+
+		/* Fix gremlins. */
+		if (is_bad_db)
+			compression_diff_db = -1.0f;
+
+		/* Adaptive release - higher compression (lower
+		 * compression_diff_db) releases faster. Contain within range:
+		 * -12 -> 0 then scale to go from 0 -> 3
+		 */
+		x = MIN(0.0f, MAX(-12.0f, compression_diff_db));
+		x = 0.25f * (x + 12.0f);
+
+		/* Compute adaptive release curve using 4th order polynomial */
+		x2 = x * x;
+		x3 = x2 * x;
+		x4 = x2 * x2;
+		release_frames = pf->kA + pf->kB * x + pf->kC * x2 + pf->kD * x3 + pf->kE * x4;
+
+		sf->envelope_rate = drc_db2lin_float(pf->kSpacingDb / release_frames);
+	} else {
+		/* Attack mode - compression_diff_db should be positive dB */
+
+		/* Fix gremlins. */
+		if (is_bad_db)
+			compression_diff_db = 1.0f;
+
+		/* As long as we're still in attack mode, use a rate based off
+		 * the largest compression_diff_db we've encountered so far.
+		 */
+		sf->max_attack_compression_diff_db =
+			MAX(sf->max_attack_compression_diff_db, compression_diff_db);
+
+		eff_atten_diff_db = MAX(0.5f, sf->max_attack_compression_diff_db);
+		x = 0.25f / eff_atten_diff_db;
+		sf->envelope_rate = 1.0f - powf(x, pf->one_over_attack_frames);
+	}
+
+	sf->scaled_desired_gain = scaled_desired_gain;
+}
+
+/* Calculate compress_gain from the envelope and apply total_gain to compress
+ * the next output division.
+ */
+static void drc_compress_output_float(struct drc_comp_data *cd, int nch)
+{
+	const struct drc_params_float *pf = &cd->params_float;
+	struct drc_state_float *sf = &cd->state_float;
+	const int div_start = cd->state.pre_delay_read_index;
+	float base;
+	float gain;
+	float r;
+	float x;
+	float *pd;
+	int i;
+	int ch;
+
+	/* Exponential approach to desired gain, attack reduces the gain to the
+	 * desired one and release increases it to 1.0.
+	 */
+	if (sf->envelope_rate < 1.0f) {
+		base = sf->scaled_desired_gain;
+		x = sf->compressor_gain - base;
+		r = 1.0f - sf->envelope_rate;
+	} else {
+		base = 0.0f;
+		x = sf->compressor_gain;
+		r = sf->envelope_rate;
+	}
+
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
+		x = MIN(x * r, 1.0f - base);
+
+		/* Warp pre-compression gain to smooth out sharp exponential
+		 * transition points, then apply the master gain.
+		 */
+		gain = pf->master_linear_gain * sinf(DRC_PI_OVER_TWO * (x + base));
+		for (ch = 0; ch < nch; ch++) {
+			pd = (float *)cd->state.pre_delay_buffers[ch];
+			pd[div_start + i] *= gain;
+		}
+	}
+
+	sf->compressor_gain = x + base;
+}
+
+static void drc_process_one_division_float(struct drc_comp_data *cd, int nch)
+{
+	drc_update_detector_average_float(cd, nch);
+	drc_update_envelope_float(cd);
+	drc_compress_output_float(cd, nch);
+}
+
+static inline void drc_pre_delay_index_inc_float(int *idx, int increment)
+{
+	*idx = (*idx + increment) & DRC_MAX_PRE_DELAY_FRAMES_MASK;
+}
+
+static void drc_delay_input_sample_float(struct drc_state *state,
+					 const struct audio_stream __sparse_cache *source,
+					 struct audio_stream __sparse_cache *sink,
+					 float **x, float **y, int samples)
+{
+	float *x1;
+	float *y1;
+	float *pd;
+	int pd_write_index, pd_read_index;
+	int nbuf, npcm, nfrm;
+	int ch;
+	int i;
+	float *x0 = *x;
+	float *y0 = *y;
+	int remaining_samples = samples;
+	int nch = source->channels;
+
+	while (remaining_samples) {
+		nbuf = audio_stream_bytes_without_wrap(source, x0) / sizeof(float);
+		npcm = MIN(remaining_samples, nbuf);
+		nbuf = audio_stream_bytes_without_wrap(sink, y0) / sizeof(float);
+		npcm = MIN(npcm, nbuf);
+		nfrm = npcm / nch;
+		for (ch = 0; ch < nch; ++ch) {
+			pd = (float *)state->pre_delay_buffers[ch];
+			x1 = x0 + ch;
+			y1 = y0 + ch;
+			pd_write_index = state->pre_delay_write_index;
+			pd_read_index = state->pre_delay_read_index;
+			for (i = 0; i < nfrm; i++) {
+				pd[pd_write_index] = *x1;
+				*y1 = pd[pd_read_index];
+				drc_pre_delay_index_inc_float(&pd_write_index, 1);
+				drc_pre_delay_index_inc_float(&pd_read_index, 1);
+				x1 += nch;
+				y1 += nch;
+			}
+		}
+		remaining_samples -= npcm;
+		x0 = audio_stream_wrap(source, x0 + npcm);
+		y0 = audio_stream_wrap(sink, y0 + npcm);
+		drc_pre_delay_index_inc_float(&state->pre_delay_write_index, nfrm);
+		drc_pre_delay_index_inc_float(&state->pre_delay_read_index, nfrm);
+	}
+
+	*x = x0;
+	*y = y0;
+}
+
+void drc_float_default(const struct comp_dev *dev,
+		       const struct audio_stream __sparse_cache *source,
+		       struct audio_stream __sparse_cache *sink, uint32_t frames)
+{
+	float *x = source->r_ptr;
+	float *y = sink->w_ptr;
+	int nch = source->channels;
+	int samples = frames * nch;
+	struct drc_comp_data *cd = comp_get_drvdata(dev);
+	struct drc_state *state = &cd->state;
+	int fragment_samples;
+	int fragment;
+
+	if (!cd->config->params.enabled) {
+		/* Delay only, to match the delay of the other bands */
+		drc_delay_input_sample_float(state, source, sink, &x, &y, samples);
+		return;
+	}
+
+	if (!state->processed) {
+		drc_update_envelope_float(cd);
+		drc_compress_output_float(cd, nch);
+		state->processed = 1;
+	}
+
+	while (samples) {
+		fragment = DRC_DIVISION_FRAMES -
+			(state->pre_delay_write_index & DRC_DIVISION_FRAMES_MASK);
+		fragment_samples = fragment * nch;
+		fragment_samples = MIN(samples, fragment_samples);
+		drc_delay_input_sample_float(state, source, sink, &x, &y, fragment_samples);
+		samples -= fragment_samples;
+
+		/* Process the input division (32 frames). */
+		if ((state->pre_delay_write_index & DRC_DIVISION_FRAMES_MASK) == 0)
+			drc_process_one_division_float(cd, nch);
+	}
+}
+
+#endif /* CONFIG_FORMAT_FLOAT_PROCESSING */
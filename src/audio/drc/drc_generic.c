@@ -23,11 +23,10 @@
 #define NEG_TWO_DB_Q30 Q_CONVERT_FLOAT(0.7943282347242815f, 30) /* -2dB = 10^(-2/20); Q2.30 */
 
 /* This is the knee part of the compression curve. Returns the output level
- * given the input level x. */
-static int32_t knee_curveK(const struct sof_drc_params *p, int32_t x)
+ * given exp(gamma) for the input level x, see volume_gain_exp_arg().
+ */
+static int32_t knee_curveK(const struct sof_drc_params *p, int32_t knee_exp_gamma)
 {
-	int32_t knee_exp_gamma;
-
 	/* The formula in knee_curveK is linear_threshold +
 	 * (1 - expf(-k * (x - linear_threshold))) / k
 	 * which simplifies to (alpha + beta * expf(gamma))
@@ -35,26 +34,42 @@ static int32_t knee_curveK(const struct sof_drc_params *p, int32_t x)
 	 *	 beta = -expf(k * linear_threshold) / k
 	 *	 gamma = -k * x
 	 */
-	knee_exp_gamma = exp_fixed(Q_MULTSR_32X32((int64_t)x, -p->K, 31, 20, 27)); /* Q12.20 */
 	return p->knee_alpha + Q_MULTSR_32X32((int64_t)p->knee_beta, knee_exp_gamma, 24, 20, 24);
 }
 
+/* Argument of the exponent function in volume_gain() for input level x,
+ * Q5.27. The exponents of a division are computed with one block call.
+ * The thresholds are Q1.31.
+ */
+static int32_t volume_gain_exp_arg(const struct sof_drc_params *p, int32_t knee_threshold,
+				   int32_t linear_threshold, int32_t x)
+{
+	if (x < knee_threshold) {
+		if (x < linear_threshold)
+			return 0;
+		/* gamma = -k * x */
+		return Q_MULTSR_32X32((int64_t)x, -p->K, 31, 20, 27);
+	}
+
+	/* log(x) * (s - 1) */
+	return Q_MULTSR_32X32((int64_t)drc_log_fixed(Q_SHIFT_RND(x, 31, 26)),
+			      (p->slope - ONE_Q30), 26, 30, 27);
+}
+
 /* Full compression curve with constant ratio after knee. Returns the ratio of
- * output and input signal. */
-static int32_t volume_gain(const struct sof_drc_params *p, int32_t x)
+ * output and input signal. The thresholds are Q1.31, the exponent exp_x is
+ * Q12.20.
+ */
+static int32_t volume_gain(const struct sof_drc_params *p, int32_t knee_threshold,
+			   int32_t linear_threshold, int32_t x, int32_t exp_x)
 {
-	const int32_t knee_threshold =
-		sat_int32(Q_SHIFT_LEFT((int64_t)p->knee_threshold, 24, 31));
-	const int32_t linear_threshold =
-		sat_int32(Q_SHIFT_LEFT((int64_t)p->linear_threshold, 30, 31));
-	int32_t exp_knee;
 	int32_t y;
 
 	if (x < knee_threshold) {
 		if (x < linear_threshold)
 			return ONE_Q30;
 		/* y = knee_curveK(x) / x */
-		y = Q_MULTSR_32X32((int64_t)knee_curveK(p, x), drc_inv_fixed(x, 31, 20),
+		y = Q_MULTSR_32X32((int64_t)knee_curveK(p, exp_x), drc_inv_fixed(x, 31, 20),
 				   24, 20, 30);
 	} else {
 		/* Constant ratio after knee.
@@ -65,9 +80,7 @@ static int32_t volume_gain(const struct sof_drc_params *p, int32_t x)
 		 * => y/x = ratio_base * x^(s - 1)
 		 * => y/x = ratio_base * e^(log(x) * (s - 1))
 		 */
-		exp_knee = exp_fixed(Q_MULTSR_32X32((int64_t)drc_log_fixed(Q_SHIFT_RND(x, 31, 26)),
-						    (p->slope - ONE_Q30), 26, 30, 27)); /* Q12.20 */
-		y = Q_MULTSR_32X32((int64_t)p->ratio_base, exp_knee, 30, 20, 30);
+		y = Q_MULTSR_32X32((int64_t)p->ratio_base, exp_x, 30, 20, 30);
 	}
 
 	return y;
@@ -79,8 +92,14 @@ void drc_update_detector_average(struct drc_state *state,
 				 int nbyte,
 				 int nch)
 {
+	const int32_t knee_threshold =
+		sat_int32(Q_SHIFT_LEFT((int64_t)p->knee_threshold, 24, 31));
+	const int32_t linear_threshold =
+		sat_int32(Q_SHIFT_LEFT((int64_t)p->linear_threshold, 30, 31));
 	int32_t detector_average = state->detector_average; /* Q2.30 */
 	int32_t abs_input_array[DRC_DIVISION_FRAMES]; /* Q1.31 */
+	int32_t gain_array[DRC_DIVISION_FRAMES]; /* Q2.30 */
+	int32_t exp_array[DRC_DIVISION_FRAMES];
 	int div_start, i, ch;
 	int16_t *sample16_p; /* for s16 format case */
 	int32_t *sample32_p; /* for s24 and s32 format cases */
@@ -88,8 +107,6 @@ void drc_update_detector_average(struct drc_state *state,
 	int32_t gain;
 	int32_t gain_diff;
 	int is_release;
-	int32_t db_per_frame;
-	int32_t sat_release_rate;
 
 	/* Calculate the start index of the last input division */
 	if (state->pre_delay_write_index == 0) {
@@ -121,17 +138,50 @@ void drc_update_detector_average(struct drc_state *state,
 		}
 	}
 
+	/* Compute compression amount from un-delayed signal */
+
+	/* Calculate shaped power on undelayed input.  Put through
+	 * shaping curve. This is linear up to the threshold, then
+	 * enters a "knee" portion followed by the "ratio" portion. The
+	 * transition from the threshold to the knee is smooth (1st
+	 * derivative matched). The transition from the knee to the
+	 * ratio portion is smooth (1st derivative matched).
+	 *
+	 * The block exp() and db2lin() are more accurate than the scalar
+	 * exp_fixed() and db2lin_fixed() but not bit-exact with them. The
+	 * output differs from the scalar versions by at most 1.5e-04
+	 * (-76 dBFS, 5 LSB in 16 bit), with an SNR of 90 dB or more. That
+	 * is below the 8e-04 difference of this DRC from the float one.
+	 */
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++)
+		exp_array[i] = volume_gain_exp_arg(p, knee_threshold, linear_threshold,
+						   abs_input_array[i]); /* Q5.27 */
+
+	exp_fixed_vec(exp_array, exp_array, DRC_DIVISION_FRAMES); /* Q12.20 */
+
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++)
+		gain_array[i] = volume_gain(p, knee_threshold, linear_threshold,
+					    abs_input_array[i], exp_array[i]); /* Q2.30 */
+
+	/* The release rate below -2 dB depends only on the gain, compute it for
+	 * the whole division though it's used only for frames that release.
+	 */
 	for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
-		/* Compute compression amount from un-delayed signal */
-
-		/* Calculate shaped power on undelayed input.  Put through
-		 * shaping curve. This is linear up to the threshold, then
-		 * enters a "knee" portion followed by the "ratio" portion. The
-		 * transition from the threshold to the knee is smooth (1st
-		 * derivative matched). The transition from the knee to the
-		 * ratio portion is smooth (1st derivative matched).
-		 */
-		gain = volume_gain(p, abs_input_array[i]); /* Q2.30 */
+		gain = gain_array[i];
+		if (gain > NEG_TWO_DB_Q30) {
+			exp_array[i] = 0;
+		} else {
+			gain = Q_SHIFT_RND(gain, 30, 26); /* Q2.30 -> Q6.26 */
+			exp_array[i] = Q_MULTSR_32X32((int64_t)drc_lin2db_fixed(gain),
+						      p->sat_release_frames_inv_neg,
+						      21, 30, 24); /* Q8.24 */
+		}
+	}
+
+	db2lin_fixed_vec(exp_array, exp_array, DRC_DIVISION_FRAMES); /* Q12.20 */
+
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
+		gain = gain_array[i]; /* Q2.30 */
 		gain_diff = gain - detector_average; /* Q2.30 */
 		is_release = (gain_diff > 0);
 		if (is_release) {
@@ -141,16 +191,10 @@ void drc_update_detector_average(struct drc_state *state,
 						       p->sat_release_rate_at_neg_two_db,
 						       30, 30, 30);
 			} else {
-				db_per_frame =
-					Q_MULTSR_32X32((int64_t)drc_lin2db_fixed(Q_SHIFT_RND(gain,
-											     30,
-											     26)),
-						       p->sat_release_frames_inv_neg,
-						       21, 30, 24); /* Q8.24 */
-				sat_release_rate =
-					db2lin_fixed(db_per_frame) - ONE_Q20; /* Q12.20 */
-				detector_average += Q_MULTSR_32X32((int64_t)gain_diff,
-								   sat_release_rate, 30, 20, 30);
+				/* sat_release_rate is Q12.20 */
+				detector_average +=
+					Q_MULTSR_32X32((int64_t)gain_diff,
+						       exp_array[i] - ONE_Q20, 30, 20, 30);
 			}
 		} else {
 			detector_average = gain;
@@ -778,6 +822,10 @@ const struct drc_proc_fnmap drc_proc_fnmap[] = {
 #if CONFIG_FORMAT_S32LE
 	{ SOF_IPC_FRAME_S32_LE, drc_s32_default },
 #endif /* CONFIG_FORMAT_S32LE */
+
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	{ SOF_IPC_FRAME_FLOAT, drc_float_default },
+#endif /* CONFIG_FORMAT_FLOAT_PROCESSING */
 };
 
 const size_t drc_proc_fncount = ARRAY_SIZE(drc_proc_fnmap);
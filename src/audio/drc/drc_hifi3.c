@@ -25,12 +25,10 @@
 #define NEG_TWO_DB_Q30 852903424  /* Q_CONVERT_FLOAT(0.7943282347242815f, 30) */
 
 /* This is the knee part of the compression curve. Returns the output level
- * given the input level x.
+ * given exp(gamma) for the input level x, see volume_gain_exp_arg().
  */
-static int32_t knee_curveK(const struct sof_drc_params *p, int32_t x)
+static int32_t knee_curveK(const struct sof_drc_params *p, int32_t knee_exp_gamma)
 {
-	ae_f32 gamma; /* Q5.27 */
-	ae_f32 knee_exp_gamma; /* Q12.20 */
 	ae_f32 knee_curve_k; /* Q8.24 */
 
 	/* The formula in knee_curveK is linear_threshold +
@@ -40,30 +38,49 @@ static int32_t knee_curveK(const struct sof_drc_params *p, int32_t x)
 	 *	 beta = -expf(k * linear_threshold) / k
 	 *	 gamma = -k * x
 	 */
-	gamma = drc_mult_lshift(x, -p->K, drc_get_lshift(31, 20, 27));
-	knee_exp_gamma = exp_fixed(gamma);
 	knee_curve_k = drc_mult_lshift(p->knee_beta, knee_exp_gamma, drc_get_lshift(24, 20, 24));
 	knee_curve_k = AE_ADD32(knee_curve_k, p->knee_alpha);
 	return knee_curve_k;
 }
 
-/* Full compression curve with constant ratio after knee. Returns the ratio of
- * output and input signal.
+/* Argument of the exponent function in volume_gain() for input level x,
+ * Q5.27. The exponents of a division are computed with one block call.
+ * The thresholds are Q1.31.
  */
-static int32_t volume_gain(const struct sof_drc_params *p, int32_t x)
+static int32_t volume_gain_exp_arg(const struct sof_drc_params *p, ae_f32 knee_threshold,
+				   ae_f32 linear_threshold, int32_t x)
 {
-	const ae_f32 knee_threshold = AE_SLAI32S(p->knee_threshold, 7); /* Q8.24 -> Q1.31 */
-	const ae_f32 linear_threshold = AE_SLAI32S(p->linear_threshold, 1); /* Q2.30 -> Q1.31 */
-	ae_f32 exp_knee; /* Q12.20 */
-	ae_f32 y; /* Q2.30 */
 	ae_f32 tmp;
 	ae_f32 tmp2;
 
+	if (x < (int32_t)knee_threshold) {
+		if (x < (int32_t)linear_threshold)
+			return 0;
+		/* gamma = -k * x */
+		return drc_mult_lshift(x, -p->K, drc_get_lshift(31, 20, 27));
+	}
+
+	/* log(x) * (s - 1) */
+	tmp = AE_SRAI32R(x, 5); /* Q1.31 -> Q5.26 */
+	tmp = drc_log_fixed(tmp); /* Q6.26 */
+	tmp2 = AE_SUB32(p->slope, ONE_Q30); /* Q2.30 */
+	return drc_mult_lshift(tmp, tmp2, drc_get_lshift(26, 30, 27));
+}
+
+/* Full compression curve with constant ratio after knee. Returns the ratio of
+ * output and input signal. The thresholds are Q1.31, the exponent exp_x is
+ * Q12.20.
+ */
+static int32_t volume_gain(const struct sof_drc_params *p, ae_f32 knee_threshold,
+			   ae_f32 linear_threshold, int32_t x, int32_t exp_x)
+{
+	ae_f32 y; /* Q2.30 */
+
 	if (x < (int32_t)knee_threshold) {
 		if (x < (int32_t)linear_threshold)
 			return ONE_Q30;
 		/* y = knee_curveK(x) / x */
-		y = drc_mult_lshift(knee_curveK(p, x), drc_inv_fixed(x, 31, 20),
+		y = drc_mult_lshift(knee_curveK(p, exp_x), drc_inv_fixed(x, 31, 20),
 				    drc_get_lshift(24, 20, 30));
 	} else {
 		/* Constant ratio after knee.
@@ -74,11 +91,7 @@ static int32_t volume_gain(const struct sof_drc_params *p, int32_t x)
 		 * => y/x = ratio_base * x^(s - 1)
 		 * => y/x = ratio_base * e^(log(x) * (s - 1))
 		 */
-		tmp = AE_SRAI32R(x, 5); /* Q1.31 -> Q5.26 */
-		tmp = drc_log_fixed(tmp); /* Q6.26 */
-		tmp2 = AE_SUB32(p->slope, ONE_Q30); /* Q2.30 */
-		exp_knee = exp_fixed(drc_mult_lshift(tmp, tmp2, drc_get_lshift(26, 30, 27)));
-		y = drc_mult_lshift(p->ratio_base, exp_knee, drc_get_lshift(30, 20, 30));
+		y = drc_mult_lshift(p->ratio_base, exp_x, drc_get_lshift(30, 20, 30));
 	}
 
 	return y;
@@ -90,8 +103,12 @@ void drc_update_detector_average(struct drc_state *state,
 				 int nbyte,
 				 int nch)
 {
+	const ae_f32 knee_threshold = AE_SLAI32S(p->knee_threshold, 7); /* Q8.24 -> Q1.31 */
+	const ae_f32 linear_threshold = AE_SLAI32S(p->linear_threshold, 1); /* Q2.30 -> Q1.31 */
 	ae_f32 detector_average = state->detector_average; /* Q2.30 */
 	int32_t abs_input_array[DRC_DIVISION_FRAMES]; /* Q1.31 */
+	int32_t gain_array[DRC_DIVISION_FRAMES]; /* Q2.30 */
+	int32_t exp_array[DRC_DIVISION_FRAMES];
 	int32_t *abs_input_array_p;
 	int div_start, i, ch;
 	int16_t *sample16_p; /* for s16 format case */
@@ -99,7 +116,6 @@ void drc_update_detector_average(struct drc_state *state,
 	int32_t sample;
 	ae_f32 gain;
 	ae_f32 gain_diff;
-	ae_f32 db_per_frame;
 	ae_f32 sat_release_rate;
 	ae_f32 tmp;
 	int is_release;
@@ -136,17 +152,47 @@ void drc_update_detector_average(struct drc_state *state,
 		}
 	}
 
+	/* Compute compression amount from un-delayed signal */
+
+	/* Calculate shaped power on undelayed input.  Put through
+	 * shaping curve. This is linear up to the threshold, then
+	 * enters a "knee" portion followed by the "ratio" portion. The
+	 * transition from the threshold to the knee is smooth (1st
+	 * derivative matched). The transition from the knee to the
+	 * ratio portion is smooth (1st derivative matched).
+	 *
+	 * The block exp() and db2lin() are not bit-exact with the scalar
+	 * versions, see drc_generic.c for the bound of the difference.
+	 */
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++)
+		exp_array[i] = volume_gain_exp_arg(p, knee_threshold, linear_threshold,
+						   abs_input_array[i]); /* Q5.27 */
+
+	exp_fixed_vec(exp_array, exp_array, DRC_DIVISION_FRAMES); /* Q12.20 */
+
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++)
+		gain_array[i] = volume_gain(p, knee_threshold, linear_threshold,
+					    abs_input_array[i], exp_array[i]); /* Q2.30 */
+
+	/* The release rate below -2 dB depends only on the gain, compute it for
+	 * the whole division though it's used only for frames that release.
+	 */
 	for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
-		/* Compute compression amount from un-delayed signal */
-
-		/* Calculate shaped power on undelayed input.  Put through
-		 * shaping curve. This is linear up to the threshold, then
-		 * enters a "knee" portion followed by the "ratio" portion. The
-		 * transition from the threshold to the knee is smooth (1st
-		 * derivative matched). The transition from the knee to the
-		 * ratio portion is smooth (1st derivative matched).
-		 */
-		gain = volume_gain(p, abs_input_array[i]); /* Q2.30 */
+		gain = gain_array[i];
+		if ((int32_t)gain > NEG_TWO_DB_Q30) {
+			exp_array[i] = 0;
+		} else {
+			gain = AE_SRAI32R(gain, 4); /* Q2.30 -> Q6.26 */
+			exp_array[i] = drc_mult_lshift(drc_lin2db_fixed(gain),
+						       p->sat_release_frames_inv_neg,
+						       drc_get_lshift(21, 30, 24)); /* Q8.24 */
+		}
+	}
+
+	db2lin_fixed_vec(exp_array, exp_array, DRC_DIVISION_FRAMES); /* Q12.20 */
+
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
+		gain = gain_array[i]; /* Q2.30 */
 		gain_diff = AE_SUB32(gain, detector_average); /* Q2.30 */
 		is_release = ((int32_t)gain_diff > 0);
 		if (is_release) {
@@ -154,11 +200,7 @@ void drc_update_detector_average(struct drc_state *state,
 				tmp = drc_mult_lshift(gain_diff, p->sat_release_rate_at_neg_two_db,
 						      drc_get_lshift(30, 30, 30));
 			} else {
-				gain = AE_SRAI32R(gain, 4); /* Q2.30 -> Q6.26 */
-				db_per_frame = drc_mult_lshift(drc_lin2db_fixed(gain),
-							       p->sat_release_frames_inv_neg,
-							       drc_get_lshift(21, 30, 24));
-				sat_release_rate = AE_SUB32(db2lin_fixed(db_per_frame), ONE_Q20);
+				sat_release_rate = AE_SUB32(exp_array[i], ONE_Q20);
 				tmp = drc_mult_lshift(gain_diff, sat_release_rate,
 						      drc_get_lshift(30, 20, 30));
 			}
@@ -20,6 +20,7 @@
 #include <sof/lib/uuid.h>
 #include <sof/list.h>
 #include <sof/math/fir_config.h>
+#include <sof/math/fir_float.h>
 #include <sof/platform.h>
 #include <sof/string.h>
 #include <sof/ut.h>
@@ -56,6 +57,11 @@ struct comp_data {
 			    const struct audio_stream __sparse_cache *source,
 			    struct audio_stream __sparse_cache *sink,
 			    int frames, int nch);
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	struct fir_state_float fir_float[PLATFORM_MAX_CHANNELS]; /**< float filters */
+	float *fir_float_data;			/**< float coefficients and delays */
+	bool float_path;			/**< filters run in float */
+#endif
 };
 
 /*
@@ -105,6 +111,43 @@ static inline void set_s32_fir(struct comp_data *cd)
 #endif /* CONFIG_FORMAT_S32LE */
 #endif
 
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+/* The float filters are in the same private data as the fixed point
+ * filters array that is passed to the processing function.
+ */
+static void eq_fir_float(struct fir_state_32x16 fir[],
+			 const struct audio_stream __sparse_cache *source,
+			 struct audio_stream __sparse_cache *sink,
+			 int frames, int nch)
+{
+	struct comp_data *cd = container_of(fir, struct comp_data, fir[0]);
+	float *x = source->r_ptr;
+	float *y = sink->w_ptr;
+	int n1;
+	int n2;
+	int n;
+	int ch;
+
+	while (frames) {
+		n1 = audio_stream_bytes_without_wrap(source, x) / (nch * sizeof(float));
+		n2 = audio_stream_bytes_without_wrap(sink, y) / (nch * sizeof(float));
+		n = MIN(n1, n2);
+		n = MIN(n, frames);
+		for (ch = 0; ch < nch; ch++)
+			fir_float(&cd->fir_float[ch], x + ch, y + ch, n, nch);
+
+		frames -= n;
+		x = audio_stream_wrap(source, x + n * nch);
+		y = audio_stream_wrap(sink, y + n * nch);
+	}
+}
+
+static inline void set_float_fir(struct comp_data *cd)
+{
+	cd->eq_fir_func = eq_fir_float;
+}
+#endif /* CONFIG_FORMAT_FLOAT_PROCESSING */
+
 static inline int set_fir_func(struct comp_dev *dev, enum sof_ipc_frame fmt)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
@@ -128,6 +171,12 @@ static inline int set_fir_func(struct comp_dev *dev, enum sof_ipc_frame fmt)
 		set_s32_fir(cd);
 		break;
 #endif /* CONFIG_FORMAT_S32LE */
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	case SOF_IPC_FRAME_FLOAT:
+		comp_info(dev, "set_fir_func(), SOF_IPC_FRAME_FLOAT");
+		set_float_fir(cd);
+		break;
+#endif /* CONFIG_FORMAT_FLOAT_PROCESSING */
 	default:
 		comp_err(dev, "set_fir_func(), invalid frame_fmt");
 		return -EINVAL;
@@ -160,6 +209,13 @@ static void eq_fir_free_delaylines(struct comp_data *cd)
 	cd->fir_delay_size = 0;
 	for (i = 0; i < PLATFORM_MAX_CHANNELS; i++)
 		fir[i].delay = NULL;
+
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	rfree(cd->fir_float_data);
+	cd->fir_float_data = NULL;
+	for (i = 0; i < PLATFORM_MAX_CHANNELS; i++)
+		fir_reset_float(&cd->fir_float[i]);
+#endif
 }
 
 static int eq_fir_init_coef(struct sof_eq_fir_config *config,
@@ -273,6 +329,35 @@ static void eq_fir_init_delay(struct fir_state_32x16 *fir,
 	}
 }
 
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+/* Convert the fixed point filters set up from the blob to float */
+static int eq_fir_setup_float(struct comp_data *cd, int nch)
+{
+	size_t size = 0;
+	float *data;
+	int i;
+
+	for (i = 0; i < nch; i++)
+		size += fir_size_float(&cd->fir[i]);
+
+	if (!size)
+		return 0;
+
+	cd->fir_float_data = rballoc(0, SOF_MEM_CAPS_RAM, size);
+	if (!cd->fir_float_data) {
+		comp_cl_err(&comp_eq_fir, "eq_fir_setup_float(), allocation failed for size %u",
+			    size);
+		return -ENOMEM;
+	}
+
+	data = cd->fir_float_data;
+	for (i = 0; i < nch; i++)
+		fir_init_float(&cd->fir_float[i], &cd->fir[i], &data);
+
+	return 0;
+}
+#endif /* CONFIG_FORMAT_FLOAT_PROCESSING */
+
 static int eq_fir_setup(struct comp_data *cd, int nch)
 {
 	int delay_size;
@@ -285,6 +370,12 @@ static int eq_fir_setup(struct comp_data *cd, int nch)
 	if (delay_size < 0)
 		return delay_size; /* Contains error code */
 
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	/* The fixed point delay lines are not needed in float */
+	if (cd->float_path)
+		return eq_fir_setup_float(cd, nch);
+#endif
+
 	/* If all channels were set to bypass there's no need to
 	 * allocate delay. Just return with success.
 	 */
@@ -355,6 +446,8 @@ static struct comp_dev *eq_fir_new(const struct comp_driver *drv,
 		goto cd_fail;
 	}
 
+	comp_data_blob_share(cd->model_handler);
+
 	/* Allocate and make a copy of the coefficients blob and reset FIR. If
 	 * the EQ is configured later in run-time the size is zero.
 	 */
@@ -583,6 +676,10 @@ static int eq_fir_prepare(struct comp_dev *dev)
 
 	cd->config = comp_get_data_blob(cd->model_handler, NULL, NULL);
 
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	cd->float_path = source_c->stream.frame_fmt == SOF_IPC_FRAME_FLOAT;
+#endif
+
 	if (cd->config) {
 		ret = eq_fir_setup(cd, source_c->stream.channels);
 		if (ret < 0)
@@ -624,6 +721,8 @@ static const struct comp_driver comp_eq_fir = {
 	.type = SOF_COMP_EQ_FIR,
 	.uid = SOF_RT_UUID(eq_fir_uuid),
 	.tctx = &eq_fir_tr,
+	.shed_tier = COMP_SHED_ENHANCE,
+	.any_period = true,
 	.ops = {
 		.create = eq_fir_new,
 		.free = eq_fir_free,
@@ -21,6 +21,7 @@
 #include <sof/lib/uuid.h>
 #include <sof/list.h>
 #include <sof/math/iir_df2t.h>
+#include <sof/math/iir_df2t_float.h>
 #include <sof/platform.h>
 #include <sof/string.h>
 #include <sof/ut.h>
@@ -44,16 +45,6 @@ DECLARE_SOF_RT_UUID("eq-iir", eq_iir_uuid, 0x5150c0e6, 0x27f9, 0x4ec8,
 
 DECLARE_TR_CTX(eq_iir_tr, SOF_UUID(eq_iir_uuid), LOG_LEVEL_INFO);
 
-/* IIR component private data */
-struct comp_data {
-	struct iir_state_df2t iir[PLATFORM_MAX_CHANNELS]; /**< filters state */
-	struct comp_data_blob_handler *model_handler;
-	struct sof_eq_iir_config *config;
-	int64_t *iir_delay;			/**< pointer to allocated RAM */
-	size_t iir_delay_size;			/**< allocated size */
-	eq_iir_func eq_iir_func;		/**< processing function */
-};
-
 #if CONFIG_FORMAT_S16LE
 
 /*
@@ -199,6 +190,167 @@ static void eq_iir_s32_default(const struct comp_dev *dev,
 }
 #endif /* CONFIG_FORMAT_S32LE */
 
+/*
+ * Variants for the common channels counts. The core is always inlined
+ * with a constant channels count, so the loop over channels is unrolled
+ * and the frames are processed in interleaved order instead of one
+ * channel at a time with strided pointers.
+ */
+#define EQ_IIR_NCH_FUNC(fmt, nch) \
+static void eq_iir_##fmt##_##nch##ch(const struct comp_dev *dev, \
+				     const struct audio_stream __sparse_cache *source, \
+				     struct audio_stream __sparse_cache *sink, \
+				     uint32_t frames) \
+{ \
+	eq_iir_##fmt##_nch(dev, source, sink, frames, nch); \
+}
+
+#if CONFIG_FORMAT_S16LE
+static __always_inline void eq_iir_s16_nch(const struct comp_dev *dev,
+					   const struct audio_stream __sparse_cache *source,
+					   struct audio_stream __sparse_cache *sink,
+					   uint32_t frames, const int nch)
+{
+	struct comp_data *cd = comp_get_drvdata(dev);
+	int16_t *x = source->r_ptr;
+	int16_t *y = sink->w_ptr;
+	int n1;
+	int n2;
+	int n;
+	int i;
+	int ch;
+
+	while (frames) {
+		n1 = audio_stream_bytes_without_wrap(source, x) / (nch * sizeof(int16_t));
+		n2 = audio_stream_bytes_without_wrap(sink, y) / (nch * sizeof(int16_t));
+		n = MIN(n1, n2);
+		n = MIN(n, frames);
+		for (i = 0; i < n; i++) {
+			for (ch = 0; ch < nch; ch++)
+				y[ch] = iir_df2t_s16(&cd->iir[ch], x[ch]);
+
+			x += nch;
+			y += nch;
+		}
+		frames -= n;
+		x = audio_stream_wrap(source, x);
+		y = audio_stream_wrap(sink, y);
+	}
+}
+
+EQ_IIR_NCH_FUNC(s16, 1)
+EQ_IIR_NCH_FUNC(s16, 2)
+EQ_IIR_NCH_FUNC(s16, 4)
+EQ_IIR_NCH_FUNC(s16, 8)
+#endif /* CONFIG_FORMAT_S16LE */
+
+#if CONFIG_FORMAT_S24LE
+static __always_inline void eq_iir_s24_nch(const struct comp_dev *dev,
+					   const struct audio_stream __sparse_cache *source,
+					   struct audio_stream __sparse_cache *sink,
+					   uint32_t frames, const int nch)
+{
+	struct comp_data *cd = comp_get_drvdata(dev);
+	int32_t *x = source->r_ptr;
+	int32_t *y = sink->w_ptr;
+	int n1;
+	int n2;
+	int n;
+	int i;
+	int ch;
+
+	while (frames) {
+		n1 = audio_stream_bytes_without_wrap(source, x) / (nch * sizeof(int32_t));
+		n2 = audio_stream_bytes_without_wrap(sink, y) / (nch * sizeof(int32_t));
+		n = MIN(n1, n2);
+		n = MIN(n, frames);
+		for (i = 0; i < n; i++) {
+			for (ch = 0; ch < nch; ch++)
+				y[ch] = iir_df2t_s24(&cd->iir[ch], x[ch]);
+
+			x += nch;
+			y += nch;
+		}
+		frames -= n;
+		x = audio_stream_wrap(source, x);
+		y = audio_stream_wrap(sink, y);
+	}
+}
+
+EQ_IIR_NCH_FUNC(s24, 1)
+EQ_IIR_NCH_FUNC(s24, 2)
+EQ_IIR_NCH_FUNC(s24, 4)
+EQ_IIR_NCH_FUNC(s24, 8)
+#endif /* CONFIG_FORMAT_S24LE */
+
+#if CONFIG_FORMAT_S32LE
+static __always_inline void eq_iir_s32_nch(const struct comp_dev *dev,
+					   const struct audio_stream __sparse_cache *source,
+					   struct audio_stream __sparse_cache *sink,
+					   uint32_t frames, const int nch)
+{
+	struct comp_data *cd = comp_get_drvdata(dev);
+	int32_t *x = source->r_ptr;
+	int32_t *y = sink->w_ptr;
+	int n1;
+	int n2;
+	int n;
+	int i;
+	int ch;
+
+	while (frames) {
+		n1 = audio_stream_bytes_without_wrap(source, x) / (nch * sizeof(int32_t));
+		n2 = audio_stream_bytes_without_wrap(sink, y) / (nch * sizeof(int32_t));
+		n = MIN(n1, n2);
+		n = MIN(n, frames);
+		for (i = 0; i < n; i++) {
+			for (ch = 0; ch < nch; ch++)
+				y[ch] = iir_df2t(&cd->iir[ch], x[ch]);
+
+			x += nch;
+			y += nch;
+		}
+		frames -= n;
+		x = audio_stream_wrap(source, x);
+		y = audio_stream_wrap(sink, y);
+	}
+}
+
+EQ_IIR_NCH_FUNC(s32, 1)
+EQ_IIR_NCH_FUNC(s32, 2)
+EQ_IIR_NCH_FUNC(s32, 4)
+EQ_IIR_NCH_FUNC(s32, 8)
+#endif /* CONFIG_FORMAT_S32LE */
+
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+static void eq_iir_float_default(const struct comp_dev *dev,
+				 const struct audio_stream __sparse_cache *source,
+				 struct audio_stream __sparse_cache *sink, uint32_t frames)
+{
+	struct comp_data *cd = comp_get_drvdata(dev);
+	float *x = source->r_ptr;
+	float *y = sink->w_ptr;
+	const int nch = source->channels;
+	int n1;
+	int n2;
+	int n;
+	int ch;
+
+	while (frames) {
+		n1 = audio_stream_bytes_without_wrap(source, x) / (nch * sizeof(float));
+		n2 = audio_stream_bytes_without_wrap(sink, y) / (nch * sizeof(float));
+		n = MIN(n1, n2);
+		n = MIN(n, frames);
+		for (ch = 0; ch < nch; ch++)
+			iir_df2t_float(&cd->iir_float[ch], x + ch, y + ch, n, nch);
+
+		frames -= n;
+		x = audio_stream_wrap(source, x + n * nch);
+		y = audio_stream_wrap(sink, y + n * nch);
+	}
+}
+#endif /* CONFIG_FORMAT_FLOAT_PROCESSING */
+
 #if CONFIG_FORMAT_S32LE && CONFIG_FORMAT_S16LE
 static void eq_iir_s32_16_default(const struct comp_dev *dev,
 				  const struct audio_stream __sparse_cache *source,
@@ -360,6 +512,25 @@ static void eq_iir_s32_s24_pass(const struct comp_dev *dev,
 #endif /* CONFIG_FORMAT_S24LE && CONFIG_FORMAT_S32LE */
 
 const struct eq_iir_func_map fm_configured[] = {
+/* The channels specific variants need to be before the generic ones */
+#if CONFIG_FORMAT_S16LE
+	{SOF_IPC_FRAME_S16_LE,  SOF_IPC_FRAME_S16_LE,  eq_iir_s16_1ch, 1},
+	{SOF_IPC_FRAME_S16_LE,  SOF_IPC_FRAME_S16_LE,  eq_iir_s16_2ch, 2},
+	{SOF_IPC_FRAME_S16_LE,  SOF_IPC_FRAME_S16_LE,  eq_iir_s16_4ch, 4},
+	{SOF_IPC_FRAME_S16_LE,  SOF_IPC_FRAME_S16_LE,  eq_iir_s16_8ch, 8},
+#endif /* CONFIG_FORMAT_S16LE */
+#if CONFIG_FORMAT_S24LE
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S24_4LE, eq_iir_s24_1ch, 1},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S24_4LE, eq_iir_s24_2ch, 2},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S24_4LE, eq_iir_s24_4ch, 4},
+	{SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S24_4LE, eq_iir_s24_8ch, 8},
+#endif /* CONFIG_FORMAT_S24LE */
+#if CONFIG_FORMAT_S32LE
+	{SOF_IPC_FRAME_S32_LE,  SOF_IPC_FRAME_S32_LE,  eq_iir_s32_1ch, 1},
+	{SOF_IPC_FRAME_S32_LE,  SOF_IPC_FRAME_S32_LE,  eq_iir_s32_2ch, 2},
+	{SOF_IPC_FRAME_S32_LE,  SOF_IPC_FRAME_S32_LE,  eq_iir_s32_4ch, 4},
+	{SOF_IPC_FRAME_S32_LE,  SOF_IPC_FRAME_S32_LE,  eq_iir_s32_8ch, 8},
+#endif /* CONFIG_FORMAT_S32LE */
 #if CONFIG_FORMAT_S16LE
 	{SOF_IPC_FRAME_S16_LE,  SOF_IPC_FRAME_S16_LE,  eq_iir_s16_default},
 #endif /* CONFIG_FORMAT_S16LE */
@@ -382,8 +553,13 @@ const struct eq_iir_func_map fm_configured[] = {
 #if CONFIG_FORMAT_S32LE
 	{SOF_IPC_FRAME_S32_LE,  SOF_IPC_FRAME_S32_LE,  eq_iir_s32_default},
 #endif /* CONFIG_FORMAT_S32LE */
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	{SOF_IPC_FRAME_FLOAT,   SOF_IPC_FRAME_FLOAT,   eq_iir_float_default},
+#endif /* CONFIG_FORMAT_FLOAT_PROCESSING */
 };
 
+const size_t fm_configured_count = ARRAY_SIZE(fm_configured);
+
 const struct eq_iir_func_map fm_passthrough[] = {
 #if CONFIG_FORMAT_S16LE
 	{SOF_IPC_FRAME_S16_LE,  SOF_IPC_FRAME_S16_LE,  eq_iir_pass},
@@ -407,10 +583,14 @@ const struct eq_iir_func_map fm_passthrough[] = {
 #if CONFIG_FORMAT_S32LE
 	{SOF_IPC_FRAME_S32_LE,  SOF_IPC_FRAME_S32_LE,  eq_iir_pass},
 #endif /* CONFIG_FORMAT_S32LE */
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	{SOF_IPC_FRAME_FLOAT,   SOF_IPC_FRAME_FLOAT,   eq_iir_pass},
+#endif /* CONFIG_FORMAT_FLOAT_PROCESSING */
 };
 
 static eq_iir_func eq_iir_find_func(enum sof_ipc_frame source_format,
 				    enum sof_ipc_frame sink_format,
+				    int channels,
 				    const struct eq_iir_func_map *map,
 				    int n)
 {
@@ -422,6 +602,8 @@ static eq_iir_func eq_iir_find_func(enum sof_ipc_frame source_format,
 			continue;
 		if ((uint8_t)sink_format != map[i].sink)
 			continue;
+		if (map[i].channels && map[i].channels != channels)
+			continue;
 
 		return map[i].func;
 	}
@@ -442,6 +624,13 @@ static void eq_iir_free_delaylines(struct comp_data *cd)
 	cd->iir_delay_size = 0;
 	for (i = 0; i < PLATFORM_MAX_CHANNELS; i++)
 		iir[i].delay = NULL;
+
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	rfree(cd->iir_float_data);
+	cd->iir_float_data = NULL;
+	for (i = 0; i < PLATFORM_MAX_CHANNELS; i++)
+		iir_reset_df2t_float(&cd->iir_float[i]);
+#endif
 }
 
 static int eq_iir_init_coef(struct sof_eq_iir_config *config,
@@ -550,6 +739,34 @@ static void eq_iir_init_delay(struct iir_state_df2t *iir,
 	}
 }
 
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+/* Convert the fixed point filters set up from the blob to float */
+static int eq_iir_setup_float(struct comp_data *cd, int nch)
+{
+	size_t size = 0;
+	float *data;
+	int i;
+
+	for (i = 0; i < nch; i++)
+		size += iir_size_df2t_float(&cd->iir[i]);
+
+	if (!size)
+		return 0;
+
+	cd->iir_float_data = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, size);
+	if (!cd->iir_float_data) {
+		comp_cl_err(&comp_eq_iir, "eq_iir_setup_float(), allocation fail");
+		return -ENOMEM;
+	}
+
+	data = cd->iir_float_data;
+	for (i = 0; i < nch; i++)
+		iir_init_df2t_float(&cd->iir_float[i], &cd->iir[i], &data);
+
+	return 0;
+}
+#endif /* CONFIG_FORMAT_FLOAT_PROCESSING */
+
 static int eq_iir_setup(struct comp_data *cd, int nch)
 {
 	int delay_size;
@@ -562,6 +779,12 @@ static int eq_iir_setup(struct comp_data *cd, int nch)
 	if (delay_size < 0)
 		return delay_size; /* Contains error code */
 
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	/* The fixed point delay lines are not needed in float */
+	if (cd->float_path)
+		return eq_iir_setup_float(cd, nch);
+#endif
+
 	/* If all channels were set to bypass there's no need to
 	 * allocate delay. Just return with success.
 	 */
@@ -584,6 +807,31 @@ static int eq_iir_setup(struct comp_data *cd, int nch)
 	return 0;
 }
 
+#if CONFIG_COMP_IIR_BATCH
+static void eq_iir_batch_detach(struct comp_dev *dev, struct comp_data *cd)
+{
+	if (cd->batch) {
+		eq_iir_batch_leave(cd->batch, dev);
+		cd->batch = NULL;
+	}
+}
+
+/* mono streams with the shared blob of this one may be filtered with it */
+static void eq_iir_batch_attach(struct comp_dev *dev, struct comp_data *cd,
+				const struct comp_buffer __sparse_cache *source,
+				const struct comp_buffer __sparse_cache *sink)
+{
+	eq_iir_batch_detach(dev, cd);
+
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	if (cd->float_path)
+		return;
+#endif
+
+	cd->batch = eq_iir_batch_join(dev, &cd->iir[0], cd->config, source, sink);
+}
+#endif /* CONFIG_COMP_IIR_BATCH */
+
 /*
  * End of EQ setup code. Next the standard component methods.
  */
@@ -632,6 +880,8 @@ static struct comp_dev *eq_iir_new(const struct comp_driver *drv,
 		goto cd_fail;
 	}
 
+	comp_data_blob_share(cd->model_handler);
+
 	/* Allocate and make a copy of the coefficients blob and reset IIR. If
 	 * the EQ is configured later in run-time the size is zero.
 	 */
@@ -661,6 +911,9 @@ static void eq_iir_free(struct comp_dev *dev)
 
 	comp_info(dev, "eq_iir_free()");
 
+#if CONFIG_COMP_IIR_BATCH
+	eq_iir_batch_detach(dev, cd);
+#endif
 	eq_iir_free_delaylines(cd);
 	comp_data_blob_handler_free(cd->model_handler);
 
@@ -693,8 +946,8 @@ static int eq_iir_verify_params(struct comp_dev *dev,
 	 * frame_fmt will be equal).
 	 */
 	buffer_flag = eq_iir_find_func(source_c->stream.frame_fmt,
-				       sink_c->stream.frame_fmt, fm_configured,
-				       ARRAY_SIZE(fm_configured)) ?
+				       sink_c->stream.frame_fmt, 0, fm_configured,
+				       fm_configured_count) ?
 				       BUFF_PARAMS_FRAME_FMT : 0;
 
 	buffer_release(sink_c);
@@ -794,6 +1047,7 @@ static int eq_iir_cmd(struct comp_dev *dev, int cmd, void *data,
 static int eq_iir_trigger(struct comp_dev *dev, int cmd)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
+	int ret;
 
 	comp_info(dev, "eq_iir_trigger()");
 
@@ -802,7 +1056,14 @@ static int eq_iir_trigger(struct comp_dev *dev, int cmd)
 		return -EINVAL;
 	}
 
-	return comp_set_state(dev, cmd);
+	ret = comp_set_state(dev, cmd);
+
+#if CONFIG_COMP_IIR_BATCH
+	if (!ret && cd->batch)
+		eq_iir_batch_trigger(cd->batch, dev, cmd);
+#endif
+
+	return ret;
 }
 
 static void eq_iir_process(struct comp_dev *dev, struct comp_buffer __sparse_cache *source,
@@ -839,6 +1100,10 @@ static int eq_iir_copy(struct comp_dev *dev)
 
 	/* Check for changed configuration */
 	if (comp_is_new_data_blob_available(cd->model_handler)) {
+#if CONFIG_COMP_IIR_BATCH
+		/* the stream is filtered alone until the next prepare */
+		eq_iir_batch_detach(dev, cd);
+#endif
 		cd->config = comp_get_data_blob(cd->model_handler, NULL, NULL);
 		ret = eq_iir_setup(cd, source_c->stream.channels);
 		if (ret < 0) {
@@ -849,6 +1114,16 @@ static int eq_iir_copy(struct comp_dev *dev)
 		}
 	}
 
+#if CONFIG_COMP_IIR_BATCH
+	if (cd->batch) {
+		buffer_release(source_c);
+		if (eq_iir_batch_copy(cd->batch, dev))
+			return 0;
+
+		source_c = buffer_acquire(sourceb);
+	}
+#endif
+
 	sinkb = list_first_item(&dev->bsink_list, struct comp_buffer,
 				source_list);
 	sink_c = buffer_acquire(sinkb);
@@ -911,6 +1186,10 @@ static int eq_iir_prepare(struct comp_dev *dev)
 
 	cd->config = comp_get_data_blob(cd->model_handler, NULL, NULL);
 
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	cd->float_path = source_format == SOF_IPC_FRAME_FLOAT;
+#endif
+
 	/* Initialize EQ */
 	comp_info(dev, "eq_iir_prepare(), source_format=%d, sink_format=%d",
 		  source_format, sink_format);
@@ -920,16 +1199,21 @@ static int eq_iir_prepare(struct comp_dev *dev)
 			comp_err(dev, "eq_iir_prepare(), setup failed.");
 			goto out;
 		}
-		cd->eq_iir_func = eq_iir_find_func(source_format, sink_format, fm_configured,
-						   ARRAY_SIZE(fm_configured));
+		cd->eq_iir_func = eq_iir_find_func(source_format, sink_format,
+						   source_c->stream.channels, fm_configured,
+						   fm_configured_count);
 		if (!cd->eq_iir_func) {
 			comp_err(dev, "eq_iir_prepare(), No proc func");
 			ret = -EINVAL;
 			goto out;
 		}
 		comp_info(dev, "eq_iir_prepare(), IIR is configured.");
+
+#if CONFIG_COMP_IIR_BATCH
+		eq_iir_batch_attach(dev, cd, source_c, sink_c);
+#endif
 	} else {
-		cd->eq_iir_func = eq_iir_find_func(source_format, sink_format, fm_passthrough,
+		cd->eq_iir_func = eq_iir_find_func(source_format, sink_format, 0, fm_passthrough,
 						   ARRAY_SIZE(fm_passthrough));
 		if (!cd->eq_iir_func) {
 			comp_err(dev, "eq_iir_prepare(), No pass func");
@@ -956,6 +1240,9 @@ static int eq_iir_reset(struct comp_dev *dev)
 
 	comp_info(dev, "eq_iir_reset()");
 
+#if CONFIG_COMP_IIR_BATCH
+	eq_iir_batch_detach(dev, cd);
+#endif
 	eq_iir_free_delaylines(cd);
 
 	cd->eq_iir_func = NULL;
@@ -966,10 +1253,36 @@ static int eq_iir_reset(struct comp_dev *dev)
 	return 0;
 }
 
+#if CONFIG_COMP_IIR_BATCH
+static int eq_iir_set_attribute(struct comp_dev *dev, uint32_t type, void *value)
+{
+	struct comp_data *cd = comp_get_drvdata(dev);
+
+	switch (type) {
+	case COMP_ATTR_PERIOD:
+		/* the lanes of a batch are sized for the period the streams joined with */
+		if (cd->batch) {
+			comp_err(dev, "eq_iir_set_attribute(): period can't change in a batch");
+			return -EBUSY;
+		}
+		return 0;
+	case COMP_ATTR_BYPASS:
+		/* a shed or bypassed stream doesn't hold back the rest of its batch */
+		if (cd->batch)
+			eq_iir_batch_bypass(cd->batch, dev);
+		return 0;
+	default:
+		return -EINVAL;
+	}
+}
+#endif
+
 static const struct comp_driver comp_eq_iir = {
 	.type = SOF_COMP_EQ_IIR,
 	.uid = SOF_RT_UUID(eq_iir_uuid),
 	.tctx = &eq_iir_tr,
+	.shed_tier = COMP_SHED_ENHANCE,
+	.any_period = true,
 	.ops = {
 		.create = eq_iir_new,
 		.free = eq_iir_free,
@@ -979,6 +1292,9 @@ static const struct comp_driver comp_eq_iir = {
 		.copy = eq_iir_copy,
 		.prepare = eq_iir_prepare,
 		.reset = eq_iir_reset,
+#if CONFIG_COMP_IIR_BATCH
+		.set_attribute = eq_iir_set_attribute,
+#endif
 	},
 };
 
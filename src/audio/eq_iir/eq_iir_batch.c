@@ -0,0 +1,402 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+/*
+ * Batch processing of IIR equalizers. Mono streams of the same core with
+ * the same shared configuration blob, rate, format and period are
+ * filtered together by iir_df2t_lanes(), one lane per stream. A stream
+ * that copies is only queued until every running stream of the batch
+ * has been queued in the scheduler tick, then the last one filters all
+ * of them. A stream that is queued again before that means a tick was
+ * missed by the others and the queued streams are filtered right away.
+ * A shed or bypassed stream leaves the running ones until it copies
+ * again. With fewer than EQ_IIR_BATCH_LANES_MIN running streams each
+ * one is filtered alone, without the extra period of latency.
+ */
+
+#include <sof/audio/audio_stream.h>
+#include <sof/audio/buffer.h>
+#include <sof/audio/component.h>
+#include <sof/audio/eq_iir/eq_iir.h>
+#include <sof/audio/format.h>
+#include <sof/bit.h>
+#include <sof/common.h>
+#include <sof/drivers/interrupt.h>
+#include <sof/lib/alloc.h>
+#include <sof/lib/cpu.h>
+#include <sof/list.h>
+#include <sof/math/iir_df2t.h>
+#include <sof/trace/trace.h>
+#include <ipc/stream.h>
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+LOG_MODULE_DECLARE(eq_iir, CONFIG_SOF_LOG_LEVEL);
+
+#define EQ_IIR_BATCH_LANES	IIR_DF2T_LANES_MAX
+
+/*
+ * Running streams needed for a batch. The lanes, including moving the
+ * samples and delays to and from them, only beat filtering every stream
+ * alone from four streams on, see test_bench_iir_df2t_lanes().
+ */
+#define EQ_IIR_BATCH_LANES_MIN	4
+
+/* streams filtered together */
+struct eq_iir_batch {
+	struct list_item list;		/**< in the batches of the core */
+	const void *config;		/**< shared configuration blob */
+	enum sof_ipc_frame frame_fmt;
+	uint32_t rate;
+	uint32_t frames;		/**< period of the streams */
+	uint32_t members;		/**< lanes in use */
+	uint32_t active;		/**< lanes of running streams */
+	uint32_t queued;		/**< lanes waiting for the batch */
+	struct comp_dev *dev[EQ_IIR_BATCH_LANES];
+	struct iir_state_df2t *iir[EQ_IIR_BATCH_LANES];
+	int32_t *data;			/**< frames x lanes samples */
+	int64_t *delay;			/**< delays x lanes */
+};
+
+static struct list_item eq_iir_batches[CONFIG_CORE_COUNT];
+
+static struct list_item *eq_iir_batches_get(void)
+{
+	struct list_item *batches = &eq_iir_batches[cpu_get_id()];
+
+	if (!batches->next)
+		list_init(batches);
+
+	return batches;
+}
+
+static int eq_iir_batch_lane(struct eq_iir_batch *batch, struct comp_dev *dev)
+{
+	int lane;
+
+	for (lane = 0; lane < EQ_IIR_BATCH_LANES; lane++)
+		if (batch->dev[lane] == dev)
+			return lane;
+
+	return -EINVAL;
+}
+
+static struct eq_iir_batch *eq_iir_batch_new(struct comp_dev *dev, struct iir_state_df2t *iir,
+					     const void *config,
+					     const struct audio_stream __sparse_cache *stream)
+{
+	struct eq_iir_batch *batch;
+	size_t delays = IIR_DF2T_NUM_DELAYS * iir->biquads;
+
+	batch = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, sizeof(*batch));
+	if (!batch)
+		return NULL;
+
+	batch->data = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+			      dev->frames * EQ_IIR_BATCH_LANES * sizeof(int32_t));
+	batch->delay = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+			       delays * EQ_IIR_BATCH_LANES * sizeof(int64_t));
+	if (!batch->data || !batch->delay) {
+		rfree(batch->data);
+		rfree(batch->delay);
+		rfree(batch);
+		return NULL;
+	}
+
+	batch->config = config;
+	batch->frame_fmt = stream->frame_fmt;
+	batch->rate = stream->rate;
+	batch->frames = dev->frames;
+
+	return batch;
+}
+
+struct eq_iir_batch *eq_iir_batch_join(struct comp_dev *dev, struct iir_state_df2t *iir,
+				       const void *config,
+				       const struct comp_buffer __sparse_cache *source,
+				       const struct comp_buffer __sparse_cache *sink)
+{
+	const struct audio_stream __sparse_cache *stream = &source->stream;
+	struct list_item *batches;
+	struct list_item *item;
+	struct eq_iir_batch *batch;
+	uint32_t period_bytes = audio_stream_period_bytes(stream, dev->frames);
+	uint32_t flags;
+	int lane;
+
+	/* the queued period of a stream stays in its buffers for a tick */
+	if (stream->channels != 1 || sink->stream.channels != 1 ||
+	    stream->frame_fmt != sink->stream.frame_fmt || !iir->biquads ||
+	    !dev->frames || stream->size < 2 * period_bytes ||
+	    sink->stream.size < 2 * period_bytes)
+		return NULL;
+
+	switch (stream->frame_fmt) {
+	case SOF_IPC_FRAME_S16_LE:
+	case SOF_IPC_FRAME_S24_4LE:
+	case SOF_IPC_FRAME_S32_LE:
+		break;
+	default:
+		return NULL;
+	}
+
+	irq_local_disable(flags);
+	batches = eq_iir_batches_get();
+	list_for_item(item, batches) {
+		batch = container_of(item, struct eq_iir_batch, list);
+		if (batch->config != config || batch->frame_fmt != stream->frame_fmt ||
+		    batch->rate != stream->rate || batch->frames != dev->frames)
+			continue;
+
+		for (lane = 0; lane < EQ_IIR_BATCH_LANES; lane++) {
+			if (!(batch->members & BIT(lane))) {
+				batch->dev[lane] = dev;
+				batch->iir[lane] = iir;
+				batch->members |= BIT(lane);
+				irq_local_enable(flags);
+				comp_info(dev, "eq_iir_batch_join(), lane %d", lane);
+				return batch;
+			}
+		}
+	}
+	irq_local_enable(flags);
+
+	batch = eq_iir_batch_new(dev, iir, config, stream);
+	if (!batch) {
+		comp_warn(dev, "eq_iir_batch_join(), no memory for a batch");
+		return NULL;
+	}
+
+	batch->dev[0] = dev;
+	batch->iir[0] = iir;
+	batch->members = BIT(0);
+
+	irq_local_disable(flags);
+	list_item_prepend(&batch->list, batches);
+	irq_local_enable(flags);
+
+	comp_info(dev, "eq_iir_batch_join(), new batch");
+
+	return batch;
+}
+
+void eq_iir_batch_leave(struct eq_iir_batch *batch, struct comp_dev *dev)
+{
+	int lane = eq_iir_batch_lane(batch, dev);
+	uint32_t flags;
+
+	if (lane < 0)
+		return;
+
+	irq_local_disable(flags);
+	batch->members &= ~BIT(lane);
+	batch->active &= ~BIT(lane);
+	batch->queued &= ~BIT(lane);
+	batch->dev[lane] = NULL;
+	batch->iir[lane] = NULL;
+	if (batch->members) {
+		irq_local_enable(flags);
+		return;
+	}
+
+	list_item_del(&batch->list);
+	irq_local_enable(flags);
+
+	rfree(batch->data);
+	rfree(batch->delay);
+	rfree(batch);
+}
+
+void eq_iir_batch_trigger(struct eq_iir_batch *batch, struct comp_dev *dev, int cmd)
+{
+	int lane = eq_iir_batch_lane(batch, dev);
+	uint32_t flags;
+
+	if (lane < 0)
+		return;
+
+	irq_local_disable(flags);
+	switch (cmd) {
+	case COMP_TRIGGER_START:
+	case COMP_TRIGGER_RELEASE:
+		batch->active |= BIT(lane);
+		break;
+	case COMP_TRIGGER_STOP:
+	case COMP_TRIGGER_PAUSE:
+	case COMP_TRIGGER_XRUN:
+		/* a queued period is left in the buffers of the stream */
+		batch->active &= ~BIT(lane);
+		batch->queued &= ~BIT(lane);
+		break;
+	default:
+		break;
+	}
+	irq_local_enable(flags);
+}
+
+/* reads a sample of a mono stream as Q1.31 */
+static int32_t eq_iir_batch_read(const struct audio_stream __sparse_cache *stream,
+				 int idx)
+{
+	int16_t *x16;
+	int32_t *x32;
+
+	if (stream->frame_fmt == SOF_IPC_FRAME_S16_LE) {
+		x16 = audio_stream_read_frag_s16(stream, idx);
+		return (int32_t)*x16 << 16;
+	}
+
+	x32 = audio_stream_read_frag_s32(stream, idx);
+
+	return stream->frame_fmt == SOF_IPC_FRAME_S24_4LE ? *x32 << 8 : *x32;
+}
+
+/* writes a Q1.31 sample to a mono stream, as the iir_df2t_s16() etc. do */
+static void eq_iir_batch_write(struct audio_stream __sparse_cache *stream, int idx,
+			       int32_t sample)
+{
+	int16_t *y16;
+	int32_t *y32;
+
+	switch (stream->frame_fmt) {
+	case SOF_IPC_FRAME_S16_LE:
+		y16 = audio_stream_write_frag_s16(stream, idx);
+		*y16 = sat_int16(Q_SHIFT_RND(sample, 31, 15));
+		break;
+	case SOF_IPC_FRAME_S24_4LE:
+		y32 = audio_stream_write_frag_s32(stream, idx);
+		*y32 = sat_int24(Q_SHIFT_RND(sample, 31, 23));
+		break;
+	default:
+		y32 = audio_stream_write_frag_s32(stream, idx);
+		*y32 = sample;
+		break;
+	}
+}
+
+/* filters the queued streams, with the frames all of them can process */
+static void eq_iir_batch_run(struct eq_iir_batch *batch)
+{
+	struct comp_buffer __sparse_cache *source_c[EQ_IIR_BATCH_LANES];
+	struct comp_buffer __sparse_cache *sink_c[EQ_IIR_BATCH_LANES];
+	struct iir_state_df2t *iir[EQ_IIR_BATCH_LANES];
+	struct comp_copy_limits cl;
+	struct comp_buffer *sourceb;
+	struct comp_buffer *sinkb;
+	struct comp_dev *dev;
+	uint32_t queued = batch->queued & batch->active;
+	int frames = batch->frames;
+	int delays;
+	int lanes = 0;
+	int lane;
+	int d;
+	int i;
+	int n;
+
+	batch->queued = 0;
+
+	for (lane = 0; lane < EQ_IIR_BATCH_LANES; lane++) {
+		if (!(queued & BIT(lane)))
+			continue;
+
+		dev = batch->dev[lane];
+		sourceb = list_first_item(&dev->bsource_list, struct comp_buffer, sink_list);
+		sinkb = list_first_item(&dev->bsink_list, struct comp_buffer, source_list);
+		source_c[lanes] = buffer_acquire(sourceb);
+		sink_c[lanes] = buffer_acquire(sinkb);
+		iir[lanes] = batch->iir[lane];
+
+		/* a stream without data doesn't hold back the others */
+		comp_get_copy_limits(source_c[lanes], sink_c[lanes], &cl);
+		if (!cl.frames) {
+			buffer_release(sink_c[lanes]);
+			buffer_release(source_c[lanes]);
+			continue;
+		}
+
+		frames = MIN(frames, cl.frames);
+		lanes++;
+	}
+
+	if (!lanes)
+		return;
+
+	/* every stream has the coefficients of the shared blob */
+	delays = IIR_DF2T_NUM_DELAYS * iir[0]->biquads;
+	for (i = 0; i < lanes; i++) {
+		buffer_stream_invalidate(source_c[i],
+					 audio_stream_frame_bytes(&source_c[i]->stream) * frames);
+		for (n = 0; n < frames; n++)
+			batch->data[n * lanes + i] = eq_iir_batch_read(&source_c[i]->stream, n);
+
+		for (d = 0; d < delays; d++)
+			batch->delay[d * lanes + i] = iir[i]->delay[d];
+	}
+
+	iir_df2t_lanes(iir[0], batch->delay, batch->data, frames, lanes);
+
+	for (i = 0; i < lanes; i++) {
+		for (n = 0; n < frames; n++)
+			eq_iir_batch_write(&sink_c[i]->stream, n, batch->data[n * lanes + i]);
+
+		for (d = 0; d < delays; d++)
+			iir[i]->delay[d] = batch->delay[d * lanes + i];
+
+		buffer_stream_writeback(sink_c[i], audio_stream_frame_bytes(&sink_c[i]->stream) *
+					frames);
+		comp_update_buffer_consume(source_c[i],
+					   audio_stream_frame_bytes(&source_c[i]->stream) * frames);
+		comp_update_buffer_produce(sink_c[i],
+					   audio_stream_frame_bytes(&sink_c[i]->stream) * frames);
+
+		buffer_release(sink_c[i]);
+		buffer_release(source_c[i]);
+	}
+}
+
+bool eq_iir_batch_copy(struct eq_iir_batch *batch, struct comp_dev *dev)
+{
+	int lane = eq_iir_batch_lane(batch, dev);
+
+	if (lane < 0)
+		return false;
+
+	/* a stream that copies is running, also when the trigger came before the join */
+	batch->active |= BIT(lane);
+
+	/* too few streams for the lanes to pay off, they are filtered alone */
+	if (popcount(batch->active) < EQ_IIR_BATCH_LANES_MIN) {
+		if (batch->queued)
+			eq_iir_batch_run(batch);
+		return false;
+	}
+
+	if (batch->queued & BIT(lane)) {
+		comp_dbg(dev, "eq_iir_batch_copy(), batch incomplete in the last tick");
+		eq_iir_batch_run(batch);
+	}
+
+	batch->queued |= BIT(lane);
+	if ((batch->queued & batch->active) == batch->active)
+		eq_iir_batch_run(batch);
+
+	return true;
+}
+
+/* the stream is back in the batch with its next eq_iir_batch_copy() */
+void eq_iir_batch_bypass(struct eq_iir_batch *batch, struct comp_dev *dev)
+{
+	int lane = eq_iir_batch_lane(batch, dev);
+
+	if (lane < 0 || !(batch->active & BIT(lane)))
+		return;
+
+	batch->active &= ~BIT(lane);
+	batch->queued &= ~BIT(lane);
+
+	/* the other streams may have been waiting only for this one */
+	if (batch->queued && (batch->queued & batch->active) == batch->active)
+		eq_iir_batch_run(batch);
+}
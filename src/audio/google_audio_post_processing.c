@@ -471,6 +471,15 @@ static int gapp_copy(struct comp_dev *dev)
 	return 0;
 }
 
+/* the library is set up for the frames of the period in params */
+static int gapp_set_attribute(struct comp_dev *dev, uint32_t type, void *value)
+{
+	if (type == COMP_ATTR_PERIOD)
+		comp_err(dev, "gapp_set_attribute(): period can't change after params");
+
+	return -EINVAL;
+}
+
 struct comp_driver comp_gapp = {
 	.uid = SOF_RT_UUID(gapp_uuid),
 	.tctx = &gapp_tr,
@@ -482,6 +491,7 @@ struct comp_driver comp_gapp = {
 		.trigger = gapp_trigger,
 		.prepare = gapp_prepare,
 		.reset = gapp_reset,
+		.set_attribute = gapp_set_attribute,
 		.copy = gapp_copy,
 	},
 };
@@ -325,7 +325,7 @@ static int google_rtc_audio_processing_prepare(struct comp_dev *dev)
 
 		if (source_c->source->pipeline->pipeline_id != dev->pipeline->pipeline_id) {
 			cd->aec_reference = source;
-			aec_channels = sourcs_c->stream.channels;
+			aec_channels = source_c->stream.channels;
 		} else {
 			cd->raw_microphone = source;
 		}
@@ -385,11 +385,12 @@ static int google_rtc_audio_processing_copy(struct comp_dev *dev)
 {
 	struct google_rtc_audio_processing_comp_data *cd = comp_get_drvdata(dev);
 	struct comp_buffer __sparse_cache *buffer_c, *mic_buf, *output_buf;
+	struct audio_stream_view ref_view;
+	struct audio_stream_view mic_view;
 	struct comp_copy_limits cl;
 	int16_t *src, *dst, *ref;
 	uint32_t num_aec_reference_frames;
 	uint32_t num_aec_reference_bytes;
-	int num_samples_remaining;
 	int num_frames_remaining;
 	int channel;
 	int nmax;
@@ -402,25 +403,33 @@ static int google_rtc_audio_processing_copy(struct comp_dev *dev)
 			return ret;
 	}
 
+	/* read the reference channels straight from the playback stream */
 	buffer_c = buffer_acquire(cd->aec_reference);
+	ret = audio_stream_view_init(&ref_view, &buffer_c->stream, NULL,
+				     cd->num_aec_reference_channels);
+	if (ret < 0) {
+		buffer_release(buffer_c);
+		return ret;
+	}
 
 	ref = buffer_c->stream.r_ptr;
 
-	num_aec_reference_frames = audio_stream_get_avail_frames(&buffer_c->stream);
+	num_aec_reference_frames = audio_stream_view_get_avail_frames(&ref_view);
 	num_aec_reference_bytes = audio_stream_get_avail_bytes(&buffer_c->stream);
 
 	buffer_stream_invalidate(buffer_c, num_aec_reference_bytes);
 
-	num_samples_remaining = num_aec_reference_frames * buffer_c->stream.channels;
-	while (num_samples_remaining) {
-		nmax = audio_stream_samples_without_wrap_s16(&buffer_c->stream, ref);
-		n = MIN(num_samples_remaining, nmax);
-		for (i = 0; i < n; i += cd->num_aec_reference_channels) {
-			j = cd->num_aec_reference_channels * cd->aec_reference_frame_index;
-			for (channel = 0; channel < cd->num_aec_reference_channels; ++channel)
-				cd->aec_reference_buffer[j++] = ref[channel];
+	num_frames_remaining = num_aec_reference_frames;
+	while (num_frames_remaining) {
+		nmax = audio_stream_view_frames_without_wrap(&ref_view, ref);
+		n = MIN(num_frames_remaining, nmax);
+		for (i = 0; i < n; i++) {
+			j = ref_view.channels * cd->aec_reference_frame_index;
+			for (channel = 0; channel < ref_view.channels; ++channel)
+				cd->aec_reference_buffer[j++] =
+					audio_stream_view_read_s16(&ref_view, ref, channel);
 
-			ref += buffer_c->stream.channels;
+			ref += ref_view.stride;
 			++cd->aec_reference_frame_index;
 
 			if (cd->aec_reference_frame_index == cd->num_frames) {
@@ -429,7 +438,7 @@ static int google_rtc_audio_processing_copy(struct comp_dev *dev)
 				cd->aec_reference_frame_index = 0;
 			}
 		}
-		num_samples_remaining -= n;
+		num_frames_remaining -= n;
 		ref = audio_stream_wrap(&buffer_c->stream, ref);
 	}
 	comp_update_buffer_consume(buffer_c, num_aec_reference_bytes);
@@ -439,6 +448,9 @@ static int google_rtc_audio_processing_copy(struct comp_dev *dev)
 	mic_buf = buffer_acquire(cd->raw_microphone);
 	output_buf = buffer_acquire(cd->output);
 
+	/* the processing takes the first microphone */
+	audio_stream_view_init(&mic_view, &mic_buf->stream, NULL, 1);
+
 	src = mic_buf->stream.r_ptr;
 	dst = output_buf->stream.w_ptr;
 
@@ -452,7 +464,8 @@ static int google_rtc_audio_processing_copy(struct comp_dev *dev)
 		nmax = audio_stream_frames_without_wrap(&output_buf->stream, dst);
 		n = MIN(n, nmax);
 		for (i = 0; i < n; i++) {
-			cd->raw_mic_buffer[cd->raw_mic_buffer_index] = *src;
+			cd->raw_mic_buffer[cd->raw_mic_buffer_index] =
+				audio_stream_view_read_s16(&mic_view, src, 0);
 			++cd->raw_mic_buffer_index;
 
 			*dst = cd->output_buffer[cd->output_buffer_index];
@@ -466,7 +479,7 @@ static int google_rtc_audio_processing_copy(struct comp_dev *dev)
 				cd->raw_mic_buffer_index = 0;
 			}
 
-			src += mic_buf->stream.channels;
+			src += mic_view.stride;
 			dst += output_buf->stream.channels;
 		}
 		num_frames_remaining -= n;
@@ -1037,6 +1037,36 @@ static int host_get_attribute(struct comp_dev *dev, uint32_t type,
 	return 0;
 }
 
+/* the pipeline has a new period, dev->frames already follows it */
+static int host_set_period(struct comp_dev *dev)
+{
+	struct host_data *hd = comp_get_drvdata(dev);
+	struct comp_buffer __sparse_cache *buffer_c;
+	uint32_t period_bytes;
+	uint32_t size;
+
+	/* params will size everything for the new period */
+	if (!hd->dma_buffer)
+		return 0;
+
+	buffer_c = buffer_acquire(hd->dma_buffer);
+	period_bytes = ALIGN_UP(dev->frames * audio_stream_frame_bytes(&buffer_c->stream),
+				hd->dma_copy_align);
+	size = buffer_c->stream.size;
+	buffer_release(buffer_c);
+
+	/* the DMA buffer is only sized in params and must hold two periods */
+	if (!period_bytes || size < 2 * period_bytes) {
+		comp_err(dev, "host_set_period(): dma buffer %u too small for period %u",
+			 size, period_bytes);
+		return -EINVAL;
+	}
+
+	hd->period_bytes = period_bytes;
+
+	return 0;
+}
+
 static int host_set_attribute(struct comp_dev *dev, uint32_t type,
 			      void *value)
 {
@@ -1049,6 +1079,8 @@ static int host_set_attribute(struct comp_dev *dev, uint32_t type,
 	case COMP_ATTR_HOST_BUFFER:
 		hd->host.elem_array = *(struct dma_sg_elem_array *)value;
 		break;
+	case COMP_ATTR_PERIOD:
+		return host_set_period(dev);
 	default:
 		return -EINVAL;
 	}
@@ -48,10 +48,11 @@ static void igo_nr_lib_process(struct comp_data *cd)
 {
 	/* Pass through the active channel if
 	 * 1) It's not enabled, or
-	 * 2) hw parameter is not valid.
+	 * 2) hw parameter is not valid, or
+	 * 3) the load is shed.
 	 */
 	if (!cd->process_enable[cd->config.active_channel_idx] ||
-	    cd->invalid_param ||
+	    cd->invalid_param || cd->shed ||
 	    cd->config.igo_params.nr_bypass == 1) {
 		memcpy_s(cd->out, IGO_FRAME_SIZE * sizeof(int16_t),
 			 cd->in, IGO_FRAME_SIZE * sizeof(int16_t));
@@ -827,9 +828,29 @@ static int32_t igo_nr_trigger(struct comp_dev *dev, int32_t cmd)
 	return ret;
 }
 
+/* the library works on blocks of the period set up in params */
+static int igo_nr_set_attribute(struct comp_dev *dev, uint32_t type, void *value)
+{
+	if (type == COMP_ATTR_PERIOD)
+		comp_err(dev, "igo_nr_set_attribute(): period can't change after params");
+
+	return -EINVAL;
+}
+
+/* the library passthrough keeps the block delay, a bypass would drop it */
+static int igo_nr_shed(struct comp_dev *dev, bool shed)
+{
+	struct comp_data *cd = comp_get_drvdata(dev);
+
+	cd->shed = shed;
+
+	return 0;
+}
+
 static const struct comp_driver comp_igo_nr = {
 	.uid = SOF_RT_UUID(igo_nr_uuid),
 	.tctx	= &igo_nr_tr,
+	.shed_tier = COMP_SHED_QUALITY,
 	.ops = {
 		.create = igo_nr_new,
 		.free = igo_nr_free,
@@ -838,7 +859,9 @@ static const struct comp_driver comp_igo_nr = {
 		.copy = igo_nr_copy,
 		.prepare = igo_nr_prepare,
 		.reset = igo_nr_reset,
+		.set_attribute = igo_nr_set_attribute,
 		.trigger = igo_nr_trigger,
+		.shed = igo_nr_shed,
 	},
 };
 
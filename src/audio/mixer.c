@@ -44,9 +44,7 @@ DECLARE_TR_CTX(mixer_tr, SOF_UUID(mixer_uuid), LOG_LEVEL_INFO);
 struct mixer_data {
 	bool sources_inactive;
 
-	void (*mix_func)(struct comp_dev *dev, struct audio_stream __sparse_cache *sink,
-			 const struct audio_stream __sparse_cache **sources, uint32_t count,
-			 uint32_t frames);
+	mixer_func mix_func;
 };
 
 #if CONFIG_FORMAT_S16LE
@@ -189,6 +187,68 @@ static void mix_n_s32(struct comp_dev *dev, struct audio_stream __sparse_cache *
 }
 #endif /* CONFIG_FORMAT_S32LE */
 
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+/* mix N float PCM source streams to one sink buffer, without saturation */
+static void mix_n_float(struct comp_dev *dev, struct audio_stream __sparse_cache *sink,
+			const struct audio_stream __sparse_cache **sources, uint32_t num_sources,
+			uint32_t frames)
+{
+	float *src[PLATFORM_MAX_CHANNELS];
+	float *dest;
+	float val;
+	int nmax;
+	int i, j, n, ns;
+	int processed = 0;
+	int nch = sink->channels;
+	int samples = frames * nch;
+
+	dest = sink->w_ptr;
+	for (j = 0; j < num_sources; j++)
+		src[j] = sources[j]->r_ptr;
+
+	while (processed < samples) {
+		nmax = samples - processed;
+		n = audio_stream_bytes_without_wrap(sink, dest) >> 2; /* divide 4 */
+		n = MIN(n, nmax);
+		for (i = 0; i < num_sources; i++) {
+			ns = audio_stream_bytes_without_wrap(sources[i], src[i]) >> 2;
+			n = MIN(n, ns);
+		}
+		for (i = 0; i < n; i++) {
+			val = 0.0f;
+			for (j = 0; j < num_sources; j++) {
+				val += *src[j];
+				src[j]++;
+			}
+
+			*dest = val;
+			dest++;
+		}
+		processed += n;
+		dest = audio_stream_wrap(sink, dest);
+		for (i = 0; i < num_sources; i++)
+			src[i] = audio_stream_wrap(sources[i], src[i]);
+	}
+}
+#endif /* CONFIG_FORMAT_FLOAT_PROCESSING */
+
+const struct mixer_func_map mixer_func_map[] = {
+#if CONFIG_FORMAT_S16LE
+	{ SOF_IPC_FRAME_S16_LE, mix_n_s16 },
+#endif /* CONFIG_FORMAT_S16LE */
+#if CONFIG_FORMAT_S24LE
+	{ SOF_IPC_FRAME_S24_4LE, mix_n_s24 },
+#endif /* CONFIG_FORMAT_S24LE */
+#if CONFIG_FORMAT_S32LE
+	{ SOF_IPC_FRAME_S32_LE, mix_n_s32 },
+#endif /* CONFIG_FORMAT_S32LE */
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	{ SOF_IPC_FRAME_FLOAT, mix_n_float },
+#endif /* CONFIG_FORMAT_FLOAT_PROCESSING */
+};
+
+const size_t mixer_func_count = ARRAY_SIZE(mixer_func_map);
+
 static struct comp_dev *mixer_new(const struct comp_driver *drv,
 				  struct comp_ipc_config *config,
 				  void *spec)
@@ -457,6 +517,7 @@ static int mixer_prepare_common(struct comp_dev *dev)
 	struct comp_buffer __sparse_cache *sink_c;
 	enum sof_ipc_frame fmt;
 	int ret;
+	int i;
 
 	comp_dbg(dev, "mixer_prepare()");
 
@@ -471,23 +532,15 @@ static int mixer_prepare_common(struct comp_dev *dev)
 	buffer_release(sink_c);
 
 	/* currently inactive so setup mixer */
-	switch (fmt) {
-#if CONFIG_FORMAT_S16LE
-	case SOF_IPC_FRAME_S16_LE:
-		md->mix_func = mix_n_s16;
-		break;
-#endif /* CONFIG_FORMAT_S16LE */
-#if CONFIG_FORMAT_S24LE
-	case SOF_IPC_FRAME_S24_4LE:
-		md->mix_func = mix_n_s24;
-		break;
-#endif /* CONFIG_FORMAT_S24LE */
-#if CONFIG_FORMAT_S32LE
-	case SOF_IPC_FRAME_S32_LE:
-		md->mix_func = mix_n_s32;
-		break;
-#endif /* CONFIG_FORMAT_S32LE */
-	default:
+	md->mix_func = NULL;
+	for (i = 0; i < mixer_func_count; i++) {
+		if (mixer_func_map[i].frame_fmt == fmt) {
+			md->mix_func = mixer_func_map[i].func;
+			break;
+		}
+	}
+
+	if (!md->mix_func) {
 		comp_err(dev, "unsupported data format");
 		return -EINVAL;
 	}
@@ -622,6 +675,7 @@ static const struct comp_driver comp_mixer = {
 	.type	= SOF_COMP_MIXER,
 	.uid	= SOF_RT_UUID(mixer_uuid),
 	.tctx	= &mixer_tr,
+	.any_period	= true,
 	.ops	= {
 		.create		= mixer_new,
 		.free		= mixer_free,
@@ -102,6 +102,12 @@ static int passthrough_codec_reset(struct processing_module *mod)
 	return 0;
 }
 
+static int passthrough_codec_set_period(struct processing_module *mod)
+{
+	/* in_buff and out_buff hold period_bytes, which don't depend on the period */
+	return 0;
+}
+
 static int passthrough_codec_free(struct processing_module *mod)
 {
 	struct comp_dev *dev = mod->dev;
@@ -120,6 +126,7 @@ static struct module_interface passthrough_interface = {
 	.prepare = passthrough_codec_prepare,
 	.process = passthrough_codec_process,
 	.reset = passthrough_codec_reset,
+	.set_period = passthrough_codec_set_period,
 	.free = passthrough_codec_free
 };
 
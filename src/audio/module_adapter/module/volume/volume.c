@@ -211,6 +211,59 @@ static uint32_t vol_zc_get_s32(const struct audio_stream __sparse_cache *source,
 
 #endif /* CONFIG_FORMAT_S32LE */
 
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+/**
+ * \brief Calculates float zero crossing.
+ * \param[in] source Buffer with the samples to check.
+ * \param[in] frames Number of frames.
+ * \param[in,out] prev_sum Previous sum of channel samples.
+ * \return Number of frames until the first sign change.
+ *
+ * The sum is kept in prev_sum in Q1.31 so that only its sign matters as
+ * in the fixed point versions.
+ */
+static uint32_t vol_zc_get_float(const struct audio_stream __sparse_cache *source,
+				 uint32_t frames, int64_t *prev_sum)
+{
+	int64_t sum;
+	float fsum;
+	uint32_t curr_frames = frames;
+	float *x = source->r_ptr;
+	int bytes;
+	int nmax;
+	int i, j, n;
+	const int nch = source->channels;
+	int remaining_samples = frames * nch;
+
+	x = audio_stream_wrap(source, x + remaining_samples - 1); /* Go to last channel */
+	while (remaining_samples) {
+		bytes = audio_stream_rewind_bytes_without_wrap(source, x);
+		nmax = VOL_BYTES_TO_S32_SAMPLES(bytes) + 1;
+		n = MIN(nmax, remaining_samples);
+		for (i = 0; i < n; i += nch) {
+			fsum = 0.0f;
+			for (j = 0; j < nch; j++) {
+				fsum += *x;
+				x--;
+			}
+
+			/* first sign change */
+			sum = (int64_t)(fsum * 2147483648.0f);
+			if ((sum ^ *prev_sum) < 0)
+				return curr_frames;
+
+			*prev_sum = sum;
+			curr_frames--;
+		}
+		remaining_samples -= n;
+		x = audio_stream_rewind_wrap(source, x);
+	}
+
+	/* sign change not detected, process all samples */
+	return frames;
+}
+#endif /* CONFIG_FORMAT_FLOAT_PROCESSING */
+
 /** \brief Map of formats with dedicated zc functions. */
 static const struct comp_zc_func_map zc_func_map[] = {
 #if CONFIG_FORMAT_S16LE
@@ -222,6 +275,9 @@ static const struct comp_zc_func_map zc_func_map[] = {
 #if CONFIG_FORMAT_S32LE
 	{ SOF_IPC_FRAME_S32_LE, vol_zc_get_s32 },
 #endif /* CONFIG_FORMAT_S32LE */
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	{ SOF_IPC_FRAME_FLOAT, vol_zc_get_float },
+#endif /* CONFIG_FORMAT_FLOAT_PROCESSING */
 };
 
 #if CONFIG_COMP_VOLUME_LINEAR_RAMP
@@ -1277,6 +1333,36 @@ err:
 	return ret;
 }
 
+/**
+ * \brief Follows a new scheduling period.
+ * \param[in,out] mod Volume processing module handle
+ * \return Error code.
+ *
+ * Volume processes what is available in a copy, only the ramp step and the
+ * period bytes depend on the period.
+ */
+static int volume_set_period(struct processing_module *mod)
+{
+	struct vol_data *cd = module_get_private_data(mod);
+	struct module_data *md = &mod->priv;
+	struct comp_dev *dev = mod->dev;
+	struct comp_buffer __sparse_cache *sink_c;
+	struct comp_buffer *sinkb;
+	uint32_t sink_period_bytes;
+
+	sinkb = list_first_item(&dev->bsink_list, struct comp_buffer, source_list);
+	sink_c = buffer_acquire(sinkb);
+	sink_period_bytes = audio_stream_period_bytes(&sink_c->stream, dev->frames);
+	buffer_release(sink_c);
+
+	prepare_ramp(dev, cd);
+
+	md->mpd.in_buff_size = sink_period_bytes;
+	md->mpd.out_buff_size = sink_period_bytes;
+
+	return 0;
+}
+
 /**
  * \brief Resets volume component.
  * \param[in,out] mod Volume processing module handle
@@ -1538,6 +1624,7 @@ static struct module_interface volume_interface = {
 	.set_configuration = volume_set_config,
 	.get_configuration = volume_get_config,
 	.reset = volume_reset,
+	.set_period = volume_set_period,
 	.free = volume_free
 };
 
@@ -1551,6 +1638,7 @@ static struct module_interface gain_interface = {
 	.set_configuration = volume_set_config,
 	.get_configuration = volume_get_config,
 	.reset = volume_reset,
+	.set_period = volume_set_period,
 	.free = volume_free
 };
 
@@ -19,6 +19,7 @@
 #include <sof/audio/format.h>
 #include <sof/common.h>
 #include <ipc/stream.h>
+#include <math.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -235,6 +236,58 @@ static void vol_s16_to_s16(struct processing_module *mod, struct input_stream_bu
 }
 #endif /* CONFIG_FORMAT_S16LE */
 
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+/**
+ * \brief Volume processing from float to float.
+ * \param[in,out] mod Pointer to struct processing_module
+ * \param[in] bsource Input buffer.
+ * \param[in,out] bsink Output buffer.
+ * \param[in] frames Number of frames to process.
+ *
+ * The gain is applied without saturation, the peak meter is not updated.
+ */
+static void vol_float_to_float(struct processing_module *mod,
+			       struct input_stream_buffer *bsource,
+			       struct output_stream_buffer *bsink, uint32_t frames)
+{
+	struct vol_data *cd = module_get_private_data(mod);
+	struct audio_stream __sparse_cache *source = bsource->data;
+	struct audio_stream __sparse_cache *sink = bsink->data;
+	float gain[PLATFORM_MAX_CHANNELS];
+	float *x, *x0;
+	float *y, *y0;
+	int nmax, n, i, j;
+	const int nch = source->channels;
+	int remaining_samples = frames * nch;
+
+	for (j = 0; j < nch; j++)
+		gain[j] = ldexpf(cd->volume[j], -VOL_QXY_Y);
+
+	x = source->r_ptr;
+	y = sink->w_ptr;
+	bsource->consumed += VOL_S32_SAMPLES_TO_BYTES(remaining_samples);
+	bsink->size += VOL_S32_SAMPLES_TO_BYTES(remaining_samples);
+	while (remaining_samples) {
+		nmax = VOL_BYTES_TO_S32_SAMPLES(audio_stream_bytes_without_wrap(source, x));
+		n = MIN(remaining_samples, nmax);
+		nmax = VOL_BYTES_TO_S32_SAMPLES(audio_stream_bytes_without_wrap(sink, y));
+		n = MIN(n, nmax);
+		for (j = 0; j < nch; j++) {
+			x0 = x + j;
+			y0 = y + j;
+			for (i = 0; i < n; i += nch) {
+				*y0 = *x0 * gain[j];
+				x0 += nch;
+				y0 += nch;
+			}
+		}
+		remaining_samples -= n;
+		x = audio_stream_wrap(source, x + n);
+		y = audio_stream_wrap(sink, y + n);
+	}
+}
+#endif /* CONFIG_FORMAT_FLOAT_PROCESSING */
+
 const struct comp_func_map volume_func_map[] = {
 #if CONFIG_FORMAT_S16LE
 	{ SOF_IPC_FRAME_S16_LE, vol_s16_to_s16 },
@@ -245,6 +298,9 @@ const struct comp_func_map volume_func_map[] = {
 #if CONFIG_FORMAT_S32LE
 	{ SOF_IPC_FRAME_S32_LE, vol_s32_to_s32 },
 #endif /* CONFIG_FORMAT_S32LE */
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	{ SOF_IPC_FRAME_FLOAT, vol_float_to_float },
+#endif /* CONFIG_FORMAT_FLOAT_PROCESSING */
 };
 
 const size_t volume_func_count = ARRAY_SIZE(volume_func_map);
@@ -996,3 +996,25 @@ int module_get_large_config(struct comp_dev *dev, uint32_t param_id, bool first_
 	return 0;
 }
 #endif
+
+int module_adapter_set_attribute(struct comp_dev *dev, uint32_t type, void *value)
+{
+	struct processing_module *mod = comp_get_drvdata(dev);
+	struct module_data *md = &mod->priv;
+
+	switch (type) {
+	case COMP_ATTR_PERIOD:
+		/*
+		 * The local buffers are sized from period_bytes, which is 1 ms of audio, and not
+		 * from the scheduling period, so only the module can tell if it follows.
+		 */
+		if (!md->ops->set_period) {
+			comp_err(dev, "module_adapter_set_attribute(): module can't change period");
+			return -EINVAL;
+		}
+
+		return md->ops->set_period(mod);
+	default:
+		return -EINVAL;
+	}
+}
@@ -620,6 +620,7 @@ static int multiband_drc_reset(struct comp_dev *dev)
 static const struct comp_driver comp_multiband_drc = {
 	.uid = SOF_RT_UUID(multiband_drc_uuid),
 	.tctx = &multiband_drc_tr,
+	.any_period = true,
 	.ops = {
 		.create  = multiband_drc_new,
 		.free    = multiband_drc_free,
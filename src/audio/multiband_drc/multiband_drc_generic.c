@@ -8,6 +8,7 @@
 #include <sof/audio/drc/drc_algorithm.h>
 #include <sof/audio/format.h>
 #include <sof/audio/multiband_drc/multiband_drc.h>
+#include <sof/bit.h>
 #include <sof/math/iir_df2t.h>
 
 static void multiband_drc_default_pass(const struct comp_dev *dev,
@@ -31,7 +32,7 @@ static void multiband_drc_process_emp_crossover(struct multiband_drc_state *stat
 	int32_t *buf_sink_band;
 	int ch, band;
 	int32_t emp_out;
-	int32_t crossover_out[nband];
+	int32_t crossover_out[CROSSOVER_4WAY_NUM_SINKS][CROSSOVER_BLOCK_FRAMES];
 
 	for (ch = 0; ch < nch; ch++) {
 		emp_s = &state->emphasis[ch];
@@ -42,10 +43,11 @@ static void multiband_drc_process_emp_crossover(struct multiband_drc_state *stat
 		else
 			emp_out = *buf_src;
 
-		split_func(emp_out, crossover_out, crossover_s);
+		/* the DRC runs frame by frame, so split blocks of one frame */
+		split_func(crossover_s, &emp_out, crossover_out, BIT(nband) - 1, 1);
 		buf_sink_band = buf_sink;
 		for (band = 0; band < nband; band++) {
-			*buf_sink_band = crossover_out[band];
+			*buf_sink_band = crossover_out[band][0];
 			buf_sink_band += PLATFORM_MAX_CHANNELS;
 		}
 
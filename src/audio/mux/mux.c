@@ -746,6 +746,7 @@ static const struct comp_driver comp_mux = {
 	.type	= SOF_COMP_MUX,
 	.uid	= SOF_RT_UUID(mux_uuid),
 	.tctx	= &mux_tr,
+	.any_period	= true,
 	.ops	= {
 		.create		= mux_new,
 		.free		= mux_free,
@@ -766,6 +767,7 @@ static const struct comp_driver comp_demux = {
 	.type	= SOF_COMP_DEMUX,
 	.uid	= SOF_RT_UUID(demux_uuid),
 	.tctx	= &demux_tr,
+	.any_period	= true,
 	.ops	= {
 		.create		= mux_new,
 		.free		= mux_free,
@@ -18,150 +18,97 @@
 
 LOG_MODULE_DECLARE(muxdemux, CONFIG_SOF_LOG_LEVEL);
 
-static void mux_check_for_wrap(struct audio_stream __sparse_cache *sink,
-			       const struct audio_stream __sparse_cache **sources,
-			       struct mux_look_up *lookup)
-{
-	const struct audio_stream __sparse_cache *source;
-	uint32_t elem;
-
-	/* check sources and destinations for wrap */
-	for (elem = 0; elem < lookup->num_elems; elem++) {
-		source = sources[lookup->copy_elem[elem].stream_id];
-		lookup->copy_elem[elem].dest =
-			audio_stream_wrap(sink, lookup->copy_elem[elem].dest);
-		lookup->copy_elem[elem].src =
-			audio_stream_wrap(source, lookup->copy_elem[elem].src);
-	}
-}
-
-static void demux_check_for_wrap(struct audio_stream __sparse_cache *sink,
-				 const struct audio_stream __sparse_cache *source,
-				 struct mux_look_up *lookup)
+/* Demux reads the source channels of a look up table through a view, view
+ * channel elem is the source channel of copy_elem[elem].
+ */
+static int demux_init_view(struct comp_dev *dev, struct audio_stream_view *view,
+			   const struct audio_stream __sparse_cache *source,
+			   struct mux_look_up *lookup)
 {
-	uint32_t elem;
+	uint8_t ch_map[PLATFORM_MAX_CHANNELS];
+	uint16_t elem;
+	int ret;
 
-	/* check sources and destinations for wrap */
-	for (elem = 0; elem < lookup->num_elems; elem++) {
-		lookup->copy_elem[elem].dest =
-			audio_stream_wrap(sink, lookup->copy_elem[elem].dest);
-		lookup->copy_elem[elem].src =
-			audio_stream_wrap(source, lookup->copy_elem[elem].src);
+	if (lookup->num_elems > PLATFORM_MAX_CHANNELS) {
+		comp_err(dev, "demux_init_view(): invalid look up table");
+		return -EINVAL;
 	}
-}
 
-#if CONFIG_FORMAT_S16LE
+	for (elem = 0; elem < lookup->num_elems; elem++)
+		ch_map[elem] = lookup->copy_elem[elem].in_ch;
 
-static uint32_t demux_calc_frames_without_wrap_s16(struct comp_dev *dev,
-						   struct audio_stream __sparse_cache *sink,
-						   const struct audio_stream
-						   __sparse_cache *source,
-						   struct mux_look_up *lookup)
-{
-	uint32_t frames;
-	uint32_t min_frames;
-	void *ptr;
+	ret = audio_stream_view_init(view, source, ch_map, lookup->num_elems);
+	if (ret < 0)
+		comp_err(dev, "demux_init_view(): invalid look up table");
 
-	/* for demux we process each source buffer separately - dest/src for
-	 * each copy_elem refers to the same sink/source buffer, so min_frames
-	 * calculation based only on lookup table first element is sufficient.
-	 */
-	ptr = (int16_t *)lookup->copy_elem[0].dest -
-		lookup->copy_elem[0].out_ch;
-	min_frames = audio_stream_frames_without_wrap(sink, ptr);
-
-	ptr = (int16_t *)lookup->copy_elem[0].src -
-		lookup->copy_elem[0].in_ch;
-	frames = audio_stream_frames_without_wrap(source, ptr);
-
-	min_frames = (frames < min_frames) ? frames : min_frames;
-
-	return min_frames;
+	return ret;
 }
 
-static uint32_t mux_calc_frames_without_wrap_s16(struct comp_dev *dev,
-						 struct audio_stream __sparse_cache *sink,
-						 const struct audio_stream
-						 __sparse_cache **sources,
-						 struct mux_look_up *lookup)
+/* Mux reads each source through a view of the channels the look up table
+ * takes from it, view_ch[elem] is the view channel of copy_elem[elem].
+ * Sources the table doesn't read from are left without a parent.
+ */
+static int mux_init_views(struct comp_dev *dev, struct audio_stream_view *views,
+			  uint8_t *view_ch,
+			  const struct audio_stream __sparse_cache **sources,
+			  struct mux_look_up *lookup)
 {
-	const struct audio_stream __sparse_cache *source;
-	uint32_t frames;
-	uint32_t min_frames;
+	uint8_t ch_map[MUX_MAX_STREAMS][PLATFORM_MAX_CHANNELS];
+	uint8_t channels[MUX_MAX_STREAMS] = { 0 };
+	uint32_t stream;
 	uint32_t elem;
-	void *ptr;
-
-	/* dest pointer for all copy_elems in lookup refers to the same
-	 * sink buffer (mux has one sink buffer), so dest min_frames
-	 * calculation based only on lookup table first element is sufficient.
-	 */
-	ptr = (int16_t *)lookup->copy_elem[0].dest -
-		lookup->copy_elem[0].out_ch;
-	min_frames = audio_stream_frames_without_wrap(sink, ptr);
+	int ret;
 
 	for (elem = 0; elem < lookup->num_elems; elem++) {
-		source = sources[lookup->copy_elem[elem].stream_id];
+		stream = lookup->copy_elem[elem].stream_id;
+		view_ch[elem] = channels[stream];
+		ch_map[stream][channels[stream]++] = lookup->copy_elem[elem].in_ch;
+	}
 
-		ptr = (int16_t *)lookup->copy_elem[elem].src -
-			lookup->copy_elem[elem].in_ch;
-		frames = audio_stream_frames_without_wrap(source, ptr);
+	for (stream = 0; stream < MUX_MAX_STREAMS; stream++) {
+		views[stream].parent = NULL;
+		if (!channels[stream])
+			continue;
 
-		min_frames = (frames < min_frames) ? frames : min_frames;
+		ret = audio_stream_view_init(&views[stream], sources[stream],
+					     ch_map[stream], channels[stream]);
+		if (ret < 0) {
+			comp_err(dev, "mux_init_views(): invalid look up table");
+			return ret;
+		}
 	}
 
-	return min_frames;
+	return 0;
 }
 
-static void mux_init_look_up_pointers_s16(struct comp_dev *dev,
-					  struct audio_stream __sparse_cache *sink,
-					  const struct audio_stream __sparse_cache **sources,
-					  struct mux_look_up *lookup)
+/* frames of the mux sources and sink that can be processed without wrap */
+static uint32_t mux_frames_without_wrap(struct audio_stream __sparse_cache *sink,
+					const void *dst, struct audio_stream_view *views,
+					const void **src, uint32_t frames)
 {
-	const struct audio_stream __sparse_cache *source;
-	uint32_t elem;
-
-	/* init pointers */
-	for (elem = 0; elem < lookup->num_elems; elem++) {
-		source = sources[lookup->copy_elem[elem].stream_id];
+	uint32_t stream;
 
-		lookup->copy_elem[elem].src = (int16_t *)source->r_ptr +
-			lookup->copy_elem[elem].in_ch;
-		lookup->copy_elem[elem].src_inc = source->channels;
+	frames = MIN(frames, audio_stream_frames_without_wrap(sink, dst));
+	for (stream = 0; stream < MUX_MAX_STREAMS; stream++)
+		if (views[stream].parent)
+			frames = MIN(frames,
+				     audio_stream_view_frames_without_wrap(&views[stream],
+									   src[stream]));
 
-		lookup->copy_elem[elem].dest = (int16_t *)sink->w_ptr +
-			lookup->copy_elem[elem].out_ch;
-		lookup->copy_elem[elem].dest_inc = sink->channels;
-	}
+	return frames;
 }
 
-static void demux_init_look_up_pointers_s16(struct comp_dev *dev,
-					    struct audio_stream __sparse_cache *sink,
-					    const struct audio_stream __sparse_cache *source,
-					    struct mux_look_up *lookup)
-{
-	uint32_t elem;
-
-	/* init pointers */
-	for (elem = 0; elem < lookup->num_elems; elem++) {
-		lookup->copy_elem[elem].src = (int16_t *)source->r_ptr +
-			lookup->copy_elem[elem].in_ch;
-		lookup->copy_elem[elem].src_inc = source->channels;
-
-		lookup->copy_elem[elem].dest = (int16_t *)sink->w_ptr +
-			lookup->copy_elem[elem].out_ch;
-		lookup->copy_elem[elem].dest_inc = sink->channels;
-	}
-}
+#if CONFIG_FORMAT_S16LE
 
 /**
  * Source stream are routed to sinks with regard to look up table based on
- * routing bitmasks from mux_stream_data structures array. Each sink channel
- * has it's own lookup[].copy_elem describing source and sink fragment of
- * memory featured in copying.
+ * routing bitmasks from mux_stream_data structures array. The source is read
+ * through a channel view of the channels routed to the sink, each view
+ * channel is written to the out_ch of its copy_elem.
  *
  * @param[in] dev Component device
  * @param[in,out] sink Destination buffer.
- * @param[in,out] sources Array of source buffers.
+ * @param[in,out] source Buffer to split.
  * @param[in] frames Number of frames to process.
  * @param[in] lookup mux look up table.
  */
@@ -169,9 +116,10 @@ static void demux_s16le(struct comp_dev *dev, struct audio_stream __sparse_cache
 			const struct audio_stream __sparse_cache *source, uint32_t frames,
 			struct mux_look_up *lookup)
 {
-	uint32_t i;
-	int16_t *src;
+	struct audio_stream_view view;
+	const int16_t *src;
 	int16_t *dst;
+	uint32_t i;
 	uint32_t elem;
 	uint32_t frames_without_wrap;
 
@@ -180,28 +128,28 @@ static void demux_s16le(struct comp_dev *dev, struct audio_stream __sparse_cache
 	if (!lookup || !lookup->num_elems)
 		return;
 
-	demux_init_look_up_pointers_s16(dev, sink, source, lookup);
+	if (demux_init_view(dev, &view, source, lookup) < 0)
+		return;
 
-	while (frames) {
-		frames_without_wrap =
-			demux_calc_frames_without_wrap_s16(dev, sink, source,
-							   lookup);
+	src = source->r_ptr;
+	dst = sink->w_ptr;
 
-		frames_without_wrap = MIN(frames, frames_without_wrap);
+	while (frames) {
+		frames_without_wrap = MIN(frames, audio_stream_frames_without_wrap(sink, dst));
+		frames_without_wrap = MIN(frames_without_wrap,
+					  audio_stream_view_frames_without_wrap(&view, src));
 
 		for (i = 0; i < frames_without_wrap; i++) {
-			for (elem = 0; elem < lookup->num_elems; elem++) {
-				src = (int16_t *)lookup->copy_elem[elem].src;
-				dst = (int16_t *)lookup->copy_elem[elem].dest;
-				*dst = *src;
-				lookup->copy_elem[elem].src = src +
-					lookup->copy_elem[elem].src_inc;
-				lookup->copy_elem[elem].dest = dst +
-					lookup->copy_elem[elem].dest_inc;
-			}
+			for (elem = 0; elem < lookup->num_elems; elem++)
+				dst[lookup->copy_elem[elem].out_ch] =
+					audio_stream_view_read_s16(&view, src, elem);
+
+			src += view.stride;
+			dst += sink->channels;
 		}
 
-		demux_check_for_wrap(sink, source, lookup);
+		src = audio_stream_wrap(source, (void *)src);
+		dst = audio_stream_wrap(sink, dst);
 
 		frames -= frames_without_wrap;
 	}
@@ -209,9 +157,9 @@ static void demux_s16le(struct comp_dev *dev, struct audio_stream __sparse_cache
 
 /**
  * Source streams are routed to sink with regard to look up table based on
- * routing bitmasks from mux_stream_data structures array. Each sink channel
- * has it's own lookup[].copy_elem describing source and sink fragment of
- * memory featured in copying.
+ * routing bitmasks from mux_stream_data structures array. Each source is
+ * read through a channel view of the channels routed from it, each view
+ * channel is written to the out_ch of its copy_elem.
  *
  * @param[in] dev Component device
  * @param[in,out] sink Destination buffer.
@@ -223,10 +171,14 @@ static void mux_s16le(struct comp_dev *dev, struct audio_stream __sparse_cache *
 		      const struct audio_stream __sparse_cache **sources, uint32_t frames,
 		      struct mux_look_up *lookup)
 {
-	uint32_t i;
-	int16_t *src;
+	struct audio_stream_view views[MUX_MAX_STREAMS];
+	uint8_t view_ch[PLATFORM_MAX_CHANNELS];
+	const void *src[MUX_MAX_STREAMS] = { NULL };
+	const struct mux_copy_elem *copy_elem;
 	int16_t *dst;
+	uint32_t i;
 	uint32_t elem;
+	uint32_t stream;
 	uint32_t frames_without_wrap;
 
 	comp_dbg(dev, "mux_s16le()");
@@ -234,28 +186,39 @@ static void mux_s16le(struct comp_dev *dev, struct audio_stream __sparse_cache *
 	if (!lookup || !lookup->num_elems)
 		return;
 
-	mux_init_look_up_pointers_s16(dev, sink, sources, lookup);
+	if (mux_init_views(dev, views, view_ch, sources, lookup) < 0)
+		return;
 
-	while (frames) {
-		frames_without_wrap =
-			mux_calc_frames_without_wrap_s16(dev, sink, sources,
-							 lookup);
+	for (stream = 0; stream < MUX_MAX_STREAMS; stream++)
+		if (views[stream].parent)
+			src[stream] = sources[stream]->r_ptr;
+	dst = sink->w_ptr;
 
-		frames_without_wrap = MIN(frames, frames_without_wrap);
+	while (frames) {
+		frames_without_wrap = mux_frames_without_wrap(sink, dst, views,
+							      src, frames);
 
 		for (i = 0; i < frames_without_wrap; i++) {
 			for (elem = 0; elem < lookup->num_elems; elem++) {
-				src = (int16_t *)lookup->copy_elem[elem].src;
-				dst = (int16_t *)lookup->copy_elem[elem].dest;
-				*dst = *src;
-				lookup->copy_elem[elem].src = src +
-					lookup->copy_elem[elem].src_inc;
-				lookup->copy_elem[elem].dest = dst +
-					lookup->copy_elem[elem].dest_inc;
+				copy_elem = &lookup->copy_elem[elem];
+				stream = copy_elem->stream_id;
+				dst[copy_elem->out_ch] =
+					audio_stream_view_read_s16(&views[stream], src[stream],
+								   view_ch[elem]);
 			}
+
+			for (stream = 0; stream < MUX_MAX_STREAMS; stream++)
+				if (views[stream].parent)
+					src[stream] = (const int16_t *)src[stream] +
+						views[stream].stride;
+			dst += sink->channels;
 		}
 
-		mux_check_for_wrap(sink, sources, lookup);
+		for (stream = 0; stream < MUX_MAX_STREAMS; stream++)
+			if (views[stream].parent)
+				src[stream] = audio_stream_wrap(sources[stream],
+								(void *)src[stream]);
+		dst = audio_stream_wrap(sink, dst);
 
 		frames -= frames_without_wrap;
 	}
@@ -264,116 +227,15 @@ static void mux_s16le(struct comp_dev *dev, struct audio_stream __sparse_cache *
 
 #if CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
 
-static uint32_t mux_calc_frames_without_wrap_s32(struct comp_dev *dev,
-						 struct audio_stream __sparse_cache *sink,
-						 const struct audio_stream
-						 __sparse_cache **sources,
-						 struct mux_look_up *lookup)
-{
-	const struct audio_stream __sparse_cache *source;
-	uint32_t frames;
-	uint32_t min_frames;
-	uint32_t elem;
-	void *ptr;
-
-	/* dest pointer for all copy_elems in lookup refers to the same
-	 * sink buffer (mux has one sink buffer), so dest min_frames
-	 * calculation based only on lookup table first element is sufficient.
-	 */
-	ptr = (int32_t *)lookup->copy_elem[0].dest -
-		lookup->copy_elem[0].out_ch;
-	min_frames = audio_stream_frames_without_wrap(sink, ptr);
-
-	for (elem = 0; elem < lookup->num_elems; elem++) {
-		source = sources[lookup->copy_elem[elem].stream_id];
-
-		ptr = (int32_t *)lookup->copy_elem[elem].src -
-			lookup->copy_elem[elem].in_ch;
-		frames = audio_stream_frames_without_wrap(source, ptr);
-
-		min_frames = (frames < min_frames) ? frames : min_frames;
-	}
-
-	return min_frames;
-}
-
-static uint32_t demux_calc_frames_without_wrap_s32(struct comp_dev *dev,
-						   struct audio_stream __sparse_cache *sink,
-						   const struct audio_stream
-						   __sparse_cache *source,
-						   struct mux_look_up *lookup)
-{
-	uint32_t frames;
-	uint32_t min_frames;
-	void *ptr;
-
-	/* for demux we process each source buffer separately - dest/src for
-	 * each copy_elem refers to the same sink/source buffer, so min_frames
-	 * calculation based only on lookup table first element is sufficient.
-	 */
-	ptr = (int32_t *)lookup->copy_elem[0].dest -
-		lookup->copy_elem[0].out_ch;
-	min_frames = audio_stream_frames_without_wrap(sink, ptr);
-
-	ptr = (int32_t *)lookup->copy_elem[0].src -
-		lookup->copy_elem[0].in_ch;
-	frames = audio_stream_frames_without_wrap(source, ptr);
-
-	min_frames = (frames < min_frames) ? frames : min_frames;
-
-	return min_frames;
-}
-
-static void mux_init_look_up_pointers_s32(struct comp_dev *dev,
-					  struct audio_stream __sparse_cache *sink,
-					  const struct audio_stream __sparse_cache **sources,
-					  struct mux_look_up *lookup)
-{
-	const struct audio_stream __sparse_cache *source;
-	uint32_t elem;
-
-	/* init pointers */
-	for (elem = 0; elem < lookup->num_elems; elem++) {
-		source = sources[lookup->copy_elem[elem].stream_id];
-
-		lookup->copy_elem[elem].src = (int32_t *)source->r_ptr +
-			lookup->copy_elem[elem].in_ch;
-		lookup->copy_elem[elem].src_inc = source->channels;
-
-		lookup->copy_elem[elem].dest = (int32_t *)sink->w_ptr +
-			lookup->copy_elem[elem].out_ch;
-		lookup->copy_elem[elem].dest_inc = sink->channels;
-	}
-}
-
-static void demux_init_look_up_pointers_s32(struct comp_dev *dev,
-					    struct audio_stream __sparse_cache *sink,
-					    const struct audio_stream __sparse_cache *source,
-					    struct mux_look_up *lookup)
-{
-	uint32_t elem;
-
-	/* init pointers */
-	for (elem = 0; elem < lookup->num_elems; elem++) {
-		lookup->copy_elem[elem].src = (int32_t *)source->r_ptr +
-			lookup->copy_elem[elem].in_ch;
-		lookup->copy_elem[elem].src_inc = source->channels;
-
-		lookup->copy_elem[elem].dest = (int32_t *)sink->w_ptr +
-			lookup->copy_elem[elem].out_ch;
-		lookup->copy_elem[elem].dest_inc = sink->channels;
-	}
-}
-
 /**
  * Source stream are routed to sinks with regard to look up table based on
- * routing bitmasks from mux_stream_data structures array. Each sink channel
- * has it's own lookup[].copy_elem describing source and sink fragment of
- * memory featured in copying.
+ * routing bitmasks from mux_stream_data structures array. The source is read
+ * through a channel view of the channels routed to the sink, each view
+ * channel is written to the out_ch of its copy_elem.
  *
  * @param[in] dev Component device
  * @param[in,out] sink Destination buffer.
- * @param[in,out] sources Array of source buffers.
+ * @param[in,out] source Buffer to split.
  * @param[in] frames Number of frames to process.
  * @param[in] lookup mux look up table.
  */
@@ -381,39 +243,40 @@ static void demux_s32le(struct comp_dev *dev, struct audio_stream __sparse_cache
 			const struct audio_stream __sparse_cache *source, uint32_t frames,
 			struct mux_look_up *lookup)
 {
-	uint32_t i;
-	int32_t *src;
+	struct audio_stream_view view;
+	const int32_t *src;
 	int32_t *dst;
+	uint32_t i;
 	uint32_t elem;
 	uint32_t frames_without_wrap;
 
-	comp_dbg(dev, "demux_s32le");
+	comp_dbg(dev, "demux_s32le()");
 
 	if (!lookup || !lookup->num_elems)
 		return;
 
-	demux_init_look_up_pointers_s32(dev, sink, source, lookup);
+	if (demux_init_view(dev, &view, source, lookup) < 0)
+		return;
 
-	while (frames) {
-		frames_without_wrap =
-			demux_calc_frames_without_wrap_s32(dev, sink, source,
-							   lookup);
+	src = source->r_ptr;
+	dst = sink->w_ptr;
 
-		frames_without_wrap = MIN(frames, frames_without_wrap);
+	while (frames) {
+		frames_without_wrap = MIN(frames, audio_stream_frames_without_wrap(sink, dst));
+		frames_without_wrap = MIN(frames_without_wrap,
+					  audio_stream_view_frames_without_wrap(&view, src));
 
 		for (i = 0; i < frames_without_wrap; i++) {
-			for (elem = 0; elem < lookup->num_elems; elem++) {
-				src = (int32_t *)lookup->copy_elem[elem].src;
-				dst = (int32_t *)lookup->copy_elem[elem].dest;
-				*dst = *src;
-				lookup->copy_elem[elem].src = src +
-					lookup->copy_elem[elem].src_inc;
-				lookup->copy_elem[elem].dest = dst +
-					lookup->copy_elem[elem].dest_inc;
-			}
+			for (elem = 0; elem < lookup->num_elems; elem++)
+				dst[lookup->copy_elem[elem].out_ch] =
+					audio_stream_view_read_s32(&view, src, elem);
+
+			src += view.stride;
+			dst += sink->channels;
 		}
 
-		demux_check_for_wrap(sink, source, lookup);
+		src = audio_stream_wrap(source, (void *)src);
+		dst = audio_stream_wrap(sink, dst);
 
 		frames -= frames_without_wrap;
 	}
@@ -421,9 +284,9 @@ static void demux_s32le(struct comp_dev *dev, struct audio_stream __sparse_cache
 
 /**
  * Source streams are routed to sink with regard to look up table based on
- * routing bitmasks from mux_stream_data structures array. Each sink channel
- * has it's own lookup[].copy_elem describing source and sink fragment of
- * memory featured in copying.
+ * routing bitmasks from mux_stream_data structures array. Each source is
+ * read through a channel view of the channels routed from it, each view
+ * channel is written to the out_ch of its copy_elem.
  *
  * @param[in] dev Component device
  * @param[in,out] sink Destination buffer.
@@ -435,10 +298,14 @@ static void mux_s32le(struct comp_dev *dev, struct audio_stream __sparse_cache *
 		      const struct audio_stream __sparse_cache **sources, uint32_t frames,
 		      struct mux_look_up *lookup)
 {
-	uint32_t i;
-	int32_t *src;
+	struct audio_stream_view views[MUX_MAX_STREAMS];
+	uint8_t view_ch[PLATFORM_MAX_CHANNELS];
+	const void *src[MUX_MAX_STREAMS] = { NULL };
+	const struct mux_copy_elem *copy_elem;
 	int32_t *dst;
+	uint32_t i;
 	uint32_t elem;
+	uint32_t stream;
 	uint32_t frames_without_wrap;
 
 	comp_dbg(dev, "mux_s32le()");
@@ -446,28 +313,39 @@ static void mux_s32le(struct comp_dev *dev, struct audio_stream __sparse_cache *
 	if (!lookup || !lookup->num_elems)
 		return;
 
-	mux_init_look_up_pointers_s32(dev, sink, sources, lookup);
+	if (mux_init_views(dev, views, view_ch, sources, lookup) < 0)
+		return;
+
+	for (stream = 0; stream < MUX_MAX_STREAMS; stream++)
+		if (views[stream].parent)
+			src[stream] = sources[stream]->r_ptr;
+	dst = sink->w_ptr;
 
 	while (frames) {
-		frames_without_wrap =
-			mux_calc_frames_without_wrap_s32(dev, sink, sources,
-							 lookup);
-
-		frames_without_wrap = MIN(frames, frames_without_wrap);
+		frames_without_wrap = mux_frames_without_wrap(sink, dst, views,
+							      src, frames);
 
 		for (i = 0; i < frames_without_wrap; i++) {
 			for (elem = 0; elem < lookup->num_elems; elem++) {
-				src = (int32_t *)lookup->copy_elem[elem].src;
-				dst = (int32_t *)lookup->copy_elem[elem].dest;
-				*dst = *src;
-				lookup->copy_elem[elem].src = src +
-					lookup->copy_elem[elem].src_inc;
-				lookup->copy_elem[elem].dest = dst +
-					lookup->copy_elem[elem].dest_inc;
+				copy_elem = &lookup->copy_elem[elem];
+				stream = copy_elem->stream_id;
+				dst[copy_elem->out_ch] =
+					audio_stream_view_read_s32(&views[stream], src[stream],
+								   view_ch[elem]);
 			}
+
+			for (stream = 0; stream < MUX_MAX_STREAMS; stream++)
+				if (views[stream].parent)
+					src[stream] = (const int32_t *)src[stream] +
+						views[stream].stride;
+			dst += sink->channels;
 		}
 
-		mux_check_for_wrap(sink, sources, lookup);
+		for (stream = 0; stream < MUX_MAX_STREAMS; stream++)
+			if (views[stream].parent)
+				src[stream] = audio_stream_wrap(sources[stream],
+								(void *)src[stream]);
+		dst = audio_stream_wrap(sink, dst);
 
 		frames -= frames_without_wrap;
 	}
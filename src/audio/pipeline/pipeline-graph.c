@@ -110,6 +110,9 @@ void pipeline_posn_init(struct sof *sof)
 struct pipeline *pipeline_new(uint32_t pipeline_id, uint32_t priority, uint32_t comp_id)
 {
 	struct sof_ipc_stream_posn posn;
+#if CONFIG_PIPELINE_SHED
+	struct sof_ipc_comp_event event;
+#endif
 	struct pipeline *p;
 	int ret;
 
@@ -132,6 +135,7 @@ struct pipeline *pipeline_new(uint32_t pipeline_id, uint32_t priority, uint32_t
 	p->pipeline_id = pipeline_id;
 	p->status = COMP_STATE_INIT;
 	p->trigger.cmd = COMP_TRIGGER_NO_ACTION;
+	p->xrun_limit_usecs = CONFIG_XRUN_CONCEAL_LIMIT_US;
 	ret = memcpy_s(&p->tctx, sizeof(struct tr_ctx), &pipe_tr,
 		       sizeof(struct tr_ctx));
 	assert(!ret);
@@ -156,6 +160,20 @@ struct pipeline *pipeline_new(uint32_t pipeline_id, uint32_t priority, uint32_t
 		}
 	}
 
+#if CONFIG_PIPELINE_SHED
+	ipc_build_comp_event(&event, SOF_COMP_NONE, p->comp_id);
+
+	if (event.rhdr.hdr.size) {
+		p->shed_msg = ipc_msg_init(event.rhdr.hdr.cmd, event.rhdr.hdr.size);
+		if (!p->shed_msg) {
+			pipe_err(p, "pipeline_new(): ipc_msg_init failed");
+			ipc_msg_free(p->msg);
+			rfree(p);
+			return NULL;
+		}
+	}
+#endif
+
 	return p;
 }
 
@@ -254,6 +272,9 @@ int pipeline_free(struct pipeline *p)
 	}
 
 	ipc_msg_free(p->msg);
+#if CONFIG_PIPELINE_SHED
+	ipc_msg_free(p->shed_msg);
+#endif
 
 	pipeline_posn_offset_put(p->posn_offset);
 
@@ -373,6 +394,8 @@ static int pipeline_comp_reset(struct comp_dev *current,
 	if (err < 0 || err == PPL_STATUS_PATH_STOP)
 		return err;
 
+	pipeline_latency_reset(current->pipeline);
+
 	return pipeline_for_each_comp(current, ctx, dir);
 }
 
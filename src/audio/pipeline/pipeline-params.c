@@ -8,11 +8,13 @@
 #include <sof/audio/buffer.h>
 #include <sof/audio/component_ext.h>
 #include <sof/audio/pipeline.h>
+#include <sof/lib/agent.h>
 #include <sof/lib/memory.h>
 #include <sof/lib/mm_heap.h>
 #include <sof/compiler_attributes.h>
 #include <sof/list.h>
 #include <sof/spinlock.h>
+#include <sof/string.h>
 #include <ipc/stream.h>
 #include <ipc/topology.h>
 #include <ipc4/error_status.h>
@@ -325,6 +327,10 @@ static int pipeline_comp_prepare(struct comp_dev *current,
 	if (err < 0 || err == PPL_STATUS_PATH_STOP)
 		return err;
 
+#if CONFIG_AGENT_BUDGET
+	sa_budget_comp_init(current);
+#endif
+
 	return pipeline_for_each_comp(current, ctx, dir);
 }
 
@@ -353,5 +359,12 @@ int pipeline_prepare(struct pipeline *p, struct comp_dev *dev)
 
 	p->status = COMP_STATE_PREPARE;
 
+	/* measure the latency of the new stream */
+	pipeline_latency_reset(p);
+
+#if CONFIG_AGENT_BUDGET
+	sa_budget_init(&p->budget, p->period);
+#endif
+
 	return ret;
 }
@@ -8,14 +8,19 @@
 #include <sof/audio/buffer.h>
 #include <sof/audio/component_ext.h>
 #include <sof/audio/pipeline.h>
+#include <sof/bit.h>
 #include <sof/drivers/interrupt.h>
+#include <sof/ipc/msg.h>
 #include <sof/lib/agent.h>
+#include <sof/lib/alloc.h>
 #include <sof/list.h>
+#include <sof/math/numbers.h>
 #include <sof/schedule/ll_schedule.h>
 #include <sof/schedule/schedule.h>
 #include <sof/schedule/task.h>
 #include <sof/spinlock.h>
 #include <sof/string.h>
+#include <ipc/control.h>
 #include <ipc/header.h>
 #include <ipc/stream.h>
 #include <ipc/topology.h>
@@ -294,6 +299,8 @@ void pipeline_schedule_triggered(struct pipeline_walk_context *ctx,
 		list_for_item(tlist, &ctx->pipelines) {
 			p = container_of(tlist, struct pipeline, list);
 			p->xrun_bytes = 0;
+			p->xrun_conceal_us = 0;
+			p->xrun_fade_in = false;
 			if (pipeline_is_timer_driven(p)) {
 				/*
 				 * Use the first of connected pipelines to
@@ -379,3 +386,382 @@ void pipeline_schedule_copy(struct pipeline *p, uint64_t start)
 	else
 		schedule_task(p->pipe_task, start, p->period);
 }
+
+struct pipeline_period_data {
+	struct pipeline *p;
+	struct comp_dev *start;
+	uint32_t period;
+	bool restore;		/* giving the old period back after a refusal */
+	struct list_item grown;	/* list of struct pipeline_period_buffer */
+};
+
+/* a buffer grown for the new period, shrunk back if the switch is refused */
+struct pipeline_period_buffer {
+	struct list_item list;
+	struct comp_buffer *buffer;
+	uint32_t size;		/* size before the switch */
+};
+
+/* gives the grown buffers their old size back, or keeps them on success */
+static void pipeline_period_buffers_put(struct pipeline_period_data *ppl_data, bool restore)
+{
+	struct pipeline_period_buffer *grown;
+	struct comp_buffer __sparse_cache *buffer_c;
+	struct list_item *clist;
+	struct list_item *tmp;
+
+	list_for_item_safe(clist, tmp, &ppl_data->grown) {
+		grown = container_of(clist, struct pipeline_period_buffer, list);
+
+		/* shrinking keeps the same memory, it can't fail */
+		if (restore) {
+			buffer_c = buffer_acquire(grown->buffer);
+			buffer_set_size(buffer_c, grown->size);
+			buffer_release(buffer_c);
+		}
+
+		list_item_del(&grown->list);
+		rfree(grown);
+	}
+}
+
+static int pipeline_period_buffer_grow(struct pipeline_period_data *ppl_data,
+				       struct comp_buffer *buffer,
+				       struct comp_buffer __sparse_cache *buffer_c, uint32_t size)
+{
+	struct pipeline_period_buffer *grown;
+	int ret;
+
+	grown = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, sizeof(*grown));
+	if (!grown)
+		return -ENOMEM;
+
+	grown->buffer = buffer;
+	grown->size = buffer_c->stream.size;
+
+	ret = buffer_set_size(buffer_c, size);
+	if (ret < 0) {
+		rfree(grown);
+		return ret;
+	}
+
+	list_item_append(&grown->list, &ppl_data->grown);
+
+	return 0;
+}
+
+/* grows the empty sink buffers of a component to hold as many new periods as old ones */
+static int pipeline_period_buffers(struct comp_dev *current, uint32_t old_frames,
+				   struct pipeline_period_data *ppl_data)
+{
+	struct comp_buffer __sparse_cache *buffer_c;
+	struct comp_buffer *buffer;
+	struct list_item *clist;
+	uint32_t old_bytes;
+	uint32_t new_bytes;
+	uint32_t size;
+	int ret = 0;
+
+	list_for_item(clist, &current->bsink_list) {
+		buffer = container_of(clist, struct comp_buffer, source_list);
+		buffer_c = buffer_acquire(buffer);
+
+		old_bytes = audio_stream_period_bytes(&buffer_c->stream, old_frames);
+		new_bytes = audio_stream_period_bytes(&buffer_c->stream, current->frames);
+		size = old_bytes ? new_bytes * MAX(buffer_c->stream.size / old_bytes, 1) :
+			new_bytes;
+
+		if (size > buffer_c->stream.size) {
+			/*
+			 * resizing drops the content, so only empty buffers can
+			 * grow, and only if no other running pipeline reads them
+			 */
+			if (audio_stream_get_avail_bytes(&buffer_c->stream) ||
+			    (buffer_c->sink && buffer_c->sink->pipeline != current->pipeline))
+				ret = -EBUSY;
+			else
+				ret = pipeline_period_buffer_grow(ppl_data, buffer, buffer_c, size);
+		}
+
+		buffer_release(buffer_c);
+
+		if (ret < 0) {
+			comp_err(current, "pipeline_period_buffers(): buffer %u can't hold %u bytes, err %d",
+				 buffer->id, size, ret);
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static int pipeline_comp_period(struct comp_dev *current,
+				struct comp_buffer *calling_buf,
+				struct pipeline_walk_context *ctx, int dir)
+{
+	struct pipeline_period_data *ppl_data = ctx->comp_data;
+	struct comp_buffer __sparse_cache *buffer_c;
+	struct comp_buffer *buffer;
+	uint32_t old_period = current->period;
+	uint32_t old_frames = current->frames;
+	uint32_t rate;
+	int ret;
+
+	if (!comp_is_single_pipeline(current, ppl_data->start))
+		return 0;
+
+	/* not reached by a refused switch, or the one that refused it */
+	if (current->period == ppl_data->period)
+		return pipeline_for_each_comp(current, ctx, dir);
+
+	/* frames follow the output rate, like in params */
+	if (!list_is_empty(&current->bsink_list))
+		buffer = list_first_item(&current->bsink_list, struct comp_buffer, source_list);
+	else if (!list_is_empty(&current->bsource_list))
+		buffer = list_first_item(&current->bsource_list, struct comp_buffer, sink_list);
+	else
+		buffer = NULL;
+
+	current->period = ppl_data->period;
+	if (buffer) {
+		buffer_c = buffer_acquire(buffer);
+		rate = buffer_c->stream.rate;
+		buffer_release(buffer_c);
+		component_set_nearest_period_frames(current, rate);
+	}
+
+	/* the grown buffers get their old size back once the walk is done */
+	if (ppl_data->restore) {
+		comp_set_attribute(current, COMP_ATTR_PERIOD, &ppl_data->period);
+#if CONFIG_AGENT_BUDGET
+		sa_budget_comp_period(current, old_period);
+#endif
+		return pipeline_for_each_comp(current, ctx, dir);
+	}
+
+	ret = pipeline_period_buffers(current, old_frames, ppl_data);
+	if (ret < 0)
+		goto err;
+
+	/* components opt in, by set_attribute() or by the driver flag */
+	if (current->drv->ops.set_attribute)
+		ret = comp_set_attribute(current, COMP_ATTR_PERIOD, &ppl_data->period);
+	else
+		ret = current->drv->any_period ? 0 : -EINVAL;
+	if (ret < 0) {
+		comp_err(current, "pipeline_comp_period(): period %u us refused, err %d",
+			 ppl_data->period, ret);
+		goto err;
+	}
+
+#if CONFIG_AGENT_BUDGET
+	sa_budget_comp_period(current, old_period);
+#endif
+
+	return pipeline_for_each_comp(current, ctx, dir);
+
+err:
+	current->period = old_period;
+	current->frames = old_frames;
+	return ret;
+}
+
+int pipeline_set_period(struct pipeline *p, uint32_t period)
+{
+	struct pipeline_period_data data = {
+		.p = p,
+		.start = p->source_comp,
+		.period = period,
+	};
+	struct pipeline_walk_context walk_ctx = {
+		.comp_func = pipeline_comp_period,
+		.comp_data = &data,
+		.skip_incomplete = true,
+	};
+	uint32_t flags;
+	bool active;
+	int ret;
+
+	list_init(&data.grown);
+
+	pipe_info(p, "pipeline_set_period(), period %u us -> %u us", p->period, period);
+
+	/* DMA driven pipelines follow the period of their DMA */
+	if (!period || !p->source_comp || !pipeline_is_timer_driven(p)) {
+		pipe_err(p, "pipeline_set_period(): period %u us can't be set", period);
+		return -EINVAL;
+	}
+
+	if (period == p->period)
+		return 0;
+
+	/* pause the task between two pipeline runs */
+	irq_local_disable(flags);
+	active = p->pipe_task && task_is_active(p->pipe_task);
+	if (active)
+		schedule_task_cancel(p->pipe_task);
+	irq_local_enable(flags);
+
+	/* the components and buffers are updated while no copy runs */
+	ret = walk_ctx.comp_func(p->source_comp, NULL, &walk_ctx, PPL_DIR_DOWNSTREAM);
+	if (ret < 0) {
+		/* give all the components the old period back */
+		data.period = p->period;
+		data.restore = true;
+		walk_ctx.comp_func(p->source_comp, NULL, &walk_ctx, PPL_DIR_DOWNSTREAM);
+		period = p->period;
+	}
+
+	pipeline_period_buffers_put(&data, ret < 0);
+
+	irq_local_disable(flags);
+
+	p->period = period;
+#if CONFIG_AGENT_BUDGET
+	sa_budget_init(&p->budget, period);
+#endif
+
+	/* resume the task with the new period */
+	if (active)
+		pipeline_schedule_copy(p, 0);
+
+	irq_local_enable(flags);
+
+	return ret;
+}
+
+#if CONFIG_PIPELINE_SHED
+struct pipeline_shed_data {
+	struct comp_dev *start;
+	bool shed;		/* shed, or restore */
+	uint32_t tier;		/* tier to shed or restore, COMP_SHED_NONE to look */
+	uint32_t tiers;		/* other tiers that can be shed or restored */
+	uint32_t count;		/* components running their fallback */
+};
+
+static int pipeline_comp_shed(struct comp_dev *current,
+			      struct comp_buffer *calling_buf,
+			      struct pipeline_walk_context *ctx, int dir)
+{
+	struct pipeline_shed_data *ppl_data = ctx->comp_data;
+	uint32_t tier = current->drv->shed_tier;
+	bool candidate;
+	int ret;
+
+	if (!comp_is_single_pipeline(current, ppl_data->start))
+		return 0;
+
+	candidate = ppl_data->shed ? !current->shed && comp_can_shed(current) :
+		current->shed;
+
+	if (candidate && tier == ppl_data->tier) {
+		ret = comp_shed(current, ppl_data->shed);
+		if (ret < 0)
+			comp_warn(current, "pipeline_comp_shed(): shed %d failed, err %d",
+				  ppl_data->shed, ret);
+	} else if (candidate) {
+		ppl_data->tiers |= BIT(tier);
+	}
+
+	if (current->shed)
+		ppl_data->count++;
+
+	return pipeline_for_each_comp(current, ctx, dir);
+}
+
+static void pipeline_shed_walk(struct pipeline *p, struct pipeline_shed_data *data)
+{
+	struct pipeline_walk_context walk_ctx = {
+		.comp_func = pipeline_comp_shed,
+		.comp_data = data,
+		.skip_incomplete = true,
+	};
+
+	data->start = p->source_comp;
+	data->tiers = 0;
+	data->count = 0;
+
+	walk_ctx.comp_func(p->source_comp, NULL, &walk_ctx, PPL_DIR_DOWNSTREAM);
+}
+
+/*
+ * order of the tiers of all pipelines, the lowest is shed first: the
+ * lowest priority pipelines, i.e. the highest SOF_TASK_PRI_ values, and
+ * their highest tiers go first
+ */
+static uint32_t pipeline_shed_key(struct pipeline *p, uint32_t tier)
+{
+	uint32_t priority = MIN(p->priority, SOF_TASK_PRI_LOW);
+
+	return (SOF_TASK_PRI_LOW - priority) * COMP_SHED_TIERS + COMP_SHED_TIERS - 1 - tier;
+}
+
+/* pipeline of a LL task, NULL for the tasks of other clients */
+static struct pipeline *pipeline_shed_task(struct list_item *tlist)
+{
+	struct task *task = container_of(tlist, struct task, list);
+
+	return task->uid == SOF_UUID(pipe_task_uuid) ? task->data : NULL;
+}
+
+static void pipeline_shed_notify(struct pipeline *p, uint32_t count)
+{
+	struct sof_ipc_comp_event event;
+
+	if (!p->shed_msg)
+		return;
+
+	ipc_build_comp_event(&event, SOF_COMP_NONE, p->comp_id);
+	event.event_type = SOF_CTRL_EVENT_SHED;
+	event.num_elems = 0;
+	event.event_value = count;
+
+	ipc_msg_send(p->shed_msg, &event, false);
+}
+
+bool pipeline_shed(struct list_item *tasks, bool shed)
+{
+	struct pipeline_shed_data data = { .shed = shed };
+	struct pipeline *next = NULL;
+	struct list_item *tlist;
+	struct pipeline *p;
+	uint32_t next_tier = COMP_SHED_NONE;
+	uint32_t next_key = 0;
+	uint32_t tier;
+	uint32_t key;
+
+	/* look for the tier of a pipeline to shed or restore first */
+	list_for_item(tlist, tasks) {
+		p = pipeline_shed_task(tlist);
+		if (!p || !p->source_comp || p->status != COMP_STATE_ACTIVE)
+			continue;
+
+		pipeline_shed_walk(p, &data);
+
+		for (tier = COMP_SHED_NONE + 1; tier < COMP_SHED_TIERS; tier++) {
+			if (!(data.tiers & BIT(tier)))
+				continue;
+
+			key = pipeline_shed_key(p, tier);
+			if (!next || (shed ? key < next_key : key > next_key)) {
+				next = p;
+				next_tier = tier;
+				next_key = key;
+			}
+		}
+	}
+
+	if (!next)
+		return false;
+
+	data.tier = next_tier;
+	pipeline_shed_walk(next, &data);
+
+	pipe_warn(next, "pipeline_shed(), shed %d tier %u, %u components on fallback",
+		  shed, next_tier, data.count);
+
+	pipeline_shed_notify(next, data.count);
+
+	return true;
+}
+#endif
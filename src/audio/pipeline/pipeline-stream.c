@@ -5,9 +5,12 @@
 // Author: Liam Girdwood <liam.r.girdwood@linux.intel.com>
 //         Keyon Jie <yang.jie@linux.intel.com>
 
+#include <sof/audio/audio_stream.h>
 #include <sof/audio/buffer.h>
 #include <sof/audio/component_ext.h>
 #include <sof/audio/pipeline.h>
+#include <sof/drivers/timer.h>
+#include <sof/lib/agent.h>
 #include <sof/lib/dai.h>
 #include <sof/lib/wait.h>
 #include <sof/list.h>
@@ -70,6 +73,190 @@ pipeline_should_report_enodata_on_trigger(struct comp_dev *rsrc,
 	return false;
 }
 
+#if CONFIG_PIPELINE_LATENCY
+static uint64_t pipeline_latency_now(struct pipeline *p)
+{
+#if CONFIG_LIBRARY
+	/* the testbench doesn't run in real time, count pipeline periods */
+	return p->copy_count * p->period;
+#else
+	return k_cyc_to_us_near64(sof_cycle_get_64());
+#endif
+}
+
+static void pipeline_latency_update(struct pipeline *p, uint64_t stamp)
+{
+	struct pipeline_latency *lat = &p->latency;
+	uint64_t now = pipeline_latency_now(p);
+	uint32_t us = now > stamp ? now - stamp : 0;
+
+	if (!lat->count || us < lat->min_us)
+		lat->min_us = us;
+	lat->max_us = MAX(lat->max_us, us);
+	lat->total_us += us;
+	lat->count++;
+}
+
+/* notes the fill level of the buffers and returns true if a source is tagged */
+static bool pipeline_latency_pre_copy(struct comp_dev *current)
+{
+	struct comp_buffer __sparse_cache *buffer_c;
+	struct comp_buffer *buffer;
+	struct list_item *clist;
+	bool tagged = list_is_empty(&current->bsource_list);
+
+	list_for_item(clist, &current->bsource_list) {
+		buffer = container_of(clist, struct comp_buffer, sink_list);
+		buffer_c = buffer_acquire(buffer);
+		if (buffer_c->tag.valid) {
+			buffer_c->tag.avail = audio_stream_get_avail_bytes(&buffer_c->stream);
+			tagged = true;
+		}
+		buffer_release(buffer_c);
+	}
+
+	if (!tagged)
+		return false;
+
+	list_for_item(clist, &current->bsink_list) {
+		buffer = container_of(clist, struct comp_buffer, source_list);
+		buffer_c = buffer_acquire(buffer);
+		buffer_c->tag.avail = audio_stream_get_avail_bytes(&buffer_c->stream);
+		buffer_release(buffer_c);
+	}
+
+	return true;
+}
+
+/*
+ * Moves the tag to the sinks when the copy consumed the tagged frame.
+ * The first frame the copy produced takes over the tag, a sink that
+ * still carries an older tag keeps it. Endpoints without sources tag
+ * the first frame they produce, endpoints without sinks measure the
+ * latency.
+ */
+static void pipeline_latency_post_copy(struct comp_dev *current)
+{
+	struct comp_buffer __sparse_cache *buffer_c;
+	struct comp_buffer *buffer;
+	struct list_item *clist;
+	uint32_t consumed;
+	uint32_t avail;
+	uint64_t stamp = 0;
+	bool endpoint = list_is_empty(&current->bsource_list);
+	bool found = false;
+
+	if (endpoint) {
+		stamp = pipeline_latency_now(current->pipeline);
+		found = true;
+	}
+
+	list_for_item(clist, &current->bsource_list) {
+		buffer = container_of(clist, struct comp_buffer, sink_list);
+		buffer_c = buffer_acquire(buffer);
+		if (buffer_c->tag.valid) {
+			avail = audio_stream_get_avail_bytes(&buffer_c->stream);
+			consumed = buffer_c->tag.avail > avail ? buffer_c->tag.avail - avail : 0;
+			if (consumed > buffer_c->tag.offset) {
+				buffer_c->tag.valid = false;
+				/* the oldest tag wins when several sources have one */
+				if (!found || buffer_c->tag.stamp < stamp)
+					stamp = buffer_c->tag.stamp;
+				found = true;
+			} else {
+				buffer_c->tag.offset -= consumed;
+			}
+		}
+		buffer_release(buffer_c);
+	}
+
+	if (!found)
+		return;
+
+	if (list_is_empty(&current->bsink_list)) {
+		pipeline_latency_update(current->pipeline, stamp);
+		return;
+	}
+
+	list_for_item(clist, &current->bsink_list) {
+		buffer = container_of(clist, struct comp_buffer, source_list);
+		buffer_c = buffer_acquire(buffer);
+		avail = audio_stream_get_avail_bytes(&buffer_c->stream);
+		if (!buffer_c->tag.valid && (!endpoint || avail > buffer_c->tag.avail)) {
+			buffer_c->tag.stamp = stamp;
+			buffer_c->tag.offset = buffer_c->tag.avail;
+			buffer_c->tag.valid = true;
+		}
+		buffer_release(buffer_c);
+	}
+}
+
+void pipeline_latency_reset(struct pipeline *p)
+{
+	p->copy_count = 0;
+	memset(&p->latency, 0, sizeof(p->latency));
+}
+
+/* frames tagged before a stop carry stamps of the old time base */
+static void pipeline_latency_start(struct comp_dev *current)
+{
+	struct comp_buffer __sparse_cache *buffer_c;
+	struct comp_buffer *buffer;
+	struct list_item *clist;
+
+	pipeline_latency_reset(current->pipeline);
+
+	list_for_item(clist, &current->bsink_list) {
+		buffer = container_of(clist, struct comp_buffer, source_list);
+		buffer_c = buffer_acquire(buffer);
+		buffer_c->tag.valid = false;
+		buffer_release(buffer_c);
+	}
+}
+
+static int pipeline_latency_copy(struct comp_dev *current)
+{
+	int ret;
+
+	if (!pipeline_latency_pre_copy(current))
+		return comp_copy(current);
+
+	ret = comp_copy(current);
+	if (ret >= 0)
+		pipeline_latency_post_copy(current);
+
+	return ret;
+}
+#else
+static inline void pipeline_latency_start(struct comp_dev *current) { }
+
+static inline int pipeline_latency_copy(struct comp_dev *current)
+{
+	return comp_copy(current);
+}
+#endif
+
+/* copies a component, bypassed or not, and measures the copy */
+static int pipeline_comp_run(struct comp_dev *current)
+{
+#if CONFIG_AGENT_BUDGET
+	uint32_t cycles = (uint32_t)sof_cycle_get_64();
+#endif
+	int ret;
+
+	/* shed components without their own fallback are bypassed */
+	if (current->bypass || (current->shed && !current->drv->ops.shed))
+		ret = comp_copy_bypass(current);
+	else
+		ret = pipeline_latency_copy(current);
+
+#if CONFIG_AGENT_BUDGET
+	sa_budget_comp(current, (uint32_t)sof_cycle_get_64() - cycles);
+#endif
+
+	return ret;
+}
+
 static int pipeline_comp_copy(struct comp_dev *current,
 			      struct comp_buffer *calling_buf,
 			      struct pipeline_walk_context *ctx, int dir)
@@ -94,7 +281,7 @@ static int pipeline_comp_copy(struct comp_dev *current,
 
 	/* copy to downstream immediately */
 	if (dir == PPL_DIR_DOWNSTREAM) {
-		err = comp_copy(current);
+		err = pipeline_comp_run(current);
 		if (err < 0 || err == PPL_STATUS_PATH_STOP)
 			return err;
 	}
@@ -104,7 +291,7 @@ static int pipeline_comp_copy(struct comp_dev *current,
 		return err;
 
 	if (dir == PPL_DIR_UPSTREAM)
-		err = comp_copy(current);
+		err = pipeline_comp_run(current);
 
 	return err;
 }
@@ -123,6 +310,9 @@ int pipeline_copy(struct pipeline *p)
 		.skip_incomplete = true,
 	};
 	struct comp_dev *start;
+#if CONFIG_AGENT_BUDGET
+	uint32_t cycles = (uint32_t)sof_cycle_get_64();
+#endif
 	uint32_t dir;
 	int ret;
 
@@ -137,11 +327,19 @@ int pipeline_copy(struct pipeline *p)
 	data.start = start;
 	data.p = p;
 
+#if CONFIG_PIPELINE_LATENCY
+	p->copy_count++;
+#endif
+
 	ret = walk_ctx.comp_func(start, NULL, &walk_ctx, dir);
 	if (ret < 0)
 		pipe_err(p, "pipeline_copy(): ret = %d, start->comp.id = %u, dir = %u",
 			 ret, dev_comp_id(start), dir);
 
+#if CONFIG_AGENT_BUDGET
+	sa_budget_pipeline(p, (uint32_t)sof_cycle_get_64() - cycles);
+#endif
+
 	return ret;
 }
 
@@ -364,6 +562,11 @@ static int pipeline_comp_trigger(struct comp_dev *current,
 	case COMP_TRIGGER_STOP:
 		if (pipeline_is_timer_driven(current->pipeline))
 			current->pipeline->status = COMP_STATE_PAUSED;
+		break;
+	case COMP_TRIGGER_START:
+		/* a restart after stop measures the new stream only */
+		pipeline_latency_start(current);
+		break;
 	}
 
 	/*
@@ -482,3 +685,18 @@ void pipeline_get_timestamp(struct pipeline *p, struct comp_dev *host,
 	/* set timestamp resolution */
 	posn->timestamp_ns = p->period * 1000;
 }
+
+void pipeline_get_latency(struct pipeline *p, struct sof_ipc_stream_latency *latency)
+{
+#if CONFIG_PIPELINE_LATENCY
+	latency->count = p->latency.count;
+	latency->min_us = p->latency.min_us;
+	latency->max_us = p->latency.max_us;
+	latency->avg_us = p->latency.count ? p->latency.total_us / p->latency.count : 0;
+#else
+	latency->count = 0;
+	latency->min_us = 0;
+	latency->max_us = 0;
+	latency->avg_us = 0;
+#endif
+}
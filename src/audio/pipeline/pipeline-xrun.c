@@ -5,11 +5,14 @@
 // Author: Liam Girdwood <liam.r.girdwood@linux.intel.com>
 //         Keyon Jie <yang.jie@linux.intel.com>
 
+#include <sof/audio/audio_stream.h>
 #include <sof/audio/buffer.h>
 #include <sof/audio/component_ext.h>
+#include <sof/audio/format.h>
 #include <sof/audio/pipeline.h>
 #include <sof/ipc/msg.h>
 #include <sof/list.h>
+#include <sof/math/numbers.h>
 #include <sof/spinlock.h>
 #include <sof/string.h>
 #include <ipc/header.h>
@@ -94,6 +97,191 @@ int pipeline_xrun_set_limit(struct pipeline *p, uint32_t xrun_limit_usecs)
 	return 0;
 }
 
+/* adds frames to the xrun being concealed, if the limit allows it */
+static int pipeline_xrun_conceal_add(struct pipeline *p, struct comp_dev *dev,
+				     uint32_t frames, uint32_t rate)
+{
+	uint32_t us = rate ? ((uint64_t)frames * 1000000 + rate - 1) / rate : 0;
+
+	if (!us || p->xrun_conceal_us + us > p->xrun_limit_usecs) {
+		comp_err(dev, "pipeline_xrun_conceal_add(): xrun of %u us over %u us limit",
+			 p->xrun_conceal_us + us, p->xrun_limit_usecs);
+		p->xrun_conceal_us = 0;
+		p->xrun_fade_in = false;
+		return -EPIPE;
+	}
+
+	p->xrun_conceal_us += us;
+
+	return 0;
+}
+
+/* applies the Q1.15 gain to the sample at idx from the read pointer */
+static void pipeline_xrun_gain(struct audio_stream __sparse_cache *stream, uint32_t idx,
+			       int32_t gain)
+{
+	uint8_t *x8;
+	int16_t *x16;
+	int32_t *x32;
+	int32_t x;
+
+	switch (stream->frame_fmt) {
+	case SOF_IPC_FRAME_S16_LE:
+		x16 = audio_stream_read_frag_s16(stream, idx);
+		*x16 = (*x16 * gain) >> 15;
+		break;
+	case SOF_IPC_FRAME_S24_4LE:
+		x32 = audio_stream_read_frag_s32(stream, idx);
+		*x32 = (sign_extend_s24(*x32) * (int64_t)gain) >> 15;
+		break;
+	case SOF_IPC_FRAME_S32_LE:
+		x32 = audio_stream_read_frag_s32(stream, idx);
+		*x32 = ((int64_t)*x32 * gain) >> 15;
+		break;
+	case SOF_IPC_FRAME_S24_3LE:
+		/* packed, the samples don't cross the end of the buffer */
+		x8 = audio_stream_read_frag(stream, idx, 3);
+		x = sign_extend_s24(x8[0] | x8[1] << 8 | x8[2] << 16);
+		x = ((int64_t)x * gain) >> 15;
+		x8[0] = x;
+		x8[1] = x >> 8;
+		x8[2] = x >> 16;
+		break;
+	default:
+		/* other formats are not ramped, the gap is still silent */
+		break;
+	}
+}
+
+/* applies a linear ramp to frames [first, first + frames) from the read pointer */
+static void pipeline_xrun_ramp(struct audio_stream __sparse_cache *stream,
+			       uint32_t first, uint32_t frames, bool fade_in)
+{
+	int32_t gain;
+	int channels = stream->channels;
+	int idx;
+	int ch;
+	int i;
+
+	for (i = 0; i < frames; i++) {
+		/* Q1.15 gain, zero at the silent end of the ramp */
+		gain = fade_in ? (i << 15) / frames : ((frames - 1 - i) << 15) / frames;
+		idx = (first + i) * channels;
+		for (ch = 0; ch < channels; ch++)
+			pipeline_xrun_gain(stream, idx + ch, gain);
+	}
+}
+
+/* the ramps around a concealed underrun are 1 ms long */
+static uint32_t pipeline_xrun_ramp_frames(const struct audio_stream __sparse_cache *stream,
+					  uint32_t avail)
+{
+	return MIN(MAX(stream->rate / 1000, 1), avail);
+}
+
+int pipeline_xrun_conceal_underrun(struct pipeline *p, struct comp_dev *dev,
+				   struct comp_buffer __sparse_cache *source,
+				   uint32_t frames)
+{
+	struct audio_stream __sparse_cache *stream = &source->stream;
+	uint32_t avail = audio_stream_get_avail_frames(stream);
+	uint32_t ramp;
+	int ret;
+
+	frames = MIN(frames, audio_stream_get_free_frames(stream));
+
+	ret = pipeline_xrun_conceal_add(p, dev, frames, stream->rate);
+	if (ret < 0)
+		return ret;
+
+	/* fade out the last frames before the gap */
+	if (!p->xrun_fade_in && avail) {
+		ramp = pipeline_xrun_ramp_frames(stream, avail);
+		pipeline_xrun_ramp(stream, avail - ramp, ramp, false);
+	}
+
+	audio_stream_set_zero(stream, frames * audio_stream_frame_bytes(stream));
+	comp_update_buffer_produce(source, frames * audio_stream_frame_bytes(stream));
+	p->xrun_fade_in = true;
+
+	return 0;
+}
+
+int pipeline_xrun_drop_overrun(struct pipeline *p, struct comp_dev *dev,
+			       struct comp_buffer __sparse_cache *sink,
+			       uint32_t frames)
+{
+	struct audio_stream __sparse_cache *stream = &sink->stream;
+	int ret;
+
+	frames = MIN(frames, audio_stream_get_avail_frames(stream));
+
+	ret = pipeline_xrun_conceal_add(p, dev, frames, stream->rate);
+	if (ret < 0)
+		return ret;
+
+	comp_update_buffer_consume(sink, frames * audio_stream_frame_bytes(stream));
+
+	return 0;
+}
+
+void pipeline_xrun_conceal_end(struct pipeline *p, struct comp_dev *dev,
+			       struct comp_buffer __sparse_cache *buffer)
+{
+	struct audio_stream __sparse_cache *stream = &buffer->stream;
+	uint32_t avail;
+
+	if (!p->xrun_conceal_us)
+		return;
+
+	/* fade in the first frames after the gap, once they arrive */
+	if (p->xrun_fade_in) {
+		avail = audio_stream_get_avail_frames(stream);
+		if (!avail)
+			return;
+
+		pipeline_xrun_ramp(stream, 0, pipeline_xrun_ramp_frames(stream, avail), true);
+		p->xrun_fade_in = false;
+	}
+
+	p->xrun_concealed++;
+	comp_info(dev, "pipeline_xrun_conceal_end(): %u us concealed, xruns concealed %u reported %u",
+		  p->xrun_conceal_us, p->xrun_concealed, p->xrun_reported);
+	p->xrun_conceal_us = 0;
+}
+
+/*
+ * The DMA runs dry on playback, or overflows on capture, before the next
+ * copy when it has less than a period of data, or space, left.
+ */
+int pipeline_xrun_conceal(struct pipeline *p, struct comp_dev *dev,
+			  struct comp_buffer __sparse_cache *buffer,
+			  uint32_t dma_bytes, uint32_t period_bytes,
+			  uint32_t dma_frame_bytes)
+{
+	uint32_t frames;
+	uint32_t local;
+
+	if (!p->xrun_limit_usecs)
+		return 0;
+
+	frames = dma_bytes < period_bytes ? (period_bytes - dma_bytes) / dma_frame_bytes : 0;
+
+	if (dev->direction == SOF_IPC_STREAM_PLAYBACK) {
+		local = audio_stream_get_avail_frames(&buffer->stream);
+		if (local < frames)
+			return pipeline_xrun_conceal_underrun(p, dev, buffer, frames - local);
+	} else {
+		local = audio_stream_get_free_frames(&buffer->stream);
+		if (local < frames)
+			return pipeline_xrun_drop_overrun(p, dev, buffer, frames - local);
+	}
+
+	pipeline_xrun_conceal_end(p, dev, buffer);
+
+	return 0;
+}
+
 /*
  * trigger handler for pipelines in xrun, used for recovery from host only.
  * return values:
@@ -155,6 +343,8 @@ void pipeline_xrun(struct pipeline *p, struct comp_dev *dev,
 	if (dev->state != COMP_STATE_ACTIVE)
 		return;
 
+	p->xrun_reported++;
+
 	/* notify all pipeline comps we are in XRUN, and stop copying */
 	ret = pipeline_trigger(p, p->source_comp, COMP_TRIGGER_XRUN);
 	if (ret < 0)
@@ -701,6 +701,7 @@ static int rtnr_reset(struct comp_dev *dev)
 static const struct comp_driver comp_rtnr = {
 	.uid = SOF_RT_UUID(rtnr_uuid),
 	.tctx = &rtnr_tr,
+	.shed_tier = COMP_SHED_QUALITY,
 	.ops = {
 		.create = rtnr_new,
 		.free = rtnr_free,
@@ -544,6 +544,7 @@ static const struct comp_driver comp_selector = {
 	.type	= SOF_COMP_SELECTOR,
 	.uid	= SOF_RT_UUID(selector_uuid),
 	.tctx	= &selector_tr,
+	.any_period	= true,
 	.ops	= {
 		.create		= selector_new,
 		.free		= selector_free,
@@ -167,7 +167,131 @@ static void sel_s32le_nch(struct comp_dev *dev, struct audio_stream __sparse_cac
 }
 #endif /* CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE */
 
+/*
+ * Single channel extraction from the common source channels counts. The
+ * core is always inlined with a constant channels count, so the source
+ * stride is known at compile time.
+ */
+#define SEL_NCH_FUNC(fmt, nch) \
+static void sel_##fmt##_1ch_##nch##ch(struct comp_dev *dev, \
+				      struct audio_stream __sparse_cache *sink, \
+				      const struct audio_stream __sparse_cache *source, \
+				      uint32_t frames) \
+{ \
+	sel_##fmt##_1ch_nch(dev, sink, source, frames, nch); \
+}
+
+#if CONFIG_FORMAT_S16LE
+/**
+ * \brief Channel selection for 16 bit, 1 channel data format, for a
+ *	  constant number of source channels.
+ * \param[in,out] dev Selector base component device.
+ * \param[in,out] sink Destination buffer.
+ * \param[in,out] source Buffer to select from.
+ * \param[in] frames Number of frames to process.
+ * \param[in] nch Number of source channels.
+ */
+static __always_inline void sel_s16le_1ch_nch(struct comp_dev *dev,
+					      struct audio_stream __sparse_cache *sink,
+					      const struct audio_stream __sparse_cache *source,
+					      uint32_t frames, const unsigned int nch)
+{
+	struct comp_data *cd = comp_get_drvdata(dev);
+	int16_t *src = source->r_ptr;
+	int16_t *dest = sink->w_ptr;
+	int16_t *src_ch;
+	int nmax;
+	int i;
+	int n;
+	int processed = 0;
+	const unsigned int sel_channel = cd->config.sel_channel; /* 0 to nch - 1 */
+
+	while (processed < frames) {
+		n = frames - processed;
+		nmax = audio_stream_bytes_without_wrap(source, src) / (nch * sizeof(int16_t));
+		n = MIN(n, nmax);
+		nmax = audio_stream_bytes_without_wrap(sink, dest) >> BYTES_TO_S16_SAMPLES;
+		n = MIN(n, nmax);
+		src_ch = src + sel_channel;
+		for (i = 0; i < n; i++) {
+			dest[i] = *src_ch;
+			src_ch += nch;
+		}
+		src = audio_stream_wrap(source, src + nch * n);
+		dest = audio_stream_wrap(sink, dest + n);
+		processed += n;
+	}
+}
+
+SEL_NCH_FUNC(s16le, 2)
+SEL_NCH_FUNC(s16le, 4)
+SEL_NCH_FUNC(s16le, 8)
+#endif /* CONFIG_FORMAT_S16LE */
+
+#if CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
+/**
+ * \brief Channel selection for 32 bit, 1 channel data format, for a
+ *	  constant number of source channels.
+ * \param[in,out] dev Selector base component device.
+ * \param[in,out] sink Destination buffer.
+ * \param[in,out] source Buffer to select from.
+ * \param[in] frames Number of frames to process.
+ * \param[in] nch Number of source channels.
+ */
+static __always_inline void sel_s32le_1ch_nch(struct comp_dev *dev,
+					      struct audio_stream __sparse_cache *sink,
+					      const struct audio_stream __sparse_cache *source,
+					      uint32_t frames, const unsigned int nch)
+{
+	struct comp_data *cd = comp_get_drvdata(dev);
+	int32_t *src = source->r_ptr;
+	int32_t *dest = sink->w_ptr;
+	int32_t *src_ch;
+	int nmax;
+	int i;
+	int n;
+	int processed = 0;
+	const unsigned int sel_channel = cd->config.sel_channel; /* 0 to nch - 1 */
+
+	while (processed < frames) {
+		n = frames - processed;
+		nmax = audio_stream_bytes_without_wrap(source, src) / (nch * sizeof(int32_t));
+		n = MIN(n, nmax);
+		nmax = audio_stream_bytes_without_wrap(sink, dest) >> BYTES_TO_S32_SAMPLES;
+		n = MIN(n, nmax);
+		src_ch = src + sel_channel;
+		for (i = 0; i < n; i++) {
+			dest[i] = *src_ch;
+			src_ch += nch;
+		}
+		src = audio_stream_wrap(source, src + nch * n);
+		dest = audio_stream_wrap(sink, dest + n);
+		processed += n;
+	}
+}
+
+SEL_NCH_FUNC(s32le, 2)
+SEL_NCH_FUNC(s32le, 4)
+SEL_NCH_FUNC(s32le, 8)
+#endif /* CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE */
+
 const struct comp_func_map func_table[] = {
+/* The source channels specific variants need to be before the generic ones */
+#if CONFIG_FORMAT_S16LE
+	{SOF_IPC_FRAME_S16_LE, 1, sel_s16le_1ch_2ch, 2},
+	{SOF_IPC_FRAME_S16_LE, 1, sel_s16le_1ch_4ch, 4},
+	{SOF_IPC_FRAME_S16_LE, 1, sel_s16le_1ch_8ch, 8},
+#endif /* CONFIG_FORMAT_S16LE */
+#if CONFIG_FORMAT_S24LE
+	{SOF_IPC_FRAME_S24_4LE, 1, sel_s32le_1ch_2ch, 2},
+	{SOF_IPC_FRAME_S24_4LE, 1, sel_s32le_1ch_4ch, 4},
+	{SOF_IPC_FRAME_S24_4LE, 1, sel_s32le_1ch_8ch, 8},
+#endif /* CONFIG_FORMAT_S24LE */
+#if CONFIG_FORMAT_S32LE
+	{SOF_IPC_FRAME_S32_LE, 1, sel_s32le_1ch_2ch, 2},
+	{SOF_IPC_FRAME_S32_LE, 1, sel_s32le_1ch_4ch, 4},
+	{SOF_IPC_FRAME_S32_LE, 1, sel_s32le_1ch_8ch, 8},
+#endif /* CONFIG_FORMAT_S32LE */
 #if CONFIG_FORMAT_S16LE
 	{SOF_IPC_FRAME_S16_LE, 1, sel_s16le_1ch},
 	{SOF_IPC_FRAME_S16_LE, 2, sel_s16le_nch},
@@ -196,6 +320,9 @@ sel_func sel_get_processing_function(struct comp_dev *dev)
 			continue;
 		if (cd->config.out_channels_count != func_table[i].out_channels)
 			continue;
+		if (func_table[i].in_channels &&
+		    cd->config.in_channels_count != func_table[i].in_channels)
+			continue;
 
 		/* TODO: add additional criteria as needed */
 		return func_table[i].sel_func;
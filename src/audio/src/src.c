@@ -87,6 +87,9 @@ struct comp_data {
 	struct polyphase_src src;
 	struct src_param param;
 	int32_t *delay_lines;
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	float *coefs_float;
+#endif
 	uint32_t sink_rate;
 	uint32_t source_rate;
 	int32_t *sbuf_w_ptr;
@@ -462,6 +465,9 @@ static void src_copy_sxx(struct comp_dev *dev,
 	case SOF_IPC_FRAME_S16_LE:
 	case SOF_IPC_FRAME_S24_4LE:
 	case SOF_IPC_FRAME_S32_LE:
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	case SOF_IPC_FRAME_FLOAT:
+#endif
 		audio_stream_copy(source, 0, sink, 0,
 				  frames * source->channels);
 		*n_read = frames;
@@ -620,6 +626,10 @@ static void src_free(struct comp_dev *dev)
 	if (cd->delay_lines)
 		rfree(cd->delay_lines);
 
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	rfree(cd->coefs_float);
+#endif
+
 	rfree(cd);
 	rfree(dev);
 }
@@ -961,6 +971,31 @@ static int src_check_buffer_sizes(struct comp_data *cd,
 	return 0;
 }
 
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+/* converts the coefficients of both stages for the float kernel */
+static int src_prepare_float(struct comp_dev *dev, struct comp_data *cd)
+{
+	struct src_stage *s1 = cd->src.stage1;
+	struct src_stage *s2 = cd->src.stage2;
+	size_t size = (s1->filter_length + s2->filter_length) * sizeof(float);
+
+	rfree(cd->coefs_float);
+	cd->coefs_float = rballoc(0, SOF_MEM_CAPS_RAM, size);
+	if (!cd->coefs_float) {
+		comp_err(dev, "src_prepare_float(): failed to alloc coefficients, size = %u",
+			 size);
+		return -ENOMEM;
+	}
+
+	src_coefs_to_float(s1, cd->coefs_float);
+	src_coefs_to_float(s2, cd->coefs_float + s1->filter_length);
+	cd->src.state1.coefs_float = cd->coefs_float;
+	cd->src.state2.coefs_float = cd->coefs_float + s1->filter_length;
+
+	return 0;
+}
+#endif /* CONFIG_FORMAT_FLOAT_PROCESSING */
+
 static int src_prepare(struct comp_dev *dev)
 {
 	struct comp_data *cd = comp_get_drvdata(dev);
@@ -998,7 +1033,7 @@ static int src_prepare(struct comp_dev *dev)
 	if (ret < 0)
 		goto out;
 
-	/* SRC supports S16_LE, S24_4LE and S32_LE formats */
+	/* SRC supports S16_LE, S24_4LE, S32_LE and float formats */
 	if (source_format != sink_format) {
 		comp_err(dev, "src_prepare(): Source fmt %d and sink fmt %d are different.",
 			 source_format, sink_format);
@@ -1025,6 +1060,16 @@ static int src_prepare(struct comp_dev *dev)
 		cd->polyphase_func = src_polyphase_stage_cir;
 		break;
 #endif /* CONFIG_FORMAT_S32LE */
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	case SOF_IPC_FRAME_FLOAT:
+		ret = src_prepare_float(dev, cd);
+		if (ret < 0)
+			goto out;
+
+		cd->data_shift = 0;
+		cd->polyphase_func = src_polyphase_stage_cir_float;
+		break;
+#endif /* CONFIG_FORMAT_FLOAT_PROCESSING */
 	default:
 		comp_err(dev, "src_prepare(): invalid format %d", source_format);
 		ret = -EINVAL;
@@ -1054,6 +1099,15 @@ static int src_reset(struct comp_dev *dev)
 	return 0;
 }
 
+/* the source and sink frames of the polyphase stages are set up in params */
+static int src_set_attribute(struct comp_dev *dev, uint32_t type, void *value)
+{
+	if (type == COMP_ATTR_PERIOD)
+		comp_err(dev, "src_set_attribute(): period can't change after params");
+
+	return -EINVAL;
+}
+
 static const struct comp_driver comp_src = {
 	.type = SOF_COMP_SRC,
 	.uid = SOF_RT_UUID(src_uuid),
@@ -1067,6 +1121,7 @@ static const struct comp_driver comp_src = {
 		.copy = src_copy,
 		.prepare = src_prepare,
 		.reset = src_reset,
+		.set_attribute = src_set_attribute,
 #if CONFIG_IPC_MAJOR_4
 		.get_attribute = src_get_attribute,
 #endif
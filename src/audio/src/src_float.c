@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+/* SRC for float streams. The polyphase stages are the same as in
+ * src_generic.c, the fixed point coefficients of a stage are converted
+ * to float once in prepare. The delay lines are the int32_t delay lines
+ * of the fixed point version, holding float samples.
+ */
+
+#include <sof/audio/src/src_config.h>
+#include <sof/audio/src/src.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+
+void src_coefs_to_float(const struct src_stage *stage, float *coefs)
+{
+	int i;
+
+#if SRC_SHORT
+	const int16_t *c = stage->coefs;
+
+	/* Q1.15 coefficients, the stage shift is applied to the output */
+	for (i = 0; i < stage->filter_length; i++)
+		coefs[i] = ldexpf(c[i], -15 - stage->shift);
+#else
+	const int32_t *c = stage->coefs;
+
+	/* Q1.31 coefficients, the stage shift is applied to the output */
+	for (i = 0; i < stage->filter_length; i++)
+		coefs[i] = ldexpf(c[i], -31 - stage->shift);
+#endif
+}
+
+static inline void src_inc_wrap_float(float **ptr, float *end, size_t size)
+{
+	if (*ptr >= end)
+		*ptr = (float *)((uint8_t *)*ptr - size);
+}
+
+static inline void src_dec_wrap_float(float **ptr, float *addr, size_t size)
+{
+	if (*ptr < addr)
+		*ptr = (float *)((uint8_t *)*ptr + size);
+}
+
+/* The delay line is written backwards, channel j of the newest frame is at
+ * rp - j and the older samples of the channel follow with stride nch.
+ */
+static inline void fir_filter_float(float *rp, const float *cp, float *wp,
+				    float *fir_end, const int fir_delay_length,
+				    const int taps_x_nch, const int nch)
+{
+	const float *coef;
+	float *data;
+	float y;
+	int frames;
+	int n1;
+	int n2;
+	int i;
+	int j;
+
+	for (j = 0; j < nch; j++) {
+		data = rp - j;
+		coef = cp;
+		y = 0.0f;
+		frames = fir_end - data + nch - j - 1; /* Frames until wrap */
+		n1 = (taps_x_nch < frames) ? taps_x_nch : frames;
+		n2 = taps_x_nch - n1;
+
+		for (i = 0; i < n1; i += nch) {
+			y += *coef * *data;
+			coef++;
+			data += nch;
+		}
+		if (data >= fir_end)
+			data -= fir_delay_length;
+
+		for (i = 0; i < n2; i += nch) {
+			y += *coef * *data;
+			coef++;
+			data += nch;
+		}
+
+		wp[j] = y;
+	}
+}
+
+void src_polyphase_stage_cir_float(struct src_stage_prm *s)
+{
+	struct src_state *fir = s->state;
+	struct src_stage *cfg = s->stage;
+	float *fir_delay = (float *)fir->fir_delay;
+	float *fir_end = fir_delay + fir->fir_delay_size;
+	float *out_delay_end = (float *)fir->out_delay + fir->out_delay_size;
+	float *fir_wp = (float *)fir->fir_wp;
+	float *out_rp = (float *)fir->out_rp;
+	const float *cp;
+	const size_t out_size = fir->out_delay_size * sizeof(float);
+	const size_t fir_size = fir->fir_delay_size * sizeof(float);
+	const int nch = s->nch;
+	const int nch_x_odm = cfg->odm * nch;
+	const int blk_in_words = nch * cfg->blk_in;
+	const int blk_out_words = nch * cfg->num_of_subfilters;
+	const int fir_length = fir->fir_delay_size;
+	const int rewind = nch * (cfg->blk_in
+		+ (cfg->num_of_subfilters - 1) * cfg->idm) - nch;
+	const int nch_x_idm = nch * cfg->idm;
+	const int taps_x_nch = cfg->subfilter_length * nch;
+	float *x_rptr = s->x_rptr;
+	float *y_wptr = s->y_wptr;
+	float *x_end_addr = s->x_end_addr;
+	float *y_end_addr = s->y_end_addr;
+	float *rp;
+	float *wp;
+	int n_wrap_buf;
+	int n_wrap_fir;
+	int n_min;
+	int i;
+	int n;
+	int m;
+
+	for (n = 0; n < s->times; n++) {
+		/* Input data */
+		m = blk_in_words;
+		while (m > 0) {
+			/* Number of words without circular wrap */
+			n_wrap_buf = x_end_addr - x_rptr;
+			n_wrap_fir = fir_wp - fir_delay + 1;
+			n_min = (n_wrap_fir < n_wrap_buf) ? n_wrap_fir : n_wrap_buf;
+			n_min = (m < n_min) ? m : n_min;
+			m -= n_min;
+			for (i = 0; i < n_min; i++) {
+				*fir_wp = *x_rptr;
+				fir_wp--;
+				x_rptr++;
+			}
+			/* Check for wrap */
+			src_dec_wrap_float(&fir_wp, fir_delay, fir_size);
+			src_inc_wrap_float(&x_rptr, x_end_addr, s->x_size);
+		}
+
+		/* Filter */
+		cp = fir->coefs_float; /* Reset to 1st coefficient */
+		rp = fir_wp + rewind;
+		src_inc_wrap_float(&rp, fir_end, fir_size);
+		wp = out_rp;
+		for (i = 0; i < cfg->num_of_subfilters; i++) {
+			fir_filter_float(rp, cp, wp, fir_end, fir_length, taps_x_nch, nch);
+			wp += nch_x_odm;
+			cp += cfg->subfilter_length;
+			src_inc_wrap_float(&wp, out_delay_end, out_size);
+			rp -= nch_x_idm; /* Next sub-filter start */
+			src_dec_wrap_float(&rp, fir_delay, fir_size);
+		}
+
+		/* Output */
+		m = blk_out_words;
+		while (m > 0) {
+			n_wrap_fir = out_delay_end - out_rp;
+			n_wrap_buf = y_end_addr - y_wptr;
+			n_min = (n_wrap_fir < n_wrap_buf) ? n_wrap_fir : n_wrap_buf;
+			n_min = (m < n_min) ? m : n_min;
+			m -= n_min;
+			for (i = 0; i < n_min; i++) {
+				*y_wptr = *out_rp;
+				y_wptr++;
+				out_rp++;
+			}
+			/* Check wrap */
+			src_inc_wrap_float(&y_wptr, y_end_addr, s->y_size);
+			src_inc_wrap_float(&out_rp, out_delay_end, out_size);
+		}
+	}
+
+	fir->fir_wp = (int32_t *)fir_wp;
+	fir->out_rp = (int32_t *)out_rp;
+	s->x_rptr = x_rptr;
+	s->y_wptr = y_wptr;
+}
+
+#endif /* CONFIG_FORMAT_FLOAT_PROCESSING */
@@ -459,6 +459,8 @@ static struct comp_dev *tdfb_new(const struct comp_driver *drv,
 		goto cd_fail;
 	}
 
+	comp_data_blob_share(cd->model_handler);
+
 	/* Get configuration data and reset FIR filters */
 	ret = comp_init_data_blob(cd->model_handler, bs, ipc_tdfb->data);
 	if (ret < 0) {
@@ -879,9 +881,19 @@ static int tdfb_trigger(struct comp_dev *dev, int cmd)
 	return ret;
 }
 
+/* max_frames, which limits the frames of a copy, is computed in params */
+static int tdfb_set_attribute(struct comp_dev *dev, uint32_t type, void *value)
+{
+	if (type == COMP_ATTR_PERIOD)
+		comp_err(dev, "tdfb_set_attribute(): period can't change after params");
+
+	return -EINVAL;
+}
+
 static const struct comp_driver comp_tdfb = {
 	.uid = SOF_RT_UUID(tdfb_uuid),
 	.tctx	= &tdfb_tr,
+	.shed_tier = COMP_SHED_QUALITY,
 	.ops = {
 		.create = tdfb_new,
 		.free = tdfb_free,
@@ -890,6 +902,7 @@ static const struct comp_driver comp_tdfb = {
 		.copy = tdfb_copy,
 		.prepare = tdfb_prepare,
 		.reset = tdfb_reset,
+		.set_attribute = tdfb_set_attribute,
 		.trigger = tdfb_trigger,
 	},
 };
@@ -18,7 +18,8 @@
 #include <sof/lib/memory.h>
 #include <sof/lib/uuid.h>
 #include <sof/list.h>
-#include <sof/math/trig.h>
+#include <sof/math/numbers.h>
+#include <sof/math/oscillator.h>
 #include <sof/platform.h>
 #include <sof/string.h>
 #include <sof/trace/trace.h>
@@ -54,17 +55,12 @@ DECLARE_SOF_RT_UUID("tone", tone_uuid, 0x04e3f894, 0x2c5c, 0x4f2e,
 
 DECLARE_TR_CTX(tone_tr, SOF_UUID(tone_uuid), LOG_LEVEL_INFO);
 
-/* 2*pi/Fs lookup tables in Q1.31 for each Fs */
+/* Supported sample rates */
 static const int32_t tone_fs_list[TONE_NUM_FS] = {
 	8000, 11025, 16000, 22050, 24000, 32000, 44100, 48000,
 	64000, 88200, 96000, 176400, 192000
 };
 
-static const int32_t tone_pi2_div_fs[TONE_NUM_FS] = {
-	1686630, 1223858, 843315, 611929, 562210, 421657, 305965,
-	281105, 210829, 152982, 140552, 76491, 70276
-};
-
 /* tone component private data */
 
 struct tone_state {
@@ -72,13 +68,11 @@ struct tone_state {
 	int32_t a; /* Current amplitude Q1.31 */
 	int32_t a_target; /* Target amplitude Q1.31 */
 	int32_t ampl_coef; /* Amplitude multiplier Q2.30 */
-	int32_t c; /* Coefficient 2*pi/Fs Q1.31 */
 	int32_t f; /* Frequency Q16.16 */
 	int32_t freq_coef; /* Frequency multiplier Q2.30 */
 	int32_t fs; /* Sample rate in Hertz Q32.0 */
 	int32_t ramp_step; /* Amplitude ramp step Q1.31 */
-	int32_t w; /* Angle radians Q4.28 */
-	int32_t w_step; /* Angle step Q4.28 */
+	struct osc_state osc; /* Phase and phase step of the sine */
 	uint32_t block_count;
 	uint32_t repeat_count;
 	uint32_t repeats; /* Number of repeats for tone (sweep steps) */
@@ -98,7 +92,7 @@ struct comp_data {
 			  uint32_t frames);
 };
 
-static int32_t tonegen(struct tone_state *sg);
+static void tonegen(struct tone_state *sg, int32_t *dest, int stride, int samples);
 static void tonegen_control(struct tone_state *sg);
 static void tonegen_update_f(struct tone_state *sg, int32_t f);
 
@@ -123,43 +117,43 @@ static void tone_s32_default(struct comp_dev *dev, struct audio_stream __sparse_
 	int n_min;
 	int nch = cd->channels;
 
-	n = frames * nch;
+	n = frames;
 	while (n > 0) {
-		n_wrap_dest = (int32_t *)sink->end_addr - dest;
+		n_wrap_dest = ((int32_t *)sink->end_addr - dest) / nch;
 		n_min = (n < n_wrap_dest) ? n : n_wrap_dest;
 		/* Process until wrap or completed n */
-		while (n_min > 0) {
-			n -= nch;
-			n_min -= nch;
-			for (i = 0; i < nch; i++) {
-				tonegen_control(&cd->sg[i]);
-				*dest = tonegen(&cd->sg[i]);
-				dest++;
-			}
-		}
+		for (i = 0; i < nch; i++)
+			tonegen(&cd->sg[i], dest + i, nch, n_min);
+
+		n -= n_min;
+		dest += n_min * nch;
 		tone_circ_inc_wrap(&dest, sink->end_addr, sink->size);
 	}
 }
 
-static int32_t tonegen(struct tone_state *sg)
+/* Generate samples of one channel. The control updates happen only at
+ * 125 us block boundaries, so the samples between them are generated
+ * as one oscillator block with constant amplitude and frequency.
+ */
+static void tonegen(struct tone_state *sg, int32_t *dest, int stride, int samples)
 {
-	int64_t sine;
-	int64_t w;
-	/* sg->w is angle in Q4.28 radians format, sin() returns Q1.31 */
-	/* sg->a is amplitude as Q1.31 */
-	sine =
-		q_mults_32x32(sin_fixed_32b(sg->w), sg->a,
-			      Q_SHIFT_BITS_64(31, 31, 31));
-
-	/* Next point */
-	w = (int64_t)sg->w + sg->w_step;
-	sg->w = (w > PI_MUL2_Q4_28)
-		? (int32_t)(w - PI_MUL2_Q4_28) : (int32_t)w;
-
-	if (sg->mute)
-		return 0;
-	else
-		return (int32_t)sine; /* Q1.31 no saturation need */
+	int n;
+
+	while (samples > 0) {
+		tonegen_control(sg);
+
+		/* Samples until the next block boundary */
+		n = (int)sg->samples_in_block - (int)sg->sample_count;
+		n = MAX(n, 1);
+		n = MIN(n, samples);
+		sg->sample_count += n - 1;
+
+		/* The phase runs also while muted */
+		sg->osc.amplitude = sg->mute ? 0 : sg->a;
+		osc_sin_block(&sg->osc, dest, stride, n);
+		dest += n * stride;
+		samples -= n;
+	}
 }
 
 static void tonegen_control(struct tone_state *sg)
@@ -179,7 +173,7 @@ static void tonegen_control(struct tone_state *sg)
 	/* Fade-in ramp during tone */
 	if (sg->block_count < sg->tone_length) {
 		if (sg->a == 0)
-			sg->w = 0; /* Reset phase to have less clicky ramp */
+			sg->osc.phase = 0; /* Reset phase to have less clicky ramp */
 
 		if (sg->a > sg->a_target) {
 			a = (int64_t)sg->a - sg->ramp_step;
@@ -298,17 +292,14 @@ static inline void tonegen_unmute(struct tone_state *sg)
 
 static void tonegen_update_f(struct tone_state *sg, int32_t f)
 {
-	int64_t w_tmp;
 	int64_t f_max;
 
 	/* Calculate Fs/2, fs is Q32.0, f is Q16.16 */
 	f_max = Q_SHIFT_LEFT((int64_t)sg->fs, 0, 16 - 1);
 	f_max = (f_max > INT32_MAX) ? INT32_MAX : f_max;
 	sg->f = (f > f_max) ? f_max : f;
-	/* Q16 x Q31 -> Q28 */
-	w_tmp = q_multsr_32x32(sg->f, sg->c, Q_SHIFT_BITS_64(16, 31, 28));
-	w_tmp = (w_tmp > PI_Q4_28) ? PI_Q4_28 : w_tmp; /* Limit to pi Q4.28 */
-	sg->w_step = (int32_t)w_tmp;
+	if (sg->fs)
+		osc_set_freq(&sg->osc, sg->f, sg->fs);
 }
 
 static void tonegen_reset(struct tone_state *sg)
@@ -316,10 +307,10 @@ static void tonegen_reset(struct tone_state *sg)
 	sg->mute = 1;
 	sg->a = 0;
 	sg->a_target = TONE_AMPLITUDE_DEFAULT;
-	sg->c = 0;
 	sg->f = TONE_FREQUENCY_DEFAULT;
-	sg->w = 0;
-	sg->w_step = 0;
+	sg->osc.phase = 0;
+	sg->osc.step = 0;
+	sg->osc.amplitude = 0;
 
 	sg->block_count = 0;
 	sg->repeat_count = 0;
@@ -337,31 +328,26 @@ static void tonegen_reset(struct tone_state *sg)
 
 static int tonegen_init(struct tone_state *sg, int32_t fs, int32_t f, int32_t a)
 {
-	int idx;
 	int i;
 
 	sg->a_target = a;
 	sg->a = (sg->ramp_step > sg->a_target) ? sg->a_target : sg->ramp_step;
 
-	idx = -1;
 	sg->mute = 1;
 	sg->fs = 0;
 
-	/* Find index of current sample rate and then get from lookup table the
-	 * corresponding 2*pi/Fs value.
-	 */
+	/* Check that the sample rate is supported */
 	for (i = 0; i < TONE_NUM_FS; i++) {
 		if (fs == tone_fs_list[i])
-			idx = i;
+			break;
 	}
 
-	if (idx < 0) {
-		sg->w_step = 0;
+	if (i == TONE_NUM_FS) {
+		sg->osc.step = 0;
 		return -EINVAL;
 	}
 
 	sg->fs = fs;
-	sg->c = tone_pi2_div_fs[idx]; /* Store 2*pi/Fs */
 	sg->mute = 0;
 	tonegen_update_f(sg, f);
 
@@ -718,6 +704,24 @@ static int tone_reset(struct comp_dev *dev)
 	return 0;
 }
 
+static int tone_set_attribute(struct comp_dev *dev, uint32_t type, void *value)
+{
+	struct comp_data *cd = comp_get_drvdata(dev);
+	struct comp_buffer __sparse_cache *sink_c;
+	struct comp_buffer *sinkb;
+
+	if (type != COMP_ATTR_PERIOD)
+		return -EINVAL;
+
+	/* a tone period follows the new pipeline period */
+	sinkb = list_first_item(&dev->bsink_list, struct comp_buffer, source_list);
+	sink_c = buffer_acquire(sinkb);
+	cd->period_bytes = dev->frames * audio_stream_frame_bytes(&sink_c->stream);
+	buffer_release(sink_c);
+
+	return 0;
+}
+
 static const struct comp_driver comp_tone = {
 	.type = SOF_COMP_TONE,
 	.uid = SOF_RT_UUID(tone_uuid),
@@ -731,6 +735,7 @@ static const struct comp_driver comp_tone = {
 		.copy = tone_copy,
 		.prepare = tone_prepare,
 		.reset = tone_reset,
+		.set_attribute = tone_set_attribute,
 	},
 };
 
@@ -160,6 +160,8 @@ enum sof_ipc_ctrl_event_type {
 	SOF_CTRL_EVENT_GENERIC_METADATA,	/**< generic event with metadata */
 	SOF_CTRL_EVENT_KD,	/**< keyword detection event */
 	SOF_CTRL_EVENT_VAD,	/**< voice activity detection event */
+	SOF_CTRL_EVENT_SHED,	/**< load shedding, value is the shed component count */
+	SOF_CTRL_EVENT_BYPASS,	/**< component bypassed by the system agent, value is 1 */
 };
 
 /**
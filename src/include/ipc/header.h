@@ -273,6 +273,8 @@ struct ipc_cmd_hdr;
 #define SOF_IPC_STREAM_TRIG_DRAIN		SOF_CMD_TYPE(0x008)
 #define SOF_IPC_STREAM_TRIG_XRUN		SOF_CMD_TYPE(0x009)
 #define SOF_IPC_STREAM_POSITION			SOF_CMD_TYPE(0x00a)
+#define SOF_IPC_STREAM_PCM_PERIOD		SOF_CMD_TYPE(0x00b)
+#define SOF_IPC_STREAM_LATENCY			SOF_CMD_TYPE(0x00c)
 #define SOF_IPC_STREAM_VORBIS_PARAMS		SOF_CMD_TYPE(0x010)
 #define SOF_IPC_STREAM_VORBIS_FREE		SOF_CMD_TYPE(0x011)
 
@@ -125,6 +125,24 @@ struct sof_ipc_stream {
 	uint32_t comp_id;
 } __attribute__((packed, aligned(4)));
 
+/* change pipeline period - SOF_IPC_STREAM_PCM_PERIOD */
+struct sof_ipc_stream_period {
+	struct sof_ipc_cmd_hdr hdr;
+	uint32_t comp_id;	/**< host component ID */
+	uint32_t period;	/**< new scheduling period in us */
+} __attribute__((packed, aligned(4)));
+
+/* end to end latency - SOF_IPC_STREAM_LATENCY */
+struct sof_ipc_stream_latency {
+	struct sof_ipc_reply rhdr;
+	uint32_t comp_id;	/**< component ID */
+	uint32_t count;		/**< number of measured frames */
+	uint32_t min_us;	/**< minimum latency in us */
+	uint32_t avg_us;	/**< average latency in us */
+	uint32_t max_us;	/**< maximum latency in us */
+	uint32_t reserved[3];
+} __attribute__((packed, aligned(4)));
+
 /* flags indicating which time stamps are in sync with each other */
 #define	SOF_TIME_HOST_SYNC	(1 << 0)
 #define	SOF_TIME_DAI_SYNC	(1 << 1)
@@ -24,6 +24,8 @@
 #ifndef __SOF_IPC4_COPIER_H__
 #define __SOF_IPC4_COPIER_H__
 
+#include <errno.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <ipc4/base-config.h>
 #include <ipc4/gateway.h>
@@ -276,7 +278,12 @@ enum ipc4_copier_module_config_params {
 	 * uint32_t. Config is only allowed when output pin is set up for 32bit and
 	 * source is connected to Gateway
 	 */
-	IPC4_COPIER_MODULE_CFG_ATTENUATION = 6
+	IPC4_COPIER_MODULE_CFG_ATTENUATION = 6,
+	/* Use LARGE_CONFIG_SET to setup the capture front-end stage. Ipc mailbox
+	 * must contain properly built ipc4_copier_frontend_cfg struct. Config is
+	 * only allowed when the source is a DAI gateway and the copier isn't active.
+	 */
+	IPC4_COPIER_MODULE_CFG_CAPTURE_FRONTEND = 7
 };
 
 struct ipc4_copier_config_timestamp_init_data {
@@ -297,6 +304,17 @@ struct ipc4_copier_config_set_sink_format {
 	struct ipc4_audio_format sink_fmt;
 } __attribute__((packed, aligned(4)));
 
+#define IPC4_COPIER_FRONTEND_MAX_CHANNELS	8
+
+struct ipc4_copier_frontend_cfg {
+	/* Non-zero to remove the DC offset of the output channels */
+	uint32_t dc_block;
+	/* DC blocking filter pole of each output channel, in Q2.30 */
+	int32_t R_coeffs[IPC4_COPIER_FRONTEND_MAX_CHANNELS];
+	/* Input channel to take for each output channel */
+	uint8_t ch_map[IPC4_COPIER_FRONTEND_MAX_CHANNELS];
+} __packed __aligned(4);
+
 #define IPC4_COPIER_DATA_SEGMENT_DISABLE	(0 << 0)
 #define IPC4_COPIER_DATA_SEGMENT_ENABLE	(1 << 0)
 #define IPC4_COPIER_DATA_SEGMENT_RESTART	(1 << 1)
@@ -340,9 +358,58 @@ struct copier_data {
 	pcm_converter_func converter[IPC4_COPIER_MODULE_OUTPUT_PINS_COUNT];
 	uint64_t input_total_data_processed;
 	uint64_t output_total_data_processed;
+
+	/* channel selection and DC removal fused into the DAI capture conversion */
+	struct copier_frontend *frontend;
 };
 
 int apply_attenuation(struct comp_dev *dev, struct copier_data *cd,
 		      struct comp_buffer __sparse_cache *sink, int frame);
 
+#if CONFIG_COPIER_CAPTURE_FRONTEND
+int copier_frontend_set_config(struct comp_dev *dev, struct copier_data *cd,
+			       const char *data, uint32_t size);
+int copier_frontend_prepare(struct comp_dev *dev, struct copier_data *cd,
+			    const struct audio_stream __sparse_cache *source,
+			    const struct audio_stream __sparse_cache *sink);
+void copier_frontend_process(struct copier_data *cd,
+			     const struct audio_stream __sparse_cache *source,
+			     struct audio_stream __sparse_cache *sink, uint32_t frames);
+void copier_frontend_free(struct copier_data *cd);
+
+static inline bool copier_frontend_active(struct copier_data *cd)
+{
+	return !!cd->frontend;
+}
+#else
+static inline int copier_frontend_set_config(struct comp_dev *dev, struct copier_data *cd,
+					     const char *data, uint32_t size)
+{
+	return -EINVAL;
+}
+
+static inline int copier_frontend_prepare(struct comp_dev *dev, struct copier_data *cd,
+					  const struct audio_stream __sparse_cache *source,
+					  const struct audio_stream __sparse_cache *sink)
+{
+	return 0;
+}
+
+static inline void copier_frontend_process(struct copier_data *cd,
+					   const struct audio_stream __sparse_cache *source,
+					   struct audio_stream __sparse_cache *sink,
+					   uint32_t frames)
+{
+}
+
+static inline void copier_frontend_free(struct copier_data *cd)
+{
+}
+
+static inline bool copier_frontend_active(struct copier_data *cd)
+{
+	return false;
+}
+#endif
+
 #endif
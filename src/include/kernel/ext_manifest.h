@@ -105,6 +105,7 @@ enum ext_man_elem_type {
 enum config_elem_type {
 	EXT_MAN_CONFIG_IPC_MSG_SIZE	= 1,
 	EXT_MAN_CONFIG_MEMORY_USAGE_SCAN = 2, /**< ABI3.18 */
+	EXT_MAN_CONFIG_BOOT_PROFILE = 3, /**< ABI3.26 */
 	EXT_MAN_CONFIG_LAST_ELEM,	/**< keep it at the end of enum list */
 };
 
@@ -26,6 +26,18 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#define ARIA_GENERIC
+
+#if defined(__XCC__)
+#include <xtensa/config/core-isa.h>
+
+#if XCHAL_HAVE_HIFI3 || XCHAL_HAVE_HIFI4
+#undef ARIA_GENERIC
+#define ARIA_HIFI3
+#endif
+
+#endif
+
 /** \brief Aria max gain states */
 #define ARIA_MAX_GAIN_STATES 10
 
@@ -23,6 +23,7 @@
 #include <ipc/stream.h>
 #include <ipc4/base-config.h>
 
+#include <errno.h>
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -800,6 +801,117 @@ static inline void audio_stream_fmt_conversion(enum ipc4_bit_depth depth,
 		*valid_fmt = SOF_IPC_FRAME_FLOAT;
 	}
 }
+
+/**
+ * Channel view of an audio stream. Gives a component the subset of the
+ * channels it needs, in any order and a channel more than once if it fans
+ * out, straight from the parent stream without copying them to a buffer
+ * of their own. The view has no
+ * pointers of its own, it walks the frames of the parent stream and
+ * uses its read position, size and available data.
+ */
+struct audio_stream_view {
+	const struct audio_stream __sparse_cache *parent; /**< stream the view refers to */
+	uint16_t channels;	/**< Number of channels in the view */
+	uint16_t stride;	/**< Number of samples in a frame of the parent */
+	uint8_t ch_map[SOF_IPC_MAX_CHANNELS]; /**< Parent channel of each view channel */
+};
+
+/**
+ * Initializes a channel view of a stream.
+ * @param view Channel view to initialize.
+ * @param parent Stream the view refers to.
+ * @param ch_map Parent channel of each view channel, NULL for the first
+ *	  channels of the parent in order.
+ * @param channels Number of channels in the view.
+ * @return 0 on success, -EINVAL if a channel doesn't exist in the parent.
+ */
+static inline int audio_stream_view_init(struct audio_stream_view *view,
+					 const struct audio_stream __sparse_cache *parent,
+					 const uint8_t *ch_map, uint16_t channels)
+{
+	int ch;
+
+	if (!channels || channels > SOF_IPC_MAX_CHANNELS)
+		return -EINVAL;
+
+	for (ch = 0; ch < channels; ch++) {
+		view->ch_map[ch] = ch_map ? ch_map[ch] : ch;
+		if (view->ch_map[ch] >= parent->channels)
+			return -EINVAL;
+	}
+
+	view->parent = parent;
+	view->channels = channels;
+	view->stride = parent->channels;
+
+	return 0;
+}
+
+/**
+ * Retrieves the frames available for reading through the view.
+ * @param view Channel view of the stream.
+ * @return Number of frames available in the parent stream.
+ */
+static inline uint32_t
+audio_stream_view_get_avail_frames(const struct audio_stream_view *view)
+{
+	return audio_stream_get_avail_frames(view->parent);
+}
+
+/**
+ * Calculates the number of frames of the view to the wrap of its parent.
+ * @param view Channel view of the stream.
+ * @param frame Pointer to a frame of the parent stream.
+ * @return Number of frames to the end of the parent buffer.
+ */
+static inline uint32_t
+audio_stream_view_frames_without_wrap(const struct audio_stream_view *view,
+				      const void *frame)
+{
+	return audio_stream_frames_without_wrap(view->parent, frame);
+}
+
+/**
+ * Reads a s16 sample of a channel of the view.
+ * @param view Channel view of the stream.
+ * @param frame Pointer to a frame of the parent stream.
+ * @param ch Channel of the view.
+ * @return Sample of the mapped channel of the parent.
+ */
+static inline int16_t audio_stream_view_read_s16(const struct audio_stream_view *view,
+						 const int16_t *frame, int ch)
+{
+	return frame[view->ch_map[ch]];
+}
+
+/**
+ * Reads a s24 or s32 sample of a channel of the view.
+ * @param view Channel view of the stream.
+ * @param frame Pointer to a frame of the parent stream.
+ * @param ch Channel of the view.
+ * @return Sample of the mapped channel of the parent.
+ */
+static inline int32_t audio_stream_view_read_s32(const struct audio_stream_view *view,
+						 const int32_t *frame, int ch)
+{
+	return frame[view->ch_map[ch]];
+}
+
+/**
+ * Advances a frame pointer of the view by a number of frames.
+ * @param view Channel view of the stream.
+ * @param frame Pointer to a frame of the parent stream.
+ * @param frames Number of frames to advance, within the parent buffer size.
+ * @return Pointer to the frame, wrapped in the parent buffer.
+ */
+static inline void *audio_stream_view_next_frame(const struct audio_stream_view *view,
+						 const void *frame, uint32_t frames)
+{
+	return audio_stream_wrap(view->parent, (char *)frame +
+				 frames * audio_stream_frame_bytes(view->parent));
+}
+
 /** @}*/
 
 #endif /* __SOF_AUDIO_AUDIO_STREAM_H__ */
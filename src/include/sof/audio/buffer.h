@@ -109,6 +109,27 @@ extern struct tr_ctx buffer_tr;
 #define BUFF_PARAMS_RATE	BIT(2)
 #define BUFF_PARAMS_CHANNELS	BIT(3)
 
+/* frame tagged with the time it entered the firmware */
+struct buffer_latency_tag {
+	uint64_t stamp;		/**< time the frame entered the firmware in us */
+	uint32_t offset;	/**< bytes in the buffer ahead of the frame */
+	uint32_t avail;		/**< avail bytes before the last copy */
+	bool valid;		/**< a frame in the buffer is tagged */
+};
+
+/* fill level and transfer extremes since prepare, see buffer_calib_size() */
+struct buffer_calib {
+	uint32_t fill_min;	/**< lowest avail bytes after a consume */
+	uint32_t fill_max;	/**< highest avail bytes after a produce */
+	uint32_t produce_min;	/**< smallest produce in bytes */
+	uint32_t produce_max;	/**< largest produce in bytes */
+	uint32_t consume_min;	/**< smallest consume in bytes */
+	uint32_t consume_max;	/**< largest consume in bytes */
+	uint32_t produces;	/**< number of produces */
+	uint32_t consumes;	/**< number of consumes */
+	uint32_t full;		/**< produces that left no free bytes */
+};
+
 /*
  * audio component buffer - connects 2 audio components together in pipeline.
  *
@@ -147,6 +168,15 @@ struct comp_buffer {
 	uint32_t buffer_fmt;	/**< enum sof_ipc_buffer_format */
 	uint16_t chmap[SOF_IPC_MAX_CHANNELS];	/**< channel map - SOF_CHMAP_ */
 
+#if CONFIG_PIPELINE_LATENCY
+	/* latency measurement, see pipeline_get_latency() */
+	struct buffer_latency_tag tag;
+#endif
+
+#if CONFIG_BUFFER_CALIBRATION
+	struct buffer_calib calib;
+#endif
+
 	bool hw_params_configured; /**< indicates whether hw params were set */
 	bool walking;		/**< indicates if the buffer is being walked */
 };
@@ -191,6 +221,11 @@ void comp_update_buffer_produce(struct comp_buffer __sparse_cache *buffer, uint3
 /* called by a component after consuming data from this buffer */
 void comp_update_buffer_consume(struct comp_buffer __sparse_cache *buffer, uint32_t bytes);
 
+#if CONFIG_BUFFER_CALIBRATION
+/* smallest size in bytes that holds what the buffer went through since prepare */
+uint32_t buffer_calib_size(struct comp_buffer __sparse_cache *buffer);
+#endif
+
 int buffer_set_params(struct comp_buffer __sparse_cache *buffer,
 		      struct sof_ipc_stream_params *params, bool force_update);
 
@@ -244,6 +279,15 @@ static inline void buffer_reset_pos(struct comp_buffer __sparse_cache *buffer, v
 	/* reset rw pointers and avail/free bytes counters */
 	audio_stream_reset(&buffer->stream);
 
+#if CONFIG_PIPELINE_LATENCY
+	/* the tagged frame is gone */
+	buffer->tag.valid = false;
+#endif
+
+#if CONFIG_BUFFER_CALIBRATION
+	memset(&buffer->calib, 0, sizeof(buffer->calib));
+#endif
+
 	/* clear buffer contents */
 	buffer_zero(buffer);
 }
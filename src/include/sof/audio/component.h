@@ -130,6 +130,8 @@ enum {
 #define COMP_ATTR_COPY_DIR	2	/**< Comp copy direction */
 #define COMP_ATTR_VDMA_INDEX	3	/**< Comp index of the virtual DMA at the gateway. */
 #define COMP_ATTR_BASE_CONFIG	4	/**< Component base config */
+#define COMP_ATTR_PERIOD	5	/**< New pipeline period in us */
+#define COMP_ATTR_BYPASS	6	/**< Copy replaced by comp_copy_bypass() */
 /** @}*/
 
 /** \name Trace macros
@@ -503,6 +505,24 @@ struct comp_ops {
 	 * @return total data processed if succeeded, 0 otherwise.
 	 */
 	uint64_t (*get_total_data_processed)(struct comp_dev *dev, uint32_t stream_no, bool input);
+
+	/**
+	 * Switches to the cheaper fallback of load shedding and back.
+	 * Components with a shed tier and without this operation are
+	 * bypassed instead.
+	 * @param dev Component device.
+	 * @param shed true for the fallback, false for full processing.
+	 * @return 0 if succeeded, error code otherwise.
+	 */
+	int (*shed)(struct comp_dev *dev, bool shed);
+};
+
+/** \brief Load shedding tiers, the highest tier is shed first */
+enum comp_shed_tier {
+	COMP_SHED_NONE = 0,	/**< needed by the stream, never shed */
+	COMP_SHED_QUALITY,	/**< quality processing, e.g. noise reduction */
+	COMP_SHED_ENHANCE,	/**< enhancement, e.g. equalization */
+	COMP_SHED_TIERS,
 };
 
 /**
@@ -514,12 +534,16 @@ struct comp_driver {
 	const struct sof_uuid *uid;	/**< Address to UUID value */
 	struct tr_ctx *tctx;		/**< Pointer to trace context */
 	struct comp_ops ops;		/**< component operations */
+	uint32_t shed_tier;		/**< COMP_SHED_, see pipeline_shed() */
+	bool any_period;		/**< see pipeline_set_period() */
 };
 
 /** \brief Holds constant pointer to component driver */
 struct comp_driver_info {
 	const struct comp_driver *drv;	/**< pointer to component driver */
 	struct list_item list;		/**< list of component drivers */
+	struct comp_driver_info *uuid_next; /**< next driver with the same UUID hash */
+	struct comp_driver_info *type_next; /**< next driver with the same type hash */
 };
 
 /**
@@ -582,9 +606,15 @@ struct comp_dev {
 	/* private data - core does not touch this */
 	void *priv_data;	/**< private data */
 
+	bool bypass;		/**< input copied to output, see comp_copy_bypass() */
+	bool shed;		/**< running its fallback, see pipeline_shed() */
+
 #if CONFIG_PERFORMANCE_COUNTERS
 	struct perf_cnt_data pcd;
 #endif
+#if CONFIG_AGENT_BUDGET
+	struct pipeline_budget budget;	/**< execution budget, 0 limit uses the pipeline's */
+#endif
 };
 
 /** @}*/
@@ -702,16 +732,37 @@ static inline struct comp_dev *comp_alloc(const struct comp_driver *drv,
 /**
  * Registers the component driver on the list of available components.
  * @param drv Component driver to be registered.
- * @return 0 if succeeded, error code otherwise.
+ * @return 0 if succeeded, -EEXIST if the driver is already registered.
  */
 int comp_register(struct comp_driver_info *drv);
 
 /**
  * Unregisters the component driver from the list of available components.
  * @param drv Component driver to be unregistered.
+ *
+ * Waits for the driver lookups in progress, once it returns no lookup
+ * refers to the driver and it can be freed or registered again. Must not
+ * be called from a context that can preempt a lookup.
  */
 void comp_unregister(struct comp_driver_info *drv);
 
+/**
+ * Finds the registered driver with the given UUID.
+ * @param uuid UUID of the driver, UUID_SIZE bytes.
+ * @return Driver or NULL if none is registered.
+ *
+ * Lookups don't take the driver list lock, they can run concurrently with
+ * the registration and the unregistration of drivers.
+ */
+const struct comp_driver *comp_driver_find_uuid(const uint8_t *uuid);
+
+/**
+ * Finds the last registered driver with the given IPC3 type.
+ * @param type SOF_COMP_ type of the driver.
+ * @return Driver or NULL if none is registered.
+ */
+const struct comp_driver *comp_driver_find_type(uint32_t type);
+
 /** @}*/
 
 /**
@@ -837,6 +888,32 @@ void comp_get_copy_limits_frame_aligned(const struct comp_buffer __sparse_cache
 					const struct comp_buffer __sparse_cache *sink,
 					struct comp_copy_limits *cl);
 
+/**
+ * Checks if a component can be bypassed, it needs a single source and a
+ * single sink with the same rate, format and channels.
+ * @param dev Component.
+ * @return true if comp_copy_bypass() can replace the component copy.
+ */
+bool comp_can_bypass(struct comp_dev *dev);
+
+/**
+ * Checks if a component can be shed. It needs a shed tier, and either
+ * its own fallback or a bypass that copies the source to the sink.
+ * @param dev Component.
+ * @return true if the component can be shed.
+ */
+bool comp_can_shed(struct comp_dev *dev);
+
+/**
+ * Copy of a bypassed component, the source is copied to the sink.
+ * The component is told with COMP_ATTR_BYPASS that it didn't copy.
+ * When the formats differ since the bypass started, the bypass is
+ * dropped and the component copies again.
+ * @param dev Component.
+ * @return 0, or the error of the component copy.
+ */
+int comp_copy_bypass(struct comp_dev *dev);
+
 /**
  * Version of comp_get_copy_limits that locks both buffers to guarantee
  * consistent state readings.
@@ -16,8 +16,10 @@
 #ifndef __SOF_AUDIO_COMPONENT_INT_H__
 #define __SOF_AUDIO_COMPONENT_INT_H__
 
+#include <sof/atomic.h>
 #include <sof/audio/component.h>
 #include <sof/drivers/idc.h>
+#include <sof/lib/agent.h>
 #include <sof/list.h>
 #include <ipc/topology.h>
 #include <kernel/abi.h>
@@ -27,10 +29,16 @@
  *  @{
  */
 
+/** \brief Number of buckets of the driver lookup tables, a power of two */
+#define COMP_DRIVER_HASH_SIZE	32
+
 /** \brief Holds list of registered components' drivers */
 struct comp_driver_list {
 	struct list_item list;	/**< list of component drivers */
 	struct k_spinlock lock;	/**< list lock */
+	struct comp_driver_info *uuid_hash[COMP_DRIVER_HASH_SIZE]; /**< drivers by UUID */
+	struct comp_driver_info *type_hash[COMP_DRIVER_HASH_SIZE]; /**< drivers by type */
+	atomic_t readers;	/**< driver lookups in progress */
 };
 
 /** \brief Retrieves the component device buffer list. */
@@ -221,6 +229,20 @@ static inline int comp_set_attribute(struct comp_dev *dev, uint32_t type,
 	return 0;
 }
 
+/** See comp_ops::shed */
+static inline int comp_shed(struct comp_dev *dev, bool shed)
+{
+	int ret = 0;
+
+	if (dev->drv->ops.shed)
+		ret = dev->drv->ops.shed(dev, shed);
+
+	if (!ret)
+		dev->shed = shed;
+
+	return ret;
+}
+
 /** Runs comp_ops::reset on the target component's core */
 static inline int comp_reset_remote(struct comp_dev *dev)
 {
@@ -237,6 +259,12 @@ static inline int comp_reset_remote(struct comp_dev *dev)
  */
 static inline int comp_reset(struct comp_dev *dev)
 {
+	/* the next run starts with the component processing again */
+	dev->bypass = false;
+#if CONFIG_AGENT_BUDGET
+	sa_budget_comp_reset(dev);
+#endif
+
 	if (dev->drv->ops.reset)
 		return (dev->is_shared && !cpu_is_me(dev->ipc_config.core)) ?
 			comp_reset_remote(dev) : dev->drv->ops.reset(dev);
@@ -27,6 +27,9 @@ struct comp_dev;
 /* Number of sinks for a 4 way crossover filter */
 #define CROSSOVER_4WAY_NUM_SINKS 4
 
+/* Frames processed at once by the LR4 filters */
+#define CROSSOVER_BLOCK_FRAMES 32
+
 /**
  * The Crossover filter will have from 2 to 4 outputs.
  * Diagram of a 4-way Crossover filter (6 LR4 Filters).
@@ -72,8 +75,13 @@ typedef void (*crossover_process)(const struct comp_dev *dev,
 				  int32_t num_sinks,
 				  uint32_t frames);
 
-typedef void (*crossover_split)(int32_t in, int32_t out[],
-				struct crossover_state *state);
+/*
+ * Splits a block of one channel into the band outputs. Only the outputs
+ * set in the active mask are computed, along with the filters they need.
+ */
+typedef void (*crossover_split)(struct crossover_state *state, const int32_t *x,
+				int32_t y[][CROSSOVER_BLOCK_FRAMES], uint32_t active,
+				int frames);
 
 /* Crossover component private data */
 struct comp_data {
@@ -84,29 +92,38 @@ struct comp_data {
 	enum sof_ipc_frame source_format;         /**< source frame format */
 	crossover_process crossover_process;      /**< processing function */
 	crossover_split crossover_split;          /**< split function */
+	uint32_t active_sinks;                    /**< outputs with a connected sink */
 };
 
 struct crossover_proc_fnmap {
 	enum sof_ipc_frame frame_fmt;
 	crossover_process crossover_proc_func;
+	uint32_t channels; /* channels count, zero for any */
 };
 
 extern const struct crossover_proc_fnmap crossover_proc_fnmap[];
 extern const struct crossover_proc_fnmap crossover_proc_fnmap_pass[];
 extern const size_t crossover_proc_fncount;
+extern const size_t crossover_proc_fncount_pass;
 
 /**
  * \brief Returns Crossover processing function.
  */
 static inline crossover_process
-	crossover_find_proc_func(enum sof_ipc_frame src_fmt)
+	crossover_find_proc_func(enum sof_ipc_frame src_fmt, uint32_t channels)
 {
 	int i;
 
 	/* Find suitable processing function from map */
-	for (i = 0; i < crossover_proc_fncount; i++)
-		if (src_fmt == crossover_proc_fnmap[i].frame_fmt)
-			return crossover_proc_fnmap[i].crossover_proc_func;
+	for (i = 0; i < crossover_proc_fncount; i++) {
+		if (src_fmt != crossover_proc_fnmap[i].frame_fmt)
+			continue;
+		if (crossover_proc_fnmap[i].channels &&
+		    crossover_proc_fnmap[i].channels != channels)
+			continue;
+
+		return crossover_proc_fnmap[i].crossover_proc_func;
+	}
 
 	return NULL;
 }
@@ -120,7 +137,7 @@ static inline crossover_process
 	int i;
 
 	/* Find suitable processing function from map */
-	for (i = 0; i < crossover_proc_fncount; i++)
+	for (i = 0; i < crossover_proc_fncount_pass; i++)
 		if (src_fmt == crossover_proc_fnmap_pass[i].frame_fmt)
 			return crossover_proc_fnmap_pass[i].crossover_proc_func;
 
@@ -120,6 +120,22 @@ struct comp_data_blob_handler *comp_data_blob_handler_new(struct comp_dev *dev)
 	return comp_data_blob_handler_new_ext(dev, false, NULL, NULL);
 }
 
+#if CONFIG_COMP_DATA_BLOB_SHARE
+/**
+ * Lets the handler share its blobs with the handlers of other component
+ * instances on the same core that hold an identical blob. The component
+ * must only read the blob. Call it before the first blob is set. It
+ * has no effect in single blob mode or with a custom allocator.
+ *
+ * @param blob_handler Data blob handler
+ */
+void comp_data_blob_share(struct comp_data_blob_handler *blob_handler);
+#else
+static inline void comp_data_blob_share(struct comp_data_blob_handler *blob_handler)
+{
+}
+#endif
+
 /**
  * Free data blob handler.
  *
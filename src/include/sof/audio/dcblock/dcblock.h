@@ -10,6 +10,7 @@
 
 #include <stdint.h>
 #include <sof/platform.h>
+#include <sof/audio/format.h>
 #include <ipc/stream.h>
 
 struct audio_stream;
@@ -20,6 +21,29 @@ struct dcblock_state {
 	int32_t y_prev; /**< state variable referring to y[n-1] */
 };
 
+/**
+ * \brief DC blocking filter for one sample, y[n] = x[n] - x[n-1] + R * y[n-1].
+ * \param state filter state of the channel
+ * \param R pole of the filter in Q2.30
+ * \param x input sample in Q1.31
+ * \return output sample in Q1.31
+ */
+static inline int32_t dcblock_generic(struct dcblock_state *state,
+				      int64_t R, int32_t x)
+{
+	/*
+	 * R: Q2.30, y_prev: Q1.31
+	 * R * y_prev: Q3.61
+	 */
+	int64_t out = ((int64_t)x) - state->x_prev +
+		      Q_SHIFT_RND(R * state->y_prev, 61, 31);
+
+	state->y_prev = sat_int32(out);
+	state->x_prev = x;
+
+	return state->y_prev;
+}
+
 /**
  * \brief Type definition for the processing function for the
  * DC Blocking Filter.
@@ -46,6 +70,7 @@ struct comp_data {
 struct dcblock_func_map {
 	enum sof_ipc_frame src_fmt; /**< source frame format */
 	dcblock_func func; /**< processing function */
+	uint32_t channels; /**< channels count, zero for any */
 };
 
 /** \brief Map of formats with dedicated processing functions. */
@@ -56,17 +81,23 @@ extern const size_t dcblock_fncount;
 
 /**
  * \brief Retrieves a DC Blocking processing function matching
- *	  the source buffer's frame format.
+ *	  the source buffer's frame format and channels count.
  * \param src_fmt the frames' format of the source buffer
+ * \param channels the channels count of the source buffer
  */
-static inline dcblock_func dcblock_find_func(enum sof_ipc_frame src_fmt)
+static inline dcblock_func dcblock_find_func(enum sof_ipc_frame src_fmt,
+					     uint32_t channels)
 {
 	int i;
 
 	/* Find suitable processing function from map */
 	for (i = 0; i < dcblock_fncount; i++) {
-		if (src_fmt == dcblock_fnmap[i].src_fmt)
-			return dcblock_fnmap[i].func;
+		if (src_fmt != dcblock_fnmap[i].src_fmt)
+			continue;
+		if (dcblock_fnmap[i].channels && dcblock_fnmap[i].channels != channels)
+			continue;
+
+		return dcblock_fnmap[i].func;
 	}
 
 	return NULL;
@@ -57,6 +57,40 @@ struct drc_state {
 	int32_t max_attack_compression_diff_db; /* Q8.24 */
 };
 
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+/* The sof_drc_params used by float streams, converted from Q format */
+struct drc_params_float {
+	float linear_threshold;
+	float slope;
+	float K;
+	float knee_alpha;
+	float knee_beta;
+	float knee_threshold;
+	float ratio_base;
+	float master_linear_gain;
+	float one_over_attack_frames;
+	float sat_release_frames_inv_neg;
+	float sat_release_rate_at_neg_two_db;
+	float kSpacingDb;
+	float kA;
+	float kB;
+	float kC;
+	float kD;
+	float kE;
+};
+
+/* Gain state of DRC for float streams, see struct drc_state. The lookahead
+ * section of struct drc_state is shared, with float samples.
+ */
+struct drc_state_float {
+	float detector_average;
+	float compressor_gain;
+	float envelope_rate;
+	float scaled_desired_gain;
+	float max_attack_compression_diff_db;
+};
+#endif /* CONFIG_FORMAT_FLOAT_PROCESSING */
+
 typedef void (*drc_func)(const struct comp_dev *dev,
 			 const struct audio_stream __sparse_cache *source,
 			 struct audio_stream __sparse_cache *sink,
@@ -70,6 +104,10 @@ struct drc_comp_data {
 	bool config_ready;                  /**< set when fully received */
 	enum sof_ipc_frame source_format;   /**< source frame format */
 	drc_func drc_func;            /**< processing function */
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	struct drc_state_float state_float; /**< compressor gains of float streams */
+	struct drc_params_float params_float; /**< blob converted to float */
+#endif
 };
 
 struct drc_proc_fnmap {
@@ -80,6 +118,15 @@ struct drc_proc_fnmap {
 extern const struct drc_proc_fnmap drc_proc_fnmap[];
 extern const size_t drc_proc_fncount;
 
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+/* Converts the setup blob to float and resets the float compressor state */
+void drc_setup_float(struct drc_comp_data *cd);
+
+void drc_float_default(const struct comp_dev *dev,
+		       const struct audio_stream __sparse_cache *source,
+		       struct audio_stream __sparse_cache *sink, uint32_t frames);
+#endif
+
 void drc_default_pass(const struct comp_dev *dev, const struct audio_stream *source,
 		      struct audio_stream *sink, uint32_t frames);
 
@@ -10,15 +10,23 @@
 #ifndef __SOF_AUDIO_EQ_IIR_EQ_IIR_H__
 #define __SOF_AUDIO_EQ_IIR_EQ_IIR_H__
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <sof/math/iir_df2t.h>
+#include <sof/math/iir_df2t_float.h>
+#include <sof/platform.h>
 
 /** \brief Macros to convert without division bytes count to samples count */
 #define EQ_IIR_BYTES_TO_S16_SAMPLES(b)	((b) >> 1)
 #define EQ_IIR_BYTES_TO_S32_SAMPLES(b)	((b) >> 2)
 
 struct audio_stream;
+struct comp_buffer;
+struct comp_data_blob_handler;
 struct comp_dev;
+struct eq_iir_batch;
+struct sof_eq_iir_config;
 
 /** \brief Type definition for processing function select return value. */
 typedef void (*eq_iir_func)(const struct comp_dev *dev,
@@ -31,8 +39,57 @@ struct eq_iir_func_map {
 	uint8_t source;				/**< source frame format */
 	uint8_t sink;				/**< sink frame format */
 	eq_iir_func func;			/**< processing function */
+	uint8_t channels;			/**< channels count, zero for any */
 };
 
+/** \brief IIR EQ component private data. */
+struct comp_data {
+	struct iir_state_df2t iir[PLATFORM_MAX_CHANNELS]; /**< filters state */
+	struct comp_data_blob_handler *model_handler;
+	struct sof_eq_iir_config *config;
+	int64_t *iir_delay;			/**< pointer to allocated RAM */
+	size_t iir_delay_size;			/**< allocated size */
+	eq_iir_func eq_iir_func;		/**< processing function */
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	struct iir_state_df2t_float iir_float[PLATFORM_MAX_CHANNELS]; /**< float filters */
+	float *iir_float_data;			/**< float coefficients and delays */
+	bool float_path;			/**< filters run in float */
+#endif
+#if CONFIG_COMP_IIR_BATCH
+	struct eq_iir_batch *batch;		/**< streams filtered together */
+#endif
+};
+
+/** \brief Map of the processing functions used with a configuration. */
+extern const struct eq_iir_func_map fm_configured[];
+
+/** \brief Number of processing functions with a configuration. */
+extern const size_t fm_configured_count;
+
+#if CONFIG_COMP_IIR_BATCH
+
+/** \brief Adds a mono stream to a batch of streams with the same tuning. */
+struct eq_iir_batch *eq_iir_batch_join(struct comp_dev *dev, struct iir_state_df2t *iir,
+				       const void *config,
+				       const struct comp_buffer __sparse_cache *source,
+				       const struct comp_buffer __sparse_cache *sink);
+
+/** \brief Removes the stream of the component from its batch. */
+void eq_iir_batch_leave(struct eq_iir_batch *batch, struct comp_dev *dev);
+
+/** \brief Starts or stops the stream of the component in its batch. */
+void eq_iir_batch_trigger(struct eq_iir_batch *batch, struct comp_dev *dev, int cmd);
+
+/**
+ * \brief Queues the stream of the component, runs the batch when complete.
+ * \return false if the stream is to be filtered alone in this tick.
+ */
+bool eq_iir_batch_copy(struct eq_iir_batch *batch, struct comp_dev *dev);
+
+/** \brief Takes the stream of a component that didn't copy out of the tick. */
+void eq_iir_batch_bypass(struct eq_iir_batch *batch, struct comp_dev *dev);
+#endif
+
 #ifdef UNIT_TEST
 void sys_comp_eq_iir_init(void);
 #endif
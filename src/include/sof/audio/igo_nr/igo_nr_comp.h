@@ -30,6 +30,7 @@ struct comp_data {
 	int16_t out[IGO_NR_IN_BUF_LENGTH];    /**< output samples mix buffer */
 	bool process_enable[SOF_IPC_MAX_CHANNELS];	/**< set if channel process is enabled */
 	bool invalid_param;	/**< sample rate != 16000 */
+	bool shed;		/**< passthrough to shed the load */
 	uint32_t sink_rate;	/* Sample rate in Hz */
 	uint32_t source_rate;	/* Sample rate in Hz */
 	uint32_t sink_format;	/* For used PCM sample format */
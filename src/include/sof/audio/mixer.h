@@ -8,6 +8,30 @@
 #ifndef __SOF_AUDIO_MIXER_H__
 #define __SOF_AUDIO_MIXER_H__
 
+#include <sof/compiler_attributes.h>
+#include <stddef.h>
+#include <stdint.h>
+
+struct audio_stream;
+struct comp_dev;
+
+/** \brief Type definition for the processing function of the mixer. */
+typedef void (*mixer_func)(struct comp_dev *dev, struct audio_stream __sparse_cache *sink,
+			   const struct audio_stream __sparse_cache **sources, uint32_t count,
+			   uint32_t frames);
+
+/** \brief Mixer processing functions map item. */
+struct mixer_func_map {
+	uint16_t frame_fmt;	/**< frame format of the sources and the sink */
+	mixer_func func;	/**< mixing function */
+};
+
+/** \brief Map of formats with dedicated processing functions. */
+extern const struct mixer_func_map mixer_func_map[];
+
+/** \brief Number of processing functions. */
+extern const size_t mixer_func_count;
+
 #ifdef UNIT_TEST
 void sys_comp_mixer_init(void);
 #endif
@@ -136,6 +136,12 @@ struct module_interface {
 	 * but leave allocated memory intact.
 	 */
 	int (*reset)(struct processing_module *mod);
+	/**
+	 * Optional, called when the pipeline changes the scheduling period of the module, see
+	 * pipeline_set_period(). dev->period and dev->frames already hold the new values. Modules
+	 * without it refuse a new period.
+	 */
+	int (*set_period)(struct processing_module *mod);
 	/**
 	 * Module specific free procedure, called as part of module_adapter component
 	 * free in .free(). This should free all memory allocated by module.
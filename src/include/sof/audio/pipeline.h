@@ -41,6 +41,22 @@ struct ipc_msg;
 #define PPL_DIR_DOWNSTREAM	0
 #define PPL_DIR_UPSTREAM	1
 
+/* latency of the frames that leave the firmware through a pipeline */
+struct pipeline_latency {
+	uint32_t count;		/* frames measured */
+	uint32_t min_us;	/* minimum latency */
+	uint32_t max_us;	/* maximum latency */
+	uint64_t total_us;	/* sum of the latencies, for the average */
+};
+
+/* execution budget of a pipeline or a component, in timer cycles */
+struct pipeline_budget {
+	uint32_t cycles;	/* last copy */
+	uint32_t cycles_max;	/* worst copy */
+	uint32_t limit;		/* allowed per copy, 0 for no limit */
+	uint32_t overruns;	/* copies over the limit */
+};
+
 /*
  * Audio pipeline.
  */
@@ -58,6 +74,17 @@ struct pipeline {
 
 	/* runtime status */
 	int32_t xrun_bytes;		/* last xrun length */
+	uint32_t xrun_conceal_us;	/* length of the xrun being concealed */
+	uint32_t xrun_concealed;	/* xruns concealed in band */
+	uint32_t xrun_reported;		/* xruns reported to the host */
+	bool xrun_fade_in;		/* fade in the data after a concealed underrun */
+#if CONFIG_PIPELINE_LATENCY
+	uint64_t copy_count;		/* copies since the pipeline started */
+	struct pipeline_latency latency;	/* end to end latency */
+#endif
+#if CONFIG_AGENT_BUDGET
+	struct pipeline_budget budget;	/* execution budget per copy */
+#endif
 	uint32_t status;		/* pipeline status */
 	struct tr_ctx tctx;		/* trace settings */
 
@@ -78,6 +105,9 @@ struct pipeline {
 	/* position update */
 	uint32_t posn_offset;		/* position update array offset*/
 	struct ipc_msg *msg;
+#if CONFIG_PIPELINE_SHED
+	struct ipc_msg *shed_msg;	/* load shedding event */
+#endif
 	struct {
 		int cmd;
 		struct comp_dev *host;
@@ -292,6 +322,31 @@ int pipeline_copy(struct pipeline *p);
 void pipeline_get_timestamp(struct pipeline *p, struct comp_dev *host_dev,
 			    struct sof_ipc_stream_posn *posn);
 
+/**
+ * \brief Get end to end latency of the frames leaving the pipeline.
+ *
+ * Needs CONFIG_PIPELINE_LATENCY, the counters stay at zero otherwise.
+ * The latency runs from the host or DAI where a frame entered the
+ * firmware to the endpoint of this pipeline where it left, so it adds
+ * up the algorithmic and buffering delay of all pipelines on the way.
+ * \param[in] p pipeline.
+ * \param[out] latency Statistics of the measured frames.
+ */
+void pipeline_get_latency(struct pipeline *p, struct sof_ipc_stream_latency *latency);
+
+#if CONFIG_PIPELINE_LATENCY
+/**
+ * \brief Starts the latency measurement of a pipeline over.
+ *
+ * Clears the statistics and the copy count, the time base of the
+ * measurement on the testbench.
+ * \param[in] p pipeline.
+ */
+void pipeline_latency_reset(struct pipeline *p);
+#else
+static inline void pipeline_latency_reset(struct pipeline *p) { }
+#endif
+
 /*
  * Pipeline scheduling APIs
  *
@@ -377,6 +432,39 @@ void pipeline_schedule_config(struct pipeline *p, uint32_t sched_id,
 			      uint32_t period_mips, uint32_t frames_per_sched,
 			      uint32_t time_domain);
 
+/**
+ * \brief Changes the scheduling period of a timer driven pipeline.
+ *
+ * Can be called while the pipeline is running, its task is paused while
+ * the components are updated. Every component of the pipeline gets the
+ * new period with COMP_ATTR_PERIOD and may refuse it, the pipeline then
+ * keeps the old period. A driver without set_attribute() accepts it only
+ * if it sets any_period. Empty buffers which are too small for the new
+ * period are resized, and get their old size back if the switch is
+ * refused. The DMA buffers of host and dai are not, so they have to be
+ * sized for the longest period in use.
+ * \param[in] p pipeline.
+ * \param[in] period New scheduling period in us.
+ * \return 0 on success.
+ */
+int pipeline_set_period(struct pipeline *p, uint32_t period);
+
+#if CONFIG_PIPELINE_SHED
+/**
+ * \brief Sheds or restores one step of the load of the LL pipelines.
+ *
+ * A step is one shed tier of the components of one pipeline. The lowest
+ * priority pipelines are shed first, starting with their highest tier,
+ * and restored in the reverse order. The host gets a SOF_CTRL_EVENT_SHED
+ * event from the pipeline with the number of its components running
+ * their fallback.
+ * \param[in] tasks LL tasks of the current core.
+ * \param[in] shed true to shed, false to restore.
+ * \return true if a step was taken.
+ */
+bool pipeline_shed(struct list_item *tasks, bool shed);
+#endif
+
 /*
  * Pipeline error handling APIs
  *
@@ -408,9 +496,70 @@ void pipeline_xrun(struct pipeline *p, struct comp_dev *dev, int32_t bytes);
 
 /**
  * \brief Set tolerance for pipeline xrun handling.
+ *
+ * Xruns up to the limit are concealed in band, longer ones stop the
+ * pipeline and are reported to the host. Zero disables the concealment,
+ * every xrun is reported. Pipelines without a limit set keep the default
+ * of CONFIG_XRUN_CONCEAL_LIMIT_US.
  * \param[in] p pipeline.
  * \param[in] xrun_limit_usecs Limit in micro secs that pipeline will tolerate.
  */
 int pipeline_xrun_set_limit(struct pipeline *p, uint32_t xrun_limit_usecs);
 
+/**
+ * \brief Conceals the xrun of a DAI in band, within the pipeline xrun limit.
+ *
+ * Called every copy. An xrun is ahead when the DMA has less than a period
+ * of data on playback, or of space on capture, left and the buffer can't
+ * cover the gap. Ends an ongoing concealed xrun otherwise.
+ * \param[in] p pipeline.
+ * \param[in] dev DAI component.
+ * \param[in] buffer DAI local buffer.
+ * \param[in] dma_bytes Data on playback, or space on capture, left in the DMA.
+ * \param[in] period_bytes DMA period size.
+ * \param[in] dma_frame_bytes DMA frame size.
+ * \return 0 if there is no xrun or it was concealed, -EPIPE if the xrun is
+ *	   over the pipeline limit.
+ */
+int pipeline_xrun_conceal(struct pipeline *p, struct comp_dev *dev,
+			  struct comp_buffer __sparse_cache *buffer,
+			  uint32_t dma_bytes, uint32_t period_bytes,
+			  uint32_t dma_frame_bytes);
+
+/**
+ * \brief Conceals an underrun in band.
+ *
+ * Fades out the data left in the buffer and appends silence, the data
+ * that follows is faded in by pipeline_xrun_conceal_end().
+ * \param[in] p pipeline.
+ * \param[in] dev Component that runs out of data.
+ * \param[in] source Buffer the component reads from.
+ * \param[in] frames Number of missing frames.
+ * \return 0 if concealed, -EPIPE if the xrun is over the pipeline limit.
+ */
+int pipeline_xrun_conceal_underrun(struct pipeline *p, struct comp_dev *dev,
+				   struct comp_buffer __sparse_cache *source,
+				   uint32_t frames);
+
+/**
+ * \brief Resolves an overrun in band by dropping the oldest data.
+ * \param[in] p pipeline.
+ * \param[in] dev Component that runs out of space.
+ * \param[in] sink Buffer the component writes to.
+ * \param[in] frames Number of frames to make room for.
+ * \return 0 if dropped, -EPIPE if the xrun is over the pipeline limit.
+ */
+int pipeline_xrun_drop_overrun(struct pipeline *p, struct comp_dev *dev,
+			       struct comp_buffer __sparse_cache *sink,
+			       uint32_t frames);
+
+/**
+ * \brief Ends an xrun concealed in band, if any.
+ * \param[in] p pipeline.
+ * \param[in] dev Component that reported the xrun.
+ * \param[in] buffer Concealed buffer, faded in after an underrun.
+ */
+void pipeline_xrun_conceal_end(struct pipeline *p, struct comp_dev *dev,
+			       struct comp_buffer __sparse_cache *buffer);
+
 #endif /* __SOF_AUDIO_PIPELINE_H__ */
@@ -51,6 +51,7 @@ struct comp_func_map {
 	uint16_t source;	/**< source frame format */
 	uint32_t out_channels;	/**< number of output stream channels */
 	sel_func sel_func;	/**< selector processing function */
+	uint32_t in_channels;	/**< number of source channels, zero for any */
 };
 
 /** \brief Map of formats with dedicated processing functions. */
@@ -48,6 +48,9 @@ struct src_state {
 	int32_t *out_delay;
 	int32_t *fir_wp;
 	int32_t *out_rp;
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+	const float *coefs_float; /* stage coefficients for float streams */
+#endif
 };
 
 struct polyphase_src {
@@ -115,6 +118,12 @@ void src_polyphase_stage_cir(struct src_stage_prm *s);
 void src_polyphase_stage_cir_s16(struct src_stage_prm *s);
 #endif /* CONFIG_FORMAT_S16LE */
 
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+void src_coefs_to_float(const struct src_stage *stage, float *coefs);
+
+void src_polyphase_stage_cir_float(struct src_stage_prm *s);
+#endif /* CONFIG_FORMAT_FLOAT_PROCESSING */
+
 int src_buffer_lengths(struct src_param *a, int fs_in, int fs_out, int nch,
 		       int source_frames);
 
@@ -29,6 +29,10 @@
 #define __aligned(x) __attribute__((__aligned__(x)))
 #endif
 
+#ifndef __always_inline
+#define __always_inline inline __attribute__((__always_inline__))
+#endif
+
 #ifndef __section
 #define __section(x) __attribute__((section(x)))
 #endif
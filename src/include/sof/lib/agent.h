@@ -17,8 +17,20 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+struct comp_dev;
+struct ipc_msg;
+struct pipeline;
+struct pipeline_budget;
 struct sof;
 
+/* longest pipeline and component copies since the last check */
+struct sa_offender {
+	uint32_t pipe_id;
+	uint32_t pipe_cycles;
+	struct comp_dev *comp;	/* cleared by comp_reset() before it can be freed */
+	uint32_t comp_cycles;
+};
+
 /* simple agent */
 struct sa {
 	uint64_t last_check;	/* time of last activity checking */
@@ -30,8 +42,59 @@ struct sa {
 	struct task work;
 	atomic_t panic_cnt;	/**< ref counter for panic_on_delay property */
 	bool panic_on_delay;	/**< emits panic on delay if true */
+#if CONFIG_AGENT_BUDGET
+	struct sa_offender offender;	/**< reported when a tick is late */
+#endif
+#if CONFIG_AGENT_BYPASS_ON_DELAY
+	struct ipc_msg *bypass_msg;	/**< SOF_CTRL_EVENT_BYPASS notification */
+#endif
 };
 
+#if CONFIG_AGENT_BUDGET
+
+/**
+ * Resets a pipeline budget, the limit is a share of the period.
+ * @param budget Pipeline or component budget to reset.
+ * @param period Pipeline period in us.
+ */
+void sa_budget_init(struct pipeline_budget *budget, uint32_t period);
+
+/**
+ * Accounts a pipeline copy.
+ * @param p Pipeline.
+ * @param cycles Duration of the copy.
+ */
+void sa_budget_pipeline(struct pipeline *p, uint32_t cycles);
+
+/**
+ * Resets a component budget, the limit comes from the topology when it has
+ * one (IPC4 cpc), otherwise the limit of the pipeline applies.
+ * @param dev Component.
+ */
+void sa_budget_comp_init(struct comp_dev *dev);
+
+/**
+ * Scales the component budget limit to the new period of the component.
+ * @param dev Component.
+ * @param old_period Period of the component the limit was set for, in us.
+ */
+void sa_budget_comp_period(struct comp_dev *dev, uint32_t old_period);
+
+/**
+ * Accounts a component copy, against its own limit or that of its pipeline.
+ * @param dev Component.
+ * @param cycles Duration of the copy.
+ */
+void sa_budget_comp(struct comp_dev *dev, uint32_t cycles);
+
+/**
+ * Forgets the copies of a component that is reset.
+ * @param dev Component.
+ */
+void sa_budget_comp_reset(struct comp_dev *dev);
+
+#endif
+
 #if CONFIG_HAVE_AGENT
 
 /**
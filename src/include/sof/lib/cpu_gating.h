@@ -0,0 +1,117 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2022 Intel Corporation. All rights reserved.
+ */
+
+/**
+ * \file include/sof/lib/cpu_gating.h
+ * \brief Automatic secondary core power gating
+ */
+
+#ifndef __SOF_LIB_CPU_GATING_H__
+#define __SOF_LIB_CPU_GATING_H__
+
+#include <sof/schedule/task.h>
+#include <sof/spinlock.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+struct sof;
+
+/** \addtogroup cpu_gating CPU gating
+ *  Secondary cores requested by the host are powered down by the primary
+ *  core once no IPC objects (pipelines, components or buffers) are placed
+ *  on them for CONFIG_CPU_GATING_IDLE_MS, and transparently powered up
+ *  again as soon as the host addresses them.
+ *  @{
+ */
+
+/** \brief Per core gating statistics */
+struct cpu_gating_stats {
+	uint64_t on_cycles;		/**< cycles spent powered while requested */
+	uint64_t off_cycles;		/**< cycles spent gated while requested */
+	uint32_t wake_latency_last;	/**< cycles taken by the last wakeup */
+	uint32_t wake_latency_max;	/**< max cycles taken by a wakeup */
+	uint32_t gate_count;		/**< number of automatic power downs */
+	uint32_t wake_count;		/**< number of automatic power ups */
+};
+
+/** \brief Power state of a requested core, as seen by the policy */
+enum cpu_gating_state {
+	CPU_GATING_ON = 0,	/**< powered, not picked */
+	CPU_GATING_PENDING,	/**< picked for power down by the idle check */
+	CPU_GATING_GATING,	/**< power down handshake in progress */
+	CPU_GATING_GATED,	/**< powered down by the policy */
+};
+
+/** \brief Per core gating state */
+struct cpu_gating_core {
+	struct cpu_gating_stats stats;
+	uint64_t ts;		/**< cycle stamp of the last power transition */
+	enum cpu_gating_state state;
+	bool requested;		/**< host wants the core enabled */
+};
+
+/** \brief Gating policy data, owned by the primary core */
+struct cpu_gating {
+	struct k_spinlock lock;		/**< protects core[] */
+	struct task work;		/**< idle check, runs on primary core */
+	struct task gate_work;		/**< power down of picked cores */
+	uint64_t idle_us;		/**< idle time before a core is gated */
+	struct cpu_gating_core core[CONFIG_CORE_COUNT];
+};
+
+#if CONFIG_CPU_GATING
+
+/**
+ * \brief Initializes the gating policy, must run on the primary core
+ *	  after the schedulers are up.
+ */
+void cpu_gating_init(struct sof *sof);
+
+/**
+ * \brief Records the host request for a secondary core.
+ * \param[in] core Id of the core.
+ * \param[in] enable True if the host enabled the core.
+ */
+void cpu_gating_request(int core, bool enable);
+
+/**
+ * \brief Powers up a core gated by the policy.
+ * \param[in] core Id of the core.
+ * \return 0 if the core is usable, error code otherwise.
+ *
+ * Called by the primary core before any IPC work is forwarded to the core.
+ */
+int cpu_gating_wake(int core);
+
+/**
+ * \brief (Re)starts the idle countdown, must run on the primary core.
+ */
+void cpu_gating_arm(void);
+
+/**
+ * \brief Retrieves the gating statistics of a core.
+ * \param[in] core Id of the core.
+ * \param[out] stats Statistics, residency accounted up to now.
+ * \return 0 if successful, error code otherwise.
+ */
+int cpu_gating_get_stats(int core, struct cpu_gating_stats *stats);
+
+#else
+
+static inline void cpu_gating_init(struct sof *sof) { }
+static inline void cpu_gating_request(int core, bool enable) { }
+static inline int cpu_gating_wake(int core) { return 0; }
+static inline void cpu_gating_arm(void) { }
+static inline int cpu_gating_get_stats(int core, struct cpu_gating_stats *stats)
+{
+	return -ENODEV;
+}
+
+#endif
+
+/** @}*/
+
+#endif /* __SOF_LIB_CPU_GATING_H__ */
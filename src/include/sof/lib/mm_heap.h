@@ -104,6 +104,21 @@ void heap_trace(struct mm_heap *heap, int size);
 int heap_info(enum mem_zone zone, int index, struct mm_info *out);
 #endif
 
+#if CONFIG_LIBRARY
+/** Starts tracking of all library allocations, must be called before the
+ * first allocation to get the whole heap covered.
+ */
+void heap_snapshot_enable(void);
+
+/** Saves contents of all live allocations and of the sof context */
+void heap_snapshot_take(void);
+
+/** Frees allocations made after heap_snapshot_take() and restores contents
+ * of the older ones, including those freed in the meantime.
+ */
+void heap_snapshot_restore(void);
+#endif
+
 /* retrieve memory map pointer */
 static inline struct mm *memmap_get(void)
 {
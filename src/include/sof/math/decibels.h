@@ -19,4 +19,8 @@
 int32_t exp_fixed(int32_t x); /* Input is Q5.27, output is Q12.20 */
 int32_t db2lin_fixed(int32_t x); /* Input is Q8.24, output is Q12.20 */
 
+/* Block versions for processing of arrays, input and output can be the same array */
+void exp_fixed_vec(const int32_t *x, int32_t *y, int n); /* Input Q5.27, output Q12.20 */
+void db2lin_fixed_vec(const int32_t *db, int32_t *y, int n); /* Input Q8.24, output Q12.20 */
+
 #endif /* __SOF_MATH_DECIBELS_H__ */
@@ -0,0 +1,41 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2022 Intel Corporation. All rights reserved.
+ */
+
+#ifndef __SOF_MATH_FIR_FLOAT_H__
+#define __SOF_MATH_FIR_FLOAT_H__
+
+#include <sof/math/fir_config.h>
+
+#if FIR_GENERIC
+
+#include <sof/math/fir_generic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+struct fir_state_float {
+	int wi; /* Write index */
+	int taps; /* Number of FIR taps, zero for bypass */
+	float *coef; /* Pointer to FIR coefficients in reverse order */
+	float *delay; /* Pointer to FIR delay line, two copies of taps */
+};
+
+/* Bytes needed for coefficients and delay line of the float version */
+size_t fir_size_float(const struct fir_state_32x16 *fir);
+
+/* Converts the Q1.15 coefficients and output shift of a fixed point FIR
+ * set up with fir_init_coef() to float. Coefficients and a cleared delay
+ * line are placed to *data, which is advanced past them.
+ */
+void fir_init_float(struct fir_state_float *fir,
+		    const struct fir_state_32x16 *fixed, float **data);
+
+void fir_reset_float(struct fir_state_float *fir);
+
+/* Filters n samples from x to y, consecutive samples are stride apart */
+void fir_float(struct fir_state_float *fir, const float *x, float *y,
+	       int n, int stride);
+
+#endif
+#endif /* __SOF_MATH_FIR_FLOAT_H__ */
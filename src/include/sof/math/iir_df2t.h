@@ -49,6 +49,9 @@
 
 #define IIR_DF2T_NUM_DELAYS 2
 
+/* Maximum number of streams filtered together by iir_df2t_lanes() */
+#define IIR_DF2T_LANES_MAX 8
+
 struct iir_state_df2t {
 	unsigned int biquads; /* Number of IIR 2nd order sections total */
 	unsigned int biquads_in_series; /* Number of IIR 2nd order sections
@@ -75,6 +78,9 @@ void iir_reset_df2t(struct iir_state_df2t *iir);
 
 int32_t iir_df2t(struct iir_state_df2t *iir, int32_t x);
 
+void iir_df2t_lanes(const struct iir_state_df2t *iir, int64_t *delay, int32_t *data,
+		    int frames, int lanes);
+
 /* Inline functions with or without HiFi3 intrinsics */
 #if IIR_HIFI3
 #include "iir_df2t_hifi3.h"
@@ -0,0 +1,43 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2022 Intel Corporation. All rights reserved.
+ */
+
+#ifndef __SOF_MATH_IIR_DF2T_FLOAT_H__
+#define __SOF_MATH_IIR_DF2T_FLOAT_H__
+
+#include <sof/math/iir_df2t.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Coefficients per biquad {a2, a1, b2, b1, b0, gain}, the output shift
+ * of the fixed point biquad is included in gain.
+ */
+#define IIR_DF2T_FLOAT_NCOEF	6
+
+struct iir_state_df2t_float {
+	unsigned int biquads; /* Number of IIR 2nd order sections total */
+	unsigned int biquads_in_series; /* Number of IIR 2nd order sections
+					 * in series.
+					 */
+	float *coef; /* Pointer to IIR coefficients */
+	float *delay; /* Pointer to IIR delay line */
+};
+
+/* Bytes needed for coefficients and delay line of the float version */
+size_t iir_size_df2t_float(const struct iir_state_df2t *iir);
+
+/* Converts the Q-format coefficients of a fixed point IIR set up with
+ * iir_init_coef_df2t() to float. Coefficients and a cleared delay line
+ * are placed to *data, which is advanced past them.
+ */
+void iir_init_df2t_float(struct iir_state_df2t_float *iir,
+			 const struct iir_state_df2t *fixed, float **data);
+
+void iir_reset_df2t_float(struct iir_state_df2t_float *iir);
+
+/* Filters n samples from x to y, consecutive samples are stride apart */
+void iir_df2t_float(struct iir_state_df2t_float *iir, const float *x,
+		    float *y, int n, int stride);
+
+#endif /* __SOF_MATH_IIR_DF2T_FLOAT_H__ */
@@ -18,4 +18,9 @@ int32_t base2_logarithm(uint32_t u);
 uint32_t ln_int32(uint32_t numerator);
 uint32_t log10_int32(uint32_t numerator);
 
+/* Block versions, input and output can be the same array */
+void base2_logarithm_vec(const uint32_t *u, int32_t *y, int n);
+void ln_int32_vec(const uint32_t *numerator, uint32_t *y, int n);
+void log10_int32_vec(const uint32_t *numerator, uint32_t *y, int n);
+
 #endif
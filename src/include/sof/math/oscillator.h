@@ -0,0 +1,54 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2022 Intel Corporation. All rights reserved.
+ */
+
+#ifndef __SOF_MATH_OSCILLATOR_H__
+#define __SOF_MATH_OSCILLATOR_H__
+
+#include <stdint.h>
+
+/* Phase is a fraction of a full turn in Q0.32, it wraps around without
+ * compares when the step is added.
+ */
+#define OSC_QUARTER_TURN	0x40000000u
+#define OSC_HALF_TURN		0x80000000u
+
+/* Quarter wave table resolution, 2^OSC_TABLE_BITS points per quarter */
+#define OSC_TABLE_BITS		8
+#define OSC_TABLE_SIZE		((1 << OSC_TABLE_BITS) + 1)
+
+struct osc_state {
+	uint32_t phase;		/* Q0.32 turns */
+	uint32_t step;		/* Q0.32 turns per sample, max half turn */
+	int32_t amplitude;	/* Q1.31 */
+};
+
+/* Set frequency f as Q16.16 Hz for sample rate fs, f is limited to fs/2 */
+void osc_set_freq(struct osc_state *osc, int32_t f, int32_t fs);
+
+/* Set frequency, amplitude as Q1.31 and reset the phase */
+void osc_init(struct osc_state *osc, int32_t f, int32_t fs, int32_t amplitude);
+
+/* sin() and cos() of phase in Q0.32 turns, output is Q1.31 */
+int32_t osc_sin_fixed(uint32_t phase);
+
+static inline int32_t osc_cos_fixed(uint32_t phase)
+{
+	return osc_sin_fixed(phase + OSC_QUARTER_TURN);
+}
+
+/* Generate n samples of one oscillator to y with stride between samples */
+void osc_sin_block(struct osc_state *osc, int32_t *y, int stride, int n);
+
+/* Generate n frames of num oscillators to interleaved y, oscillator ch
+ * is channel ch.
+ */
+void osc_bank_sin(struct osc_state *osc, int num, int32_t *y, int n);
+
+/* Generate n samples of the saturated sum of num oscillators to y with
+ * stride between samples, e.g. a multitone.
+ */
+void osc_bank_sum(struct osc_state *osc, int num, int32_t *y, int stride, int n);
+
+#endif /* __SOF_MATH_OSCILLATOR_H__ */
@@ -12,4 +12,7 @@
 #include <stdint.h>
 
 uint16_t sqrt_int16(uint16_t u);
+
+/* Block version, input and output can be the same array */
+void sqrt_int16_vec(const uint16_t *u, uint16_t *y, int n);
 #endif
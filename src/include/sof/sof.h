@@ -14,6 +14,7 @@
 
 struct cascade_root;
 struct clock_info;
+struct cpu_gating;
 struct comp_driver_list;
 struct dai_info;
 struct dma_info;
@@ -101,6 +102,9 @@ struct sof {
 	/* pipelines stream position */
 	struct pipeline_posn *pipeline_posn;
 
+	/* automatic secondary core gating */
+	struct cpu_gating *cpu_gating;
+
 	__aligned(PLATFORM_DCACHE_ALIGN) int alignment[0];
 } __aligned(PLATFORM_DCACHE_ALIGN);
 
@@ -62,6 +62,8 @@ struct tr_ctx;
 #define TRACE_BOOT_SYS_TRACES		(TRACE_BOOT_SYS + 0x200)
 #define TRACE_BOOT_SYS_NOTIFIER		(TRACE_BOOT_SYS + 0x300)
 #define TRACE_BOOT_SYS_POWER		(TRACE_BOOT_SYS + 0x400)
+#define TRACE_BOOT_SYS_COMP		(TRACE_BOOT_SYS + 0x500)
+#define TRACE_BOOT_SYS_READY		(TRACE_BOOT_SYS + 0x600)
 
 /* platform/device specific codes */
 #define TRACE_BOOT_PLATFORM_ENTRY	(TRACE_BOOT_PLATFORM + 0x100)
@@ -249,10 +251,27 @@ do {											\
 
 #define trace_point(x)  do {} while (0)
 
+static inline void boot_profile_dump(void) { }
+
 #else  /* CONFIG_LIBRARY */
 
+#if CONFIG_BOOT_PROFILE && !defined(__BOOT_LOADER__)
+/* records a timestamp for each boot trace point */
+void boot_profile_point(uint32_t point);
+
+/* logs the boot stages of the current core */
+void boot_profile_dump(void);
+
+#define trace_point(x) do {			\
+		platform_trace_point(x);	\
+		boot_profile_point(x);		\
+	} while (0)
+#else
 #define trace_point(x) platform_trace_point(x)
 
+static inline void boot_profile_dump(void) { }
+#endif
+
 #define BASE_LOG_ASSERT_FAIL_MSG \
 unsupported_amount_of_params_in_trace_event\
 _thrown_from_macro_BASE_LOG_in_trace_h
@@ -316,6 +335,7 @@ do {									\
 
 #define trace_point(x)  do {} while (0)
 
+static inline void boot_profile_dump(void) { }
 static inline void trace_flush_dma_to_mbox(void) { }
 static inline void trace_on(void) { }
 static inline void trace_off(void) { }
@@ -13,6 +13,7 @@
 #include <sof/drivers/interrupt.h>
 #include <sof/init.h>
 #include <sof/lib/cpu.h>
+#include <sof/lib/cpu_gating.h>
 #include <sof/lib/memory.h>
 #include <sof/lib/mm_heap.h>
 #include <sof/lib/notifier.h>
@@ -118,6 +119,7 @@ static int secondary_core_restore(void)
 		return err;
 
 	trace_point(TRACE_BOOT_PLATFORM);
+	boot_profile_dump();
 
 	/* In restore case (D0ix->D0 flow) we do not have to invoke here
 	 * schedule_task(*task_main_get(), 0, UINT64_MAX) as it is done in
@@ -173,6 +175,7 @@ int secondary_core_init(struct sof *sof)
 		return err;
 
 	trace_point(TRACE_BOOT_PLATFORM);
+	boot_profile_dump();
 
 #ifndef __ZEPHYR__
 	/* task initialized in edf_scheduler_init */
@@ -219,6 +222,8 @@ static int primary_core_init(int argc, char *argv[], struct sof *sof)
 	if (platform_init(sof) < 0)
 		panic(SOF_IPC_PANIC_PLATFORM);
 
+	cpu_gating_init(sof);
+
 	trace_point(TRACE_BOOT_PLATFORM);
 
 #if CONFIG_NO_SECONDARY_CORE_ROM
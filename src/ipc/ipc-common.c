@@ -18,6 +18,7 @@
 #include <sof/lib/alloc.h>
 #include <sof/lib/cache.h>
 #include <sof/lib/cpu.h>
+#include <sof/lib/cpu_gating.h>
 #include <sof/lib/mailbox.h>
 #include <sof/list.h>
 #include <sof/platform.h>
@@ -46,6 +47,11 @@ int ipc_process_on_core(uint32_t core, bool blocking)
 	struct idc_msg msg = { .header = IDC_MSG_IPC, .core = core, };
 	int ret;
 
+	/* power up the core if it was gated while idle */
+	ret = cpu_gating_wake(core);
+	if (ret < 0)
+		return ret;
+
 	/* check if requested core is enabled */
 	if (!cpu_is_core_enabled(core)) {
 		tr_err(&ipc_tr, "ipc_process_on_core(): core #%d is disabled", core);
@@ -74,6 +80,9 @@ int ipc_process_on_core(uint32_t core, bool blocking)
 	if (ret < 0)
 		return ret;
 
+	/* the core may become idle after this message, check it later */
+	cpu_gating_arm();
+
 	/* reply written by other core */
 	return 1;
 }
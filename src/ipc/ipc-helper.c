@@ -206,6 +206,13 @@ int ipc_pipeline_complete(struct ipc *ipc, uint32_t comp_id)
 		return -EINVAL;
 	}
 
+	/* check type */
+	if (ipc_pipe->type != COMP_TYPE_PIPELINE) {
+		tr_err(&ipc_tr, "ipc_pipeline_complete(): comp id: %d is not a PIPELINE",
+		       comp_id);
+		return -EINVAL;
+	}
+
 	/* check core */
 	if (!cpu_is_me(ipc_pipe->core))
 		return ipc_process_on_core(ipc_pipe->core, false);
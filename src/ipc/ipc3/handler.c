@@ -26,6 +26,7 @@
 #include <sof/lib/agent.h>
 #include <sof/lib/alloc.h>
 #include <sof/lib/cache.h>
+#include <sof/lib/cpu_gating.h>
 #include <sof/lib/mailbox.h>
 #include <sof/lib/mm_heap.h>
 #include <sof/lib/pm_runtime.h>
@@ -203,7 +204,7 @@ static int ipc_stream_pcm_params(uint32_t stream)
 
 	/* get the pcm_dev */
 	pcm_dev = ipc_get_comp_by_id(ipc, pcm_params.comp_id);
-	if (!pcm_dev) {
+	if (!pcm_dev || pcm_dev->type != COMP_TYPE_COMPONENT) {
 		tr_err(&ipc_tr, "ipc: comp %d not found", pcm_params.comp_id);
 		return -ENODEV;
 	}
@@ -350,7 +351,7 @@ static int ipc_stream_pcm_free(uint32_t header)
 
 	/* get the pcm_dev */
 	pcm_dev = ipc_get_comp_by_id(ipc, free_req.comp_id);
-	if (!pcm_dev) {
+	if (!pcm_dev || pcm_dev->type != COMP_TYPE_COMPONENT) {
 		tr_err(&ipc_tr, "ipc: comp %d not found", free_req.comp_id);
 		return -ENODEV;
 	}
@@ -387,7 +388,7 @@ static int ipc_stream_position(uint32_t header)
 
 	/* get the pcm_dev */
 	pcm_dev = ipc_get_comp_by_id(ipc, stream.comp_id);
-	if (!pcm_dev) {
+	if (!pcm_dev || pcm_dev->type != COMP_TYPE_COMPONENT) {
 		tr_err(&ipc_tr, "ipc: comp %d not found", stream.comp_id);
 		return -ENODEV;
 	}
@@ -436,7 +437,7 @@ static int ipc_stream_trigger(uint32_t header)
 
 	/* get the pcm_dev */
 	pcm_dev = ipc_get_comp_by_id(ipc, stream.comp_id);
-	if (!pcm_dev) {
+	if (!pcm_dev || pcm_dev->type != COMP_TYPE_COMPONENT) {
 		tr_err(&ipc_tr, "ipc: comp %d not found", stream.comp_id);
 		return -ENODEV;
 	}
@@ -475,6 +476,14 @@ static int ipc_stream_trigger(uint32_t header)
 		return -EINVAL;
 	}
 
+	/* the scheduling component must have been reached on pipeline complete */
+	if (!pcm_dev->cd->pipeline->sched_comp ||
+	    !pcm_dev->cd->pipeline->sched_comp->pipeline) {
+		tr_err(&ipc_tr, "ipc: comp %d pipeline not complete",
+		       stream.comp_id);
+		return -EINVAL;
+	}
+
 	/*
 	 * Trigger the component: timer domain pipelines offload some trigger
 	 * operations in their pipeline tasks, in which case IPC response to
@@ -506,6 +515,99 @@ static int ipc_stream_trigger(uint32_t header)
 	return ret;
 }
 
+/* change the period of a running stream */
+static int ipc_stream_period(uint32_t header)
+{
+	struct ipc *ipc = ipc_get();
+	struct sof_ipc_stream_period period;
+	struct ipc_comp_dev *pcm_dev;
+	int ret;
+
+	/* copy message with ABI safe method */
+	IPC_COPY_CMD(period, ipc->comp_data);
+
+	/* get the pcm_dev */
+	pcm_dev = ipc_get_comp_by_id(ipc, period.comp_id);
+	if (!pcm_dev || pcm_dev->type != COMP_TYPE_COMPONENT) {
+		tr_err(&ipc_tr, "ipc: comp %d not found", period.comp_id);
+		return -ENODEV;
+	}
+
+	/* check core */
+	if (!cpu_is_me(pcm_dev->core))
+		return ipc_process_on_core(pcm_dev->core, false);
+
+	tr_info(&ipc_tr, "ipc: comp %d -> period %u us", period.comp_id,
+		period.period);
+
+	if (!pcm_dev->cd->pipeline) {
+		tr_err(&ipc_tr, "ipc: comp %d pipeline not found",
+		       period.comp_id);
+		return -EINVAL;
+	}
+
+	ret = pipeline_set_period(pcm_dev->cd->pipeline, period.period);
+	if (ret < 0)
+		tr_err(&ipc_tr, "ipc: comp %d period %u us failed %d",
+		       period.comp_id, period.period, ret);
+
+	return ret;
+}
+
+/* get end to end latency of the frames leaving a pipeline */
+static int ipc_stream_latency(uint32_t header)
+{
+	struct ipc *ipc = ipc_get();
+	struct sof_ipc_stream stream;
+	struct sof_ipc_stream_latency latency;
+	struct ipc_comp_dev *pcm_dev;
+	struct comp_dev *sink;
+
+	/* copy message with ABI safe method */
+	IPC_COPY_CMD(stream, ipc->comp_data);
+
+	/* get the pcm_dev */
+	pcm_dev = ipc_get_comp_by_id(ipc, stream.comp_id);
+	if (!pcm_dev || pcm_dev->type != COMP_TYPE_COMPONENT) {
+		tr_err(&ipc_tr, "ipc: comp %d not found", stream.comp_id);
+		return -ENODEV;
+	}
+
+	/* check core */
+	if (!cpu_is_me(pcm_dev->core))
+		return ipc_process_on_core(pcm_dev->core, false);
+
+	tr_info(&ipc_tr, "ipc: comp %d -> latency", stream.comp_id);
+
+	if (!pcm_dev->cd->pipeline) {
+		tr_err(&ipc_tr, "ipc: comp %d pipeline not found",
+		       stream.comp_id);
+		return -EINVAL;
+	}
+
+	/*
+	 * the latency is recorded by the pipeline of the endpoint the frames
+	 * leave through, the DAI on playback or the host itself on capture
+	 */
+	sink = pipeline_get_dai_comp(pcm_dev->cd->pipeline->pipeline_id, PPL_DIR_DOWNSTREAM);
+	if (!sink || !sink->pipeline) {
+		tr_err(&ipc_tr, "ipc: comp %d sink endpoint not found",
+		       stream.comp_id);
+		return -EINVAL;
+	}
+
+	memset(&latency, 0, sizeof(latency));
+	latency.rhdr.hdr.cmd = header;
+	latency.rhdr.hdr.size = sizeof(latency);
+	latency.comp_id = stream.comp_id;
+
+	pipeline_get_latency(sink->pipeline, &latency);
+
+	mailbox_hostbox_write(0, &latency, sizeof(latency));
+
+	return 1;
+}
+
 static int ipc_glb_stream_message(uint32_t header)
 {
 	uint32_t cmd = iCS(header);
@@ -524,6 +626,10 @@ static int ipc_glb_stream_message(uint32_t header)
 		return ipc_stream_trigger(header);
 	case SOF_IPC_STREAM_POSITION:
 		return ipc_stream_position(header);
+	case SOF_IPC_STREAM_PCM_PERIOD:
+		return ipc_stream_period(header);
+	case SOF_IPC_STREAM_LATENCY:
+		return ipc_stream_latency(header);
 	default:
 		tr_err(&ipc_tr, "ipc: unknown stream cmd 0x%x", cmd);
 		return -EINVAL;
@@ -723,7 +829,9 @@ static int ipc_pm_core_enable(uint32_t header)
 					tr_err(&ipc_tr, "Failed to enable core %d", i);
 					return ret;
 				}
+				cpu_gating_request(i, true);
 			} else {
+				cpu_gating_request(i, false);
 				cpu_disable_core(i);
 			}
 		}
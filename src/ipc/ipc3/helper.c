@@ -75,24 +75,12 @@ void ipc_build_trace_posn(struct sof_ipc_dma_trace_posn *posn)
 
 static const struct comp_driver *get_drv(struct sof_ipc_comp *comp)
 {
-	struct comp_driver_list *drivers = comp_drivers_get();
-	struct list_item *clist;
 	const struct comp_driver *drv = NULL;
-	struct comp_driver_info *info;
 	struct sof_ipc_comp_ext *comp_ext;
-	k_spinlock_key_t key;
 
 	/* do we have extended data ? */
 	if (!comp->ext_data_length) {
-		/* search driver list for driver type */
-		list_for_item(clist, &drivers->list) {
-			info = container_of(clist, struct comp_driver_info, list);
-			if (info->drv->type == comp->type) {
-				drv = info->drv;
-				break;
-			}
-		}
-
+		drv = comp_driver_find_type(comp->type);
 		if (!drv)
 			tr_err(&comp_tr, "get_drv(): driver not found, comp->type = %u",
 			       comp->type);
@@ -121,19 +109,7 @@ static const struct comp_driver *get_drv(struct sof_ipc_comp *comp)
 		goto out;
 	}
 
-	/* search driver list with UUID */
-	key = k_spin_lock(&drivers->lock);
-
-	list_for_item(clist, &drivers->list) {
-		info = container_of(clist, struct comp_driver_info,
-				    list);
-		if (!memcmp(info->drv->uid, comp_ext->uuid,
-			    UUID_SIZE)) {
-			drv = info->drv;
-			break;
-		}
-	}
-
+	drv = comp_driver_find_uuid(comp_ext->uuid);
 	if (!drv)
 		tr_err(&comp_tr,
 		       "get_drv(): the provided UUID (%8x%8x%8x%8x) doesn't match to any driver!",
@@ -142,8 +118,6 @@ static const struct comp_driver *get_drv(struct sof_ipc_comp *comp)
 		       *(uint32_t *)(&comp_ext->uuid[8]),
 		       *(uint32_t *)(&comp_ext->uuid[12]));
 
-	k_spin_unlock(&drivers->lock, key);
-
 out:
 	if (drv)
 		tr_dbg(&comp_tr, "get_drv(), found driver type %d, uuid %pU",
@@ -564,6 +538,12 @@ static int ipc_comp_to_buffer_connect(struct ipc_comp_dev *comp,
 	tr_dbg(&ipc_tr, "ipc: comp sink %d, source %d -> connect", buffer->id,
 	       comp->id);
 
+	/* relinking a connected buffer would corrupt the component lists */
+	if (buffer->cb->source) {
+		tr_err(&ipc_tr, "ipc: buffer %d already has a source", buffer->id);
+		return -EINVAL;
+	}
+
 	return comp_buffer_connect(comp->cd, comp->core, buffer->cb,
 				   PPL_CONN_DIR_COMP_TO_BUFFER);
 }
@@ -574,6 +554,11 @@ static int ipc_buffer_to_comp_connect(struct ipc_comp_dev *buffer,
 	tr_dbg(&ipc_tr, "ipc: comp sink %d, source %d -> connect", comp->id,
 	       buffer->id);
 
+	if (buffer->cb->sink) {
+		tr_err(&ipc_tr, "ipc: buffer %d already has a sink", buffer->id);
+		return -EINVAL;
+	}
+
 	return comp_buffer_connect(comp->cd, comp->core, buffer->cb,
 				   PPL_CONN_DIR_BUFFER_TO_COMP);
 }
@@ -19,6 +19,7 @@
 #include <sof/ipc/common.h>
 #include <sof/ipc/msg.h>
 #include <sof/ipc/driver.h>
+#include <sof/lib/cpu_gating.h>
 #include <sof/lib/mailbox.h>
 #include <sof/lib/pm_runtime.h>
 #include <sof/math/numbers.h>
@@ -857,7 +858,9 @@ static int ipc4_module_process_dx(struct ipc4_message_request *ipc4)
 				tr_err(&ipc_tr, "failed to enable core %d", core_id);
 				return IPC4_FAILURE;
 			}
+			cpu_gating_request(core_id, true);
 		} else {
+			cpu_gating_request(core_id, false);
 			cpu_disable_core(core_id);
 			if (cpu_is_core_enabled(core_id)) {
 				tr_err(&ipc_tr, "failed to disable core %d", core_id);
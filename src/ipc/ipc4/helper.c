@@ -51,6 +51,7 @@ void ipc_build_stream_posn(struct sof_ipc_stream_posn *posn, uint32_t type,
 void ipc_build_comp_event(struct sof_ipc_comp_event *event, uint32_t type,
 			  uint32_t id)
 {
+	memset(event, 0, sizeof(*event));
 }
 
 bool ipc_trigger_trace_xfer(uint32_t avail)
@@ -752,26 +753,13 @@ int ipc4_trigger_chain_dma(struct ipc *ipc, struct ipc4_chain_dma *cdma)
 
 const struct comp_driver *ipc4_get_drv(uint8_t *uuid)
 {
-	struct comp_driver_list *drivers = comp_drivers_get();
-	struct list_item *clist;
-	const struct comp_driver *drv = NULL;
-	struct comp_driver_info *info;
-	uint32_t flags;
-
-	irq_local_disable(flags);
+	const struct comp_driver *drv;
 
-	/* search driver list with UUID */
-	list_for_item(clist, &drivers->list) {
-		info = container_of(clist, struct comp_driver_info,
-				    list);
-		if (!memcmp(info->drv->uid, uuid, UUID_SIZE)) {
-			tr_dbg(&comp_tr,
-			       "found type %d, uuid %pU",
-			       info->drv->type,
-			       info->drv->tctx->uuid_p);
-			drv = info->drv;
-			goto out;
-		}
+	drv = comp_driver_find_uuid(uuid);
+	if (drv) {
+		tr_dbg(&comp_tr, "found type %d, uuid %pU", drv->type,
+		       drv->tctx->uuid_p);
+		return drv;
 	}
 
 	tr_err(&comp_tr, "get_drv(): the provided UUID (%8x %8x %8x %8x) can't be found!",
@@ -780,9 +768,7 @@ const struct comp_driver *ipc4_get_drv(uint8_t *uuid)
 	       *(uint32_t *)(&uuid[8]),
 	       *(uint32_t *)(&uuid[12]));
 
-out:
-	irq_local_enable(flags);
-	return drv;
+	return NULL;
 }
 
 const struct comp_driver *ipc4_get_comp_drv(int module_id)
@@ -11,12 +11,24 @@
  * tick. If the core exceeds the threshold by over 5% then the SA will emit
  * error trace. However if it will be exceeded by over 100% the panic will be
  * called.
+ *
+ * With CONFIG_AGENT_BUDGET every pipeline and component copy is measured, so a
+ * late tick is reported with the pipeline and the component that took the
+ * longest and the state of the component buffers. With
+ * CONFIG_AGENT_BYPASS_ON_DELAY that component is bypassed instead of panicking,
+ * and the host is notified.
  */
 
+#include <sof/audio/buffer.h>
+#include <sof/audio/component.h>
+#include <sof/audio/pipeline.h>
 #include <sof/drivers/timer.h>
+#include <sof/ipc/msg.h>
+#include <sof/ipc/topology.h>
 #include <sof/lib/agent.h>
 #include <sof/lib/alloc.h>
 #include <sof/lib/clk.h>
+#include <sof/lib/cpu.h>
 #include <sof/lib/memory.h>
 #include <sof/lib/uuid.h>
 #include <sof/debug/panic.h>
@@ -25,9 +37,12 @@
 #include <sof/schedule/schedule.h>
 #include <sof/schedule/task.h>
 #include <sof/sof.h>
+#include <sof/string.h>
 #include <sof/trace/trace.h>
+#include <ipc/control.h>
 #include <ipc/topology.h>
 #include <ipc/trace.h>
+#include <ipc4/base-config.h>
 #include <user/trace.h>
 #include <limits.h>
 #include <stdbool.h>
@@ -69,6 +84,176 @@ static void perf_avg_sa_trace(struct perf_cnt_data *pcd, int ignored)
 
 #endif
 
+#if CONFIG_AGENT_BUDGET
+void sa_budget_init(struct pipeline_budget *budget, uint32_t period)
+{
+	budget->cycles = 0;
+	budget->cycles_max = 0;
+	budget->limit = k_us_to_cyc_ceil64(period) * CONFIG_AGENT_BUDGET_PCT / 100;
+	budget->overruns = 0;
+}
+
+/* returns true when the copy is over the limit */
+static bool sa_budget_account(struct pipeline_budget *budget, uint32_t limit, uint32_t cycles)
+{
+	budget->cycles = cycles;
+	if (cycles > budget->cycles_max)
+		budget->cycles_max = cycles;
+
+	if (!limit || cycles <= limit)
+		return false;
+
+	budget->overruns++;
+
+	/* trace the first overrun and then less and less often */
+	return is_power_of_2(budget->overruns);
+}
+
+void sa_budget_pipeline(struct pipeline *p, uint32_t cycles)
+{
+	struct sa *sa = sof_get()->sa;
+
+	if (sa_budget_account(&p->budget, p->budget.limit, cycles))
+		pipe_warn(p, "sa_budget_pipeline(): %u cycles, limit %u, overruns %u",
+			  cycles, p->budget.limit, p->budget.overruns);
+
+	/* the agent only checks its own core */
+	if (sa && cpu_get_id() == sa->work.core && cycles > sa->offender.pipe_cycles) {
+		sa->offender.pipe_id = p->pipeline_id;
+		sa->offender.pipe_cycles = cycles;
+	}
+}
+
+void sa_budget_comp_init(struct comp_dev *dev)
+{
+#if CONFIG_IPC_MAJOR_4
+	struct ipc4_base_module_cfg base_cfg;
+#endif
+	uint32_t limit = 0;
+
+#if CONFIG_IPC_MAJOR_4
+	/* the topology gives the worst cycles of one chunk, that is one copy */
+	if (dev->drv->ops.get_attribute &&
+	    !dev->drv->ops.get_attribute(dev, COMP_ATTR_BASE_CONFIG, &base_cfg))
+		limit = base_cfg.cpc;
+#endif
+
+	sa_budget_comp_reset(dev);
+	dev->budget.limit = limit;
+}
+
+void sa_budget_comp_period(struct comp_dev *dev, uint32_t old_period)
+{
+	if (old_period)
+		dev->budget.limit = (uint64_t)dev->budget.limit * dev->period / old_period;
+}
+
+void sa_budget_comp(struct comp_dev *dev, uint32_t cycles)
+{
+	struct sa *sa = sof_get()->sa;
+	uint32_t limit = dev->budget.limit;
+
+	/* without a budget of its own the component may take the whole pipeline's */
+	if (!limit && dev->pipeline)
+		limit = dev->pipeline->budget.limit;
+
+	if (sa_budget_account(&dev->budget, limit, cycles))
+		comp_warn(dev, "sa_budget_comp(): %u cycles, limit %u, overruns %u",
+			  cycles, limit, dev->budget.overruns);
+
+	if (sa && cpu_get_id() == sa->work.core && cycles > sa->offender.comp_cycles) {
+		sa->offender.comp = dev;
+		sa->offender.comp_cycles = cycles;
+	}
+}
+
+void sa_budget_comp_reset(struct comp_dev *dev)
+{
+	struct sa *sa = sof_get()->sa;
+
+	memset(&dev->budget, 0, sizeof(dev->budget));
+
+	if (sa && sa->offender.comp == dev) {
+		sa->offender.comp = NULL;
+		sa->offender.comp_cycles = 0;
+	}
+}
+
+static void sa_report_buffer(struct comp_buffer *buffer)
+{
+	struct comp_buffer __sparse_cache *buffer_c = buffer_acquire(buffer);
+
+	tr_err(&sa_tr, "validate(), buffer comp %u -> comp %u avail %u free %u",
+	       buffer_c->source ? dev_comp_id(buffer_c->source) : 0,
+	       buffer_c->sink ? dev_comp_id(buffer_c->sink) : 0,
+	       audio_stream_get_avail_bytes(&buffer_c->stream),
+	       audio_stream_get_free_bytes(&buffer_c->stream));
+
+	buffer_release(buffer_c);
+}
+
+/* reports the longest copies of the late tick */
+static void sa_report(struct sa *sa)
+{
+	struct sa_offender *offender = &sa->offender;
+	struct list_item *clist;
+	struct comp_dev *dev;
+
+	tr_err(&sa_tr, "validate(), longest pipeline %u: %u cycles",
+	       offender->pipe_id, offender->pipe_cycles);
+
+	dev = offender->comp;
+	if (!dev)
+		return;
+
+	tr_err(&sa_tr, "validate(), longest comp %u pipeline %u: %u cycles, max %u",
+	       dev_comp_id(dev), dev->pipeline ? dev->pipeline->pipeline_id : 0,
+	       offender->comp_cycles, dev->budget.cycles_max);
+
+	list_for_item(clist, &dev->bsource_list)
+		sa_report_buffer(container_of(clist, struct comp_buffer, sink_list));
+
+	list_for_item(clist, &dev->bsink_list)
+		sa_report_buffer(container_of(clist, struct comp_buffer, source_list));
+}
+#endif
+
+#if CONFIG_AGENT_BYPASS_ON_DELAY
+static void sa_bypass_notify(struct sa *sa, struct comp_dev *dev)
+{
+	struct sof_ipc_comp_event event;
+
+	if (!sa->bypass_msg)
+		return;
+
+	ipc_build_comp_event(&event, dev->ipc_config.type, dev_comp_id(dev));
+	event.event_type = SOF_CTRL_EVENT_BYPASS;
+	event.num_elems = 0;
+	event.event_value = 1;
+
+	/* one message for all components, a queued one is sent with the last id */
+	sa->bypass_msg->header = event.rhdr.hdr.cmd;
+	ipc_msg_send(sa->bypass_msg, &event, false);
+}
+
+/* degrades the audio rather than the whole DSP, only done once per component */
+static bool sa_bypass(struct sa *sa)
+{
+	struct comp_dev *dev = sa->offender.comp;
+
+	if (!dev || dev->bypass || !comp_can_bypass(dev))
+		return false;
+
+	comp_err(dev, "sa_bypass(), bypassing the component after a late tick");
+	dev->bypass = true;
+	sa_bypass_notify(sa, dev);
+
+	return true;
+}
+#elif CONFIG_AGENT_PANIC_ON_DELAY
+#define sa_bypass(sa) false
+#endif
+
 static enum task_state validate(void *data)
 {
 	struct sa *sa = data;
@@ -81,9 +266,14 @@ static enum task_state validate(void *data)
 	perf_cnt_stamp(&sa->pcd, perf_sa_trace, 0 /* ignored */);
 	perf_cnt_average(&sa->pcd, perf_avg_sa_trace, 0 /* ignored */);
 
+#if CONFIG_AGENT_BUDGET
+	if (delta > sa->warn_timeout)
+		sa_report(sa);
+#endif
+
 #if CONFIG_AGENT_PANIC_ON_DELAY
 	/* panic timeout */
-	if (sa->panic_on_delay && delta > sa->panic_timeout)
+	if (sa->panic_on_delay && delta > sa->panic_timeout && !sa_bypass(sa))
 		panic(SOF_IPC_PANIC_IDLE);
 #endif
 
@@ -96,6 +286,11 @@ static enum task_state validate(void *data)
 				(unsigned int)delta);
 	}
 
+#if CONFIG_AGENT_BUDGET
+	/* start over for the next tick */
+	memset(&sa->offender, 0, sizeof(sa->offender));
+#endif
+
 	/* update last_check to current */
 	sa->last_check = current;
 
@@ -104,6 +299,9 @@ static enum task_state validate(void *data)
 
 void sa_init(struct sof *sof, uint64_t timeout)
 {
+#if CONFIG_AGENT_BYPASS_ON_DELAY
+	struct sof_ipc_comp_event event;
+#endif
 	uint64_t ticks;
 
 	if (timeout > UINT_MAX)
@@ -133,6 +331,12 @@ void sa_init(struct sof *sof, uint64_t timeout)
 			(unsigned int)ticks, (unsigned int)sof->sa->warn_timeout,
 			(unsigned int)sof->sa->panic_timeout);
 
+#if CONFIG_AGENT_BYPASS_ON_DELAY
+	ipc_build_comp_event(&event, SOF_COMP_NONE, 0);
+	if (event.rhdr.hdr.size)
+		sof->sa->bypass_msg = ipc_msg_init(event.rhdr.hdr.cmd, event.rhdr.hdr.size);
+#endif
+
 	schedule_task_init_ll(&sof->sa->work, SOF_UUID(agent_work_task_uuid),
 			      SOF_SCHEDULE_LL_TIMER,
 			      SOF_TASK_PRI_HIGH, validate, sof->sa, 0, 0);
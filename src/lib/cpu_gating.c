@@ -0,0 +1,355 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+/**
+ * \file
+ * \brief Automatic secondary core power gating
+ *
+ * The host enables secondary cores with SOF_IPC_PM_CORE_ENABLE long before
+ * any stream is started on them and usually keeps them on until it is done
+ * with the whole topology. The primary core tracks which cores host IPC
+ * objects and powers down requested cores, which stay empty longer than
+ * CONFIG_CPU_GATING_IDLE_MS. All IPC work for a secondary core is routed by
+ * the primary core, so it powers such core up again before forwarding it.
+ *
+ * Only empty cores are gated: per core system heap, schedulers and notifiers
+ * are released on power down, so idle pipelines would lose their state. The
+ * wake is therefore predictive by construction: a gated core is empty, so the
+ * first IPC addressed to it creates a pipeline, component or buffer and
+ * powers it up while the host is still building the stream, long before its
+ * params and trigger.
+ *
+ * The idle countdown is a low priority LL timer task, but powering a core
+ * down is an IDC handshake with it, so the LL task only picks the cores
+ * and leaves the power down to an EDF task. The IPC task may preempt it, so
+ * the whole GATING transition is done under the lock.
+ */
+
+#include <sof/drivers/timer.h>
+#include <sof/ipc/common.h>
+#include <sof/ipc/topology.h>
+#include <sof/lib/alloc.h>
+#include <sof/lib/cpu.h>
+#include <sof/lib/cpu_gating.h>
+#include <sof/lib/memory.h>
+#include <sof/lib/uuid.h>
+#include <sof/list.h>
+#include <sof/platform.h>
+#include <sof/schedule/edf_schedule.h>
+#include <sof/schedule/ll_schedule.h>
+#include <sof/schedule/schedule.h>
+#include <sof/schedule/task.h>
+#include <sof/sof.h>
+#include <sof/spinlock.h>
+#include <sof/trace/trace.h>
+#include <ipc/topology.h>
+#include <user/trace.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+LOG_MODULE_REGISTER(cpu_gating, CONFIG_SOF_LOG_LEVEL);
+
+/* 5f5200c6-b00f-4466-a06e-dcad1ffe3fdc */
+DECLARE_SOF_UUID("cpu-gating", cpu_gating_uuid, 0x5f5200c6, 0xb00f, 0x4466,
+		 0xa0, 0x6e, 0xdc, 0xad, 0x1f, 0xfe, 0x3f, 0xdc);
+
+DECLARE_TR_CTX(cg_tr, SOF_UUID(cpu_gating_uuid), LOG_LEVEL_INFO);
+
+/* dd367585-846e-46d5-acac-c977656e973d */
+DECLARE_SOF_UUID("cpu-gating-work", cpu_gating_work_uuid, 0xdd367585, 0x846e, 0x46d5,
+		 0xac, 0xac, 0xc9, 0x77, 0x65, 0x6e, 0x97, 0x3d);
+
+/* 2c4e3c36-58b3-4b8f-9a0f-5b1e6dd3a2c7 */
+DECLARE_SOF_UUID("cpu-gating-gate", cpu_gating_gate_uuid, 0x2c4e3c36, 0x58b3, 0x4b8f,
+		 0x9a, 0x0f, 0x5b, 0x1e, 0x6d, 0xd3, 0xa2, 0xc7);
+
+static inline struct cpu_gating *cpu_gating_get(void)
+{
+	return sof_get()->cpu_gating;
+}
+
+/* does any pipeline, component or buffer live on the core */
+static bool cpu_gating_core_in_use(struct ipc *ipc, int core)
+{
+	struct ipc_comp_dev *icd;
+	struct list_item *clist;
+
+	list_for_item(clist, &ipc->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+		if (icd->core == core)
+			return true;
+	}
+
+	return false;
+}
+
+/* account residency of the state left at 'now', caller holds the lock */
+static void cpu_gating_account(struct cpu_gating_core *cgc, uint64_t now)
+{
+	if (cgc->state == CPU_GATING_GATED)
+		cgc->stats.off_cycles += now - cgc->ts;
+	else
+		cgc->stats.on_cycles += now - cgc->ts;
+
+	cgc->ts = now;
+}
+
+/* powers down the picked cores, which no IPC has addressed since */
+static enum task_state cpu_gating_gate_run(void *data)
+{
+	struct cpu_gating *cg = data;
+	struct cpu_gating_core *cgc;
+	k_spinlock_key_t key;
+	uint32_t count;
+	int i;
+
+	for (i = 0; i < CONFIG_CORE_COUNT; i++) {
+		cgc = &cg->core[i];
+
+		/*
+		 * An IPC preempting this task in the middle of the handshake
+		 * would find the core neither gated nor usable, so the lock
+		 * is held until the core is down.
+		 */
+		key = k_spin_lock(&cg->lock);
+
+		if (cgc->state != CPU_GATING_PENDING) {
+			k_spin_unlock(&cg->lock, key);
+			continue;
+		}
+
+		cgc->state = CPU_GATING_GATING;
+		cpu_disable_core(i);
+		cpu_gating_account(cgc, sof_cycle_get_64());
+
+		if (cpu_is_core_enabled(i)) {
+			cgc->state = CPU_GATING_ON;
+			k_spin_unlock(&cg->lock, key);
+			tr_err(&cg_tr, "cpu_gating: core %d power down failed", i);
+			continue;
+		}
+
+		cgc->state = CPU_GATING_GATED;
+		count = ++cgc->stats.gate_count;
+
+		k_spin_unlock(&cg->lock, key);
+
+		tr_info(&cg_tr, "cpu_gating: core %d gated, count %u", i, count);
+	}
+
+	return SOF_TASK_STATE_COMPLETED;
+}
+
+static enum task_state cpu_gating_run(void *data)
+{
+	struct cpu_gating *cg = data;
+	struct ipc *ipc = ipc_get();
+	bool gate[CONFIG_CORE_COUNT] = { false };
+	bool picked = false;
+	k_spinlock_key_t key;
+	int i;
+
+	/*
+	 * The component list is only modified while an IPC is processed, so
+	 * it can be walked safely when there is no IPC in flight. Otherwise
+	 * check again one idle period later.
+	 */
+	key = k_spin_lock(&ipc->lock);
+
+	if (ipc->task_mask) {
+		k_spin_unlock(&ipc->lock, key);
+		return SOF_TASK_STATE_RESCHEDULE;
+	}
+
+	for (i = 0; i < CONFIG_CORE_COUNT; i++) {
+		if (i == PLATFORM_PRIMARY_CORE_ID || !cg->core[i].requested ||
+		    !cpu_is_core_enabled(i))
+			continue;
+
+		gate[i] = !cpu_gating_core_in_use(ipc, i);
+	}
+
+	k_spin_unlock(&ipc->lock, key);
+
+	key = k_spin_lock(&cg->lock);
+	for (i = 0; i < CONFIG_CORE_COUNT; i++) {
+		if (gate[i] && cg->core[i].state == CPU_GATING_ON) {
+			cg->core[i].state = CPU_GATING_PENDING;
+			picked = true;
+		}
+	}
+	k_spin_unlock(&cg->lock, key);
+
+	if (picked)
+		schedule_task(&cg->gate_work, 0, 0);
+
+	/* re-armed by the next IPC forwarded to a secondary core */
+	return SOF_TASK_STATE_COMPLETED;
+}
+
+void cpu_gating_init(struct sof *sof)
+{
+	static const struct task_ops gate_ops = {
+		.run = cpu_gating_gate_run,
+	};
+	struct cpu_gating *cg;
+	uint64_t now = sof_cycle_get_64();
+	int i;
+
+	cg = rzalloc(SOF_MEM_ZONE_SYS_SHARED, 0, SOF_MEM_CAPS_RAM, sizeof(*cg));
+	if (!cg) {
+		tr_err(&cg_tr, "cpu_gating_init(): allocation failed");
+		return;
+	}
+
+	k_spinlock_init(&cg->lock);
+	cg->idle_us = CONFIG_CPU_GATING_IDLE_MS * 1000ULL;
+
+	for (i = 0; i < CONFIG_CORE_COUNT; i++)
+		cg->core[i].ts = now;
+
+	schedule_task_init_ll(&cg->work, SOF_UUID(cpu_gating_work_uuid),
+			      SOF_SCHEDULE_LL_TIMER, SOF_TASK_PRI_LOW,
+			      cpu_gating_run, cg, PLATFORM_PRIMARY_CORE_ID, 0);
+	schedule_task_init_edf(&cg->gate_work, SOF_UUID(cpu_gating_gate_uuid),
+			       &gate_ops, cg, PLATFORM_PRIMARY_CORE_ID, 0);
+
+	sof->cpu_gating = cg;
+
+	tr_info(&cg_tr, "cpu_gating_init(), idle timeout %u ms",
+		CONFIG_CPU_GATING_IDLE_MS);
+}
+
+void cpu_gating_request(int core, bool enable)
+{
+	struct cpu_gating *cg = cpu_gating_get();
+	struct cpu_gating_core *cgc;
+	struct cpu_gating_stats stats;
+	k_spinlock_key_t key;
+	bool report;
+
+	if (!cg || core == PLATFORM_PRIMARY_CORE_ID)
+		return;
+
+	cgc = &cg->core[core];
+
+	key = k_spin_lock(&cg->lock);
+
+	if (cgc->requested)
+		cpu_gating_account(cgc, sof_cycle_get_64());
+	else
+		cgc->ts = sof_cycle_get_64();
+
+	report = cgc->requested && !enable;
+	stats = cgc->stats;
+
+	cgc->requested = enable;
+	/* an explicit host request always reflects the real power state */
+	cgc->state = CPU_GATING_ON;
+
+	k_spin_unlock(&cg->lock, key);
+
+	if (report)
+		tr_info(&cg_tr, "cpu_gating: core %d released, on %u off %u kcycles, %u gates",
+			core, (uint32_t)(stats.on_cycles / 1000),
+			(uint32_t)(stats.off_cycles / 1000), stats.gate_count);
+
+	if (enable)
+		cpu_gating_arm();
+}
+
+int cpu_gating_wake(int core)
+{
+	struct cpu_gating *cg = cpu_gating_get();
+	struct cpu_gating_core *cgc;
+	k_spinlock_key_t key;
+	uint64_t start;
+	uint64_t now;
+	uint32_t latency;
+	uint32_t count;
+	bool gated;
+	int ret;
+
+	if (!cg || core >= CONFIG_CORE_COUNT)
+		return 0;
+
+	cgc = &cg->core[core];
+
+	key = k_spin_lock(&cg->lock);
+
+	/* a core picked but not yet powered down is simply kept */
+	if (cgc->state == CPU_GATING_PENDING)
+		cgc->state = CPU_GATING_ON;
+
+	/*
+	 * A GATING core is fully down once the lock is released, power it up
+	 * like a GATED one. Both stay out of the idle check meanwhile.
+	 */
+	gated = cgc->state == CPU_GATING_GATING || cgc->state == CPU_GATING_GATED;
+
+	k_spin_unlock(&cg->lock, key);
+
+	if (!gated)
+		return 0;
+
+	start = sof_cycle_get_64();
+
+	ret = cpu_enable_core(core);
+	if (ret < 0) {
+		tr_err(&cg_tr, "cpu_gating_wake(): core %d power up failed %d",
+		       core, ret);
+		return ret;
+	}
+
+	now = sof_cycle_get_64();
+	latency = (uint32_t)(now - start);
+
+	key = k_spin_lock(&cg->lock);
+	cpu_gating_account(cgc, now);
+	cgc->state = CPU_GATING_ON;
+	count = ++cgc->stats.wake_count;
+	cgc->stats.wake_latency_last = latency;
+	if (latency > cgc->stats.wake_latency_max)
+		cgc->stats.wake_latency_max = latency;
+	k_spin_unlock(&cg->lock, key);
+
+	tr_info(&cg_tr, "cpu_gating: core %d woken in %u cycles, count %u",
+		core, latency, count);
+
+	return 0;
+}
+
+void cpu_gating_arm(void)
+{
+	struct cpu_gating *cg = cpu_gating_get();
+
+	if (!cg)
+		return;
+
+	if (task_is_active(&cg->work))
+		reschedule_task(&cg->work, cg->idle_us);
+	else
+		schedule_task(&cg->work, cg->idle_us, cg->idle_us);
+}
+
+int cpu_gating_get_stats(int core, struct cpu_gating_stats *stats)
+{
+	struct cpu_gating *cg = cpu_gating_get();
+	struct cpu_gating_core *cgc;
+	k_spinlock_key_t key;
+
+	if (!cg || core >= CONFIG_CORE_COUNT)
+		return -EINVAL;
+
+	cgc = &cg->core[core];
+
+	key = k_spin_lock(&cg->lock);
+	if (cgc->requested)
+		cpu_gating_account(cgc, sof_cycle_get_64());
+	*stats = cgc->stats;
+	k_spin_unlock(&cg->lock, key);
+
+	return 0;
+}
@@ -6,12 +6,16 @@
 //
 //
 
+#include <sof/audio/format.h>
+#include <sof/common.h>
 #include <sof/math/log.h>
 
 /* Defines Constant*/
 #define BASE2LOG_WRAP_SCHAR_BITS 0xFF
 #define BASE2LOG_UPPERBYTES 0xFFFFFF
 #define BASE2LOG_WORDLENGTH 0x1F
+#define BASE2LOG_ONE_Q30 Q_CONVERT_FLOAT(1.0, 30)
+#define BASE2LOG_SQRT2_Q30 Q_CONVERT_FLOAT(1.4142135623730951, 30)
 /**
  *  Base-2 logarithm log2(n)
  *
@@ -120,3 +124,67 @@ int32_t base2_logarithm(uint32_t u)
 	return s_v + (((x & BASE2LOG_UPPERBYTES) * (int64_t)(l2_i - l3_i)) >> 24);
 }
 
+/**
+ * Polynomial base-2 logarithm for the block version. The leading zeros
+ * are counted with clz() instead of the byte lookup, the mantissa is
+ * reduced to [1/sqrt(2), sqrt(2)) with a select and log2() of it is a
+ * 7th order polynomial. No table lookups or branches are needed, so a
+ * loop over the function can be vectorized by the compiler.
+ *
+ * Arguments	: uint32_t u, Q32.0 [1 to 4294967295]
+ * Return Type	: int32_t y, Q16.16 [0 to 32]
+ */
+static inline int32_t base2_logarithm_poly(uint32_t u)
+{
+	/* Coefficients obtained from Chebyshev interpolation of log2(1 + x)
+	 * in [1/sqrt(2) - 1, sqrt(2) - 1], max err ~= 3.7e-7
+	 */
+	const int32_t C7 = Q_CONVERT_FLOAT(0.163373938748, 30);
+	const int32_t C6 = Q_CONVERT_FLOAT(-0.270253165937, 30);
+	const int32_t C5 = Q_CONVERT_FLOAT(0.298494176228, 30);
+	const int32_t C4 = Q_CONVERT_FLOAT(-0.359271500417, 30);
+	const int32_t C3 = Q_CONVERT_FLOAT(0.480392918610, 30);
+	const int32_t C2 = Q_CONVERT_FLOAT(-0.721368128281, 30);
+	const int32_t C1 = Q_CONVERT_FLOAT(1.442701134717, 30);
+	const int32_t C0 = Q_CONVERT_FLOAT(0.000000051796, 30);
+	int64_t p;
+	int32_t m;
+	int32_t x;
+	int32_t e;
+	int shift;
+
+	/* u = m * 2^e with 1 <= m < 2, m is Q2.30. The OR keeps zero input defined. */
+	shift = clz(u | 1);
+	m = (int32_t)((u << shift) >> 1);
+	e = BASE2LOG_WORDLENGTH - shift;
+	if (m > BASE2LOG_SQRT2_Q30) {
+		m >>= 1;
+		e++;
+	}
+
+	x = m - BASE2LOG_ONE_Q30;
+	p = Q_MULTSR_32X32((int64_t)C7, x, 30, 30, 30) + C6;
+	p = Q_MULTSR_32X32(p, x, 30, 30, 30) + C5;
+	p = Q_MULTSR_32X32(p, x, 30, 30, 30) + C4;
+	p = Q_MULTSR_32X32(p, x, 30, 30, 30) + C3;
+	p = Q_MULTSR_32X32(p, x, 30, 30, 30) + C2;
+	p = Q_MULTSR_32X32(p, x, 30, 30, 30) + C1;
+	p = Q_MULTSR_32X32(p, x, 30, 30, 30) + C0;
+
+	return (e << 16) + (int32_t)Q_SHIFT_RND(p, 30, 16);
+}
+
+/**
+ * Block version of base2_logarithm(), u and y can be the same array.
+ *
+ * Arguments	: const uint32_t *u, Q32.0 [1 to 4294967295]
+ *		  int32_t *y, Q16.16 [0 to 32]
+ *		  int n, number of values
+ */
+void base2_logarithm_vec(const uint32_t *u, int32_t *y, int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++)
+		y[i] = base2_logarithm_poly(u[i]);
+}
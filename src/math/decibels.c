@@ -6,6 +6,7 @@
 
 #include <sof/audio/format.h>
 #include <sof/math/decibels.h>
+#include <sof/math/numbers.h>
 #include <stdint.h>
 
 #define ONE_Q20         Q_CONVERT_FLOAT(1.0, 20)	  /* Use Q12.20 */
@@ -13,6 +14,12 @@
 #define TWO_Q27         Q_CONVERT_FLOAT(2.0, 27)	  /* Use Q5.27 */
 #define MINUS_TWO_Q27   Q_CONVERT_FLOAT(-2.0, 27)	  /* Use Q5.27 */
 #define LOG10_DIV20_Q27 Q_CONVERT_FLOAT(0.1151292546, 27) /* Use Q5.27 */
+#define ONE_Q30         Q_CONVERT_FLOAT(1.0, 30)	  /* Use Q2.30 */
+#define LOG2E_Q30       Q_CONVERT_FLOAT(1.4426950408889634, 30) /* Use Q2.30 */
+
+#define EXP_FIXED_MIN_Q27     Q_CONVERT_FLOAT(-11.5, 27)
+#define EXP_FIXED_MAX_Q27     Q_CONVERT_FLOAT(7.6245, 27)
+#define DB2LIN_FIXED_MIN_Q24  Q_CONVERT_FLOAT(-100.0, 24)
 
 /* Exponent function for small values of x. This function calculates
  * fairly accurately exponent for x in range -2.0 .. +2.0. The iteration
@@ -63,7 +70,7 @@ int32_t db2lin_fixed(int32_t db)
 {
 	int32_t arg;
 
-	if (db < Q_CONVERT_FLOAT(-100.0, 24))
+	if (db < DB2LIN_FIXED_MIN_Q24)
 		return 0;
 
 	/* Q8.24 x Q5.27, result needs to be Q5.27 */
@@ -92,10 +99,10 @@ int32_t exp_fixed(int32_t x)
 	int i;
 	int n = 0;
 
-	if (x < Q_CONVERT_FLOAT(-11.5, 27))
+	if (x < EXP_FIXED_MIN_Q27)
 		return 0;
 
-	if (x > Q_CONVERT_FLOAT(7.6245, 27))
+	if (x > EXP_FIXED_MAX_Q27)
 		return INT32_MAX;
 
 	/* x is Q5.27 */
@@ -115,3 +122,91 @@ int32_t exp_fixed(int32_t x)
 
 	return y;
 }
+
+/* Polynomial exponent function for the block version. The argument is
+ * split as exp(x) = 2^(x * log2(e)) = 2^k * 2^f where k is integer and
+ * 0 <= f < 1. The fractional power is a 6th order polynomial and the
+ * integer power is a shift. Unlike exp_fixed() there are no loops with
+ * data dependent length, the saturation and range checks are selects,
+ * so a loop over the function can be vectorized by the compiler.
+ *
+ * Input  is Q5.27, same range limitation as in exp_fixed()
+ * Output is Q12.20, 0.0 .. +2048.0
+ */
+
+static inline int32_t exp_fixed_poly(int32_t x)
+{
+	/* Coefficients obtained from Chebyshev interpolation of 2^f in [0, 1],
+	 * max err ~= 2.8e-9
+	 */
+	const int32_t C6 = Q_CONVERT_FLOAT(0.000218657848, 30);
+	const int32_t C5 = Q_CONVERT_FLOAT(0.001239133184, 30);
+	const int32_t C4 = Q_CONVERT_FLOAT(0.009684186310, 30);
+	const int32_t C3 = Q_CONVERT_FLOAT(0.055480630197, 30);
+	const int32_t C2 = Q_CONVERT_FLOAT(0.240230454412, 30);
+	const int32_t C1 = Q_CONVERT_FLOAT(0.693146932759, 30);
+	const int32_t C0 = Q_CONVERT_FLOAT(1.000000002531, 30);
+	int64_t t;
+	int64_t p;
+	int32_t xc;
+	int32_t f;
+	int k;
+
+	xc = MIN(MAX(x, EXP_FIXED_MIN_Q27), EXP_FIXED_MAX_Q27);
+
+	/* Q5.27 x Q2.30 -> Q7.57, k is the floor and f the fraction */
+	t = (int64_t)xc * LOG2E_Q30;
+	k = (int)(t >> 57);
+	f = (int32_t)(t >> 27) & (ONE_Q30 - 1);
+
+	/* 2^f in Q2.30 */
+	p = Q_MULTSR_32X32((int64_t)C6, f, 30, 30, 30) + C5;
+	p = Q_MULTSR_32X32(p, f, 30, 30, 30) + C4;
+	p = Q_MULTSR_32X32(p, f, 30, 30, 30) + C3;
+	p = Q_MULTSR_32X32(p, f, 30, 30, 30) + C2;
+	p = Q_MULTSR_32X32(p, f, 30, 30, 30) + C1;
+	p = Q_MULTSR_32X32(p, f, 30, 30, 30) + C0;
+
+	/* Scale by 2^k and round to Q12.20, k is -17 .. 10 after the clamp */
+	p = (((p << 1) >> (10 - k)) + 1) >> 1;
+
+	if (x < EXP_FIXED_MIN_Q27)
+		p = 0;
+
+	if (x > EXP_FIXED_MAX_Q27)
+		p = INT32_MAX;
+
+	return sat_int32(p);
+}
+
+/* Block version of exp_fixed(), x and y can be the same array.
+ *
+ * Input  is Q5.27
+ * Output is Q12.20
+ */
+
+void exp_fixed_vec(const int32_t *x, int32_t *y, int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++)
+		y[i] = exp_fixed_poly(x[i]);
+}
+
+/* Block version of db2lin_fixed(), db and y can be the same array.
+ *
+ * Input  is Q8.24
+ * Output is Q12.20
+ */
+
+void db2lin_fixed_vec(const int32_t *db, int32_t *y, int n)
+{
+	int32_t arg;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		/* Q8.24 x Q5.27, result needs to be Q5.27 */
+		arg = (int32_t)Q_MULTSR_32X32((int64_t)db[i], LOG10_DIV20_Q27, 24, 27, 27);
+		y[i] = db[i] < DB2LIN_FIXED_MIN_Q24 ? 0 : exp_fixed_poly(arg);
+	}
+}
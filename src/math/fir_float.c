@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <sof/math/fir_config.h>
+
+#if FIR_GENERIC && CONFIG_FORMAT_FLOAT_PROCESSING
+
+#include <sof/math/fir_float.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+size_t fir_size_float(const struct fir_state_32x16 *fir)
+{
+	/* Coefficients and two copies of the delay line, fir_reset() leaves
+	 * taps as is so bypass is detected from length.
+	 */
+	return fir->length ? 3 * fir->taps * sizeof(float) : 0;
+}
+
+void fir_init_float(struct fir_state_float *fir,
+		    const struct fir_state_32x16 *fixed, float **data)
+{
+	const int shift = -15 - fixed->out_shift;
+	int i;
+
+	fir->wi = 0;
+	fir->taps = fixed->length ? fixed->taps : 0;
+	fir->coef = *data;
+	fir->delay = fir->coef + fir->taps;
+
+	/* Reversed so that the newest sample is multiplied last */
+	for (i = 0; i < fir->taps; i++)
+		fir->coef[i] = ldexpf(fixed->coef[fir->taps - 1 - i], shift);
+
+	for (i = 0; i < 2 * fir->taps; i++)
+		fir->delay[i] = 0.0f;
+
+	*data = fir->delay + 2 * fir->taps;
+}
+
+void fir_reset_float(struct fir_state_float *fir)
+{
+	fir->wi = 0;
+	fir->taps = 0;
+	fir->coef = NULL;
+	fir->delay = NULL;
+}
+
+/*
+ * Every input is written to delay[wi] and delay[wi + taps], so the last
+ * taps samples are always found without a wrap at delay[wi + 1] and the
+ * dot product is a plain loop the compiler can vectorize.
+ */
+void fir_float(struct fir_state_float *fir, const float *x, float *y,
+	       int n, int stride)
+{
+	const int taps = fir->taps;
+	const float *data;
+	float acc;
+	int i;
+	int k;
+
+	/* Bypass is set with taps set to zero. */
+	if (!taps) {
+		for (k = 0; k < n; k++)
+			y[k * stride] = x[k * stride];
+		return;
+	}
+
+	for (k = 0; k < n; k++) {
+		fir->delay[fir->wi] = x[k * stride];
+		fir->delay[fir->wi + taps] = x[k * stride];
+		fir->wi++;
+		if (fir->wi == taps)
+			fir->wi = 0;
+
+		data = &fir->delay[fir->wi];
+		acc = 0.0f;
+		for (i = 0; i < taps; i++)
+			acc += fir->coef[i] * data[i];
+
+		y[k * stride] = acc;
+	}
+}
+
+#endif /* FIR_GENERIC && CONFIG_FORMAT_FLOAT_PROCESSING */
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <sof/audio/format.h>
+#include <sof/math/iir_df2t.h>
+#include <sof/math/iir_df2t_float.h>
+#include <user/eq.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+
+size_t iir_size_df2t_float(const struct iir_state_df2t *iir)
+{
+	return iir->biquads * (IIR_DF2T_FLOAT_NCOEF + IIR_DF2T_NUM_DELAYS) * sizeof(float);
+}
+
+void iir_init_df2t_float(struct iir_state_df2t_float *iir,
+			 const struct iir_state_df2t *fixed, float **data)
+{
+	const int32_t *src = fixed->coef;
+	float *coef = *data;
+	int i;
+
+	iir->biquads = fixed->biquads;
+	iir->biquads_in_series = fixed->biquads_in_series;
+	iir->coef = coef;
+	iir->delay = coef + iir->biquads * IIR_DF2T_FLOAT_NCOEF;
+
+	/* Fixed point order is {a2, a1, b2, b1, b0, shift, gain}, with
+	 * Q2.30 filter coefficients and Q2.14 gain.
+	 */
+	for (i = 0; i < iir->biquads; i++) {
+		coef[0] = ldexpf(src[0], -30);
+		coef[1] = ldexpf(src[1], -30);
+		coef[2] = ldexpf(src[2], -30);
+		coef[3] = ldexpf(src[3], -30);
+		coef[4] = ldexpf(src[4], -30);
+		coef[5] = ldexpf(src[6], -14 - src[5]);
+		coef += IIR_DF2T_FLOAT_NCOEF;
+		src += SOF_EQ_IIR_NBIQUAD_DF2T;
+	}
+
+	for (i = 0; i < iir->biquads * IIR_DF2T_NUM_DELAYS; i++)
+		iir->delay[i] = 0.0f;
+
+	*data = iir->delay + iir->biquads * IIR_DF2T_NUM_DELAYS;
+}
+
+void iir_reset_df2t_float(struct iir_state_df2t_float *iir)
+{
+	iir->biquads = 0;
+	iir->biquads_in_series = 0;
+	iir->coef = NULL;
+	iir->delay = NULL;
+}
+
+/* Same direct form II transposed biquads as iir_df2t(), but without
+ * saturation between the sections.
+ */
+void iir_df2t_float(struct iir_state_df2t_float *iir, const float *x,
+		    float *y, int n, int stride)
+{
+	const float *c;
+	float *d;
+	float in;
+	float out;
+	float tmp;
+	int i;
+	int j;
+	int k;
+
+	/* Bypass is set with number of biquads set to zero. */
+	if (!iir->biquads) {
+		for (k = 0; k < n; k++)
+			y[k * stride] = x[k * stride];
+		return;
+	}
+
+	for (k = 0; k < n; k++) {
+		c = iir->coef;
+		d = iir->delay;
+		out = 0.0f;
+		in = x[k * stride];
+		for (j = 0; j < iir->biquads; j += iir->biquads_in_series) {
+			for (i = 0; i < iir->biquads_in_series; i++) {
+				tmp = c[4] * in + d[0];
+				d[0] = d[1] + c[3] * in + c[1] * tmp;
+				d[1] = c[2] * in + c[0] * tmp;
+				in = c[5] * tmp;
+				c += IIR_DF2T_FLOAT_NCOEF;
+				d += IIR_DF2T_NUM_DELAYS;
+			}
+
+			/* Output of previous section is in variable in */
+			out += in;
+		}
+
+		y[k * stride] = out;
+	}
+}
+
+#endif /* CONFIG_FORMAT_FLOAT_PROCESSING */
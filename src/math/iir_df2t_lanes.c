@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <sof/audio/format.h>
+#include <sof/math/iir_df2t.h>
+#include <user/eq.h>
+#include <stdint.h>
+
+/*
+ * Series DF2T IIR of iir_df2t() for several streams with the same
+ * coefficients. Samples and delays are stored lane by lane, one lane per
+ * stream, and every step of a biquad is done for all lanes before the
+ * next one. The loops over lanes have no dependency between iterations,
+ * so they vectorize also when the streams are mono. The arithmetic is
+ * the same as in the generic iir_df2t(), the output of a lane is bit
+ * exact with filtering the stream alone.
+ */
+
+/* data is frames x lanes samples, delay is IIR_DF2T_NUM_DELAYS x biquads x lanes */
+void iir_df2t_lanes(const struct iir_state_df2t *iir, int64_t *delay, int32_t *data,
+		    int frames, int lanes)
+{
+	int32_t in[IIR_DF2T_LANES_MAX];
+	int32_t out[IIR_DF2T_LANES_MAX];
+	int32_t tmp;
+	int64_t acc;
+	int64_t *d0;
+	int64_t *d1;
+	int32_t *coef;
+	int32_t *x;
+	int i;
+	int j;
+	int l;
+	int n;
+
+	/* Bypass is set with number of biquads set to zero. */
+	if (!iir->biquads)
+		return;
+
+	for (n = 0; n < frames; n++) {
+		x = data + n * lanes;
+		for (l = 0; l < lanes; l++) {
+			in[l] = x[l];
+			out[l] = 0;
+		}
+
+		/* Coefficients order in coef[] is {a2, a1, b2, b1, b0, shift, gain} */
+		coef = iir->coef;
+		d0 = delay;
+		for (j = 0; j < iir->biquads; j += iir->biquads_in_series) {
+			for (i = 0; i < iir->biquads_in_series; i++) {
+				d1 = d0 + lanes;
+				for (l = 0; l < lanes; l++) {
+					acc = ((int64_t)coef[4]) * in[l] + d0[l];
+					tmp = (int32_t)sat_int32(Q_SHIFT_RND(acc, 61, 31));
+					acc = d1[l];
+					acc += ((int64_t)coef[3]) * in[l];
+					acc += ((int64_t)coef[1]) * tmp;
+					d0[l] = acc;
+					acc = ((int64_t)coef[2]) * in[l];
+					acc += ((int64_t)coef[0]) * tmp;
+					d1[l] = acc;
+					acc = ((int64_t)coef[6]) * tmp;
+					acc = Q_SHIFT_RND(acc, 45 + coef[5], 31);
+					in[l] = sat_int32(acc);
+				}
+
+				coef += SOF_EQ_IIR_NBIQUAD_DF2T;
+				d0 += IIR_DF2T_NUM_DELAYS * lanes;
+			}
+
+			for (l = 0; l < lanes; l++)
+				out[l] = sat_int32((int64_t)out[l] + in[l]);
+		}
+
+		for (l = 0; l < lanes; l++)
+			x[l] = out[l];
+	}
+}
@@ -30,3 +30,20 @@ uint32_t log10_int32(uint32_t numerator)
 	return((uint32_t)Q_SHIFT_RND((int64_t)base2_logarithm(numerator) *
 				     ONE_OVER_LOG2_10, 63, 32));
 }
+
+/**
+ * Block version of log10_int32(), numerator and y can be the same array.
+ *
+ * Arguments	: const uint32_t *numerator [1 to 4294967295, Q32.0]
+ *		  uint32_t *y, UQ4.28 [0 to 9.6329499409]
+ *		  int n, number of values
+ */
+void log10_int32_vec(const uint32_t *numerator, uint32_t *y, int n)
+{
+	int32_t *log2 = (int32_t *)y;
+	int i;
+
+	base2_logarithm_vec(numerator, log2, n);
+	for (i = 0; i < n; i++)
+		y[i] = (uint32_t)Q_SHIFT_RND((int64_t)log2[i] * ONE_OVER_LOG2_10, 63, 32);
+}
@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+/*
+ * Phase accumulator sine oscillators. The phase is an unsigned fraction of
+ * a full turn, so advancing it is a single add that wraps for free. The
+ * sine is looked up from a quarter wave table of sin(k * pi / 512) and
+ * refined between the table points with
+ *
+ *   sin(a + b) = sin(a) * cos(b) + cos(a) * sin(b)
+ *
+ * where cos(a) comes from the same table and the short arc b uses
+ * cos(b) = 1 - b^2 / 2 and sin(b) = b - b^3 / 6. The error of the
+ * truncated series is below 1e-10 for |b| < pi / 512, so the result is
+ * accurate to a few LSB of Q1.31, with no loops or branches per sample.
+ */
+
+#include <sof/audio/format.h>
+#include <sof/math/oscillator.h>
+#include <stdint.h>
+
+#define OSC_FRAC_BITS	(30 - OSC_TABLE_BITS)
+#define OSC_FRAC_MASK	((1 << OSC_FRAC_BITS) - 1)
+#define OSC_PI_Q29	Q_CONVERT_FLOAT(3.14159265358979323846, 29)
+#define OSC_ONE_SIXTH_Q31 Q_CONVERT_FLOAT(1.0 / 6.0, 31)
+
+/* sin(k * pi / 512) for k = 0 .. 256 in Q1.31 */
+static const int32_t osc_sin_table[OSC_TABLE_SIZE] = {
+	0, 13176712, 26352928, 39528151, 52701887, 65873638,
+	79042909, 92209205, 105372028, 118530885, 131685278, 144834714,
+	157978697, 171116733, 184248325, 197372981, 210490206, 223599506,
+	236700388, 249792358, 262874923, 275947592, 289009871, 302061269,
+	315101295, 328129457, 341145265, 354148230, 367137861, 380113669,
+	393075166, 406021865, 418953276, 431868915, 444768294, 457650927,
+	470516330, 483364019, 496193509, 509004318, 521795963, 534567963,
+	547319836, 560051104, 572761285, 585449903, 598116479, 610760536,
+	623381598, 635979190, 648552838, 661102068, 673626408, 686125387,
+	698598533, 711045377, 723465451, 735858287, 748223418, 760560380,
+	772868706, 785147934, 797397602, 809617249, 821806413, 833964638,
+	846091463, 858186435, 870249095, 882278992, 894275671, 906238681,
+	918167572, 930061894, 941921200, 953745043, 965532978, 977284562,
+	988999351, 1000676905, 1012316784, 1023918550, 1035481766, 1047005996,
+	1058490808, 1069935768, 1081340445, 1092704411, 1104027237, 1115308496,
+	1126547765, 1137744621, 1148898640, 1160009405, 1171076495, 1182099496,
+	1193077991, 1204011567, 1214899813, 1225742318, 1236538675, 1247288478,
+	1257991320, 1268646800, 1279254516, 1289814068, 1300325060, 1310787095,
+	1321199781, 1331562723, 1341875533, 1352137822, 1362349204, 1372509294,
+	1382617710, 1392674072, 1402678000, 1412629117, 1422527051, 1432371426,
+	1442161874, 1451898025, 1461579514, 1471205974, 1480777044, 1490292364,
+	1499751576, 1509154322, 1518500250, 1527789007, 1537020244, 1546193612,
+	1555308768, 1564365367, 1573363068, 1582301533, 1591180426, 1599999411,
+	1608758157, 1617456335, 1626093616, 1634669676, 1643184191, 1651636841,
+	1660027308, 1668355276, 1676620432, 1684822463, 1692961062, 1701035922,
+	1709046739, 1716993211, 1724875040, 1732691928, 1740443581, 1748129707,
+	1755750017, 1763304224, 1770792044, 1778213194, 1785567396, 1792854372,
+	1800073849, 1807225553, 1814309216, 1821324572, 1828271356, 1835149306,
+	1841958164, 1848697674, 1855367581, 1861967634, 1868497586, 1874957189,
+	1881346202, 1887664383, 1893911494, 1900087301, 1906191570, 1912224073,
+	1918184581, 1924072871, 1929888720, 1935631910, 1941302225, 1946899451,
+	1952423377, 1957873796, 1963250501, 1968553292, 1973781967, 1978936331,
+	1984016189, 1989021350, 1993951625, 1998806829, 2003586779, 2008291295,
+	2012920201, 2017473321, 2021950484, 2026351522, 2030676269, 2034924562,
+	2039096241, 2043191150, 2047209133, 2051150040, 2055013723, 2058800036,
+	2062508835, 2066139983, 2069693342, 2073168777, 2076566160, 2079885360,
+	2083126254, 2086288720, 2089372638, 2092377892, 2095304370, 2098151960,
+	2100920556, 2103610054, 2106220352, 2108751352, 2111202959, 2113575080,
+	2115867626, 2118080511, 2120213651, 2122266967, 2124240380, 2126133817,
+	2127947206, 2129680480, 2131333572, 2132906420, 2134398966, 2135811153,
+	2137142927, 2138394240, 2139565043, 2140655293, 2141664948, 2142593971,
+	2143442326, 2144209982, 2144896910, 2145503083, 2146028480, 2146473080,
+	2146836866, 2147119825, 2147321946, 2147443222, 2147483647,
+};
+
+static inline int32_t osc_sin_sample(uint32_t phase)
+{
+	uint32_t x = phase & (OSC_QUARTER_TURN - 1);
+	int32_t sin_a;
+	int32_t cos_a;
+	int32_t b;
+	int32_t b2;
+	int32_t sin_b;
+	int64_t y;
+	int idx;
+
+	/* Mirror the second and fourth quarter */
+	if (phase & OSC_QUARTER_TURN)
+		x = OSC_QUARTER_TURN - x;
+
+	idx = x >> OSC_FRAC_BITS;
+	sin_a = osc_sin_table[idx];
+	cos_a = osc_sin_table[(1 << OSC_TABLE_BITS) - idx];
+
+	/* Arc from the table point, pi / 2^31 radians per step of x, in Q1.31 */
+	b = (int32_t)(((int64_t)(x & OSC_FRAC_MASK) * OSC_PI_Q29) >> 29);
+	b2 = q_mults_32x32(b, b, Q_SHIFT_BITS_64(31, 31, 31));
+	sin_b = b - q_mults_32x32(q_mults_32x32(b, b2, Q_SHIFT_BITS_64(31, 31, 31)),
+				  OSC_ONE_SIXTH_Q31, Q_SHIFT_BITS_64(31, 31, 31));
+
+	/* sin(a) * cos(b) + cos(a) * sin(b), with cos(b) = 1 - b^2 / 2 */
+	y = sin_a - q_mults_32x32(sin_a, b2, Q_SHIFT_BITS_64(31, 31, 30)) +
+		q_mults_32x32(cos_a, sin_b, Q_SHIFT_BITS_64(31, 31, 31));
+
+	/* Negative half of the period, the peak can round over full scale */
+	y = sat_int32(y);
+	return (phase & OSC_HALF_TURN) ? -y : y;
+}
+
+static inline int32_t osc_next(struct osc_state *osc)
+{
+	int32_t y = osc_sin_sample(osc->phase);
+
+	osc->phase += osc->step;
+	return q_mults_32x32(y, osc->amplitude, Q_SHIFT_BITS_64(31, 31, 31));
+}
+
+void osc_set_freq(struct osc_state *osc, int32_t f, int32_t fs)
+{
+	/* f / fs of a full turn, f is Q16.16 and the step Q0.32 */
+	int64_t step = ((int64_t)f << 16) / fs;
+
+	osc->step = step > OSC_HALF_TURN ? OSC_HALF_TURN : (uint32_t)step;
+}
+
+void osc_init(struct osc_state *osc, int32_t f, int32_t fs, int32_t amplitude)
+{
+	osc->phase = 0;
+	osc->amplitude = amplitude;
+	osc_set_freq(osc, f, fs);
+}
+
+int32_t osc_sin_fixed(uint32_t phase)
+{
+	return osc_sin_sample(phase);
+}
+
+void osc_sin_block(struct osc_state *osc, int32_t *y, int stride, int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++) {
+		*y = osc_next(osc);
+		y += stride;
+	}
+}
+
+void osc_bank_sin(struct osc_state *osc, int num, int32_t *y, int n)
+{
+	int ch;
+
+	/* one pass per oscillator keeps its state in registers */
+	for (ch = 0; ch < num; ch++)
+		osc_sin_block(&osc[ch], y + ch, num, n);
+}
+
+void osc_bank_sum(struct osc_state *osc, int num, int32_t *y, int stride, int n)
+{
+	int64_t sum;
+	int i;
+	int j;
+
+	for (i = 0; i < n; i++) {
+		sum = 0;
+		for (j = 0; j < num; j++)
+			sum += osc_next(&osc[j]);
+
+		*y = sat_int32(sum);
+		y += stride;
+	}
+}
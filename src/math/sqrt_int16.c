@@ -6,6 +6,8 @@
 //
 //
 
+#include <sof/audio/format.h>
+#include <sof/common.h>
 #include <sof/math/sqrt.h>
 
 #define SQRT_WRAP_SCHAR_BITS 0xFF
@@ -145,3 +147,70 @@ uint16_t sqrt_int16(uint16_t u)
 
 	return y;
 }
+
+/*
+ * Polynomial square root for the block version. The input is normalized
+ * with clz() to u = x * 2^n, 0.5 <= x < 1, sqrt(x) is a 5th order
+ * polynomial and an odd n is handled by a multiply with sqrt(2). There
+ * are no table lookups or branches, so a loop over the function can be
+ * vectorized by the compiler.
+ *
+ * Arguments	: uint16_t u, Q4.12 [0 to 65535]
+ * Return Type	: uint16_t y, Q4.12 [0 to 4]
+ */
+static inline uint16_t sqrt_int16_poly(uint16_t u)
+{
+	/* Coefficients obtained from Chebyshev interpolation of sqrt(x)
+	 * in [0.5, 1], max err ~= 1.2e-6
+	 */
+	const int32_t C5 = Q_CONVERT_FLOAT(0.110494348923, 29);
+	const int32_t C4 = Q_CONVERT_FLOAT(-0.531437466617, 29);
+	const int32_t C3 = Q_CONVERT_FLOAT(1.100824604839, 29);
+	const int32_t C2 = Q_CONVERT_FLOAT(-1.341608161026, 29);
+	const int32_t C1 = Q_CONVERT_FLOAT(1.454117098674, 29);
+	const int32_t C0 = Q_CONVERT_FLOAT(0.207610248993, 29);
+	const int32_t SQRT2 = Q_CONVERT_FLOAT(1.4142135623730951, 30);
+	int64_t p;
+	int32_t x;
+	int shift;
+	int odd;
+	int half;
+	int s;
+
+	/* u = x * 2^(32 - shift) in Q32.0, x is Q2.30 */
+	shift = clz((uint32_t)u | 1);
+	x = (int32_t)(((uint32_t)u << shift) >> 2);
+
+	p = Q_MULTSR_32X32((int64_t)C5, x, 29, 30, 29) + C4;
+	p = Q_MULTSR_32X32(p, x, 29, 30, 29) + C3;
+	p = Q_MULTSR_32X32(p, x, 29, 30, 29) + C2;
+	p = Q_MULTSR_32X32(p, x, 29, 30, 29) + C1;
+	p = Q_MULTSR_32X32(p, x, 29, 30, 29) + C0;
+
+	/* In Q4.12 the exponent is 20 - shift, an odd exponent gives sqrt(2) */
+	odd = shift & 1;
+	if (odd)
+		p = Q_MULTSR_32X32(p, SQRT2, 29, 30, 29);
+
+	/* Scale the Q3.29 root by 2^half to Q4.12, the shift is 15 .. 23 */
+	half = (20 - shift - odd) >> 1;
+	s = 17 - half;
+	p = ((p >> (s - 1)) + 1) >> 1;
+
+	return u ? (uint16_t)p : 0;
+}
+
+/*
+ * Block version of sqrt_int16(), u and y can be the same array.
+ *
+ * Arguments	: const uint16_t *u, Q4.12
+ *		  uint16_t *y, Q4.12
+ *		  int n, number of values
+ */
+void sqrt_int16_vec(const uint16_t *u, uint16_t *y, int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++)
+		y[i] = sqrt_int16_poly(u[i]);
+}
@@ -7,40 +7,193 @@
 //         Keyon Jie <yang.jie@linux.intel.com>
 //         Ranjani Sridharan <ranjani.sridharan@linux.intel.com>
 
+#include <stdbool.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include <malloc.h>
 #include <sof/lib/alloc.h>
 #include <sof/lib/mm_heap.h>
+#include <sof/math/numbers.h>
+#include <sof/string.h>
+#include <sof/sof.h>
 
 /* testbench mem alloc definition */
 
+/*
+ * Optional allocation tracking used by persistent fuzzing harnesses to roll
+ * the firmware state back between inputs without running the whole init
+ * again. Nothing is tracked unless heap_snapshot_enable() is called.
+ */
+struct heap_block {
+	void *ptr;
+	void *saved;		/* contents at snapshot time */
+	size_t size;
+	bool snap;		/* allocated before the snapshot */
+	bool freed;		/* freed after the snapshot, release deferred */
+};
+
+static struct heap_tracker {
+	struct heap_block *blocks;
+	size_t count;
+	size_t max;
+	bool enabled;
+	struct sof sof;		/* sof context at snapshot time */
+} tracker;
+
+static void heap_track(void *ptr, size_t bytes)
+{
+	struct heap_block *blocks;
+
+	if (!tracker.enabled || !ptr)
+		return;
+
+	if (tracker.count == tracker.max) {
+		tracker.max = tracker.max ? tracker.max * 2 : 256;
+		blocks = realloc(tracker.blocks, tracker.max * sizeof(*blocks));
+		if (!blocks)
+			abort();
+		tracker.blocks = blocks;
+	}
+
+	tracker.blocks[tracker.count++] = (struct heap_block){
+		.ptr = ptr,
+		.size = bytes,
+	};
+}
+
+static struct heap_block *heap_find(void *ptr)
+{
+	size_t i;
+
+	/* recent allocations are the most likely to be freed */
+	for (i = tracker.count; i > 0; i--)
+		if (tracker.blocks[i - 1].ptr == ptr)
+			return &tracker.blocks[i - 1];
+
+	return NULL;
+}
+
+static void heap_untrack(struct heap_block *block)
+{
+	free(block->saved);
+	*block = tracker.blocks[--tracker.count];
+}
+
+void heap_snapshot_enable(void)
+{
+	tracker.enabled = true;
+}
+
+void heap_snapshot_take(void)
+{
+	struct heap_block *block;
+	size_t i;
+
+	for (i = 0; i < tracker.count; i++) {
+		block = &tracker.blocks[i];
+
+		if (!block->saved) {
+			block->saved = malloc(block->size ? block->size : 1);
+			if (!block->saved)
+				abort();
+		}
+
+		memcpy_s(block->saved, block->size, block->ptr, block->size);
+		block->snap = true;
+	}
+
+	tracker.sof = *sof_get();
+}
+
+void heap_snapshot_restore(void)
+{
+	struct heap_block *block;
+	size_t i = 0;
+
+	while (i < tracker.count) {
+		block = &tracker.blocks[i];
+
+		if (!block->snap) {
+			free(block->ptr);
+			heap_untrack(block);
+			continue;
+		}
+
+		memcpy_s(block->ptr, block->size, block->saved, block->size);
+		block->freed = false;
+		i++;
+	}
+
+	*sof_get() = tracker.sof;
+}
+
 void *rmalloc(enum mem_zone zone, uint32_t flags, uint32_t caps, size_t bytes)
 {
-	return malloc(bytes);
+	void *ptr = malloc(bytes);
+
+	heap_track(ptr, bytes);
+	return ptr;
 }
 
 void *rzalloc(enum mem_zone zone, uint32_t flags, uint32_t caps, size_t bytes)
 {
-	return calloc(bytes, 1);
+	void *ptr = calloc(bytes, 1);
+
+	heap_track(ptr, bytes);
+	return ptr;
 }
 
 void rfree(void *ptr)
 {
+	struct heap_block *block;
+
+	if (tracker.enabled && ptr) {
+		block = heap_find(ptr);
+		if (block && block->freed) {
+			fprintf(stderr, "error: double free of %p\n", ptr);
+			abort();
+		}
+
+		if (block && block->snap) {
+			/* the snapshot still needs it */
+			block->freed = true;
+			return;
+		}
+
+		if (block)
+			heap_untrack(block);
+	}
+
 	free(ptr);
 }
 
 void *rballoc_align(uint32_t flags, uint32_t caps, size_t bytes,
 		    uint32_t alignment)
 {
-	return malloc(bytes);
+	void *ptr = malloc(bytes);
+
+	heap_track(ptr, bytes);
+	return ptr;
 }
 
 void *rbrealloc_align(void *ptr, uint32_t flags, uint32_t caps, size_t bytes,
 		      size_t old_bytes, uint32_t alignment)
 {
-	return realloc(ptr, bytes);
+	void *new_ptr;
+
+	if (!tracker.enabled)
+		return realloc(ptr, bytes);
+
+	/* never move a block the snapshot refers to */
+	new_ptr = rballoc_align(flags, caps, bytes, alignment);
+	if (new_ptr && ptr) {
+		memcpy_s(new_ptr, bytes, ptr, MIN(bytes, old_bytes));
+		rfree(ptr);
+	}
+
+	return new_ptr;
 }
 
 void heap_trace(struct mm_heap *heap, int size)
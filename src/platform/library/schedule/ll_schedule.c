@@ -34,6 +34,9 @@ struct ll_vcore {
 	pthread_t thread_id;
 	int vcore_ready;
 	int core_id;
+	struct task *running;	/* task in its run() on this vcore */
+	bool cancel_running;	/* running task was cancelled */
+	struct list_item *next;	/* next task of the LL thread list walk */
 };
 
 static int tick_period_us;
@@ -62,7 +65,7 @@ static void *ll_thread(void *data)
 {
 	struct ll_vcore *vc = data;
 	struct timespec ts, td0, td1;
-	struct list_item *tlist, *tlist_;
+	struct list_item *tlist;
 	struct task *task;
 	int err;
 	uint64_t delta;
@@ -117,13 +120,18 @@ static void *ll_thread(void *data)
 			break;
 		}
 
-		/* iterate through the task list */
-		list_for_item_safe(tlist, tlist_, &vc->list) {
+		/*
+		 * iterate through the task list, other threads can unlink
+		 * tasks while it is unlocked for a run()
+		 */
+		for (tlist = vc->list.next; tlist != &vc->list; tlist = vc->next) {
+			vc->next = tlist->next;
 			task = container_of(tlist, struct task, list);
 
 			/* only run queued tasks */
 			if (task->state == SOF_TASK_STATE_QUEUED) {
 				task->state = SOF_TASK_STATE_RUNNING;
+				vc->running = task;
 				pthread_mutex_unlock(&vc->list_mutex);
 
 				/* run task and time it */
@@ -132,6 +140,17 @@ static void *ll_thread(void *data)
 				clock_gettime(CLOCK_MONOTONIC, &td1);
 
 				pthread_mutex_lock(&vc->list_mutex);
+				vc->running = NULL;
+
+				/*
+				 * A task cancelled while running is only reported
+				 * as cancelled now, so nobody tears its pipeline
+				 * down while run() is still copying.
+				 */
+				if (vc->cancel_running) {
+					vc->cancel_running = false;
+					task->state = SOF_TASK_STATE_CANCEL;
+				}
 
 				/* only re-queue if not cancelled */
 				if (task->state == SOF_TASK_STATE_RUNNING)
@@ -153,13 +172,22 @@ out:
 	return NULL;
 }
 
+/* unlink a task, keeping the list walk of the LL thread valid */
+static void ll_task_del(struct ll_vcore *vc, struct task *task)
+{
+	if (vc->next == &task->list)
+		vc->next = task->list.next;
+
+	list_item_del(&task->list);
+}
+
 static int schedule_ll_task_complete(void *data, struct task *task)
 {
 	struct ll_vcore *vc = data;
 
 	/* task is complete so remove it from list */
 	pthread_mutex_lock(&vc->list_mutex);
-	list_item_del(&task->list);
+	ll_task_del(vc, task);
 	task->state = SOF_TASK_STATE_COMPLETED;
 	pthread_mutex_unlock(&vc->list_mutex);
 
@@ -247,9 +275,18 @@ static int schedule_ll_task_cancel(void *data, struct task *task)
 	struct ll_vcore *vc = data;
 
 	pthread_mutex_lock(&vc->list_mutex);
+
+	/* cancelled while in its run(), finish it in the LL thread */
+	if (task == vc->running) {
+		vc->cancel_running = true;
+		ll_task_del(vc, task);
+		pthread_mutex_unlock(&vc->list_mutex);
+		return 0;
+	}
+
 	/* delete task */
 	task->state = SOF_TASK_STATE_CANCEL;
-	list_item_del(&task->list);
+	ll_task_del(vc, task);
 
 	/* list empty then return */
 	if (list_is_empty(&vc->list)) {
@@ -269,7 +306,7 @@ static int schedule_ll_task_free(void *data, struct task *task)
 
 	pthread_mutex_lock(&vc->list_mutex);
 	task->state = SOF_TASK_STATE_FREE;
-	list_item_del(&task->list);
+	ll_task_del(vc, task);
 
 	/* list empty then return */
 	if (list_is_empty(&vc->list)) {
@@ -19,6 +19,7 @@
 #include <sof/lib/perf_cnt.h>
 #include <sof/lib/uuid.h>
 #include <sof/list.h>
+#include <sof/math/numbers.h>
 #include <sof/platform.h>
 #include <sof/schedule/ll_schedule.h>
 #include <sof/schedule/ll_schedule_domain.h>
@@ -74,6 +75,14 @@ struct ll_schedule_data {
 	struct perf_cnt_data pcd;
 #endif
 	struct ll_schedule_domain *domain;	/* scheduling domain */
+#if CONFIG_PIPELINE_SHED
+	uint32_t cycles_sum;			/* load of the ticks, see dsp_load_shed() */
+	uint32_t cycles_max;
+	uint32_t cycles_cnt;
+	uint32_t shed_calm;			/* calm windows since the last change */
+	uint32_t shed_calm_limit;		/* calm windows needed to restore */
+	bool shed_restored;			/* last change was a restore */
+#endif
 };
 
 static const struct scheduler_ops schedule_ll_ops;
@@ -191,6 +200,84 @@ static inline void dsp_load_check(struct task *task, uint32_t cycles0, uint32_t
 }
 #endif
 
+#if CONFIG_PIPELINE_SHED
+/* calm windows before a restore, doubled when a restore overloads the core again */
+#define SHED_CALM_WINDOWS	4
+#define SHED_CALM_WINDOWS_MAX	64
+
+/* shortest period of the LL tasks, the length of a tick */
+static uint64_t schedule_ll_tick_cycles(struct ll_schedule_data *sch)
+{
+	struct ll_task_pdata *pdata;
+	struct list_item *tlist;
+	struct task *task;
+	uint64_t period = 0;
+
+	list_for_item(tlist, &sch->tasks) {
+		task = container_of(tlist, struct task, list);
+		pdata = ll_sch_get_pdata(task);
+		if (pdata->period && (!period || pdata->period < period))
+			period = pdata->period;
+	}
+
+	return k_us_to_cyc_ceil64(period);
+}
+
+/*
+ * Load of the whole ticks, checked over the same windows as the load of
+ * each task in dsp_load_check(). A window over the high threshold sheds
+ * a tier of components, a few calm windows restore one.
+ */
+static void dsp_load_shed(struct ll_schedule_data *sch, uint32_t cycles0, uint32_t cycles1)
+{
+	uint32_t diff = cycles1 - cycles0;
+	uint64_t period;
+	uint32_t load;
+
+	sch->cycles_sum += diff;
+	sch->cycles_max = MAX(sch->cycles_max, diff);
+
+	if (++sch->cycles_cnt < 1 << CHECKS_WINDOW_SIZE)
+		return;
+
+	sch->cycles_sum >>= CHECKS_WINDOW_SIZE;
+	period = schedule_ll_tick_cycles(sch);
+	load = period ? sch->cycles_sum * 100ULL / period : 0;
+
+	if (!sch->shed_calm_limit)
+		sch->shed_calm_limit = SHED_CALM_WINDOWS;
+
+	if (load > CONFIG_PIPELINE_SHED_HIGH_PCT) {
+		tr_warn(&ll_tr, "ll load %u percent of the tick, avg %u max %u",
+			load, sch->cycles_sum, sch->cycles_max);
+		sch->shed_calm = 0;
+		if (pipeline_shed(&sch->tasks, true)) {
+			/* the last restore didn't hold, wait longer next time */
+			if (sch->shed_restored)
+				sch->shed_calm_limit = MIN(sch->shed_calm_limit * 2,
+							   SHED_CALM_WINDOWS_MAX);
+			sch->shed_restored = false;
+		}
+	} else if (load < CONFIG_PIPELINE_SHED_LOW_PCT && sch->cycles_max <= period) {
+		if (++sch->shed_calm >= sch->shed_calm_limit) {
+			sch->shed_calm = 0;
+			if (pipeline_shed(&sch->tasks, false)) {
+				/* the last restore held */
+				if (sch->shed_restored)
+					sch->shed_calm_limit = SHED_CALM_WINDOWS;
+				sch->shed_restored = true;
+			}
+		}
+	} else {
+		sch->shed_calm = 0;
+	}
+
+	sch->cycles_sum = 0;
+	sch->cycles_max = 0;
+	sch->cycles_cnt = 0;
+}
+#endif
+
 static void schedule_ll_tasks_execute(struct ll_schedule_data *sch)
 {
 	struct ll_schedule_domain *domain = sch->domain;
@@ -318,8 +405,16 @@ static void schedule_ll_tasks_run(void *data)
 	perf_cnt_init(&sch->pcd);
 
 	/* run tasks if there are any pending */
-	if (schedule_ll_is_pending(sch))
+	if (schedule_ll_is_pending(sch)) {
+#if CONFIG_PIPELINE_SHED
+		uint32_t cycles0 = (uint32_t)sof_cycle_get_64();
+
 		schedule_ll_tasks_execute(sch);
+		dsp_load_shed(sch, cycles0, (uint32_t)sof_cycle_get_64());
+#else
+		schedule_ll_tasks_execute(sch);
+#endif
+	}
 
 	notifier_event(sch, NOTIFIER_ID_LL_POST_RUN,
 		       NOTIFIER_TARGET_CORE_LOCAL, NULL, 0);
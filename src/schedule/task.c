@@ -23,6 +23,7 @@
 #include <sof/schedule/schedule.h>
 #include <sof/schedule/task.h>
 #include <sof/sof.h>
+#include <sof/trace/trace.h>
 #include <ipc/topology.h>
 #include <errno.h>
 #include <stddef.h>
@@ -94,6 +95,7 @@ int task_main_start(struct sof *sof)
 	int ret;
 
 	/* init default audio components */
+	trace_point(TRACE_BOOT_SYS_COMP);
 	sys_comp_init(sof);
 
 	/* init self-registered modules */
@@ -107,6 +109,9 @@ int task_main_start(struct sof *sof)
 	if (ret < 0)
 		return ret;
 
+	trace_point(TRACE_BOOT_SYS_READY);
+	boot_profile_dump();
+
 	/* task initialized in edf_scheduler_init */
 	schedule_task(*task_main_get(), 0, UINT64_MAX);
 
@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+/*
+ * Boot time profiling. Every boot trace point also records a timestamp,
+ * per core, so the time spent in each init stage shows up in the trace
+ * once the firmware is up. Trace points are hit before the heap and the
+ * timers are set up, so the table is static and the timestamps are read
+ * from the core's cycle counter. Only the 32 bit difference to
+ * TRACE_BOOT_START is kept, which wraps correctly with a 32 bit counter.
+ */
+
+#include <sof/compiler_attributes.h>
+#include <sof/drivers/timer.h>
+#include <sof/lib/cpu.h>
+#include <sof/lib/memory.h>
+#include <sof/lib/uuid.h>
+#include <sof/trace/trace.h>
+#include <user/trace.h>
+#include <stdint.h>
+
+#if !defined(__ZEPHYR__) && !CONFIG_LIBRARY
+#include <xtensa/hal.h>
+#endif
+
+/* 45a787da-a63b-40d0-8e9d-19039719c567 */
+DECLARE_SOF_UUID("boot-profile", boot_profile_uuid, 0x45a787da, 0xa63b, 0x40d0,
+		 0x8e, 0x9d, 0x19, 0x03, 0x97, 0x19, 0xc5, 0x67);
+
+DECLARE_TR_CTX(boot_profile_tr, SOF_UUID(boot_profile_uuid), LOG_LEVEL_INFO);
+
+/* enough for the trace points of a full primary core boot */
+#define BOOT_PROFILE_POINTS	32
+
+struct boot_profile_entry {
+	uint32_t point;		/* TRACE_BOOT_ code */
+	uint32_t cycles;	/* cycles since TRACE_BOOT_START */
+};
+
+struct boot_profile {
+	uint64_t start;		/* timestamp of TRACE_BOOT_START */
+	uint32_t count;		/* recorded entries */
+	uint32_t dropped;	/* entries that didn't fit */
+	struct boot_profile_entry entry[BOOT_PROFILE_POINTS];
+} __aligned(PLATFORM_DCACHE_ALIGN);
+
+/*
+ * Written before the heap is up, one table per core needs no locking.
+ * Each table starts on and fills whole cache lines, so no line is shared
+ * by two cores.
+ */
+static struct boot_profile boot_profile[CONFIG_CORE_COUNT];
+
+static uint64_t boot_profile_now(void)
+{
+#ifdef __ZEPHYR__
+	return sof_cycle_get_64();
+#elif CONFIG_LIBRARY
+	return 0;
+#else
+	/* the cpu timers are only allocated in platform_init() */
+	return xthal_get_ccount();
+#endif
+}
+
+void boot_profile_point(uint32_t point)
+{
+	struct boot_profile *bp = &boot_profile[cpu_get_id()];
+	uint64_t now = boot_profile_now();
+
+	/* a core restored from D0ix boots again */
+	if (point == TRACE_BOOT_START) {
+		bp->start = now;
+		bp->count = 0;
+		bp->dropped = 0;
+	}
+
+	if (bp->count == BOOT_PROFILE_POINTS) {
+		bp->dropped++;
+		return;
+	}
+
+	bp->entry[bp->count].point = point;
+	bp->entry[bp->count].cycles = now - bp->start;
+	bp->count++;
+}
+
+void boot_profile_dump(void)
+{
+	struct boot_profile *bp = &boot_profile[cpu_get_id()];
+	uint32_t prev = 0;
+	int i;
+
+	for (i = 0; i < bp->count; i++) {
+		tr_info(&boot_profile_tr, "boot point 0x%x at %u cycles, +%u",
+			bp->entry[i].point, bp->entry[i].cycles,
+			bp->entry[i].cycles - prev);
+		prev = bp->entry[i].cycles;
+	}
+
+	if (bp->dropped)
+		tr_warn(&boot_profile_tr, "boot profile dropped %u points", bp->dropped);
+}
@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <sof/audio/aria/aria.h>
+#include <sof/audio/component.h>
+#include <sof/common.h>
+#include <sof/string.h>
+
+#define ARIA_TEST_BLOCKS	24
+
+/* Output hashes of the cases below. The build picks the generic or the
+ * HiFi3 kernels like the firmware does, so running the test on the host
+ * and on the xtensa simulator checks that both produce the same output.
+ */
+static const struct aria_test_case {
+	size_t chan_cnt;
+	size_t smpl_groups;
+	size_t att;
+	uint32_t hash;
+} aria_test_cases[] = {
+	{ 1, 48, 1, 0x80e00609 },
+	{ 2, 48, 2, 0x75dfd63d },
+	{ 3, 48, 1, 0x0ecd45c7 },
+	{ 3, 47, 3, 0x03bd0c75 },	/* odd delay line, unaligned read */
+	{ 4, 48, 3, 0x6f0efa95 },
+	{ 5, 47, 2, 0x7709a6f5 },	/* odd delay line, unaligned read */
+	{ 8, 48, 1, 0x73a85825 },
+};
+
+struct aria_test {
+	struct comp_dev dev;
+	struct aria_data cd;
+	int32_t *in;
+	int32_t *out;
+	size_t samples;
+};
+
+static void aria_test_new(struct aria_test *t, const struct aria_test_case *tc)
+{
+	struct comp_dev *dev = &t->dev;
+	size_t idx;
+
+	/* same state as aria_algo_init() */
+	memset(t, 0, sizeof(*t));
+	t->samples = tc->chan_cnt * tc->smpl_groups;
+	t->cd.chan_cnt = tc->chan_cnt;
+	t->cd.smpl_group_cnt = tc->smpl_groups;
+	t->cd.buff_size = ALIGN_UP(t->samples, 2);
+	t->cd.offset = t->samples % 2;
+	t->cd.att = tc->att;
+	for (idx = 0; idx < ARIA_MAX_GAIN_STATES; ++idx)
+		t->cd.gains[idx] = (1ULL << (32 - t->cd.att - 1)) - 1;
+
+	t->cd.data = test_calloc(t->cd.buff_size, sizeof(int32_t));
+	t->in = test_calloc(t->cd.buff_size, sizeof(int32_t));
+	t->out = test_calloc(t->cd.buff_size, sizeof(int32_t));
+	assert_non_null(t->cd.data);
+	assert_non_null(t->in);
+	assert_non_null(t->out);
+
+	comp_set_drvdata(dev, &t->cd);
+}
+
+static void aria_test_free(struct aria_test *t)
+{
+	test_free(t->cd.data);
+	test_free(t->in);
+	test_free(t->out);
+}
+
+/* noise at a level that changes every few blocks, with full scale peaks */
+static void aria_test_fill(struct aria_test *t, int block, uint32_t *seed)
+{
+	static const int shift[] = { 8, 8, 2, 0, 0, 4, 12, 1 };
+	size_t i;
+
+	for (i = 0; i < t->samples; i++) {
+		*seed = *seed * 1664525 + 1013904223;
+		t->in[i] = (int32_t)*seed >> shift[(block / 3) % ARRAY_SIZE(shift)];
+	}
+
+	if (block % 7 == 3)
+		t->in[t->samples / 2] = INT32_MIN;
+}
+
+static uint32_t aria_test_hash(uint32_t hash, const int32_t *data, size_t samples)
+{
+	size_t i;
+
+	/* FNV-1a over the sample values */
+	for (i = 0; i < samples; i++)
+		hash = (hash ^ (uint32_t)data[i]) * 16777619;
+
+	return hash;
+}
+
+static void test_aria_kernel_golden(void **state)
+{
+	const struct aria_test_case *tc;
+	struct aria_test t;
+	uint32_t seed;
+	uint32_t hash;
+	int block;
+	int i;
+
+	(void)state;
+
+	for (i = 0; i < ARRAY_SIZE(aria_test_cases); i++) {
+		tc = &aria_test_cases[i];
+		aria_test_new(&t, tc);
+		seed = i + 1;
+		hash = 2166136261;
+
+		for (block = 0; block < ARIA_TEST_BLOCKS; block++) {
+			aria_test_fill(&t, block, &seed);
+			assert_int_equal(aria_process_data(&t.dev, t.out, t.samples, t.in,
+							   t.samples), 0);
+			hash = aria_test_hash(hash, t.out, t.samples);
+		}
+
+		printf("%s: %zu ch, %zu groups, att %zu: hash 0x%08x\n", __func__,
+		       tc->chan_cnt, tc->smpl_groups, tc->att, hash);
+		assert_int_equal(hash, tc->hash);
+
+		aria_test_free(&t);
+	}
+}
+
+/* a signal under the attenuation threshold is delayed by one block and,
+ * once the gain states have filled, amplified by 2 pow att, also with an
+ * odd delay line and in bypass
+ */
+static void test_aria_kernel_quiet_gain(void **state)
+{
+	static const struct aria_test_case quiet_cases[] = {
+		{ 2, 48, 2, 0 },
+		{ 3, 47, 2, 0 },
+		{ 3, 47, 0, 0 },
+	};
+	const struct aria_test_case *tc;
+	struct aria_test t;
+	int32_t prev[3 * 48];
+	int32_t diff;
+	size_t i;
+	int block;
+	int j;
+
+	(void)state;
+
+	for (j = 0; j < ARRAY_SIZE(quiet_cases); j++) {
+		tc = &quiet_cases[j];
+		aria_test_new(&t, tc);
+		memset(prev, 0, sizeof(prev));
+
+		for (block = 0; block < ARIA_TEST_BLOCKS; block++) {
+			for (i = 0; i < t.samples; i++)
+				t.in[i] = (int32_t)((block * 200 + i) * 40009) -
+					  (INT32_MAX >> 3);
+
+			assert_int_equal(aria_process_data(&t.dev, t.out, t.samples, t.in,
+							   t.samples), 0);
+
+			for (i = 0; block >= ARIA_MAX_GAIN_STATES && i < t.samples; i++) {
+				diff = t.out[i] - prev[i] * (1 << tc->att);
+				assert_true(diff >= -(1 << tc->att) && diff <= 1 << tc->att);
+			}
+
+			memcpy_s(prev, sizeof(prev), t.in, t.samples * sizeof(int32_t));
+		}
+
+		aria_test_free(&t);
+	}
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_aria_kernel_golden),
+		cmocka_unit_test(test_aria_kernel_quiet_gain),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
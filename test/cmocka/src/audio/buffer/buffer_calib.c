@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/buffer.h>
+#include <sof/ipc/driver.h>
+#include <sof/ipc/msg.h>
+#include <sof/ipc/topology.h>
+#include <sof/ipc/schedule.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+/* two S16 channels, 4 bytes per frame */
+static struct comp_buffer *calib_buffer_new(uint32_t size)
+{
+	struct sof_ipc_buffer test_buf_desc = {
+		.size = size
+	};
+	struct comp_buffer *buf = buffer_new(&test_buf_desc);
+
+	assert_non_null(buf);
+	buf->stream.frame_fmt = SOF_IPC_FRAME_S16_LE;
+	buf->stream.channels = 2;
+	buffer_reset_pos(buf, NULL);
+
+	return buf;
+}
+
+static void test_audio_buffer_calib_jitter(void **state)
+{
+	struct comp_buffer *buf = calib_buffer_new(64);
+
+	(void)state;
+
+	comp_update_buffer_produce(buf, 16);
+	comp_update_buffer_consume(buf, 12);
+	comp_update_buffer_produce(buf, 24);
+	comp_update_buffer_consume(buf, 20);
+
+	assert_int_equal(buf->calib.fill_min, 4);
+	assert_int_equal(buf->calib.fill_max, 28);
+	assert_int_equal(buf->calib.produce_min, 16);
+	assert_int_equal(buf->calib.produce_max, 24);
+	assert_int_equal(buf->calib.consume_min, 12);
+	assert_int_equal(buf->calib.consume_max, 20);
+	assert_int_equal(buf->calib.full, 0);
+
+	/* the highest fill level and 8 bytes of jitter */
+	assert_int_equal(buffer_calib_size(buf), 36);
+
+	buffer_free(buf);
+}
+
+static void test_audio_buffer_calib_full(void **state)
+{
+	struct comp_buffer *buf = calib_buffer_new(64);
+
+	(void)state;
+
+	comp_update_buffer_produce(buf, 64);
+	comp_update_buffer_consume(buf, 32);
+
+	/* a full buffer may have stalled its producer, it keeps its size */
+	assert_int_equal(buf->calib.full, 1);
+	assert_int_equal(buffer_calib_size(buf), 64);
+
+	buffer_free(buf);
+}
+
+static void test_audio_buffer_calib_reset(void **state)
+{
+	struct comp_buffer *buf = calib_buffer_new(64);
+
+	(void)state;
+
+	comp_update_buffer_produce(buf, 8);
+	comp_update_buffer_consume(buf, 8);
+	assert_int_equal(buffer_calib_size(buf), 8);
+
+	/* prepare starts a new measurement */
+	buffer_reset_pos(buf, NULL);
+	assert_int_equal(buf->calib.produces, 0);
+	assert_int_equal(buffer_calib_size(buf), 64);
+
+	buffer_free(buf);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_audio_buffer_calib_jitter),
+		cmocka_unit_test(test_audio_buffer_calib_full),
+		cmocka_unit_test(test_audio_buffer_calib_reset),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
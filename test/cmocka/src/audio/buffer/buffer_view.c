@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/buffer.h>
+#include <sof/ipc/driver.h>
+#include <sof/ipc/msg.h>
+#include <sof/ipc/topology.h>
+#include <sof/ipc/schedule.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <math.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+#define VIEW_TEST_CHANNELS	4
+#define VIEW_TEST_FRAMES	6
+
+static struct comp_buffer *view_test_buffer(void)
+{
+	struct sof_ipc_buffer test_buf_desc = {
+		.size = VIEW_TEST_FRAMES * VIEW_TEST_CHANNELS * sizeof(int16_t)
+	};
+	struct comp_buffer *buf = buffer_new(&test_buf_desc);
+
+	assert_non_null(buf);
+	buf->stream.frame_fmt = SOF_IPC_FRAME_S16_LE;
+	buf->stream.channels = VIEW_TEST_CHANNELS;
+
+	return buf;
+}
+
+/* sample value encodes the frame and the channel */
+static int16_t view_test_sample(int frame, int ch)
+{
+	return frame * 10 + ch;
+}
+
+static void view_test_produce(struct comp_buffer *buf, int first_frame, int frames)
+{
+	int16_t *ptr;
+	int frame;
+	int ch;
+
+	for (frame = 0; frame < frames; frame++) {
+		for (ch = 0; ch < VIEW_TEST_CHANNELS; ch++) {
+			ptr = audio_stream_write_frag_s16(&buf->stream,
+							  frame * VIEW_TEST_CHANNELS + ch);
+			*ptr = view_test_sample(first_frame + frame, ch);
+		}
+	}
+
+	comp_update_buffer_produce(buf, frames * VIEW_TEST_CHANNELS * sizeof(int16_t));
+}
+
+static void test_audio_buffer_view_reads_mapped_channels(void **state)
+{
+	(void)state;
+
+	struct comp_buffer *buf = view_test_buffer();
+	struct audio_stream_view view;
+	uint8_t ch_map[2] = {3, 1};
+	int16_t *frame;
+	int i;
+
+	view_test_produce(buf, 0, VIEW_TEST_FRAMES);
+
+	assert_int_equal(audio_stream_view_init(&view, &buf->stream, ch_map, 2), 0);
+	assert_int_equal(view.channels, 2);
+	assert_int_equal(view.stride, VIEW_TEST_CHANNELS);
+	assert_int_equal(audio_stream_view_get_avail_frames(&view), VIEW_TEST_FRAMES);
+
+	frame = buf->stream.r_ptr;
+	for (i = 0; i < VIEW_TEST_FRAMES; i++) {
+		assert_int_equal(audio_stream_view_read_s16(&view, frame, 0),
+				 view_test_sample(i, 3));
+		assert_int_equal(audio_stream_view_read_s16(&view, frame, 1),
+				 view_test_sample(i, 1));
+		frame = audio_stream_view_next_frame(&view, frame, 1);
+	}
+
+	buffer_free(buf);
+}
+
+static void test_audio_buffer_view_wraps_with_parent(void **state)
+{
+	(void)state;
+
+	struct comp_buffer *buf = view_test_buffer();
+	struct audio_stream_view view;
+	int16_t *frame;
+	int i;
+
+	/* move the read position so the next frames wrap */
+	view_test_produce(buf, 0, 4);
+	comp_update_buffer_consume(buf, 4 * VIEW_TEST_CHANNELS * sizeof(int16_t));
+	view_test_produce(buf, 4, 4);
+
+	assert_int_equal(audio_stream_view_init(&view, &buf->stream, NULL, 2), 0);
+	assert_int_equal(view.ch_map[0], 0);
+	assert_int_equal(view.ch_map[1], 1);
+
+	frame = buf->stream.r_ptr;
+	assert_int_equal(audio_stream_view_frames_without_wrap(&view, frame), 2);
+
+	for (i = 4; i < 8; i++) {
+		assert_int_equal(audio_stream_view_read_s16(&view, frame, 0),
+				 view_test_sample(i, 0));
+		assert_int_equal(audio_stream_view_read_s16(&view, frame, 1),
+				 view_test_sample(i, 1));
+		frame = audio_stream_view_next_frame(&view, frame, 1);
+	}
+
+	buffer_free(buf);
+}
+
+static void test_audio_buffer_view_repeats_channels(void **state)
+{
+	(void)state;
+
+	struct comp_buffer *buf = view_test_buffer();
+	struct audio_stream_view view;
+	uint8_t ch_map[VIEW_TEST_CHANNELS + 2] = {2, 2, 0, 2, 1, 0};
+	int16_t *frame;
+	int i;
+	int ch;
+
+	view_test_produce(buf, 0, VIEW_TEST_FRAMES);
+
+	/* a channel fanned out to several view channels */
+	assert_int_equal(audio_stream_view_init(&view, &buf->stream, ch_map,
+						ARRAY_SIZE(ch_map)), 0);
+	assert_int_equal(view.channels, ARRAY_SIZE(ch_map));
+	assert_int_equal(view.stride, VIEW_TEST_CHANNELS);
+
+	frame = buf->stream.r_ptr;
+	for (i = 0; i < VIEW_TEST_FRAMES; i++) {
+		for (ch = 0; ch < ARRAY_SIZE(ch_map); ch++)
+			assert_int_equal(audio_stream_view_read_s16(&view, frame, ch),
+					 view_test_sample(i, ch_map[ch]));
+		frame = audio_stream_view_next_frame(&view, frame, 1);
+	}
+
+	buffer_free(buf);
+}
+
+static void test_audio_buffer_view_rejects_missing_channels(void **state)
+{
+	(void)state;
+
+	struct comp_buffer *buf = view_test_buffer();
+	struct audio_stream_view view;
+	uint8_t ch_map[2] = {0, VIEW_TEST_CHANNELS};
+
+	assert_int_equal(audio_stream_view_init(&view, &buf->stream, ch_map, 2), -EINVAL);
+	assert_int_equal(audio_stream_view_init(&view, &buf->stream, NULL,
+						VIEW_TEST_CHANNELS + 1), -EINVAL);
+	assert_int_equal(audio_stream_view_init(&view, &buf->stream, NULL,
+						SOF_IPC_MAX_CHANNELS + 1), -EINVAL);
+	assert_int_equal(audio_stream_view_init(&view, &buf->stream, NULL, 0), -EINVAL);
+
+	buffer_free(buf);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_audio_buffer_view_reads_mapped_channels),
+		cmocka_unit_test(test_audio_buffer_view_wraps_with_parent),
+		cmocka_unit_test(test_audio_buffer_view_repeats_channels),
+		cmocka_unit_test(test_audio_buffer_view_rejects_missing_channels),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
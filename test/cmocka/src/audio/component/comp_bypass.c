@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <sof/audio/buffer.h>
+#include <sof/audio/component_ext.h>
+#include <sof/audio/pipeline.h>
+#include <ipc/stream.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+#define TEST_RATE		48000
+#define TEST_CHANNELS		2
+#define TEST_FRAMES		48
+#define TEST_SAMPLES		(TEST_FRAMES * TEST_CHANNELS)
+#define TEST_BUFFER_SIZE	(2 * TEST_SAMPLES * sizeof(int32_t))
+
+struct bypass_data {
+	struct comp_dev dev;
+	struct comp_buffer *source;
+	struct comp_buffer *sink;
+	int copies;		/* copies the component made itself */
+	int bypassed;		/* COMP_ATTR_BYPASS received */
+};
+
+static int bypass_test_copy(struct comp_dev *dev)
+{
+	struct bypass_data *bd = comp_get_drvdata(dev);
+
+	bd->copies++;
+	return 0;
+}
+
+static int bypass_test_set_attribute(struct comp_dev *dev, uint32_t type, void *value)
+{
+	struct bypass_data *bd = comp_get_drvdata(dev);
+
+	if (type == COMP_ATTR_BYPASS)
+		bd->bypassed++;
+
+	return 0;
+}
+
+static const struct comp_driver bypass_test_drv = {
+	.ops = {
+		.copy = bypass_test_copy,
+		.set_attribute = bypass_test_set_attribute,
+	},
+};
+
+static struct comp_buffer *bypass_buffer(void)
+{
+	struct comp_buffer *buffer = buffer_alloc(TEST_BUFFER_SIZE, SOF_MEM_CAPS_RAM, 0);
+
+	assert_non_null(buffer);
+	buffer->stream.rate = TEST_RATE;
+	buffer->stream.channels = TEST_CHANNELS;
+	buffer->stream.frame_fmt = SOF_IPC_FRAME_S32_LE;
+
+	return buffer;
+}
+
+static int setup(void **state)
+{
+	struct bypass_data *bd = test_calloc(1, sizeof(*bd));
+	struct comp_dev *dev = &bd->dev;
+
+	dev->drv = &bypass_test_drv;
+	dev->state = COMP_STATE_ACTIVE;
+	list_init(&dev->bsource_list);
+	list_init(&dev->bsink_list);
+	comp_set_drvdata(dev, bd);
+
+	bd->source = bypass_buffer();
+	bd->sink = bypass_buffer();
+	pipeline_connect(dev, bd->source, PPL_CONN_DIR_BUFFER_TO_COMP);
+	pipeline_connect(dev, bd->sink, PPL_CONN_DIR_COMP_TO_BUFFER);
+
+	*state = bd;
+
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	struct bypass_data *bd = *state;
+
+	buffer_free(bd->source);
+	buffer_free(bd->sink);
+	test_free(bd);
+
+	return 0;
+}
+
+static void bypass_fill(struct bypass_data *bd)
+{
+	int32_t *src = bd->source->stream.w_ptr;
+	int i;
+
+	for (i = 0; i < TEST_SAMPLES; i++)
+		src[i] = i + 1;
+	audio_stream_produce(&bd->source->stream, TEST_SAMPLES * sizeof(int32_t));
+}
+
+static void test_comp_bypass_copy(void **state)
+{
+	struct bypass_data *bd = *state;
+	int32_t *snk = bd->sink->stream.w_ptr;
+	int i;
+
+	assert_true(comp_can_bypass(&bd->dev));
+
+	bypass_fill(bd);
+	bd->dev.bypass = true;
+	assert_int_equal(comp_copy_bypass(&bd->dev), 0);
+
+	/* the input goes to the output unchanged, without the component */
+	assert_int_equal(audio_stream_get_avail_bytes(&bd->sink->stream),
+			 TEST_SAMPLES * sizeof(int32_t));
+	assert_int_equal(audio_stream_get_avail_bytes(&bd->source->stream), 0);
+	for (i = 0; i < TEST_SAMPLES; i++)
+		assert_int_equal(snk[i], i + 1);
+
+	assert_int_equal(bd->copies, 0);
+	assert_int_equal(bd->bypassed, 1);
+	assert_true(bd->dev.bypass);
+}
+
+static void test_comp_bypass_format(void **state)
+{
+	struct bypass_data *bd = *state;
+
+	/* a format converter can't be bypassed */
+	bd->sink->stream.frame_fmt = SOF_IPC_FRAME_S16_LE;
+	assert_false(comp_can_bypass(&bd->dev));
+
+	bd->sink->stream.frame_fmt = SOF_IPC_FRAME_S32_LE;
+	bd->sink->stream.channels = TEST_CHANNELS * 2;
+	assert_false(comp_can_bypass(&bd->dev));
+
+	bd->sink->stream.channels = TEST_CHANNELS;
+	bd->sink->stream.rate = TEST_RATE / 2;
+	assert_false(comp_can_bypass(&bd->dev));
+}
+
+static void test_comp_bypass_format_changed(void **state)
+{
+	struct bypass_data *bd = *state;
+
+	/* new params changed the format of a bypassed component */
+	bd->dev.bypass = true;
+	bd->sink->stream.frame_fmt = SOF_IPC_FRAME_S16_LE;
+	bypass_fill(bd);
+
+	assert_int_equal(comp_copy_bypass(&bd->dev), 0);
+
+	/* the component processes again rather than output silence */
+	assert_false(bd->dev.bypass);
+	assert_int_equal(bd->copies, 1);
+	assert_int_equal(bd->bypassed, 0);
+	assert_int_equal(audio_stream_get_avail_bytes(&bd->source->stream),
+			 TEST_SAMPLES * sizeof(int32_t));
+	assert_int_equal(audio_stream_get_avail_bytes(&bd->sink->stream), 0);
+}
+
+static void test_comp_bypass_reset(void **state)
+{
+	struct bypass_data *bd = *state;
+
+	bd->dev.bypass = true;
+	assert_int_equal(comp_reset(&bd->dev), 0);
+
+	/* the next stream starts with the component processing */
+	assert_false(bd->dev.bypass);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_comp_bypass_copy, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_comp_bypass_format, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_comp_bypass_format_changed,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_comp_bypass_reset, setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
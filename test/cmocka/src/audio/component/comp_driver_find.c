@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component_ext.h>
+#include <sof/lib/uuid.h>
+#include <sof/sof.h>
+#include <errno.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+/* three times the hash table size, some UUIDs share a bucket */
+#define TEST_DRIVERS	(3 * COMP_DRIVER_HASH_SIZE)
+
+struct find_test_data {
+	struct sof_uuid uuid[TEST_DRIVERS];
+	struct comp_driver drv[TEST_DRIVERS];
+	struct comp_driver_info info[TEST_DRIVERS];
+};
+
+static int setup(void **state)
+{
+	struct find_test_data *td = test_calloc(1, sizeof(*td));
+	int i;
+
+	if (!td)
+		return -1;
+
+	sys_comp_init(sof_get());
+
+	for (i = 0; i < TEST_DRIVERS; i++) {
+		td->uuid[i].a = 0x5a5a0000 + i;
+		td->uuid[i].b = i * 7;
+		td->uuid[i].c = 0x1234;
+		td->uuid[i].d[7] = i;
+
+		/* types i and i + COMP_DRIVER_HASH_SIZE share a bucket */
+		td->drv[i].type = 1000 + i;
+		td->drv[i].uid = &td->uuid[i];
+		td->info[i].drv = &td->drv[i];
+	}
+
+	*state = td;
+
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	test_free(*state);
+
+	return 0;
+}
+
+static void register_all(struct find_test_data *td)
+{
+	int i;
+
+	for (i = 0; i < TEST_DRIVERS; i++)
+		assert_int_equal(comp_register(&td->info[i]), 0);
+}
+
+static void test_comp_driver_find_collisions(void **state)
+{
+	struct find_test_data *td = *state;
+	struct sof_uuid uuid;
+	int i;
+
+	register_all(td);
+
+	for (i = 0; i < TEST_DRIVERS; i++) {
+		assert_ptr_equal(comp_driver_find_uuid((const uint8_t *)&td->uuid[i]),
+				 &td->drv[i]);
+		assert_ptr_equal(comp_driver_find_type(td->drv[i].type), &td->drv[i]);
+	}
+
+	/* a UUID or type that is not registered, in a bucket in use */
+	uuid = td->uuid[0];
+	uuid.d[0] = 1;
+	assert_null(comp_driver_find_uuid((const uint8_t *)&uuid));
+	assert_null(comp_driver_find_type(1000 + TEST_DRIVERS));
+
+	for (i = 0; i < TEST_DRIVERS; i++)
+		comp_unregister(&td->info[i]);
+}
+
+static void test_comp_driver_find_duplicates(void **state)
+{
+	struct find_test_data *td = *state;
+	const uint8_t *uuid = (const uint8_t *)&td->uuid[0];
+
+	/* a second driver with the same UUID and type replaces the first */
+	td->drv[1].type = td->drv[0].type;
+	td->drv[1].uid = &td->uuid[0];
+
+	assert_int_equal(comp_register(&td->info[0]), 0);
+	assert_int_equal(comp_register(&td->info[1]), 0);
+	assert_ptr_equal(comp_driver_find_uuid(uuid), &td->drv[1]);
+	assert_ptr_equal(comp_driver_find_type(td->drv[0].type), &td->drv[1]);
+
+	/* the same driver can't be registered twice */
+	assert_int_equal(comp_register(&td->info[1]), -EEXIST);
+	assert_int_equal(comp_register(&td->info[0]), -EEXIST);
+
+	/* unregistering the second one brings the first one back */
+	comp_unregister(&td->info[1]);
+	assert_ptr_equal(comp_driver_find_uuid(uuid), &td->drv[0]);
+	assert_ptr_equal(comp_driver_find_type(td->drv[0].type), &td->drv[0]);
+
+	comp_unregister(&td->info[0]);
+	assert_null(comp_driver_find_uuid(uuid));
+	assert_null(comp_driver_find_type(td->drv[0].type));
+	assert_true(list_is_empty(&comp_drivers_get()->list));
+}
+
+static void test_comp_driver_find_unregistered(void **state)
+{
+	struct find_test_data *td = *state;
+	int i;
+
+	register_all(td);
+
+	/* unregister every other driver, from the middle of the chains too */
+	for (i = 0; i < TEST_DRIVERS; i += 2)
+		comp_unregister(&td->info[i]);
+
+	for (i = 0; i < TEST_DRIVERS; i++) {
+		if (i % 2) {
+			assert_ptr_equal(comp_driver_find_uuid((const uint8_t *)&td->uuid[i]),
+					 &td->drv[i]);
+			assert_ptr_equal(comp_driver_find_type(td->drv[i].type), &td->drv[i]);
+		} else {
+			assert_null(comp_driver_find_uuid((const uint8_t *)&td->uuid[i]));
+			assert_null(comp_driver_find_type(td->drv[i].type));
+		}
+	}
+
+	/* an unregistered driver can be registered again */
+	assert_int_equal(comp_register(&td->info[0]), 0);
+	assert_ptr_equal(comp_driver_find_uuid((const uint8_t *)&td->uuid[0]), &td->drv[0]);
+
+	for (i = 0; i < TEST_DRIVERS; i++)
+		if (i % 2 || !i)
+			comp_unregister(&td->info[i]);
+
+	assert_true(list_is_empty(&comp_drivers_get()->list));
+	assert_int_equal(atomic_read(&comp_drivers_get()->readers), 0);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_comp_driver_find_collisions, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_comp_driver_find_duplicates, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_comp_driver_find_unregistered, setup,
+						teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/data_blob.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+#define BLOB_SHARE_INSTANCES	3
+
+struct blob_share_data {
+	struct comp_dev dev[BLOB_SHARE_INSTANCES];
+	struct comp_data_blob_handler *handler[BLOB_SHARE_INSTANCES];
+};
+
+static const uint32_t blob_a[] = {1, 2, 3, 4, 5, 6, 7, 8};
+static const uint32_t blob_b[] = {1, 2, 3, 4, 5, 6, 7, 9};
+
+static int setup(void **state)
+{
+	struct blob_share_data *bd = test_calloc(1, sizeof(*bd));
+	int i;
+
+	for (i = 0; i < BLOB_SHARE_INSTANCES; i++) {
+		bd->dev[i].state = COMP_STATE_READY;
+		bd->handler[i] = comp_data_blob_handler_new(&bd->dev[i]);
+		assert_non_null(bd->handler[i]);
+		comp_data_blob_share(bd->handler[i]);
+	}
+
+	*state = bd;
+
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	struct blob_share_data *bd = *state;
+	int i;
+
+	for (i = 0; i < BLOB_SHARE_INSTANCES; i++)
+		comp_data_blob_handler_free(bd->handler[i]);
+
+	test_free(bd);
+
+	return 0;
+}
+
+static void *blob_init(struct blob_share_data *bd, int i, const uint32_t *blob)
+{
+	int ret;
+
+	ret = comp_init_data_blob(bd->handler[i], sizeof(blob_a), (void *)blob);
+	assert_int_equal(ret, 0);
+
+	return comp_get_data_blob(bd->handler[i], NULL, NULL);
+}
+
+static void test_data_blob_share_identical(void **state)
+{
+	struct blob_share_data *bd = *state;
+	void *a0 = blob_init(bd, 0, blob_a);
+	void *a1 = blob_init(bd, 1, blob_a);
+	void *b2 = blob_init(bd, 2, blob_b);
+
+	/* identical blobs share the memory, the others don't */
+	assert_ptr_equal(a0, a1);
+	assert_ptr_not_equal(a0, b2);
+	assert_memory_equal(a1, blob_a, sizeof(blob_a));
+	assert_memory_equal(b2, blob_b, sizeof(blob_b));
+
+	/* the blob stays while an instance holds it */
+	comp_data_blob_handler_free(bd->handler[0]);
+	bd->handler[0] = NULL;
+	assert_memory_equal(comp_get_data_blob(bd->handler[1], NULL, NULL), blob_a,
+			    sizeof(blob_a));
+}
+
+static void test_data_blob_share_update(void **state)
+{
+	struct blob_share_data *bd = *state;
+	void *a0 = blob_init(bd, 0, blob_a);
+	void *a1 = blob_init(bd, 1, blob_a);
+	void *b2 = blob_init(bd, 2, blob_b);
+	void *b1;
+	int ret;
+
+	assert_ptr_equal(a0, a1);
+
+	/* a new tuning for one instance moves it to the other shared blob */
+	ret = comp_data_blob_set(bd->handler[1], MODULE_CFG_FRAGMENT_SINGLE, sizeof(blob_b),
+				 (const uint8_t *)blob_b, sizeof(blob_b));
+	assert_int_equal(ret, 0);
+	b1 = comp_get_data_blob(bd->handler[1], NULL, NULL);
+	assert_ptr_equal(b1, b2);
+	assert_memory_equal(comp_get_data_blob(bd->handler[0], NULL, NULL), blob_a,
+			    sizeof(blob_a));
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_data_blob_share_identical, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_data_blob_share_update, setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+#include <setjmp.h>
+#include <math.h>
+#include <cmocka.h>
+
+#include <sof/audio/component.h>
+#include <sof/audio/drc/drc.h>
+#include <sof/audio/drc/drc_algorithm.h>
+#include <sof/audio/format.h>
+#include <sof/common.h>
+#include <sof/string.h>
+
+/* The fixed point DRC approximates the log, exp and sin curves of the
+ * compressor, the float one calls the libm functions. Max error measured is
+ * 8.0e-04, about -62 dBFS.
+ */
+#define CMP_TOLERANCE	0.001
+#define _M_PI		3.14159265358979323846	/* pi */
+#define DRC_CHANNELS	2
+#define DRC_FRAMES	48
+#define DRC_PERIODS	1000
+
+/* sof_drc_params of the default DRC configuration blob */
+static const int32_t drc_test_params[] = {
+	0x00000001, 0xe8000000, 0x1e000000, 0x01000000, 0x00624dd3, 0x0409c2b1,
+	0x40000000, 0x000199a6, 0x0a0fd8ce, 0xf5f01a1f, 0x01fec983, 0x3a6130df,
+	0x010e83cb, 0x017384ef, 0xff6b646d, 0x00224103, 0x00000005, 0x00f81000,
+	0x001081aa, 0x008af0f4, 0x0022e1aa, 0x00029bb9,
+};
+
+struct drc_test {
+	struct comp_dev dev;
+	struct drc_comp_data cd;
+	struct audio_stream source;
+	struct audio_stream sink;
+	drc_func func;
+};
+
+static void drc_test_init(struct drc_test *t, struct sof_drc_config *config,
+			  enum sof_ipc_frame fmt, void *x, void *y)
+{
+	const size_t size = DRC_FRAMES * DRC_CHANNELS * get_sample_bytes(fmt);
+	struct comp_dev *dev = &t->dev;
+
+	memset(t, 0, sizeof(*t));
+	t->cd.config = config;
+	t->cd.source_format = fmt;
+	comp_set_drvdata(dev, &t->cd);
+
+	drc_reset_state(&t->cd.state);
+	assert_int_equal(drc_init_pre_delay_buffers(&t->cd.state, get_sample_bytes(fmt),
+						    DRC_CHANNELS), 0);
+	assert_int_equal(drc_set_pre_delay_time(&t->cd.state, config->params.pre_delay_time,
+						48000), 0);
+	if (fmt == SOF_IPC_FRAME_FLOAT)
+		drc_setup_float(&t->cd);
+
+	t->func = drc_find_proc_func(fmt);
+	assert_non_null(t->func);
+
+	t->source.addr = x;
+	t->source.end_addr = (char *)x + size;
+	t->source.size = size;
+	t->source.channels = DRC_CHANNELS;
+	t->source.frame_fmt = fmt;
+	t->sink = t->source;
+	t->sink.addr = y;
+	t->sink.end_addr = (char *)y + size;
+}
+
+static void drc_test_run(struct drc_test *t)
+{
+	t->source.r_ptr = t->source.addr;
+	t->sink.w_ptr = t->sink.addr;
+	t->func(&t->dev, &t->source, &t->sink, DRC_FRAMES);
+}
+
+static void test_drc_float_parity(void **state)
+{
+	struct sof_drc_config config;
+	struct drc_test *fixed = test_calloc(1, sizeof(*fixed));
+	struct drc_test *flt = test_calloc(1, sizeof(*flt));
+	int32_t x[DRC_FRAMES * DRC_CHANNELS];
+	int32_t y[DRC_FRAMES * DRC_CHANNELS];
+	float xf[ARRAY_SIZE(x)];
+	float yf[ARRAY_SIZE(y)];
+	double level;
+	double diff;
+	double max_diff = 0;
+	float min_gain = 1.0f;
+	int n = 0;
+	int i;
+	int j;
+
+	memset(&config, 0, sizeof(config));
+	assert_int_equal(sizeof(drc_test_params), sizeof(config.params));
+	memcpy_s(&config.params, sizeof(config.params), drc_test_params,
+		 sizeof(drc_test_params));
+	config.size = sizeof(config);
+
+	drc_test_init(fixed, &config, SOF_IPC_FRAME_S32_LE, x, y);
+	drc_test_init(flt, &config, SOF_IPC_FRAME_FLOAT, xf, yf);
+
+	for (j = 0; j < DRC_PERIODS; j++) {
+		/* A tone stepping from -20 dBFS to -2 dBFS and back to make
+		 * the compressor attack and release.
+		 */
+		level = (j / 250) & 1 ? 0.8 : 0.1;
+		for (i = 0; i < ARRAY_SIZE(x); i++) {
+			x[i] = Q_CONVERT_FLOAT(level * sin(2 * _M_PI * 997 * n / 48000), 31);
+			xf[i] = ldexpf(x[i], -31);
+			n += i & 1;
+		}
+
+		drc_test_run(fixed);
+		drc_test_run(flt);
+
+		for (i = 0; i < ARRAY_SIZE(y); i++) {
+			diff = fabs(ldexpf(y[i], -31) - yf[i]);
+			if (diff > max_diff)
+				max_diff = diff;
+		}
+
+		min_gain = MIN(min_gain, flt->cd.state_float.compressor_gain);
+	}
+
+	printf("%s: max diff %g, min gain %g\n", __func__, max_diff, min_gain);
+	assert_true(max_diff < CMP_TOLERANCE);
+
+	/* the loud parts were compressed */
+	assert_true(min_gain < 0.7f);
+
+	drc_reset_state(&fixed->cd.state);
+	drc_reset_state(&flt->cd.state);
+	test_free(fixed);
+	test_free(flt);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_drc_float_parity),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,225 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <stdint.h>
+#include <sof/audio/buffer.h>
+#include <sof/audio/component_ext.h>
+#include <sof/audio/pipeline.h>
+#include <sof/list.h>
+#include <ipc/stream.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#ifdef HAVE_MALLOC_H
+#include <malloc.h>
+#else
+#include <stdlib.h>
+#endif
+
+#define TEST_PERIOD		1000
+#define TEST_CHANNELS		2
+#define TEST_FRAMES		48
+/* one S32_LE stereo period */
+#define TEST_PERIOD_BYTES	(TEST_FRAMES * TEST_CHANNELS * 4)
+#define TEST_BUFFER_SIZE	(2 * TEST_PERIOD_BYTES)
+
+/* capture: source -> first -> second -> sink */
+enum {
+	TEST_COMP_SOURCE = 0,
+	TEST_COMP_FIRST,
+	TEST_COMP_SECOND,
+	TEST_COMP_SINK,
+	TEST_COMPS,
+};
+
+struct test_data {
+	struct pipeline *p;
+	struct comp_dev *comp[TEST_COMPS];
+	struct comp_buffer *buffer[TEST_COMPS];	/* sink buffer of each component */
+};
+
+static struct comp_buffer *test_source_buffer(struct comp_dev *dev)
+{
+	if (list_is_empty(&dev->bsource_list))
+		return NULL;
+
+	return list_first_item(&dev->bsource_list, struct comp_buffer, sink_list);
+}
+
+static struct comp_buffer *test_sink_buffer(struct comp_dev *dev)
+{
+	if (list_is_empty(&dev->bsink_list))
+		return NULL;
+
+	return list_first_item(&dev->bsink_list, struct comp_buffer, source_list);
+}
+
+/* every component moves one period, the endpoints only produce or consume */
+static int test_copy(struct comp_dev *dev)
+{
+	struct comp_buffer *source = test_source_buffer(dev);
+	struct comp_buffer *sink = test_sink_buffer(dev);
+
+	if (source) {
+		if (audio_stream_get_avail_bytes(&source->stream) < TEST_PERIOD_BYTES)
+			return 0;
+		audio_stream_consume(&source->stream, TEST_PERIOD_BYTES);
+	}
+
+	if (sink)
+		audio_stream_produce(&sink->stream, TEST_PERIOD_BYTES);
+
+	return 0;
+}
+
+static const struct comp_driver test_drv = {
+	.ops = {
+		.copy = test_copy,
+	},
+};
+
+static int setup(void **state)
+{
+	struct test_data *td = calloc(1, sizeof(*td));
+	struct comp_buffer *buffer;
+	struct comp_dev *dev;
+	int i;
+
+	if (!td)
+		return -1;
+
+	td->p = calloc(1, sizeof(*td->p));
+	assert_non_null(td->p);
+	td->p->pipeline_id = 1;
+	td->p->period = TEST_PERIOD;
+	td->p->status = COMP_STATE_ACTIVE;
+
+	for (i = 0; i < TEST_COMPS; i++) {
+		dev = calloc(1, sizeof(*dev));
+		assert_non_null(dev);
+		dev->drv = &test_drv;
+		dev->ipc_config.id = i;
+		dev->ipc_config.pipeline_id = td->p->pipeline_id;
+		dev->pipeline = td->p;
+		dev->state = COMP_STATE_ACTIVE;
+		dev->direction = SOF_IPC_STREAM_CAPTURE;
+		list_init(&dev->bsource_list);
+		list_init(&dev->bsink_list);
+		td->comp[i] = dev;
+
+		if (!i)
+			continue;
+
+		buffer = buffer_alloc(TEST_BUFFER_SIZE, SOF_MEM_CAPS_RAM, 0);
+		assert_non_null(buffer);
+		buffer->stream.channels = TEST_CHANNELS;
+		buffer->stream.frame_fmt = SOF_IPC_FRAME_S32_LE;
+		pipeline_connect(td->comp[i - 1], buffer, PPL_CONN_DIR_COMP_TO_BUFFER);
+		pipeline_connect(dev, buffer, PPL_CONN_DIR_BUFFER_TO_COMP);
+		td->buffer[i - 1] = buffer;
+	}
+
+	td->p->source_comp = td->comp[TEST_COMP_SOURCE];
+	td->p->sched_comp = td->comp[TEST_COMP_SINK];
+	td->p->sink_comp = td->comp[TEST_COMP_SINK];
+
+	*state = td;
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	free(*state);
+	return 0;
+}
+
+static void test_audio_pipeline_latency_direct(void **state)
+{
+	struct test_data *td = *state;
+	struct sof_ipc_stream_latency latency;
+	int i;
+
+	/* every frame goes from the source to the sink in the same copy */
+	for (i = 0; i < 4; i++)
+		assert_int_equal(pipeline_copy(td->p), 0);
+
+	pipeline_get_latency(td->p, &latency);
+	assert_int_equal(latency.count, 4);
+	assert_int_equal(latency.min_us, 0);
+	assert_int_equal(latency.max_us, 0);
+	assert_int_equal(latency.avg_us, 0);
+
+	/* the sink took the tag, nothing is left in flight */
+	for (i = 0; i < TEST_COMP_SINK; i++)
+		assert_false(td->buffer[i]->tag.valid);
+}
+
+static void test_audio_pipeline_latency_delay(void **state)
+{
+	struct test_data *td = *state;
+	struct comp_buffer *delay = td->buffer[TEST_COMP_FIRST];
+	struct sof_ipc_stream_latency latency;
+	int i;
+
+	/* a period of silence ahead of the first frame between the components */
+	audio_stream_produce(&delay->stream, TEST_PERIOD_BYTES);
+
+	assert_int_equal(pipeline_copy(td->p), 0);
+
+	/* the tagged frame waits behind the silence */
+	assert_true(delay->tag.valid);
+	assert_int_equal(delay->tag.stamp, TEST_PERIOD);
+	assert_int_equal(delay->tag.offset, 0);
+	assert_false(td->buffer[TEST_COMP_SECOND]->tag.valid);
+
+	pipeline_get_latency(td->p, &latency);
+	assert_int_equal(latency.count, 0);
+
+	/* it leaves one period later, later frames wait for the tag to clear */
+	for (i = 0; i < 3; i++)
+		assert_int_equal(pipeline_copy(td->p), 0);
+
+	pipeline_get_latency(td->p, &latency);
+	assert_true(latency.count > 0);
+	assert_int_equal(latency.min_us, TEST_PERIOD);
+	assert_int_equal(latency.max_us, TEST_PERIOD);
+	assert_int_equal(latency.avg_us, TEST_PERIOD);
+}
+
+static void test_audio_pipeline_latency_reset(void **state)
+{
+	struct test_data *td = *state;
+	struct sof_ipc_stream_latency latency;
+	int i;
+
+	for (i = 0; i < 4; i++)
+		assert_int_equal(pipeline_copy(td->p), 0);
+	assert_int_equal(td->p->copy_count, 4);
+
+	/* the next stream starts from zero */
+	assert_int_equal(pipeline_reset(td->p, td->comp[TEST_COMP_SOURCE]), 0);
+	assert_int_equal(td->p->copy_count, 0);
+
+	pipeline_get_latency(td->p, &latency);
+	assert_int_equal(latency.count, 0);
+	assert_int_equal(latency.max_us, 0);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_audio_pipeline_latency_direct,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_audio_pipeline_latency_delay,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_audio_pipeline_latency_reset,
+						setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
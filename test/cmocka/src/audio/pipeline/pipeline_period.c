@@ -0,0 +1,280 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <stdint.h>
+#include <sof/audio/buffer.h>
+#include <sof/audio/component_ext.h>
+#include <sof/audio/pipeline.h>
+#include <sof/list.h>
+#include <sof/schedule/schedule.h>
+#include <sof/schedule/task.h>
+#include <ipc/stream.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#ifdef HAVE_MALLOC_H
+#include <malloc.h>
+#else
+#include <stdlib.h>
+#endif
+
+#define TEST_RATE		48000
+#define TEST_CHANNELS		2
+#define TEST_PERIOD		1000
+#define TEST_PERIOD_LONG	2000
+#define TEST_FRAMES		48
+#define TEST_FRAMES_LONG	96
+/* two S32_LE stereo periods */
+#define TEST_BUFFER_SIZE	(2 * TEST_FRAMES * TEST_CHANNELS * 4)
+
+/* source -> first -> second -> sink */
+enum {
+	TEST_COMP_SOURCE = 0,
+	TEST_COMP_FIRST,
+	TEST_COMP_SECOND,
+	TEST_COMP_SINK,
+	TEST_COMPS,
+};
+
+struct test_data {
+	struct pipeline *p;
+	struct comp_dev *comp[TEST_COMPS];
+	struct comp_buffer *buffer[TEST_COMPS];	/* sink buffer of each component */
+	struct task task;
+	uint32_t period[TEST_COMPS];		/* last period given to each component */
+	int refuse;				/* component refusing the new period */
+};
+
+/* scheduler mock, records how the pipeline task is paused and resumed */
+static struct {
+	int cancel_count;
+	int schedule_count;
+	uint64_t period;
+} test_sch;
+
+static struct test_data *test_td;
+
+static int test_schedule_task(void *data, struct task *task, uint64_t start,
+			      uint64_t period)
+{
+	test_sch.schedule_count++;
+	test_sch.period = period;
+	task->state = SOF_TASK_STATE_QUEUED;
+	return 0;
+}
+
+static int test_schedule_task_cancel(void *data, struct task *task)
+{
+	test_sch.cancel_count++;
+	task->state = SOF_TASK_STATE_CANCEL;
+	return 0;
+}
+
+static int test_schedule_task_free(void *data, struct task *task)
+{
+	return 0;
+}
+
+static const struct scheduler_ops test_sch_ops = {
+	.schedule_task = test_schedule_task,
+	.schedule_task_cancel = test_schedule_task_cancel,
+	.schedule_task_free = test_schedule_task_free,
+};
+
+static struct schedule_data test_sch_data = {
+	.type = SOF_SCHEDULE_LL_TIMER,
+	.ops = &test_sch_ops,
+};
+
+static struct schedulers test_schedulers;
+static struct schedulers *test_schedulers_ptr = &test_schedulers;
+
+struct schedulers **arch_schedulers_get(void)
+{
+	return &test_schedulers_ptr;
+}
+
+static int test_set_attribute(struct comp_dev *dev, uint32_t type, void *value)
+{
+	int i = dev->ipc_config.id;
+
+	if (type != COMP_ATTR_PERIOD)
+		return -EINVAL;
+
+	/* the new period comes with the new frames */
+	assert_int_equal(dev->period, *(uint32_t *)value);
+	test_td->period[i] = dev->period;
+
+	return i == test_td->refuse ? -EINVAL : 0;
+}
+
+static const struct comp_driver test_drv = {
+	.ops = {
+		.set_attribute = test_set_attribute,
+	},
+};
+
+static int setup(void **state)
+{
+	struct test_data *td = calloc(1, sizeof(*td));
+	struct comp_buffer *buffer;
+	struct comp_dev *dev;
+	int i;
+
+	if (!td)
+		return -1;
+
+	memset(&test_sch, 0, sizeof(test_sch));
+	list_init(&test_schedulers.list);
+	list_init(&test_sch_data.list);
+	list_item_append(&test_sch_data.list, &test_schedulers.list);
+
+	td->p = calloc(1, sizeof(*td->p));
+	assert_non_null(td->p);
+	td->p->pipeline_id = 1;
+	td->p->period = TEST_PERIOD;
+	td->p->time_domain = SOF_TIME_DOMAIN_TIMER;
+	td->p->status = COMP_STATE_ACTIVE;
+
+	for (i = 0; i < TEST_COMPS; i++) {
+		dev = calloc(1, sizeof(*dev));
+		assert_non_null(dev);
+		dev->drv = &test_drv;
+		dev->ipc_config.id = i;
+		dev->ipc_config.pipeline_id = td->p->pipeline_id;
+		dev->pipeline = td->p;
+		dev->state = COMP_STATE_ACTIVE;
+		dev->period = TEST_PERIOD;
+		dev->frames = TEST_FRAMES;
+		list_init(&dev->bsource_list);
+		list_init(&dev->bsink_list);
+		td->comp[i] = dev;
+		td->period[i] = TEST_PERIOD;
+
+		if (!i)
+			continue;
+
+		buffer = buffer_alloc(TEST_BUFFER_SIZE, SOF_MEM_CAPS_RAM, 0);
+		assert_non_null(buffer);
+		buffer->stream.rate = TEST_RATE;
+		buffer->stream.channels = TEST_CHANNELS;
+		buffer->stream.frame_fmt = SOF_IPC_FRAME_S32_LE;
+		pipeline_connect(td->comp[i - 1], buffer, PPL_CONN_DIR_COMP_TO_BUFFER);
+		pipeline_connect(dev, buffer, PPL_CONN_DIR_BUFFER_TO_COMP);
+		td->buffer[i - 1] = buffer;
+	}
+
+	td->p->source_comp = td->comp[TEST_COMP_SOURCE];
+	td->p->sched_comp = td->comp[TEST_COMP_SINK];
+	td->p->sink_comp = td->comp[TEST_COMP_SINK];
+
+	/* the pipeline task is running */
+	td->task.type = SOF_SCHEDULE_LL_TIMER;
+	td->task.state = SOF_TASK_STATE_QUEUED;
+	td->p->pipe_task = &td->task;
+
+	td->refuse = -1;
+	test_td = td;
+	*state = td;
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	free(*state);
+	return 0;
+}
+
+static void test_audio_pipeline_period_switch(void **state)
+{
+	struct test_data *td = *state;
+	int i;
+
+	assert_int_equal(pipeline_set_period(td->p, TEST_PERIOD_LONG), 0);
+
+	assert_int_equal(td->p->period, TEST_PERIOD_LONG);
+	for (i = 0; i < TEST_COMPS; i++) {
+		assert_int_equal(td->comp[i]->period, TEST_PERIOD_LONG);
+		assert_int_equal(td->comp[i]->frames, TEST_FRAMES_LONG);
+		assert_int_equal(td->period[i], TEST_PERIOD_LONG);
+	}
+
+	/* the empty buffers hold as many periods as before */
+	for (i = 0; i < TEST_COMP_SINK; i++)
+		assert_int_equal(td->buffer[i]->stream.size, 2 * TEST_BUFFER_SIZE);
+
+	/* paused once and resumed with the new period */
+	assert_int_equal(test_sch.cancel_count, 1);
+	assert_int_equal(test_sch.schedule_count, 1);
+	assert_int_equal(test_sch.period, TEST_PERIOD_LONG);
+	assert_true(task_is_active(&td->task));
+}
+
+static void test_audio_pipeline_period_refused(void **state)
+{
+	struct test_data *td = *state;
+	int i;
+
+	/* the first component accepts and grows its buffer, the second refuses */
+	td->refuse = TEST_COMP_SECOND;
+
+	assert_int_equal(pipeline_set_period(td->p, TEST_PERIOD_LONG), -EINVAL);
+
+	assert_int_equal(td->p->period, TEST_PERIOD);
+	for (i = 0; i < TEST_COMPS; i++) {
+		assert_int_equal(td->comp[i]->period, TEST_PERIOD);
+		assert_int_equal(td->comp[i]->frames, TEST_FRAMES);
+		assert_int_equal(td->period[i], i == TEST_COMP_SECOND ? TEST_PERIOD_LONG :
+				 TEST_PERIOD);
+	}
+
+	for (i = 0; i < TEST_COMP_SINK; i++)
+		assert_int_equal(td->buffer[i]->stream.size, TEST_BUFFER_SIZE);
+
+	/* resumed with the old period */
+	assert_int_equal(test_sch.cancel_count, 1);
+	assert_int_equal(test_sch.schedule_count, 1);
+	assert_int_equal(test_sch.period, TEST_PERIOD);
+	assert_true(task_is_active(&td->task));
+}
+
+static void test_audio_pipeline_period_busy_buffer(void **state)
+{
+	struct test_data *td = *state;
+	int i;
+
+	/* a buffer with data in it can't grow */
+	audio_stream_produce(&td->buffer[TEST_COMP_FIRST]->stream, 8);
+
+	assert_int_equal(pipeline_set_period(td->p, TEST_PERIOD_LONG), -EBUSY);
+
+	assert_int_equal(td->p->period, TEST_PERIOD);
+	for (i = 0; i < TEST_COMPS; i++) {
+		assert_int_equal(td->comp[i]->period, TEST_PERIOD);
+		assert_int_equal(td->comp[i]->frames, TEST_FRAMES);
+	}
+
+	for (i = 0; i < TEST_COMP_SINK; i++)
+		assert_int_equal(td->buffer[i]->stream.size, TEST_BUFFER_SIZE);
+
+	assert_int_equal(test_sch.period, TEST_PERIOD);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_audio_pipeline_period_switch,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_audio_pipeline_period_refused,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_audio_pipeline_period_busy_buffer,
+						setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,234 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <stdint.h>
+#include <sof/audio/buffer.h>
+#include <sof/audio/component_ext.h>
+#include <sof/audio/pipeline.h>
+#include <sof/list.h>
+#include <sof/schedule/schedule.h>
+#include <sof/schedule/task.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#ifdef HAVE_MALLOC_H
+#include <malloc.h>
+#else
+#include <stdlib.h>
+#endif
+
+/* source -> noise reduction -> equalizer -> sink */
+enum {
+	TEST_COMP_SOURCE = 0,
+	TEST_COMP_NR,
+	TEST_COMP_EQ,
+	TEST_COMP_SINK,
+	TEST_COMPS,
+};
+
+struct test_pipeline {
+	struct pipeline *p;
+	struct comp_dev *comp[TEST_COMPS];
+};
+
+struct test_data {
+	struct list_item tasks;
+	struct test_pipeline high;
+	struct test_pipeline low;
+};
+
+static int test_shed(struct comp_dev *dev, bool shed)
+{
+	return 0;
+}
+
+static const struct comp_driver test_drv = {
+	.ops = {
+		.shed = test_shed,
+	},
+};
+
+static const struct comp_driver test_drv_nr = {
+	.ops = {
+		.shed = test_shed,
+	},
+	.shed_tier = COMP_SHED_QUALITY,
+};
+
+static const struct comp_driver test_drv_eq = {
+	.ops = {
+		.shed = test_shed,
+	},
+	.shed_tier = COMP_SHED_ENHANCE,
+};
+
+/* component.c isn't linked, all test components have their own fallback */
+bool comp_can_shed(struct comp_dev *dev)
+{
+	return dev->drv->shed_tier != COMP_SHED_NONE;
+}
+
+/* the mock leaves the task empty, pipeline_shed() looks the pipeline up */
+int schedule_task_init_ll(struct task *task,
+			  const struct sof_uuid_entry *uid, uint16_t type,
+			  uint16_t priority, enum task_state (*run)(void *data),
+			  void *data, uint16_t core, uint32_t flags)
+{
+	return schedule_task_init(task, uid, type, priority, run, data, core, flags);
+}
+
+int schedule_task_init(struct task *task,
+		       const struct sof_uuid_entry *uid, uint16_t type,
+		       uint16_t priority, enum task_state (*run)(void *data),
+		       void *data, uint16_t core, uint32_t flags)
+{
+	task->uid = uid;
+	task->type = type;
+	task->priority = priority;
+	task->ops.run = run;
+	task->data = data;
+
+	return 0;
+}
+
+static const struct comp_driver *test_comp_drv(int i)
+{
+	switch (i) {
+	case TEST_COMP_NR:
+		return &test_drv_nr;
+	case TEST_COMP_EQ:
+		return &test_drv_eq;
+	default:
+		return &test_drv;
+	}
+}
+
+static void test_pipeline_init(struct test_pipeline *tp, struct list_item *tasks,
+			       uint32_t pipeline_id, uint32_t priority)
+{
+	struct comp_buffer *buffer;
+	struct comp_dev *dev;
+	int i;
+
+	tp->p = calloc(1, sizeof(*tp->p));
+	assert_non_null(tp->p);
+	tp->p->pipeline_id = pipeline_id;
+	tp->p->priority = priority;
+	tp->p->status = COMP_STATE_ACTIVE;
+
+	for (i = 0; i < TEST_COMPS; i++) {
+		dev = calloc(1, sizeof(*dev));
+		assert_non_null(dev);
+		dev->drv = test_comp_drv(i);
+		dev->ipc_config.id = pipeline_id * TEST_COMPS + i;
+		dev->ipc_config.pipeline_id = pipeline_id;
+		dev->pipeline = tp->p;
+		dev->state = COMP_STATE_ACTIVE;
+		list_init(&dev->bsource_list);
+		list_init(&dev->bsink_list);
+		tp->comp[i] = dev;
+
+		if (!i)
+			continue;
+
+		buffer = buffer_alloc(64, SOF_MEM_CAPS_RAM, 0);
+		assert_non_null(buffer);
+		pipeline_connect(tp->comp[i - 1], buffer, PPL_CONN_DIR_COMP_TO_BUFFER);
+		pipeline_connect(dev, buffer, PPL_CONN_DIR_BUFFER_TO_COMP);
+	}
+
+	tp->p->source_comp = tp->comp[TEST_COMP_SOURCE];
+	tp->p->sched_comp = tp->comp[TEST_COMP_SINK];
+	tp->p->sink_comp = tp->comp[TEST_COMP_SINK];
+
+	assert_int_equal(pipeline_comp_task_init(tp->p), 0);
+	list_item_append(&tp->p->pipe_task->list, tasks);
+}
+
+static int setup(void **state)
+{
+	struct test_data *td = calloc(1, sizeof(*td));
+
+	if (!td)
+		return -1;
+
+	list_init(&td->tasks);
+	test_pipeline_init(&td->high, &td->tasks, 1, SOF_TASK_PRI_HIGH);
+	test_pipeline_init(&td->low, &td->tasks, 2, SOF_TASK_PRI_LOW);
+
+	*state = td;
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	free(*state);
+	return 0;
+}
+
+static void test_pipeline_shed_step(struct test_data *td, bool shed,
+				    struct comp_dev *dev)
+{
+	assert_true(pipeline_shed(&td->tasks, shed));
+	assert_int_equal(dev->shed, shed);
+}
+
+static void test_audio_pipeline_shed_low_priority_first(void **state)
+{
+	struct test_data *td = *state;
+
+	/* the highest tier of the low priority pipeline goes first */
+	test_pipeline_shed_step(td, true, td->low.comp[TEST_COMP_EQ]);
+	assert_false(td->low.comp[TEST_COMP_NR]->shed);
+	assert_false(td->high.comp[TEST_COMP_EQ]->shed);
+
+	test_pipeline_shed_step(td, true, td->low.comp[TEST_COMP_NR]);
+	assert_false(td->high.comp[TEST_COMP_EQ]->shed);
+
+	test_pipeline_shed_step(td, true, td->high.comp[TEST_COMP_EQ]);
+	assert_false(td->high.comp[TEST_COMP_NR]->shed);
+
+	test_pipeline_shed_step(td, true, td->high.comp[TEST_COMP_NR]);
+
+	/* nothing left to shed */
+	assert_false(pipeline_shed(&td->tasks, true));
+}
+
+static void test_audio_pipeline_restore_high_priority_first(void **state)
+{
+	struct test_data *td = *state;
+
+	while (pipeline_shed(&td->tasks, true))
+		;
+
+	/* restored in the reverse order */
+	test_pipeline_shed_step(td, false, td->high.comp[TEST_COMP_NR]);
+	assert_true(td->high.comp[TEST_COMP_EQ]->shed);
+
+	test_pipeline_shed_step(td, false, td->high.comp[TEST_COMP_EQ]);
+	assert_true(td->low.comp[TEST_COMP_NR]->shed);
+
+	test_pipeline_shed_step(td, false, td->low.comp[TEST_COMP_NR]);
+	assert_true(td->low.comp[TEST_COMP_EQ]->shed);
+
+	test_pipeline_shed_step(td, false, td->low.comp[TEST_COMP_EQ]);
+
+	assert_false(pipeline_shed(&td->tasks, false));
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_audio_pipeline_shed_low_priority_first,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_audio_pipeline_restore_high_priority_first,
+						setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
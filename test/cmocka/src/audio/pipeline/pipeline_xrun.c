@@ -0,0 +1,280 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <sof/audio/audio_stream.h>
+#include <sof/audio/buffer.h>
+#include <sof/audio/component.h>
+#include <sof/audio/format.h>
+#include <sof/audio/pipeline.h>
+#include <errno.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+#define XRUN_TEST_RATE		48000
+#define XRUN_TEST_CHANNELS	2
+#define XRUN_TEST_FRAMES	480
+#define XRUN_TEST_SAMPLE	0x100000
+
+struct xrun_test_data {
+	struct pipeline p;
+	struct comp_dev dev;
+	struct comp_driver drv;
+	struct comp_buffer *buffer;
+};
+
+static int setup(void **state)
+{
+	struct xrun_test_data *td = test_calloc(1, sizeof(*td));
+	struct comp_buffer __sparse_cache *buffer_c;
+
+	td->buffer = buffer_alloc(XRUN_TEST_FRAMES * XRUN_TEST_CHANNELS * sizeof(int32_t),
+				  SOF_MEM_CAPS_RAM, 0);
+	if (!td->buffer) {
+		test_free(td);
+		return -1;
+	}
+
+	buffer_c = buffer_acquire(td->buffer);
+	buffer_c->stream.frame_fmt = SOF_IPC_FRAME_S32_LE;
+	buffer_c->stream.channels = XRUN_TEST_CHANNELS;
+	buffer_c->stream.rate = XRUN_TEST_RATE;
+	buffer_release(buffer_c);
+
+	td->dev.drv = &td->drv;
+	td->dev.pipeline = &td->p;
+	td->p.xrun_limit_usecs = 10000;
+
+	*state = td;
+
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	struct xrun_test_data *td = *state;
+
+	buffer_free(td->buffer);
+	test_free(td);
+
+	return 0;
+}
+
+static void fill(struct comp_buffer __sparse_cache *buffer_c, int frames)
+{
+	int32_t *x;
+	int i;
+
+	for (i = 0; i < frames * XRUN_TEST_CHANNELS; i++) {
+		x = audio_stream_write_frag_s32(&buffer_c->stream, i);
+		*x = XRUN_TEST_SAMPLE;
+	}
+
+	comp_update_buffer_produce(buffer_c, frames * XRUN_TEST_CHANNELS * sizeof(int32_t));
+}
+
+static int32_t sample(struct comp_buffer __sparse_cache *buffer_c, int frame)
+{
+	int32_t *x = audio_stream_read_frag_s32(&buffer_c->stream, frame * XRUN_TEST_CHANNELS);
+
+	return *x;
+}
+
+/* packed 24 bit samples, written to and read from the first channel */
+static void fill_s24_3le(struct comp_buffer __sparse_cache *buffer_c, int frames, int32_t x)
+{
+	uint8_t *x8;
+	int i;
+
+	for (i = 0; i < frames * XRUN_TEST_CHANNELS; i++) {
+		x8 = audio_stream_write_frag(&buffer_c->stream, i, 3);
+		x8[0] = x;
+		x8[1] = x >> 8;
+		x8[2] = x >> 16;
+	}
+
+	comp_update_buffer_produce(buffer_c, frames * XRUN_TEST_CHANNELS * 3);
+}
+
+static int32_t sample_s24_3le(struct comp_buffer __sparse_cache *buffer_c, int frame)
+{
+	uint8_t *x8 = audio_stream_read_frag(&buffer_c->stream, frame * XRUN_TEST_CHANNELS, 3);
+
+	return sign_extend_s24(x8[0] | x8[1] << 8 | x8[2] << 16);
+}
+
+static void test_pipeline_xrun_underrun(void **state)
+{
+	struct xrun_test_data *td = *state;
+	struct comp_buffer __sparse_cache *buffer_c = buffer_acquire(td->buffer);
+	int ret;
+
+	fill(buffer_c, 96);
+
+	/* 96 missing frames at 48 kHz are 2 ms */
+	ret = pipeline_xrun_conceal_underrun(&td->p, &td->dev, buffer_c, 96);
+	assert_int_equal(ret, 0);
+	assert_int_equal(td->p.xrun_conceal_us, 2000);
+	assert_int_equal(audio_stream_get_avail_frames(&buffer_c->stream), 192);
+
+	/* the last ms of data fades out, the frames before it are untouched */
+	assert_int_equal(sample(buffer_c, 47), XRUN_TEST_SAMPLE);
+	assert_true(sample(buffer_c, 48) < XRUN_TEST_SAMPLE);
+	assert_int_equal(sample(buffer_c, 95), 0);
+	assert_int_equal(sample(buffer_c, 96), 0);
+	assert_int_equal(sample(buffer_c, 191), 0);
+
+	/* the data after the gap fades in */
+	comp_update_buffer_consume(buffer_c, 192 * XRUN_TEST_CHANNELS * sizeof(int32_t));
+	fill(buffer_c, 96);
+	pipeline_xrun_conceal_end(&td->p, &td->dev, buffer_c);
+	assert_int_equal(sample(buffer_c, 0), 0);
+	assert_true(sample(buffer_c, 47) < XRUN_TEST_SAMPLE);
+	assert_int_equal(sample(buffer_c, 48), XRUN_TEST_SAMPLE);
+	assert_int_equal(td->p.xrun_conceal_us, 0);
+	assert_int_equal(td->p.xrun_concealed, 1);
+
+	buffer_release(buffer_c);
+}
+
+static void test_pipeline_xrun_underrun_s24_3le(void **state)
+{
+	struct xrun_test_data *td = *state;
+	struct comp_buffer __sparse_cache *buffer_c = buffer_acquire(td->buffer);
+	int ret;
+
+	buffer_c->stream.frame_fmt = SOF_IPC_FRAME_S24_3LE;
+	fill_s24_3le(buffer_c, 96, -XRUN_TEST_SAMPLE);
+
+	ret = pipeline_xrun_conceal_underrun(&td->p, &td->dev, buffer_c, 96);
+	assert_int_equal(ret, 0);
+	assert_int_equal(audio_stream_get_avail_frames(&buffer_c->stream), 192);
+
+	/* the fade out keeps the sign and doesn't touch the next sample */
+	assert_int_equal(sample_s24_3le(buffer_c, 47), -XRUN_TEST_SAMPLE);
+	assert_true(sample_s24_3le(buffer_c, 48) > -XRUN_TEST_SAMPLE);
+	assert_true(sample_s24_3le(buffer_c, 94) < 0);
+	assert_int_equal(sample_s24_3le(buffer_c, 95), 0);
+	assert_int_equal(sample_s24_3le(buffer_c, 96), 0);
+
+	buffer_release(buffer_c);
+}
+
+static void test_pipeline_xrun_overrun(void **state)
+{
+	struct xrun_test_data *td = *state;
+	struct comp_buffer __sparse_cache *buffer_c = buffer_acquire(td->buffer);
+	int ret;
+
+	fill(buffer_c, XRUN_TEST_FRAMES);
+
+	ret = pipeline_xrun_drop_overrun(&td->p, &td->dev, buffer_c, 48);
+	assert_int_equal(ret, 0);
+	assert_int_equal(td->p.xrun_conceal_us, 1000);
+	assert_int_equal(audio_stream_get_free_frames(&buffer_c->stream), 48);
+
+	pipeline_xrun_conceal_end(&td->p, &td->dev, buffer_c);
+	assert_int_equal(td->p.xrun_conceal_us, 0);
+	assert_int_equal(td->p.xrun_concealed, 1);
+
+	buffer_release(buffer_c);
+}
+
+static void test_pipeline_xrun_over_limit(void **state)
+{
+	struct xrun_test_data *td = *state;
+	struct comp_buffer __sparse_cache *buffer_c = buffer_acquire(td->buffer);
+	int ret;
+
+	td->p.xrun_limit_usecs = 1500;
+	fill(buffer_c, 96);
+
+	ret = pipeline_xrun_conceal_underrun(&td->p, &td->dev, buffer_c, 48);
+	assert_int_equal(ret, 0);
+
+	/* the xrun keeps going past the limit, it is left to the host */
+	ret = pipeline_xrun_conceal_underrun(&td->p, &td->dev, buffer_c, 48);
+	assert_int_equal(ret, -EPIPE);
+	assert_int_equal(td->p.xrun_conceal_us, 0);
+	assert_int_equal(audio_stream_get_avail_frames(&buffer_c->stream), 144);
+
+	buffer_release(buffer_c);
+}
+
+static void test_pipeline_xrun_dai(void **state)
+{
+	struct xrun_test_data *td = *state;
+	struct comp_buffer __sparse_cache *buffer_c = buffer_acquire(td->buffer);
+	const uint32_t frame_bytes = XRUN_TEST_CHANNELS * sizeof(int32_t);
+	int ret;
+
+	/* an empty DMA needs a period of 96 frames, 48 are left */
+	td->dev.direction = SOF_IPC_STREAM_PLAYBACK;
+	fill(buffer_c, 48);
+	ret = pipeline_xrun_conceal(&td->p, &td->dev, buffer_c, 0, 96 * frame_bytes,
+				    frame_bytes);
+	assert_int_equal(ret, 0);
+	assert_int_equal(audio_stream_get_avail_frames(&buffer_c->stream), 96);
+	assert_int_equal(td->p.xrun_conceal_us, 1000);
+
+	/* the DMA has a period again */
+	ret = pipeline_xrun_conceal(&td->p, &td->dev, buffer_c, 96 * frame_bytes,
+				    96 * frame_bytes, frame_bytes);
+	assert_int_equal(ret, 0);
+	assert_int_equal(td->p.xrun_conceal_us, 0);
+	assert_int_equal(td->p.xrun_concealed, 1);
+
+	/* a full DMA on capture drops the oldest 96 frames of a full buffer */
+	td->dev.direction = SOF_IPC_STREAM_CAPTURE;
+	comp_update_buffer_consume(buffer_c, 96 * frame_bytes);
+	fill(buffer_c, XRUN_TEST_FRAMES);
+	ret = pipeline_xrun_conceal(&td->p, &td->dev, buffer_c, 0, 96 * frame_bytes,
+				    frame_bytes);
+	assert_int_equal(ret, 0);
+	assert_int_equal(audio_stream_get_free_frames(&buffer_c->stream), 96);
+
+	buffer_release(buffer_c);
+}
+
+static void test_pipeline_xrun_disabled(void **state)
+{
+	struct xrun_test_data *td = *state;
+	struct comp_buffer __sparse_cache *buffer_c = buffer_acquire(td->buffer);
+	const uint32_t frame_bytes = XRUN_TEST_CHANNELS * sizeof(int32_t);
+	int ret;
+
+	/* a zero limit disables the concealment, the xrun is left to the DAI */
+	assert_int_equal(pipeline_xrun_set_limit(&td->p, 0), 0);
+	assert_int_equal(td->p.xrun_limit_usecs, 0);
+
+	td->dev.direction = SOF_IPC_STREAM_PLAYBACK;
+	fill(buffer_c, 48);
+	ret = pipeline_xrun_conceal(&td->p, &td->dev, buffer_c, 0, 96 * frame_bytes,
+				    frame_bytes);
+	assert_int_equal(ret, 0);
+	assert_int_equal(audio_stream_get_avail_frames(&buffer_c->stream), 48);
+	assert_int_equal(td->p.xrun_conceal_us, 0);
+	assert_int_equal(sample(buffer_c, 47), XRUN_TEST_SAMPLE);
+
+	buffer_release(buffer_c);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_pipeline_xrun_underrun, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_pipeline_xrun_underrun_s24_3le, setup,
+						teardown),
+		cmocka_unit_test_setup_teardown(test_pipeline_xrun_overrun, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_pipeline_xrun_over_limit, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_pipeline_xrun_dai, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_pipeline_xrun_disabled, setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
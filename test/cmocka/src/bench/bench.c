@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <cmocka.h>
+
+#if defined(__XTENSA__)
+#include <xtensa/config/core-isa.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#if !defined(__XTENSA__)
+#include <time.h>
+#endif
+
+#include <sof/common.h>
+
+#include "bench.h"
+
+/* samples to process per measurement, the ISS is a lot slower */
+#if defined(__XTENSA__)
+#define BENCH_SAMPLES	20000
+#else
+#define BENCH_SAMPLES	400000
+#endif
+
+const uint32_t bench_frames[BENCH_NUM_FRAMES] = { 48, 192, BENCH_MAX_FRAMES };
+const uint32_t bench_channels[BENCH_NUM_CHANNELS] = { 1, 2, 4, BENCH_MAX_CHANNELS };
+
+/* cycle counts only carry over to the same core configuration */
+#if defined(__XTENSA__)
+#define BENCH_TARGET	XCHAL_CORE_ID
+#else
+#define BENCH_TARGET	"host"
+#endif
+
+/* 32 bit counters wrap, only differences over one block are used */
+static inline uint32_t bench_cycles(void)
+{
+#if defined(__XTENSA__)
+	uint32_t ccount;
+
+	__asm__ __volatile__("rsr %0, ccount" : "=a" (ccount));
+	return ccount;
+#elif defined(__x86_64__) || defined(__i386__)
+	return (uint32_t)__rdtsc();
+#else
+	return 0;
+#endif
+}
+
+static inline uint64_t bench_ns(void)
+{
+#if defined(__XTENSA__)
+	return 0;
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+void bench_print_target(void)
+{
+	print_message("bench target %s\n", BENCH_TARGET);
+}
+
+void bench_run(const char *name, bench_kernel kernel, void *ctx,
+	       uint32_t frames, uint32_t channels)
+{
+	uint32_t samples = frames * channels;
+	uint32_t reps = BENCH_SAMPLES / samples;
+	uint64_t cycles = 0;
+	uint64_t ns;
+	uint32_t start;
+	double cps;
+	double nps;
+	uint32_t i;
+
+	if (reps < 2)
+		reps = 2;
+
+	/* first call warms up caches and filter state */
+	kernel(ctx, frames);
+
+	ns = bench_ns();
+	for (i = 0; i < reps; i++) {
+		start = bench_cycles();
+		kernel(ctx, frames);
+		cycles += (uint32_t)(bench_cycles() - start);
+	}
+	ns = bench_ns() - ns;
+
+	cps = (double)cycles / reps / samples;
+	nps = (double)ns / reps / samples;
+
+	print_message("bench %-28s frames %4u ch %u: %8.2f cycles/sample %8.3f ns/sample\n",
+		      name, frames, channels, cps, nps);
+}
+
+/* xorshift, the benchmarks see identical data on every run */
+static uint32_t bench_seed = 0x2545f491;
+
+static uint32_t bench_rand(void)
+{
+	bench_seed ^= bench_seed << 13;
+	bench_seed ^= bench_seed >> 17;
+	bench_seed ^= bench_seed << 5;
+	return bench_seed;
+}
+
+void bench_fill_s32(int32_t *data, uint32_t samples)
+{
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		data[i] = (int32_t)bench_rand();
+}
+
+void bench_fill_s16(int16_t *data, uint32_t samples)
+{
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		data[i] = (int16_t)(bench_rand() >> 16);
+}
@@ -0,0 +1,60 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2022 Intel Corporation. All rights reserved.
+ */
+
+#ifndef __TEST_CMOCKA_BENCH_H__
+#define __TEST_CMOCKA_BENCH_H__
+
+#include <stdint.h>
+
+/*
+ * Microbenchmark helpers for processing kernels. A kernel is called
+ * directly on synthetic audio, outside of any pipeline, and the cost is
+ * reported per sample for every block size and channel count.
+ *
+ * Cycles come from CCOUNT on xtensa and from the time stamp counter on
+ * x86 hosts. Wall clock time is only available on the host. The figures
+ * are reported, not checked: xt-run gives repeatable cycle counts on
+ * xtensa and its output is the input for calibrating the topology budget
+ * costs in tools/tplg_budget.
+ */
+
+/* block sizes in frames, 1 ms, 4 ms and 20 ms at 48 kHz */
+#define BENCH_NUM_FRAMES	3
+#define BENCH_MAX_FRAMES	960
+
+/* channel counts */
+#define BENCH_NUM_CHANNELS	4
+#define BENCH_MAX_CHANNELS	8
+
+extern const uint32_t bench_frames[BENCH_NUM_FRAMES];
+extern const uint32_t bench_channels[BENCH_NUM_CHANNELS];
+
+/* processes frames of audio, ctx is owned by the benchmark */
+typedef void (*bench_kernel)(void *ctx, uint32_t frames);
+
+/**
+ * \brief Reports the core the results are measured on.
+ *
+ * Printed once before the results, tplg_budget only trusts a bench log
+ * as calibrated when it comes from the core the topology is for.
+ */
+void bench_print_target(void);
+
+/**
+ * \brief Measures a kernel and reports the cost per sample.
+ * \param[in] name Kernel name, printed as the first field of the result.
+ * \param[in] kernel Function processing a block.
+ * \param[in] ctx Kernel context, must be prepared for the block size.
+ * \param[in] frames Block size.
+ * \param[in] channels Number of channels.
+ */
+void bench_run(const char *name, bench_kernel kernel, void *ctx,
+	       uint32_t frames, uint32_t channels);
+
+/* fills buffer with deterministic full scale noise */
+void bench_fill_s32(int32_t *data, uint32_t samples);
+void bench_fill_s16(int16_t *data, uint32_t samples);
+
+#endif /* __TEST_CMOCKA_BENCH_H__ */
@@ -0,0 +1,621 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+/*
+ * Benchmarks for the processing functions of audio components. The
+ * functions are taken from the component function maps, so the build
+ * selects the same generic or HiFi version as the firmware.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <cmocka.h>
+
+#include <sof/audio/aria/aria.h>
+#include <sof/audio/buffer.h>
+#include <sof/audio/component.h>
+#include <sof/audio/format.h>
+#include <sof/audio/mixer.h>
+#include <sof/audio/pcm_converter.h>
+#include <sof/common.h>
+#include <sof/lib/alloc.h>
+#include <sof/string.h>
+#if CONFIG_COMP_VOLUME
+#include <sof/audio/module_adapter/module/generic.h>
+#include <sof/audio/volume.h>
+#endif
+#if CONFIG_COMP_CROSSOVER
+#include <sof/audio/crossover/crossover.h>
+#include <sof/audio/crossover/crossover_algorithm.h>
+#include <user/eq.h>
+#endif
+#if CONFIG_COMP_DRC
+#include <sof/audio/drc/drc.h>
+#include <sof/audio/drc/drc_algorithm.h>
+#endif
+#if CONFIG_COMP_SRC
+#include <sof/audio/src/src.h>
+#endif
+
+#include "../util.h"
+#include "bench.h"
+
+#define BENCH_NAME_LEN	32
+
+static const char *bench_fmt_name(enum sof_ipc_frame fmt)
+{
+	switch (fmt) {
+	case SOF_IPC_FRAME_S16_LE:
+		return "s16";
+	case SOF_IPC_FRAME_S24_4LE:
+		return "s24";
+	case SOF_IPC_FRAME_S32_LE:
+		return "s32";
+	case SOF_IPC_FRAME_FLOAT:
+		return "float";
+	default:
+		return "other";
+	}
+}
+
+/*
+ * Source full of noise and empty sink, the kernels don't move the stream
+ * pointers so every call sees the same buffers.
+ */
+struct bench_streams {
+	struct comp_buffer *source;
+	struct comp_buffer *sink;
+	uint32_t channels;
+};
+
+static void bench_streams_new(struct bench_streams *s, struct comp_dev *dev,
+			      enum sof_ipc_frame source_fmt, enum sof_ipc_frame sink_fmt,
+			      uint32_t frames, uint32_t channels)
+{
+	uint32_t samples = frames * channels;
+
+	s->channels = channels;
+	s->source = create_test_source(dev, 0, source_fmt, channels,
+				       samples * get_sample_bytes(source_fmt));
+	s->sink = create_test_sink(dev, 0, sink_fmt, channels,
+				   samples * get_sample_bytes(sink_fmt));
+
+	if (source_fmt == SOF_IPC_FRAME_S16_LE)
+		bench_fill_s16(s->source->stream.addr, samples);
+	else
+		bench_fill_s32(s->source->stream.addr, samples);
+
+	audio_stream_produce(&s->source->stream, s->source->stream.size);
+}
+
+static void bench_streams_free(struct bench_streams *s)
+{
+	free_test_source(s->source);
+	free_test_sink(s->sink);
+}
+
+struct bench_pcm {
+	struct bench_streams s;
+	pcm_converter_func func;
+};
+
+static void bench_pcm_convert(void *ctx, uint32_t frames)
+{
+	struct bench_pcm *b = ctx;
+
+	b->func(&b->s.source->stream, 0, &b->s.sink->stream, 0, frames * b->s.channels);
+}
+
+static void test_bench_pcm_converter(void **state)
+{
+	char name[BENCH_NAME_LEN];
+	struct bench_pcm b;
+	int i, j, k;
+
+	for (k = 0; k < pcm_func_count; k++) {
+		snprintf(name, sizeof(name), "pcm_%s_to_%s",
+			 bench_fmt_name(pcm_func_map[k].source),
+			 bench_fmt_name(pcm_func_map[k].sink));
+		b.func = pcm_func_map[k].func;
+
+		for (i = 0; i < BENCH_NUM_FRAMES; i++) {
+			for (j = 0; j < BENCH_NUM_CHANNELS; j++) {
+				bench_streams_new(&b.s, NULL, pcm_func_map[k].source,
+						  pcm_func_map[k].sink, bench_frames[i],
+						  bench_channels[j]);
+				bench_run(name, bench_pcm_convert, &b, bench_frames[i],
+					  bench_channels[j]);
+				bench_streams_free(&b.s);
+			}
+		}
+	}
+}
+
+/* streams mixed together by one mixer */
+static const uint32_t bench_mixer_sources[] = { 2, 4 };
+
+#define BENCH_MIXER_MAX_SOURCES	4
+
+struct bench_mixer {
+	struct bench_streams s;
+	struct comp_buffer *sources[BENCH_MIXER_MAX_SOURCES];
+	const struct audio_stream __sparse_cache *streams[BENCH_MIXER_MAX_SOURCES];
+	struct comp_dev dev;
+	mixer_func func;
+	uint32_t num_sources;
+};
+
+static void bench_mixer(void *ctx, uint32_t frames)
+{
+	struct bench_mixer *b = ctx;
+
+	b->func(&b->dev, &b->s.sink->stream, b->streams, b->num_sources, frames);
+}
+
+static void bench_mixer_new(struct bench_mixer *b, enum sof_ipc_frame fmt,
+			    uint32_t frames, uint32_t channels)
+{
+	uint32_t samples = frames * channels;
+	int j;
+
+	bench_streams_new(&b->s, NULL, fmt, fmt, frames, channels);
+	b->sources[0] = b->s.source;
+	for (j = 1; j < b->num_sources; j++) {
+		b->sources[j] = create_test_source(NULL, 0, fmt, channels,
+						   b->s.source->stream.size);
+		if (fmt == SOF_IPC_FRAME_S16_LE)
+			bench_fill_s16(b->sources[j]->stream.addr, samples);
+		else
+			bench_fill_s32(b->sources[j]->stream.addr, samples);
+		audio_stream_produce(&b->sources[j]->stream, b->sources[j]->stream.size);
+	}
+
+	for (j = 0; j < b->num_sources; j++)
+		b->streams[j] = &b->sources[j]->stream;
+}
+
+static void bench_mixer_free(struct bench_mixer *b)
+{
+	int j;
+
+	for (j = 1; j < b->num_sources; j++)
+		free_test_source(b->sources[j]);
+	bench_streams_free(&b->s);
+}
+
+static void test_bench_mixer(void **state)
+{
+	struct bench_mixer *b = test_calloc(1, sizeof(*b));
+	char name[BENCH_NAME_LEN];
+	enum sof_ipc_frame fmt;
+	int i, j, k, m;
+
+	for (k = 0; k < mixer_func_count; k++) {
+		fmt = mixer_func_map[k].frame_fmt;
+		b->func = mixer_func_map[k].func;
+
+		for (m = 0; m < ARRAY_SIZE(bench_mixer_sources); m++) {
+			b->num_sources = bench_mixer_sources[m];
+			snprintf(name, sizeof(name), "mixer_%s_%u_sources", bench_fmt_name(fmt),
+				 b->num_sources);
+
+			for (i = 0; i < BENCH_NUM_FRAMES; i++) {
+				for (j = 0; j < BENCH_NUM_CHANNELS; j++) {
+					bench_mixer_new(b, fmt, bench_frames[i], bench_channels[j]);
+					bench_run(name, bench_mixer, b, bench_frames[i],
+						  bench_channels[j]);
+					bench_mixer_free(b);
+				}
+			}
+		}
+	}
+
+	test_free(b);
+}
+
+#if CONFIG_COMP_VOLUME
+struct bench_vol {
+	struct bench_streams s;
+	struct processing_module mod;
+	struct comp_dev dev;
+	struct vol_data cd;
+	struct input_stream_buffer input;
+	struct output_stream_buffer output;
+	vol_scale_func func;
+};
+
+static void bench_vol(void *ctx, uint32_t frames)
+{
+	struct bench_vol *b = ctx;
+
+	b->func(&b->mod, &b->input, &b->output, frames);
+}
+
+static void test_bench_volume(void **state)
+{
+	const size_t vol_size = sizeof(int32_t) * SOF_IPC_MAX_CHANNELS * 4;
+	struct bench_vol *b = test_calloc(1, sizeof(*b));
+	struct comp_dev *dev = &b->dev;
+	char name[BENCH_NAME_LEN];
+	enum sof_ipc_frame fmt;
+	int i, j, k, ch;
+
+	b->mod.dev = dev;
+	b->mod.priv.private = &b->cd;
+	comp_set_drvdata(dev, &b->mod);
+	b->cd.vol = test_malloc(vol_size);
+
+	/* -6 dB, the gain value has no effect on the cost */
+	for (ch = 0; ch < SOF_IPC_MAX_CHANNELS; ch++)
+		b->cd.volume[ch] = VOL_ZERO_DB / 2;
+	for (ch = 0; ch < SOF_IPC_MAX_CHANNELS * 4; ch++)
+		b->cd.vol[ch] = VOL_ZERO_DB / 2;
+
+	for (k = 0; k < volume_func_count; k++) {
+		fmt = volume_func_map[k].frame_fmt;
+		snprintf(name, sizeof(name), "vol_%s_to_%s", bench_fmt_name(fmt),
+			 bench_fmt_name(fmt));
+		b->func = volume_func_map[k].func;
+
+		for (i = 0; i < BENCH_NUM_FRAMES; i++) {
+			for (j = 0; j < BENCH_NUM_CHANNELS; j++) {
+				list_init(&dev->bsource_list);
+				list_init(&dev->bsink_list);
+				bench_streams_new(&b->s, dev, fmt, fmt, bench_frames[i],
+						  bench_channels[j]);
+				b->input.data = &b->s.source->stream;
+				b->output.data = &b->s.sink->stream;
+				b->cd.channels = bench_channels[j];
+				bench_run(name, bench_vol, b, bench_frames[i], bench_channels[j]);
+				bench_streams_free(&b->s);
+			}
+		}
+	}
+
+	test_free(b->cd.vol);
+	test_free(b);
+}
+#endif /* CONFIG_COMP_VOLUME */
+
+#if CONFIG_COMP_CROSSOVER
+/* LR4 low and high pass pair at 1 kHz for 48 kHz, used for every split */
+static const struct sof_eq_iir_biquad_df2t bench_crossover_coef[] = {
+	{ -892285457, 1949207645, 4204909, 8409818, 4204909, 0, 16384 },
+	{ -892285457, 1949207645, 978808732, -1957617463, 978808732, 0, 16384 },
+	{ -892285457, 1949207645, 4204909, 8409818, 4204909, 0, 16384 },
+	{ -892285457, 1949207645, 978808732, -1957617463, 978808732, 0, 16384 },
+	{ -892285457, 1949207645, 4204909, 8409818, 4204909, 0, 16384 },
+	{ -892285457, 1949207645, 978808732, -1957617463, 978808732, 0, 16384 },
+};
+
+struct bench_crossover {
+	struct bench_streams s;
+	struct comp_buffer *sinks[CROSSOVER_4WAY_NUM_SINKS];
+	struct comp_dev dev;
+	struct comp_data cd;
+	int num_sinks;
+};
+
+static void bench_crossover(void *ctx, uint32_t frames)
+{
+	struct bench_crossover *b = ctx;
+
+	b->cd.crossover_process(&b->dev, b->s.source, b->sinks, b->num_sinks, frames);
+}
+
+static void bench_crossover_new(struct bench_crossover *b, enum sof_ipc_frame fmt,
+				uint32_t frames, uint32_t channels)
+{
+	struct sof_eq_iir_biquad_df2t coef[ARRAY_SIZE(bench_crossover_coef)];
+	int ch;
+	int j;
+
+	memcpy_s(coef, sizeof(coef), bench_crossover_coef, sizeof(bench_crossover_coef));
+	for (ch = 0; ch < channels; ch++)
+		assert_int_equal(crossover_init_coef_ch(coef, &b->cd.state[ch], b->num_sinks), 0);
+
+	b->cd.crossover_process = crossover_find_proc_func(fmt, channels);
+	b->cd.crossover_split = crossover_find_split_func(b->num_sinks);
+	b->cd.active_sinks = BIT(b->num_sinks) - 1;
+
+	bench_streams_new(&b->s, NULL, fmt, fmt, frames, channels);
+	b->sinks[0] = b->s.sink;
+	for (j = 1; j < b->num_sinks; j++)
+		b->sinks[j] = create_test_sink(NULL, 0, fmt, channels, b->s.sink->stream.size);
+}
+
+static void bench_crossover_free(struct bench_crossover *b, uint32_t channels)
+{
+	int ch;
+	int j;
+
+	for (j = 1; j < b->num_sinks; j++)
+		free_test_sink(b->sinks[j]);
+	bench_streams_free(&b->s);
+	for (ch = 0; ch < channels; ch++)
+		crossover_reset_state_ch(&b->cd.state[ch]);
+}
+
+static void test_bench_crossover(void **state)
+{
+	struct bench_crossover *b = test_calloc(1, sizeof(*b));
+	struct comp_dev *dev = &b->dev;
+	char name[BENCH_NAME_LEN];
+	enum sof_ipc_frame fmt;
+	int i, j, k;
+
+	comp_set_drvdata(dev, &b->cd);
+
+	for (k = 0; k < crossover_proc_fncount; k++) {
+		/* one pass per format, the function for each channels count is
+		 * looked up like in prepare
+		 */
+		if (crossover_proc_fnmap[k].channels)
+			continue;
+
+		fmt = crossover_proc_fnmap[k].frame_fmt;
+		for (b->num_sinks = CROSSOVER_2WAY_NUM_SINKS;
+		     b->num_sinks <= CROSSOVER_4WAY_NUM_SINKS; b->num_sinks++) {
+			snprintf(name, sizeof(name), "crossover_%s_%dway", bench_fmt_name(fmt),
+				 b->num_sinks);
+
+			for (i = 0; i < BENCH_NUM_FRAMES; i++) {
+				for (j = 0; j < BENCH_NUM_CHANNELS; j++) {
+					bench_crossover_new(b, fmt, bench_frames[i],
+							    bench_channels[j]);
+					bench_run(name, bench_crossover, b, bench_frames[i],
+						  bench_channels[j]);
+					bench_crossover_free(b, bench_channels[j]);
+				}
+			}
+		}
+	}
+
+	test_free(b);
+}
+#endif /* CONFIG_COMP_CROSSOVER */
+
+#if CONFIG_COMP_DRC
+/* sof_drc_params of the default DRC configuration blob */
+static const int32_t bench_drc_params[] = {
+	0x00000001, 0xe8000000, 0x1e000000, 0x01000000, 0x00624dd3, 0x0409c2b1,
+	0x40000000, 0x000199a6, 0x0a0fd8ce, 0xf5f01a1f, 0x01fec983, 0x3a6130df,
+	0x010e83cb, 0x017384ef, 0xff6b646d, 0x00224103, 0x00000005, 0x00f81000,
+	0x001081aa, 0x008af0f4, 0x0022e1aa, 0x00029bb9,
+};
+
+struct bench_drc {
+	struct bench_streams s;
+	struct comp_dev dev;
+	struct drc_comp_data cd;
+	struct sof_drc_config config;
+	drc_func func;
+};
+
+static void bench_drc(void *ctx, uint32_t frames)
+{
+	struct bench_drc *b = ctx;
+
+	b->func(&b->dev, &b->s.source->stream, &b->s.sink->stream, frames);
+}
+
+static void test_bench_drc(void **state)
+{
+	struct bench_drc *b = test_calloc(1, sizeof(*b));
+	struct comp_dev *dev = &b->dev;
+	struct drc_state *drc_state;
+	char name[BENCH_NAME_LEN];
+	int32_t pre_delay;
+	enum sof_ipc_frame fmt;
+	int i, j, k;
+	int ret;
+
+	assert_int_equal(sizeof(bench_drc_params), sizeof(b->config.params));
+	memcpy_s(&b->config.params, sizeof(b->config.params), bench_drc_params,
+		 sizeof(bench_drc_params));
+	b->config.size = sizeof(b->config);
+	b->cd.config = &b->config;
+	pre_delay = b->config.params.pre_delay_time;
+	comp_set_drvdata(dev, &b->cd);
+
+	for (k = 0; k < drc_proc_fncount; k++) {
+		fmt = drc_proc_fnmap[k].frame_fmt;
+		snprintf(name, sizeof(name), "drc_%s_default", bench_fmt_name(fmt));
+		b->func = drc_proc_fnmap[k].drc_proc_func;
+
+		for (i = 0; i < BENCH_NUM_FRAMES; i++) {
+			for (j = 0; j < BENCH_NUM_CHANNELS; j++) {
+				drc_state = &b->cd.state;
+				drc_reset_state(drc_state);
+				ret = drc_init_pre_delay_buffers(drc_state, get_sample_bytes(fmt),
+								 bench_channels[j]);
+				assert_int_equal(ret, 0);
+				ret = drc_set_pre_delay_time(drc_state, pre_delay, 48000);
+				assert_int_equal(ret, 0);
+#if CONFIG_FORMAT_FLOAT_PROCESSING
+				if (fmt == SOF_IPC_FRAME_FLOAT)
+					drc_setup_float(&b->cd);
+#endif
+
+				bench_streams_new(&b->s, NULL, fmt, fmt, bench_frames[i],
+						  bench_channels[j]);
+				bench_run(name, bench_drc, b, bench_frames[i], bench_channels[j]);
+				bench_streams_free(&b->s);
+			}
+		}
+	}
+
+	/* frees the pre-delay buffers */
+	drc_reset_state(&b->cd.state);
+	test_free(b);
+}
+#endif /* CONFIG_COMP_DRC */
+
+#if CONFIG_COMP_SRC
+/* a typical up, down and fractional conversion */
+static const int bench_src_rates[][2] = {
+	{ 16000, 48000 },
+	{ 96000, 48000 },
+	{ 44100, 48000 },
+};
+
+struct bench_src {
+	struct polyphase_src src;
+	struct src_param param;
+	struct src_stage_prm prm;
+	int32_t *delay;
+	int32_t *x;
+	int32_t *y;
+};
+
+static void bench_src(void *ctx, uint32_t frames)
+{
+	struct bench_src *b = ctx;
+
+	src_polyphase_stage_cir(&b->prm);
+}
+
+static void test_bench_src_polyphase(void **state)
+{
+	struct bench_src *b = test_calloc(1, sizeof(*b));
+	size_t size = BENCH_MAX_FRAMES * BENCH_MAX_CHANNELS * sizeof(int32_t);
+	char name[BENCH_NAME_LEN];
+	int i, j, k;
+	int times;
+
+	b->x = test_malloc(size);
+	b->y = test_malloc(size);
+	bench_fill_s32(b->x, BENCH_MAX_FRAMES * BENCH_MAX_CHANNELS);
+
+	for (k = 0; k < ARRAY_SIZE(bench_src_rates); k++) {
+		snprintf(name, sizeof(name), "src_polyphase_%d_%d",
+			 bench_src_rates[k][0], bench_src_rates[k][1]);
+
+		for (i = 0; i < BENCH_NUM_FRAMES; i++) {
+			for (j = 0; j < BENCH_NUM_CHANNELS; j++) {
+				/* rate pair may be left out of the coefficient set */
+				if (src_buffer_lengths(&b->param, bench_src_rates[k][0],
+						       bench_src_rates[k][1], bench_channels[j],
+						       bench_frames[i]) < 0)
+					continue;
+
+				b->delay = test_calloc(b->param.total, sizeof(int32_t));
+				if (src_polyphase_init(&b->src, &b->param, b->delay) <= 0) {
+					test_free(b->delay);
+					continue;
+				}
+
+				/* first stage only, it does most of the work */
+				times = MAX(bench_frames[i] / b->src.stage1->blk_in, 1);
+				b->prm.nch = bench_channels[j];
+				b->prm.times = times;
+				b->prm.shift = 0;
+				b->prm.x_rptr = b->x;
+				b->prm.x_end_addr = (char *)b->x + size;
+				b->prm.x_size = size;
+				b->prm.y_wptr = b->y;
+				b->prm.y_addr = b->y;
+				b->prm.y_end_addr = (char *)b->y + size;
+				b->prm.y_size = size;
+				b->prm.state = &b->src.state1;
+				b->prm.stage = b->src.stage1;
+
+				bench_run(name, bench_src, b, times * b->src.stage1->blk_in,
+					  bench_channels[j]);
+				test_free(b->delay);
+			}
+		}
+	}
+
+	test_free(b->y);
+	test_free(b->x);
+	test_free(b);
+}
+#endif /* CONFIG_COMP_SRC */
+
+/* ARIA is an IPC4 module, its kernels build in any configuration */
+struct bench_aria {
+	struct comp_dev dev;
+	struct aria_data cd;
+	int32_t *in;
+	int32_t *out;
+};
+
+static void bench_aria(void *ctx, uint32_t frames)
+{
+	struct bench_aria *b = ctx;
+	size_t samples = frames * b->cd.chan_cnt;
+
+	aria_process_data(&b->dev, b->out, samples, b->in, samples);
+}
+
+static void test_bench_aria(void **state)
+{
+	const size_t max_samples = BENCH_MAX_FRAMES * BENCH_MAX_CHANNELS;
+	struct bench_aria *b = test_calloc(1, sizeof(*b));
+	struct comp_dev *dev = &b->dev;
+	char name[BENCH_NAME_LEN];
+	size_t idx;
+	int i, j;
+
+	comp_set_drvdata(dev, &b->cd);
+	b->cd.data = test_calloc(max_samples, sizeof(int32_t));
+	b->in = test_malloc(max_samples * sizeof(int32_t));
+	b->out = test_malloc(max_samples * sizeof(int32_t));
+	bench_fill_s32(b->in, max_samples);
+
+	/* full scale noise, the gain is computed and applied on every block */
+	b->cd.att = ARIA_MAX_ATT;
+	snprintf(name, sizeof(name), "aria_s32_att%zu", b->cd.att);
+
+	for (i = 0; i < BENCH_NUM_FRAMES; i++) {
+		for (j = 0; j < BENCH_NUM_CHANNELS; j++) {
+			/* same state as aria_algo_init(), one block of delay */
+			b->cd.chan_cnt = bench_channels[j];
+			b->cd.smpl_group_cnt = bench_frames[i];
+			b->cd.buff_size = ALIGN_UP(bench_channels[j] * bench_frames[i], 2);
+			b->cd.offset = (bench_channels[j] * bench_frames[i]) % 2;
+			b->cd.buff_pos = 0;
+			b->cd.gain_state = 0;
+			for (idx = 0; idx < ARIA_MAX_GAIN_STATES; idx++)
+				b->cd.gains[idx] = (1ULL << (32 - b->cd.att - 1)) - 1;
+
+			bench_run(name, bench_aria, b, bench_frames[i], bench_channels[j]);
+		}
+	}
+
+	test_free(b->cd.data);
+	test_free(b->in);
+	test_free(b->out);
+	test_free(b);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_bench_pcm_converter),
+		cmocka_unit_test(test_bench_mixer),
+#if CONFIG_COMP_VOLUME
+		cmocka_unit_test(test_bench_volume),
+#endif
+#if CONFIG_COMP_CROSSOVER
+		cmocka_unit_test(test_bench_crossover),
+#endif
+#if CONFIG_COMP_DRC
+		cmocka_unit_test(test_bench_drc),
+#endif
+#if CONFIG_COMP_SRC
+		cmocka_unit_test(test_bench_src_polyphase),
+#endif
+		cmocka_unit_test(test_bench_aria),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+	bench_print_target();
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
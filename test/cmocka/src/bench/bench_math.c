@@ -0,0 +1,323 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+/*
+ * Benchmarks for the filter and transform kernels of src/math.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <cmocka.h>
+
+#include <sof/audio/buffer.h>
+#include <sof/audio/component.h>
+#include <sof/audio/eq_fir/eq_fir.h>
+#include <sof/audio/eq_iir/eq_iir.h>
+#include <sof/common.h>
+#include <sof/math/fir_config.h>
+#include <sof/math/iir_df2t.h>
+#include <sof/math/fft.h>
+#include <user/eq.h>
+#include <user/fir.h>
+
+#include "../util.h"
+#include "../audio/eq_iir/cmocka_iir_coef_2ch.h"
+#include "bench.h"
+
+/* response of the 2ch IIR test blob, four biquads in series */
+#define BENCH_IIR_RESPONSE	17
+
+#define BENCH_FIR_TAPS		64
+
+struct bench_filter {
+	struct comp_buffer *source;
+	struct comp_buffer *sink;
+	uint32_t channels;
+};
+
+static void bench_filter_new(struct bench_filter *f, uint32_t frames, uint32_t channels)
+{
+	uint16_t size = frames * channels * sizeof(int32_t);
+
+	f->channels = channels;
+	f->source = create_test_source(NULL, 0, SOF_IPC_FRAME_S32_LE, channels, size);
+	f->sink = create_test_sink(NULL, 0, SOF_IPC_FRAME_S32_LE, channels, size);
+	bench_fill_s32(f->source->stream.addr, frames * channels);
+}
+
+static void bench_filter_free(struct bench_filter *f)
+{
+	free_test_source(f->source);
+	free_test_sink(f->sink);
+}
+
+struct bench_iir {
+	struct bench_filter f;
+	struct comp_dev dev;
+	struct comp_data cd;
+	eq_iir_func func;
+	int64_t delay[BENCH_MAX_CHANNELS * 2 * SOF_EQ_IIR_DF2T_BIQUADS_MAX];
+};
+
+/* sets up the filters of an eq_iir instance like eq_iir_setup() does */
+static void bench_iir_init(struct comp_dev *dev, struct comp_data *cd, int64_t *delay,
+			   uint32_t channels)
+{
+	struct sof_eq_iir_header_df2t *config =
+		(struct sof_eq_iir_header_df2t *)&iir_coef_2ch[BENCH_IIR_RESPONSE];
+	uint32_t ch;
+
+	comp_set_drvdata(dev, cd);
+	for (ch = 0; ch < channels; ch++) {
+		assert_int_equal(iir_init_coef_df2t(&cd->iir[ch], config), 0);
+		iir_init_delay_df2t(&cd->iir[ch], &delay);
+	}
+}
+
+static void bench_eq_iir(void *ctx, uint32_t frames)
+{
+	struct bench_iir *b = ctx;
+
+	b->func(&b->dev, &b->f.source->stream, &b->f.sink->stream, frames);
+}
+
+/*
+ * The S32 processing functions of eq_iir, eq_iir_s32_default() for any
+ * channel count and the unrolled ones for the channel count they are
+ * selected for.
+ */
+static void test_bench_eq_iir_s32(void **state)
+{
+	struct bench_iir *b = test_calloc(1, sizeof(*b));
+	const struct eq_iir_func_map *map;
+	char name[32];
+	int i, j, m;
+
+	for (m = 0; m < fm_configured_count; m++) {
+		map = &fm_configured[m];
+		if (map->source != SOF_IPC_FRAME_S32_LE || map->sink != SOF_IPC_FRAME_S32_LE ||
+		    !map->func)
+			continue;
+
+		if (map->channels)
+			snprintf(name, sizeof(name), "eq_iir_s32_%uch", map->channels);
+		else
+			snprintf(name, sizeof(name), "eq_iir_s32");
+
+		b->func = map->func;
+		for (i = 0; i < BENCH_NUM_FRAMES; i++) {
+			for (j = 0; j < BENCH_NUM_CHANNELS; j++) {
+				if (map->channels && map->channels != bench_channels[j])
+					continue;
+
+				bench_filter_new(&b->f, bench_frames[i], bench_channels[j]);
+				bench_iir_init(&b->dev, &b->cd, b->delay, bench_channels[j]);
+				bench_run(name, bench_eq_iir, b, bench_frames[i],
+					  bench_channels[j]);
+				bench_filter_free(&b->f);
+			}
+		}
+	}
+
+	test_free(b);
+}
+
+/*
+ * Mono streams with the same coefficients, filtered one by one with the
+ * eq_iir mono function like separate eq_iir instances do, or together
+ * with iir_df2t_lanes() like an eq_iir batch does. The batch cost
+ * includes moving the samples and delays to and from the lanes.
+ */
+struct bench_lanes {
+	struct bench_filter f[BENCH_MAX_CHANNELS];
+	struct comp_dev dev[BENCH_MAX_CHANNELS];
+	struct comp_data cd[BENCH_MAX_CHANNELS];
+	int64_t delay[BENCH_MAX_CHANNELS][2 * SOF_EQ_IIR_DF2T_BIQUADS_MAX];
+	int32_t data[BENCH_MAX_FRAMES * BENCH_MAX_CHANNELS];
+	int64_t lane_delay[BENCH_MAX_CHANNELS * 2 * SOF_EQ_IIR_DF2T_BIQUADS_MAX];
+	eq_iir_func func;
+	uint32_t streams;
+};
+
+static void bench_iir_streams(void *ctx, uint32_t frames)
+{
+	struct bench_lanes *b = ctx;
+	uint32_t s;
+
+	for (s = 0; s < b->streams; s++)
+		b->func(&b->dev[s], &b->f[s].source->stream, &b->f[s].sink->stream, frames);
+}
+
+static void bench_iir_lanes(void *ctx, uint32_t frames)
+{
+	struct bench_lanes *b = ctx;
+	struct iir_state_df2t *iir;
+	uint32_t lanes = b->streams;
+	uint32_t delays = IIR_DF2T_NUM_DELAYS * b->cd[0].iir[0].biquads;
+	int32_t *x;
+	int32_t *y;
+	uint32_t s;
+	uint32_t d;
+	uint32_t n;
+
+	for (s = 0; s < lanes; s++) {
+		x = b->f[s].source->stream.r_ptr;
+		iir = &b->cd[s].iir[0];
+		for (n = 0; n < frames; n++)
+			b->data[n * lanes + s] = x[n];
+		for (d = 0; d < delays; d++)
+			b->lane_delay[d * lanes + s] = iir->delay[d];
+	}
+
+	iir_df2t_lanes(&b->cd[0].iir[0], b->lane_delay, b->data, frames, lanes);
+
+	for (s = 0; s < lanes; s++) {
+		y = b->f[s].sink->stream.w_ptr;
+		iir = &b->cd[s].iir[0];
+		for (n = 0; n < frames; n++)
+			y[n] = b->data[n * lanes + s];
+		for (d = 0; d < delays; d++)
+			iir->delay[d] = b->lane_delay[d * lanes + s];
+	}
+}
+
+static void test_bench_iir_df2t_lanes(void **state)
+{
+	struct bench_lanes *b = test_calloc(1, sizeof(*b));
+	const struct eq_iir_func_map *map;
+	int i, j, k;
+
+	/* the function eq_iir selects for a mono S32 stream */
+	for (k = 0; k < fm_configured_count; k++) {
+		map = &fm_configured[k];
+		if (map->source == SOF_IPC_FRAME_S32_LE && map->sink == SOF_IPC_FRAME_S32_LE &&
+		    (!map->channels || map->channels == 1))
+			break;
+	}
+	assert_true(k < fm_configured_count);
+	b->func = map->func;
+
+	for (i = 0; i < BENCH_NUM_FRAMES; i++) {
+		for (j = 0; j < BENCH_NUM_CHANNELS; j++) {
+			b->streams = bench_channels[j];
+			for (k = 0; k < b->streams; k++) {
+				bench_filter_new(&b->f[k], bench_frames[i], 1);
+				bench_iir_init(&b->dev[k], &b->cd[k], b->delay[k], 1);
+			}
+
+			bench_run("eq_iir_s32_mono_streams", bench_iir_streams, b,
+				  bench_frames[i], b->streams);
+			bench_run("iir_df2t_lanes", bench_iir_lanes, b, bench_frames[i],
+				  b->streams);
+
+			for (k = 0; k < b->streams; k++)
+				bench_filter_free(&b->f[k]);
+		}
+	}
+
+	test_free(b);
+}
+
+struct bench_fir {
+	struct bench_filter f;
+	struct fir_state_32x16 fir[BENCH_MAX_CHANNELS];
+	int32_t delay[BENCH_MAX_CHANNELS * (BENCH_FIR_TAPS + 4)];
+	int16_t config[SOF_FIR_COEF_NHEADER + BENCH_FIR_TAPS];
+};
+
+static void bench_eq_fir_s32(void *ctx, uint32_t frames)
+{
+	struct bench_fir *b = ctx;
+
+	eq_fir_s32(b->fir, &b->f.source->stream, &b->f.sink->stream, frames,
+		   b->f.channels);
+}
+
+static void test_bench_eq_fir_s32(void **state)
+{
+	struct bench_fir *b = test_calloc(1, sizeof(*b));
+	struct sof_fir_coef_data *config = (struct sof_fir_coef_data *)b->config;
+	int32_t *delay;
+	int i, j, k;
+
+	/* coefficient values don't affect the cost */
+	config->length = BENCH_FIR_TAPS;
+	config->out_shift = 0;
+	for (k = 0; k < BENCH_FIR_TAPS; k++)
+		config->coef[k] = (k == BENCH_FIR_TAPS / 2) ? 16384 : 1024 / (k + 1);
+
+	assert_true(fir_delay_size(config) > 0);
+
+	for (i = 0; i < BENCH_NUM_FRAMES; i++) {
+		for (j = 0; j < BENCH_NUM_CHANNELS; j++) {
+			bench_filter_new(&b->f, bench_frames[i], bench_channels[j]);
+			delay = b->delay;
+			for (k = 0; k < bench_channels[j]; k++) {
+				fir_init_coef(&b->fir[k], config);
+				fir_init_delay(&b->fir[k], &delay);
+			}
+
+			bench_run("eq_fir_s32", bench_eq_fir_s32, b, bench_frames[i],
+				  bench_channels[j]);
+			bench_filter_free(&b->f);
+		}
+	}
+
+	test_free(b);
+}
+
+#ifdef BENCH_FFT
+static const uint32_t bench_fft_sizes[] = { 64, 256, 1024 };
+
+static void bench_fft(void *ctx, uint32_t frames)
+{
+	fft_execute(ctx, false);
+}
+
+static void test_bench_fft_execute(void **state)
+{
+	struct icomplex32 *inb;
+	struct icomplex32 *outb;
+	struct fft_plan *plan;
+	uint32_t size;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(bench_fft_sizes); i++) {
+		size = bench_fft_sizes[i];
+		inb = test_calloc(size, sizeof(*inb));
+		outb = test_calloc(size, sizeof(*outb));
+		bench_fill_s32((int32_t *)inb, 2 * size);
+
+		plan = fft_plan_new(inb, outb, size);
+		assert_non_null(plan);
+
+		bench_run("fft_execute", bench_fft, plan, size, 1);
+
+		fft_plan_free(plan);
+		test_free(outb);
+		test_free(inb);
+	}
+}
+#endif
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_bench_eq_iir_s32),
+		cmocka_unit_test(test_bench_iir_df2t_lanes),
+		cmocka_unit_test(test_bench_eq_fir_s32),
+#ifdef BENCH_FFT
+		cmocka_unit_test(test_bench_fft_execute),
+#endif
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+	bench_print_target();
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
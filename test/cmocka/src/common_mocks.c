@@ -327,6 +327,16 @@ int WEAK comp_set_state(struct comp_dev *dev, int cmd)
 	return 0;
 }
 
+const struct comp_driver *WEAK comp_driver_find_uuid(const uint8_t *uuid)
+{
+	return NULL;
+}
+
+const struct comp_driver *WEAK comp_driver_find_type(uint32_t type)
+{
+	return NULL;
+}
+
 #ifndef __ZEPHYR__
 uint64_t WEAK clock_ms_to_ticks(int clock, uint64_t ms)
 {
@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <stdint.h>
+#include <sof/audio/component_ext.h>
+#include <sof/audio/pipeline.h>
+#include <sof/lib/agent.h>
+#include <sof/list.h>
+#include <sof/sof.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#ifdef HAVE_MALLOC_H
+#include <malloc.h>
+#else
+#include <stdlib.h>
+#endif
+
+#define TEST_PERIOD		1000
+#define TEST_PIPE_LIMIT		1000
+#define TEST_COMP_LIMIT		100
+
+struct test_data {
+	struct pipeline p;
+	struct comp_dev dev;
+	struct comp_dev other;
+};
+
+static const struct comp_driver test_drv;
+
+static struct sa test_sa;
+static struct sof test_sof = {
+	.sa = &test_sa,
+};
+
+struct sof *sof_get(void)
+{
+	return &test_sof;
+}
+
+static int setup(void **state)
+{
+	struct test_data *td = calloc(1, sizeof(*td));
+
+	if (!td)
+		return -1;
+
+	memset(&test_sa, 0, sizeof(test_sa));
+
+	td->p.pipeline_id = 1;
+	td->p.period = TEST_PERIOD;
+	td->p.budget.limit = TEST_PIPE_LIMIT;
+
+	td->dev.drv = &test_drv;
+	td->dev.pipeline = &td->p;
+	td->dev.period = TEST_PERIOD;
+
+	td->other.drv = &test_drv;
+	td->other.pipeline = &td->p;
+	td->other.period = TEST_PERIOD;
+
+	*state = td;
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	free(*state);
+	return 0;
+}
+
+static void test_lib_agent_budget_comp_limit(void **state)
+{
+	struct test_data *td = *state;
+
+	/* a component budget of its own is checked rather than the pipeline's */
+	td->dev.budget.limit = TEST_COMP_LIMIT;
+
+	sa_budget_comp(&td->dev, TEST_COMP_LIMIT);
+	assert_int_equal(td->dev.budget.overruns, 0);
+
+	sa_budget_comp(&td->dev, TEST_COMP_LIMIT + 1);
+	assert_int_equal(td->dev.budget.overruns, 1);
+	assert_int_equal(td->dev.budget.cycles, TEST_COMP_LIMIT + 1);
+
+	sa_budget_comp(&td->dev, TEST_COMP_LIMIT / 2);
+	assert_int_equal(td->dev.budget.overruns, 1);
+	assert_int_equal(td->dev.budget.cycles, TEST_COMP_LIMIT / 2);
+	assert_int_equal(td->dev.budget.cycles_max, TEST_COMP_LIMIT + 1);
+}
+
+static void test_lib_agent_budget_pipe_limit(void **state)
+{
+	struct test_data *td = *state;
+
+	/* without one the component may take the whole pipeline budget */
+	sa_budget_comp(&td->dev, TEST_PIPE_LIMIT);
+	assert_int_equal(td->dev.budget.overruns, 0);
+
+	sa_budget_comp(&td->dev, TEST_PIPE_LIMIT + 1);
+	assert_int_equal(td->dev.budget.overruns, 1);
+
+	sa_budget_pipeline(&td->p, TEST_PIPE_LIMIT + 1);
+	assert_int_equal(td->p.budget.overruns, 1);
+	assert_int_equal(td->p.budget.cycles_max, TEST_PIPE_LIMIT + 1);
+}
+
+static void test_lib_agent_budget_offender(void **state)
+{
+	struct test_data *td = *state;
+
+	sa_budget_comp(&td->dev, 10);
+	sa_budget_comp(&td->other, 20);
+	sa_budget_comp(&td->dev, 15);
+	sa_budget_pipeline(&td->p, 45);
+
+	/* the longest copies are kept for a late tick */
+	assert_ptr_equal(test_sa.offender.comp, &td->other);
+	assert_int_equal(test_sa.offender.comp_cycles, 20);
+	assert_int_equal(test_sa.offender.pipe_id, td->p.pipeline_id);
+	assert_int_equal(test_sa.offender.pipe_cycles, 45);
+}
+
+static void test_lib_agent_budget_comp_reset(void **state)
+{
+	struct test_data *td = *state;
+
+	td->other.budget.limit = TEST_COMP_LIMIT;
+	sa_budget_comp(&td->other, TEST_COMP_LIMIT + 1);
+	td->other.bypass = true;
+
+	assert_int_equal(comp_reset(&td->other), 0);
+
+	/* the reset component is forgotten, including as the offender */
+	assert_false(td->other.bypass);
+	assert_int_equal(td->other.budget.cycles_max, 0);
+	assert_int_equal(td->other.budget.overruns, 0);
+	assert_ptr_equal(test_sa.offender.comp, NULL);
+	assert_int_equal(test_sa.offender.comp_cycles, 0);
+
+	/* another component stays the offender */
+	sa_budget_comp(&td->dev, 10);
+	assert_int_equal(comp_reset(&td->other), 0);
+	assert_ptr_equal(test_sa.offender.comp, &td->dev);
+}
+
+static void test_lib_agent_budget_comp_init(void **state)
+{
+	struct test_data *td = *state;
+
+	sa_budget_comp(&td->dev, TEST_PIPE_LIMIT + 1);
+
+	/* no topology budget, the pipeline's applies from a clean start */
+	sa_budget_comp_init(&td->dev);
+	assert_int_equal(td->dev.budget.limit, 0);
+	assert_int_equal(td->dev.budget.cycles_max, 0);
+	assert_int_equal(td->dev.budget.overruns, 0);
+	assert_ptr_equal(test_sa.offender.comp, NULL);
+}
+
+static void test_lib_agent_budget_comp_period(void **state)
+{
+	struct test_data *td = *state;
+
+	/* the limit follows the amount of data a copy processes */
+	td->dev.budget.limit = TEST_COMP_LIMIT;
+	td->dev.period = 2 * TEST_PERIOD;
+	sa_budget_comp_period(&td->dev, TEST_PERIOD);
+	assert_int_equal(td->dev.budget.limit, 2 * TEST_COMP_LIMIT);
+
+	td->dev.period = TEST_PERIOD;
+	sa_budget_comp_period(&td->dev, 2 * TEST_PERIOD);
+	assert_int_equal(td->dev.budget.limit, TEST_COMP_LIMIT);
+
+	/* no limit stays no limit */
+	td->other.period = 2 * TEST_PERIOD;
+	sa_budget_comp_period(&td->other, TEST_PERIOD);
+	assert_int_equal(td->other.budget.limit, 0);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_lib_agent_budget_comp_limit,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_lib_agent_budget_pipe_limit,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_lib_agent_budget_offender,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_lib_agent_budget_comp_reset,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_lib_agent_budget_comp_init,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_lib_agent_budget_comp_period,
+						setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
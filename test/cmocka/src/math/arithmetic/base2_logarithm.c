@@ -61,10 +61,31 @@ static void test_math_arithmetic_base2log_fixed(void **state)
 	}
 }
 
+static void test_math_arithmetic_base2log_fixed_vec(void **state)
+{
+	(void)state;
+
+	int32_t y[100];
+	float diff;
+	int i;
+
+	base2_logarithm_vec(uv, y, ARRAY_SIZE(uv));
+	for (i = 0; i < ARRAY_SIZE(log2_lookup_table); i++) {
+		diff = fabs(log2_lookup_table[i] - (double)y[i] / (1 << 16));
+
+		if (diff > CMP_TOLERANCE) {
+			printf("%s: diff for %.16f: value = %.16f, log2 = %.16f\n", __func__, diff,
+			       (double)uv[i], (double)y[i] / (1 << 16));
+			assert_true(diff <= CMP_TOLERANCE);
+		}
+	}
+}
+
 int main(void)
 {
 	const struct CMUnitTest tests[] = {
-		cmocka_unit_test(test_math_arithmetic_base2log_fixed)
+		cmocka_unit_test(test_math_arithmetic_base2log_fixed),
+		cmocka_unit_test(test_math_arithmetic_base2log_fixed_vec)
 	};
 
 	cmocka_set_message_output(CM_OUTPUT_TAP);
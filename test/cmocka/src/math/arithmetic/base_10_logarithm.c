@@ -93,10 +93,31 @@ static void test_math_arithmetic_base10log_fixed(void **state)
 	}
 }
 
+static void test_math_arithmetic_base10log_fixed_vec(void **state)
+{
+	(void)state;
+
+	uint32_t y[100];
+	double diff;
+	int i;
+
+	log10_int32_vec(uv, y, ARRAY_SIZE(uv));
+	for (i = 0; i < ARRAY_SIZE(common_log10_ref_table); i++) {
+		diff = fabs(common_log10_ref_table[i] - (double)y[i] / (1 << 28));
+
+		if (diff > CMP_TOLERANCE) {
+			printf("%s: diff for %.16f: val = %16d, log10() = %.16f\n", __func__, diff,
+			       uv[i], (double)y[i] / (1 << 28));
+			assert_true(diff <= CMP_TOLERANCE);
+		}
+	}
+}
+
 int main(void)
 {
 	const struct CMUnitTest tests[] = {
-		cmocka_unit_test(test_math_arithmetic_base10log_fixed)
+		cmocka_unit_test(test_math_arithmetic_base10log_fixed),
+		cmocka_unit_test(test_math_arithmetic_base10log_fixed_vec)
 	};
 
 	cmocka_set_message_output(CM_OUTPUT_TAP);
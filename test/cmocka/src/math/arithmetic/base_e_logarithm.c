@@ -92,10 +92,31 @@ static void test_math_arithmetic_base_e_log_fixed(void **state)
 	}
 }
 
+static void test_math_arithmetic_base_e_log_fixed_vec(void **state)
+{
+	(void)state;
+
+	uint32_t y[100];
+	double diff;
+	int i;
+
+	ln_int32_vec(uv, y, ARRAY_SIZE(uv));
+	for (i = 0; i < ARRAY_SIZE(natural_log_lookup_table); i++) {
+		diff = fabs(natural_log_lookup_table[i] - (double)y[i] / (1 << 27));
+
+		if (diff > CMP_TOLERANCE) {
+			printf("%s: diff for %.16f: value = %16d, log() = %.16f\n", __func__, diff,
+			       uv[i], (double)y[i] / (1 << 27));
+			assert_true(diff <= CMP_TOLERANCE);
+		}
+	}
+}
+
 int main(void)
 {
 	const struct CMUnitTest tests[] = {
-		cmocka_unit_test(test_math_arithmetic_base_e_log_fixed)
+		cmocka_unit_test(test_math_arithmetic_base_e_log_fixed),
+		cmocka_unit_test(test_math_arithmetic_base_e_log_fixed_vec)
 	};
 
 	cmocka_set_message_output(CM_OUTPUT_TAP);
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <math.h>
+#include <cmocka.h>
+
+#include <sof/math/decibels.h>
+#include <sof/audio/format.h>
+#include <sof/common.h>
+
+/* 'Error[max] = 0.0000057299, exp() for -11.5 .. 7.6245' */
+#define EXP_CMP_TOLERANCE 0.0000060000
+
+/* 'Error[max] = 0.0000300377, 10^(dB/20) for -90 .. +66 dB' */
+#define DB2LIN_CMP_TOLERANCE 0.0000310000
+
+#define EXP_TEST_POINTS		1024
+#define EXP_TEST_MIN		-11.5
+#define EXP_TEST_MAX		7.6245
+#define DB2LIN_TEST_MIN		-90.0
+#define DB2LIN_TEST_MAX		66.0
+
+static void test_math_decibels_exp_fixed_vec(void **state)
+{
+	(void)state;
+
+	int32_t x[EXP_TEST_POINTS];
+	int32_t y[EXP_TEST_POINTS];
+	double step = (EXP_TEST_MAX - EXP_TEST_MIN) / (EXP_TEST_POINTS - 1);
+	double ref;
+	double diff;
+	int i;
+
+	for (i = 0; i < EXP_TEST_POINTS; i++)
+		x[i] = Q_CONVERT_FLOAT(EXP_TEST_MIN + i * step, EXP_FIXED_INPUT_QY);
+
+	exp_fixed_vec(x, y, EXP_TEST_POINTS);
+	for (i = 0; i < EXP_TEST_POINTS; i++) {
+		ref = exp((double)x[i] / (1 << EXP_FIXED_INPUT_QY));
+		diff = fabs(ref - (double)y[i] / (1 << EXP_FIXED_OUTPUT_QY));
+
+		if (diff > EXP_CMP_TOLERANCE) {
+			printf("%s: diff for %.16f: exp() = %.16f, exp_fixed_vec() = %.16f\n",
+			       __func__, diff, ref, (double)y[i] / (1 << EXP_FIXED_OUTPUT_QY));
+			assert_true(diff <= EXP_CMP_TOLERANCE);
+		}
+	}
+}
+
+static void test_math_decibels_db2lin_fixed_vec(void **state)
+{
+	(void)state;
+
+	int32_t x[EXP_TEST_POINTS];
+	double step = (DB2LIN_TEST_MAX - DB2LIN_TEST_MIN) / (EXP_TEST_POINTS - 1);
+	double ref;
+	double diff;
+	int i;
+
+	for (i = 0; i < EXP_TEST_POINTS; i++)
+		x[i] = Q_CONVERT_FLOAT(DB2LIN_TEST_MIN + i * step, DB2LIN_FIXED_INPUT_QY);
+
+	/* in place */
+	db2lin_fixed_vec(x, x, EXP_TEST_POINTS);
+	for (i = 0; i < EXP_TEST_POINTS; i++) {
+		ref = pow(10, (DB2LIN_TEST_MIN + i * step) / 20);
+		diff = fabs(ref - (double)x[i] / (1 << DB2LIN_FIXED_OUTPUT_QY));
+
+		if (diff > DB2LIN_CMP_TOLERANCE) {
+			printf("%s: diff for %.16f: 10^(dB/20) = %.16f, db2lin = %.16f\n",
+			       __func__, diff, ref, (double)x[i] / (1 << DB2LIN_FIXED_OUTPUT_QY));
+			assert_true(diff <= DB2LIN_CMP_TOLERANCE);
+		}
+	}
+}
+
+/* Out of range input saturates the same way as in the scalar functions */
+static void test_math_decibels_vec_range(void **state)
+{
+	(void)state;
+
+	int32_t x[] = {
+		INT32_MIN,
+		Q_CONVERT_FLOAT(-11.6, EXP_FIXED_INPUT_QY),
+		Q_CONVERT_FLOAT(7.7, EXP_FIXED_INPUT_QY),
+		INT32_MAX,
+	};
+	int32_t db[] = {
+		INT32_MIN,
+		Q_CONVERT_FLOAT(-100.1, DB2LIN_FIXED_INPUT_QY),
+		Q_CONVERT_FLOAT(0.0, DB2LIN_FIXED_INPUT_QY),
+		Q_CONVERT_FLOAT(66.3, DB2LIN_FIXED_INPUT_QY),
+	};
+	int32_t y[4];
+	int i;
+
+	exp_fixed_vec(x, y, ARRAY_SIZE(x));
+	for (i = 0; i < ARRAY_SIZE(x); i++)
+		assert_int_equal(y[i], exp_fixed(x[i]));
+
+	db2lin_fixed_vec(db, y, ARRAY_SIZE(db));
+	assert_int_equal(y[0], 0);
+	assert_int_equal(y[1], 0);
+	assert_int_equal(y[2], Q_CONVERT_FLOAT(1.0, DB2LIN_FIXED_OUTPUT_QY));
+	assert_int_equal(y[3], INT32_MAX);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_math_decibels_exp_fixed_vec),
+		cmocka_unit_test(test_math_decibels_db2lin_fixed_vec),
+		cmocka_unit_test(test_math_decibels_vec_range),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -150,10 +150,36 @@ static void test_math_arithmetic_sqrt_fixed(void **state)
 	}
 }
 
+static void test_math_arithmetic_sqrt_fixed_vec(void **state)
+{
+	(void)state;
+
+	uint16_t u[252];
+	int i;
+	double y;
+	double diff;
+
+	for (i = 0; i < ARRAY_SIZE(u); i++)
+		u[i] = (uint16_t)uv[i];
+
+	sqrt_int16_vec(u, u, ARRAY_SIZE(u));
+	for (i = 0; i < ARRAY_SIZE(sqrt_ref_table); i++) {
+		y = Q_CONVERT_QTOF(u[i], 12);
+		diff = fabs(sqrt_ref_table[i] - y);
+
+		if (diff > CMP_TOLERANCE) {
+			printf("%s: diff for %.16f: reftbl = %.16f, sqrt = %.16f\n", __func__,
+			       diff, (double)sqrt_ref_table[i], y);
+			assert_true(diff <= CMP_TOLERANCE);
+		}
+	}
+}
+
 int main(void)
 {
 	const struct CMUnitTest tests[] = {
-		cmocka_unit_test(test_math_arithmetic_sqrt_fixed)
+		cmocka_unit_test(test_math_arithmetic_sqrt_fixed),
+		cmocka_unit_test(test_math_arithmetic_sqrt_fixed_vec)
 	};
 
 	cmocka_set_message_output(CM_OUTPUT_TAP);
@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+#include <setjmp.h>
+#include <math.h>
+#include <cmocka.h>
+
+#include <sof/audio/format.h>
+#include <sof/common.h>
+#include <sof/math/fir_generic.h>
+#include <sof/math/fir_float.h>
+#include <sof/math/numbers.h>
+#include <user/fir.h>
+
+/* Max error measured is 1.7e-07 */
+#define CMP_TOLERANCE	0.0000003
+#define _M_PI		3.14159265358979323846	/* pi */
+#define FIR_SAMPLES	4800
+#define FIR_TAPS	48
+
+static void test_fir_float_parity(int out_shift)
+{
+	union {
+		struct sof_fir_coef_data hdr;
+		int16_t words[SOF_FIR_COEF_NHEADER + FIR_TAPS];
+	} config = { 0 };
+	struct fir_state_32x16 fir;
+	struct fir_state_float firf;
+	int32_t delay[FIR_TAPS + 4];
+	int32_t *delay_ptr = delay;
+	float data[3 * FIR_TAPS];
+	float *data_ptr = data;
+	static float x[FIR_SAMPLES];
+	static float y[FIR_SAMPLES];
+	int32_t x_fixed;
+	double diff;
+	double max_diff = 0;
+	double w;
+	double t;
+	int i;
+
+	/* Hamming windowed low-pass at 0.2 of sample rate. The coefficients
+	 * are scaled to compensate a left shift at output.
+	 */
+	config.hdr.length = FIR_TAPS;
+	config.hdr.out_shift = out_shift;
+	for (i = 0; i < FIR_TAPS; i++) {
+		t = i - (FIR_TAPS - 1) / 2.0;
+		w = 0.54 - 0.46 * cos(2 * _M_PI * i / (FIR_TAPS - 1));
+		config.words[SOF_FIR_COEF_NHEADER + i] =
+			Q_CONVERT_FLOAT(ldexp(w * sin(2 * _M_PI * 0.2 * t) / (_M_PI * t),
+					      out_shift), 15);
+	}
+
+	assert_int_equal(fir_delay_size(&config.hdr), sizeof(delay));
+	fir_init_coef(&fir, &config.hdr);
+	memset(delay, 0, sizeof(delay));
+	fir_init_delay(&fir, &delay_ptr);
+
+	assert_int_equal(fir_size_float(&fir), sizeof(data));
+	fir_init_float(&firf, &fir, &data_ptr);
+	assert_true(data_ptr == data + ARRAY_SIZE(data));
+
+	for (i = 0; i < FIR_SAMPLES; i++) {
+		x_fixed = Q_CONVERT_FLOAT(0.4 * sin(2 * _M_PI * 997 * i / 48000) +
+					  0.4 * sin(2 * _M_PI * 13001 * i / 48000), 31);
+		x[i] = ldexpf(x_fixed, -31);
+	}
+
+	fir_float(&firf, x, y, FIR_SAMPLES, 1);
+
+	for (i = 0; i < FIR_SAMPLES; i++) {
+		x_fixed = Q_CONVERT_FLOAT(x[i], 31);
+		diff = fabs(ldexp(fir_32x16(&fir, x_fixed), -31) - y[i]);
+		max_diff = MAX(max_diff, diff);
+	}
+
+	if (max_diff > CMP_TOLERANCE)
+		printf("%s: out_shift %d max diff = %.12f\n", __func__, out_shift, max_diff);
+
+	assert_true(max_diff <= CMP_TOLERANCE);
+}
+
+static void test_math_fir_float(void **state)
+{
+	(void)state;
+
+	test_fir_float_parity(0);
+}
+
+static void test_math_fir_float_shift(void **state)
+{
+	(void)state;
+
+	test_fir_float_parity(-2);
+}
+
+static void test_math_fir_float_bypass(void **state)
+{
+	(void)state;
+
+	struct fir_state_32x16 fir = { 0 };
+	struct fir_state_float firf;
+	float x[8] = {0.5f, 1.0f, -0.25f, 2.0f, 0.125f, 3.0f, -1.0f, 4.0f};
+	float y[8] = { 0 };
+	float *data_ptr = NULL;
+	int i;
+
+	/* A reset filter keeps its taps count but is in bypass */
+	fir.taps = FIR_TAPS;
+	fir_reset(&fir);
+	assert_int_equal(fir_size_float(&fir), 0);
+	fir_init_float(&firf, &fir, &data_ptr);
+	fir_float(&firf, x, y, 4, 2);
+	for (i = 0; i < 8; i++)
+		assert_true(y[i] == (i & 1 ? 0.0f : x[i]));
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_math_fir_float),
+		cmocka_unit_test(test_math_fir_float_shift),
+		cmocka_unit_test(test_math_fir_float_bypass),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
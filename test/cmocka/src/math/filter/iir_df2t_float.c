@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+#include <setjmp.h>
+#include <math.h>
+#include <cmocka.h>
+
+#include <sof/audio/format.h>
+#include <sof/common.h>
+#include <sof/math/numbers.h>
+#include <sof/math/iir_df2t.h>
+#include <sof/math/iir_df2t_float.h>
+#include <user/eq.h>
+
+/* Max error measured is 3.2e-05, the fixed point version is within 3.2e-07
+ * of a double precision reference so this is the single precision error
+ * of the low frequency sections, amplified by the output gain.
+ */
+#define CMP_TOLERANCE	0.00005
+#define _M_PI		3.14159265358979323846	/* pi */
+#define IIR_SAMPLES	4800
+#define IIR_BIQUADS	4
+
+/* Four biquads of the EQ IIR test blob, a2, a1, b2, b1, b0, shift, gain */
+static const int32_t iir_biquads[IIR_BIQUADS * SOF_EQ_IIR_NBIQUAD_DF2T] = {
+	0xc12c82bd, 0x7ed0b52e, 0x1fc7cc0c, 0xc07067e9, 0x1fc7cc0c, 0x00000000, 0x00004000,
+	0xcad0cdef, 0x742e8c5d, 0x0cdc9086, 0xe2f11723, 0x10b2f932, 0x00000000, 0x00004000,
+	0xcf45334a, 0x68260de9, 0x0a54e176, 0xe5d6cb75, 0x11fc1f3d, 0x00000000, 0x00004000,
+	0xf2940609, 0xe25f3930, 0x0d69ba64, 0x1ad374c8, 0x0d69ba64, 0xfffffffb, 0x000045bf,
+};
+
+static void test_iir_float_parity(int in_series)
+{
+	union {
+		struct sof_eq_iir_header_df2t hdr;
+		int32_t words[SOF_EQ_IIR_NHEADER_DF2T +
+			      IIR_BIQUADS * SOF_EQ_IIR_NBIQUAD_DF2T];
+	} config = { 0 };
+	struct iir_state_df2t iir;
+	struct iir_state_df2t_float iirf;
+	int64_t delay[2 * IIR_BIQUADS];
+	int64_t *delay_ptr = delay;
+	float data[IIR_BIQUADS * (IIR_DF2T_FLOAT_NCOEF + IIR_DF2T_NUM_DELAYS)];
+	float *data_ptr = data;
+	static float x[IIR_SAMPLES];
+	static float y[IIR_SAMPLES];
+	int32_t x_fixed;
+	double diff;
+	double max_diff = 0;
+	int i;
+
+	config.hdr.num_sections = IIR_BIQUADS;
+	config.hdr.num_sections_in_series = in_series;
+	for (i = 0; i < IIR_BIQUADS * SOF_EQ_IIR_NBIQUAD_DF2T; i++)
+		config.words[SOF_EQ_IIR_NHEADER_DF2T + i] = iir_biquads[i];
+
+	assert_int_equal(iir_init_coef_df2t(&iir, &config.hdr), 0);
+	memset(delay, 0, sizeof(delay));
+	iir_init_delay_df2t(&iir, &delay_ptr);
+
+	assert_int_equal(iir_size_df2t_float(&iir), sizeof(data));
+	iir_init_df2t_float(&iirf, &iir, &data_ptr);
+	assert_true(data_ptr == data + ARRAY_SIZE(data));
+
+	/* Two tones at -8 dBFS each, quantized so both get the same input */
+	for (i = 0; i < IIR_SAMPLES; i++) {
+		x_fixed = Q_CONVERT_FLOAT(0.2 * sin(2 * _M_PI * 997 * i / 48000) +
+					  0.2 * sin(2 * _M_PI * 9001 * i / 48000), 31);
+		x[i] = ldexpf(x_fixed, -31);
+	}
+
+	iir_df2t_float(&iirf, x, y, IIR_SAMPLES, 1);
+
+	for (i = 0; i < IIR_SAMPLES; i++) {
+		x_fixed = Q_CONVERT_FLOAT(x[i], 31);
+		diff = fabs(ldexp(iir_df2t(&iir, x_fixed), -31) - y[i]);
+		max_diff = MAX(max_diff, diff);
+	}
+
+	if (max_diff > CMP_TOLERANCE)
+		printf("%s: in_series %d max diff = %.12f\n", __func__, in_series, max_diff);
+
+	assert_true(max_diff <= CMP_TOLERANCE);
+}
+
+static void test_math_iir_df2t_float_series(void **state)
+{
+	(void)state;
+
+	test_iir_float_parity(IIR_BIQUADS);
+}
+
+static void test_math_iir_df2t_float_parallel(void **state)
+{
+	(void)state;
+
+	test_iir_float_parity(IIR_BIQUADS / 2);
+}
+
+static void test_math_iir_df2t_float_stride(void **state)
+{
+	(void)state;
+
+	struct iir_state_df2t iir;
+	struct iir_state_df2t_float iirf;
+	float x[8] = {0.5f, 1.0f, -0.25f, 2.0f, 0.125f, 3.0f, -1.0f, 4.0f};
+	float y[8] = { 0 };
+	float *data_ptr = NULL;
+	int i;
+
+	/* Bypass with zero biquads copies every other sample */
+	iir_reset_df2t(&iir);
+	assert_int_equal(iir_size_df2t_float(&iir), 0);
+	iir_init_df2t_float(&iirf, &iir, &data_ptr);
+	iir_df2t_float(&iirf, x, y, 4, 2);
+	for (i = 0; i < 8; i++)
+		assert_true(y[i] == (i & 1 ? 0.0f : x[i]));
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_math_iir_df2t_float_series),
+		cmocka_unit_test(test_math_iir_df2t_float_parallel),
+		cmocka_unit_test(test_math_iir_df2t_float_stride),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+#include <setjmp.h>
+#include <math.h>
+#include <cmocka.h>
+
+#include <sof/audio/format.h>
+#include <sof/common.h>
+#include <sof/math/iir_df2t.h>
+#include <user/eq.h>
+
+#define _M_PI		3.14159265358979323846	/* pi */
+#define IIR_FRAMES	960
+#define IIR_BIQUADS	4
+#define IIR_LANES	5
+
+/* Four biquads of the EQ IIR test blob, a2, a1, b2, b1, b0, shift, gain */
+static const int32_t iir_biquads[IIR_BIQUADS * SOF_EQ_IIR_NBIQUAD_DF2T] = {
+	0xc12c82bd, 0x7ed0b52e, 0x1fc7cc0c, 0xc07067e9, 0x1fc7cc0c, 0x00000000, 0x00004000,
+	0xcad0cdef, 0x742e8c5d, 0x0cdc9086, 0xe2f11723, 0x10b2f932, 0x00000000, 0x00004000,
+	0xcf45334a, 0x68260de9, 0x0a54e176, 0xe5d6cb75, 0x11fc1f3d, 0x00000000, 0x00004000,
+	0xf2940609, 0xe25f3930, 0x0d69ba64, 0x1ad374c8, 0x0d69ba64, 0xfffffffb, 0x000045bf,
+};
+
+/* every lane must match the stream filtered alone by iir_df2t() */
+static void test_iir_lanes_parity(int in_series)
+{
+	union {
+		struct sof_eq_iir_header_df2t hdr;
+		int32_t words[SOF_EQ_IIR_NHEADER_DF2T +
+			      IIR_BIQUADS * SOF_EQ_IIR_NBIQUAD_DF2T];
+	} config = { 0 };
+	struct iir_state_df2t iir[IIR_LANES];
+	static int64_t delay[IIR_LANES][2 * IIR_BIQUADS];
+	static int64_t lanes_delay[2 * IIR_BIQUADS * IIR_LANES];
+	static int32_t data[IIR_FRAMES * IIR_LANES];
+	int64_t *delay_ptr;
+	int32_t ref;
+	int half = IIR_FRAMES / 2;
+	int i;
+	int l;
+
+	config.hdr.num_sections = IIR_BIQUADS;
+	config.hdr.num_sections_in_series = in_series;
+	for (i = 0; i < IIR_BIQUADS * SOF_EQ_IIR_NBIQUAD_DF2T; i++)
+		config.words[SOF_EQ_IIR_NHEADER_DF2T + i] = iir_biquads[i];
+
+	memset(delay, 0, sizeof(delay));
+	memset(lanes_delay, 0, sizeof(lanes_delay));
+	for (l = 0; l < IIR_LANES; l++) {
+		delay_ptr = delay[l];
+		assert_int_equal(iir_init_coef_df2t(&iir[l], &config.hdr), 0);
+		iir_init_delay_df2t(&iir[l], &delay_ptr);
+	}
+
+	/* a different tone in every lane, the last one clips */
+	for (i = 0; i < IIR_FRAMES; i++)
+		for (l = 0; l < IIR_LANES; l++)
+			data[i * IIR_LANES + l] =
+				Q_CONVERT_FLOAT((l == IIR_LANES - 1 ? 0.999 : 0.3) *
+						sin(2 * _M_PI * (101 + 997 * l) * i / 48000), 31);
+
+	/* two blocks, the delays carry the state from one to the next */
+	iir_df2t_lanes(&iir[0], lanes_delay, data, half, IIR_LANES);
+	iir_df2t_lanes(&iir[0], lanes_delay, data + half * IIR_LANES, IIR_FRAMES - half,
+		       IIR_LANES);
+
+	for (i = 0; i < IIR_FRAMES; i++) {
+		for (l = 0; l < IIR_LANES; l++) {
+			ref = iir_df2t(&iir[l],
+				       Q_CONVERT_FLOAT((l == IIR_LANES - 1 ? 0.999 : 0.3) *
+						       sin(2 * _M_PI * (101 + 997 * l) * i / 48000),
+						       31));
+			assert_int_equal(data[i * IIR_LANES + l], ref);
+		}
+	}
+
+	for (i = 0; i < 2 * IIR_BIQUADS; i++)
+		for (l = 0; l < IIR_LANES; l++)
+			assert_true(lanes_delay[i * IIR_LANES + l] == delay[l][i]);
+}
+
+static void test_math_iir_df2t_lanes_series(void **state)
+{
+	(void)state;
+
+	test_iir_lanes_parity(IIR_BIQUADS);
+}
+
+static void test_math_iir_df2t_lanes_parallel(void **state)
+{
+	(void)state;
+
+	test_iir_lanes_parity(IIR_BIQUADS / 2);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_math_iir_df2t_lanes_series),
+		cmocka_unit_test(test_math_iir_df2t_lanes_parallel),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <math.h>
+#include <cmocka.h>
+
+#include <sof/audio/format.h>
+#include <sof/math/oscillator.h>
+
+/* Max error measured is 1.18e-09, i.e. 2.5 LSB of Q1.31 */
+#define CMP_TOLERANCE	0.0000000015
+#define _M_PI		3.14159265358979323846	/* pi */
+#define OSC_FS		48000
+#define OSC_FRAMES	480
+#define OSC_NUM		3
+
+static double osc_phase_rad(uint32_t phase)
+{
+	return 2 * _M_PI * phase / 4294967296.0;
+}
+
+static void test_math_osc_sin_fixed(void **state)
+{
+	(void)state;
+
+	uint64_t phase;
+	double diff;
+
+	for (phase = 0; phase < (1ULL << 32); phase += 65537) {
+		diff = fabs((double)osc_sin_fixed(phase) / 2147483648.0 -
+			    sin(osc_phase_rad(phase)));
+		if (diff > CMP_TOLERANCE) {
+			printf("%s: diff for phase %u = %.12f\n", __func__,
+			       (uint32_t)phase, diff);
+		}
+
+		assert_true(diff <= CMP_TOLERANCE);
+
+		diff = fabs((double)osc_cos_fixed(phase) / 2147483648.0 -
+			    cos(osc_phase_rad(phase)));
+		if (diff > CMP_TOLERANCE) {
+			printf("%s: cos diff for phase %u = %.12f\n", __func__,
+			       (uint32_t)phase, diff);
+		}
+
+		assert_true(diff <= CMP_TOLERANCE);
+	}
+}
+
+static void test_math_osc_bank_sin(void **state)
+{
+	(void)state;
+
+	const double freq[OSC_NUM] = {997.0, 5000.0, 23999.0};
+	struct osc_state osc[OSC_NUM];
+	int32_t y[OSC_FRAMES * OSC_NUM];
+	double ref;
+	double diff;
+	double f;
+	int ch;
+	int i;
+
+	for (ch = 0; ch < OSC_NUM; ch++)
+		osc_init(&osc[ch], Q_CONVERT_FLOAT(freq[ch], 16), OSC_FS,
+			 Q_CONVERT_FLOAT(0.5, 31));
+
+	osc_bank_sin(osc, OSC_NUM, y, OSC_FRAMES);
+
+	for (ch = 0; ch < OSC_NUM; ch++) {
+		/* frequency as set, quantized to the Q0.32 phase step */
+		f = (double)osc[ch].step * OSC_FS / 4294967296.0;
+		for (i = 0; i < OSC_FRAMES; i++) {
+			ref = 0.5 * sin(2 * _M_PI * f * i / OSC_FS);
+			diff = fabs((double)y[i * OSC_NUM + ch] / 2147483648.0 - ref);
+			if (diff > CMP_TOLERANCE) {
+				printf("%s: diff for ch %d sample %d = %.12f\n",
+				       __func__, ch, i, diff);
+			}
+
+			assert_true(diff <= CMP_TOLERANCE);
+		}
+	}
+}
+
+static void test_math_osc_bank_sum(void **state)
+{
+	(void)state;
+
+	struct osc_state osc[2];
+	int32_t y[OSC_FRAMES];
+	int i;
+
+	/* two full scale tones in phase saturate instead of wrapping */
+	osc_init(&osc[0], Q_CONVERT_FLOAT(1000.0, 16), OSC_FS, INT32_MAX);
+	osc_init(&osc[1], Q_CONVERT_FLOAT(1000.0, 16), OSC_FS, INT32_MAX);
+	osc_bank_sum(osc, 2, y, 1, OSC_FRAMES);
+
+	/* 12 samples is a quarter period, i.e. the peak */
+	assert_int_equal(y[12], INT32_MAX);
+	assert_int_equal(y[36], INT32_MIN);
+	for (i = 0; i < 12; i++)
+		assert_true(y[i + 1] >= y[i]);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_math_osc_sin_fixed),
+		cmocka_unit_test(test_math_osc_bank_sin),
+		cmocka_unit_test(test_math_osc_bank_sum),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -65,6 +65,8 @@ uint32_t stream_cmd_types[] = {SOF_IPC_STREAM_PCM_PARAMS,
 			       SOF_IPC_STREAM_TRIG_DRAIN,
 			       SOF_IPC_STREAM_TRIG_XRUN,
 			       SOF_IPC_STREAM_POSITION,
+			       SOF_IPC_STREAM_PCM_PERIOD,
+			       SOF_IPC_STREAM_LATENCY,
 			       SOF_IPC_STREAM_VORBIS_PARAMS,
 			       SOF_IPC_STREAM_VORBIS_FREE};
 
@@ -0,0 +1,303 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+/*
+ * Persistent mode support shared by the IPC fuzz targets.
+ *
+ * Firmware is initialised once, then the library heap is snapshotted. After
+ * every input the heap is rolled back to that snapshot, which is much
+ * cheaper than tearing the topology down through IPC or initialising
+ * everything again, and also works for inputs leaving firmware in a state
+ * no IPC sequence can clean up.
+ *
+ * The static library has no host or DAI drivers, so simple endpoint
+ * components are registered for SOF_COMP_HOST and SOF_COMP_DAI. They
+ * produce silence or drop data, which lets pipelines complete, accept
+ * params and move data so the fuzzer reaches the pipeline code.
+ */
+
+#include <sof/audio/buffer.h>
+#include <sof/audio/component.h>
+#include <sof/audio/component_ext.h>
+#include <sof/audio/pipeline.h>
+#include <sof/ipc/common.h>
+#include <sof/ipc/driver.h>
+#include <sof/ipc/topology.h>
+#include <sof/lib/alloc.h>
+#include <sof/lib/dai.h>
+#include <sof/lib/mailbox.h>
+#include <sof/lib/mm_heap.h>
+#include <sof/lib/notifier.h>
+#include <sof/lib/uuid.h>
+#include <sof/math/numbers.h>
+#include <sof/schedule/task.h>
+#include <ipc/header.h>
+#include <ipc/topology.h>
+#include <stdint.h>
+#include <string.h>
+#include "fuzz_ipc_common.h"
+
+/* 036264c7-e52b-4d8a-9d1b-92a26463ef88 */
+DECLARE_SOF_RT_UUID("fuzz-endpoint", fuzz_ep_uuid, 0x036264c7, 0xe52b, 0x4d8a,
+		    0x9d, 0x1b, 0x92, 0xa2, 0x64, 0x63, 0xef, 0x88);
+DECLARE_TR_CTX(fuzz_ep_tr, SOF_UUID(fuzz_ep_uuid), LOG_LEVEL_INFO);
+
+struct fuzz_ep_data {
+	uint32_t rate;
+	uint32_t channels;
+	uint32_t frame_fmt;
+};
+
+static struct comp_dev *fuzz_ep_new(const struct comp_driver *drv,
+				    struct comp_ipc_config *config,
+				    void *spec)
+{
+	struct ipc_comp_file *ipc_file = spec;
+	struct fuzz_ep_data *ep;
+	struct comp_dev *dev;
+	struct dai_data *dd;
+	struct dai *dai;
+
+	dev = comp_alloc(drv, sizeof(*dev));
+	if (!dev)
+		return NULL;
+	dev->ipc_config = *config;
+
+	/* DAI endpoints are expected to carry dai_data */
+	dd = rzalloc(SOF_MEM_ZONE_RUNTIME_SHARED, 0, SOF_MEM_CAPS_RAM, sizeof(*dd));
+	dai = rzalloc(SOF_MEM_ZONE_RUNTIME_SHARED, 0, SOF_MEM_CAPS_RAM, sizeof(*dai));
+	ep = rzalloc(SOF_MEM_ZONE_RUNTIME_SHARED, 0, SOF_MEM_CAPS_RAM, sizeof(*ep));
+	if (!dd || !dai || !ep)
+		goto err;
+
+	dai->drv = rzalloc(SOF_MEM_ZONE_RUNTIME_SHARED, 0, SOF_MEM_CAPS_RAM,
+			   sizeof(*dai->drv));
+	if (!dai->drv)
+		goto err;
+
+	ep->rate = ipc_file->rate;
+	ep->channels = ipc_file->channels;
+	ep->frame_fmt = ipc_file->frame_fmt;
+	dev->direction = ipc_file->direction & 1;
+
+	dd->dai = dai;
+	comp_set_drvdata(dev, dd);
+	dai_set_drvdata(dai, ep);
+
+	dev->state = COMP_STATE_READY;
+	return dev;
+
+err:
+	if (dai)
+		rfree((void *)dai->drv);
+	rfree(ep);
+	rfree(dai);
+	rfree(dd);
+	rfree(dev);
+	return NULL;
+}
+
+static void fuzz_ep_free(struct comp_dev *dev)
+{
+	struct dai_data *dd = comp_get_drvdata(dev);
+
+	rfree(dai_get_drvdata(dd->dai));
+	rfree((void *)dd->dai->drv);
+	rfree(dd->dai);
+	rfree(dd);
+	rfree(dev);
+}
+
+static int fuzz_ep_params(struct comp_dev *dev, struct sof_ipc_stream_params *params)
+{
+	struct comp_buffer *buffer;
+	uint32_t periods;
+	int ret;
+
+	ret = comp_verify_params(dev, 0, params);
+	if (ret < 0)
+		return ret;
+
+	if (!list_is_empty(&dev->bsink_list)) {
+		buffer = list_first_item(&dev->bsink_list, struct comp_buffer, source_list);
+		periods = dev->ipc_config.periods_sink;
+	} else if (!list_is_empty(&dev->bsource_list)) {
+		buffer = list_first_item(&dev->bsource_list, struct comp_buffer, sink_list);
+		periods = dev->ipc_config.periods_source;
+	} else {
+		return -EINVAL;
+	}
+
+	return buffer_set_size(buffer, MAX(periods, 1) * dev->frames *
+			       audio_stream_frame_bytes(&buffer->stream));
+}
+
+static int fuzz_ep_trigger(struct comp_dev *dev, int cmd)
+{
+	return comp_set_state(dev, cmd);
+}
+
+static int fuzz_ep_prepare(struct comp_dev *dev)
+{
+	int ret;
+
+	ret = comp_set_state(dev, COMP_TRIGGER_PREPARE);
+	if (ret < 0)
+		return ret;
+
+	if (ret == COMP_STATUS_STATE_ALREADY_SET)
+		return PPL_STATUS_PATH_STOP;
+
+	return 0;
+}
+
+static int fuzz_ep_reset(struct comp_dev *dev)
+{
+	comp_set_state(dev, COMP_TRIGGER_RESET);
+	return 0;
+}
+
+static int fuzz_ep_copy(struct comp_dev *dev)
+{
+	struct comp_buffer *buffer;
+	uint32_t bytes;
+
+	/* source endpoint: produce a period of silence */
+	if (!list_is_empty(&dev->bsink_list)) {
+		buffer = list_first_item(&dev->bsink_list, struct comp_buffer, source_list);
+		bytes = MIN(audio_stream_get_free_frames(&buffer->stream), dev->frames) *
+			audio_stream_frame_bytes(&buffer->stream);
+		if (bytes && !audio_stream_set_zero(&buffer->stream, bytes))
+			comp_update_buffer_produce(buffer, bytes);
+	}
+
+	/* sink endpoint: drop whatever is available */
+	if (!list_is_empty(&dev->bsource_list)) {
+		buffer = list_first_item(&dev->bsource_list, struct comp_buffer, sink_list);
+		bytes = audio_stream_get_avail_bytes(&buffer->stream);
+		if (bytes)
+			comp_update_buffer_consume(buffer, bytes);
+	}
+
+	return 0;
+}
+
+static int fuzz_ep_get_hw_params(struct comp_dev *dev,
+				 struct sof_ipc_stream_params *params, int dir)
+{
+	struct dai_data *dd = comp_get_drvdata(dev);
+	struct fuzz_ep_data *ep = dai_get_drvdata(dd->dai);
+
+	params->direction = dir;
+	params->rate = ep->rate;
+	params->channels = ep->channels;
+	params->buffer_fmt = 0;
+	params->frame_fmt = ep->frame_fmt;
+	return 0;
+}
+
+static const struct comp_driver comp_fuzz_host = {
+	.type = SOF_COMP_HOST,
+	.uid = SOF_RT_UUID(fuzz_ep_uuid),
+	.tctx = &fuzz_ep_tr,
+	.ops = {
+		.create = fuzz_ep_new,
+		.free = fuzz_ep_free,
+		.params = fuzz_ep_params,
+		.trigger = fuzz_ep_trigger,
+		.copy = fuzz_ep_copy,
+		.prepare = fuzz_ep_prepare,
+		.reset = fuzz_ep_reset,
+	},
+};
+
+static const struct comp_driver comp_fuzz_dai = {
+	.type = SOF_COMP_DAI,
+	.uid = SOF_RT_UUID(fuzz_ep_uuid),
+	.tctx = &fuzz_ep_tr,
+	.ops = {
+		.create = fuzz_ep_new,
+		.free = fuzz_ep_free,
+		.params = fuzz_ep_params,
+		.trigger = fuzz_ep_trigger,
+		.copy = fuzz_ep_copy,
+		.prepare = fuzz_ep_prepare,
+		.reset = fuzz_ep_reset,
+		.dai_get_hw_params = fuzz_ep_get_hw_params,
+	},
+};
+
+static struct comp_driver_info comp_fuzz_host_info = {
+	.drv = &comp_fuzz_host,
+};
+
+static struct comp_driver_info comp_fuzz_dai_info = {
+	.drv = &comp_fuzz_dai,
+};
+
+int fuzz_ipc_init(void)
+{
+	/* every allocation from now on is covered by the snapshot */
+	heap_snapshot_enable();
+
+	init_system_notify(sof_get());
+
+	trace_init(sof_get());
+
+	platform_init(sof_get());
+
+	/* init components */
+	sys_comp_init(sof_get());
+	comp_register(&comp_fuzz_host_info);
+	comp_register(&comp_fuzz_dai_info);
+
+	/* other necessary initializations, todo: follow better SOF init */
+	pipeline_posn_init(sof_get());
+
+	heap_snapshot_take();
+
+	return 0;
+}
+
+void fuzz_ipc_reset(void)
+{
+	heap_snapshot_restore();
+}
+
+int fuzz_ipc_send(const void *msg, size_t size)
+{
+	struct sof_ipc_cmd_hdr *hdr = ipc_get()->comp_data;
+	struct sof_ipc_reply reply;
+
+	/* commands read their payload from comp_data, like after mailbox_validate() */
+	memset(hdr, 0, SOF_IPC_MSG_MAX_SIZE);
+	memcpy_s(hdr, SOF_IPC_MSG_MAX_SIZE, msg, MIN(size, SOF_IPC_MSG_MAX_SIZE));
+
+	/* sanity check performed typically by platform dependent code */
+	if (hdr->size < sizeof(*hdr) || hdr->size > SOF_IPC_MSG_MAX_SIZE)
+		return -EINVAL;
+
+	ipc_cmd(ipc_to_hdr(hdr));
+
+	mailbox_hostbox_read(&reply, sizeof(reply), 0, sizeof(reply));
+
+	return reply.error;
+}
+
+void fuzz_ipc_run_pipeline(uint32_t comp_id, unsigned int count)
+{
+	struct ipc_comp_dev *icd = ipc_get_comp_by_id(ipc_get(), comp_id);
+	struct pipeline *p;
+
+	if (!icd || icd->type != COMP_TYPE_PIPELINE)
+		return;
+
+	p = icd->pipeline;
+
+	/* only run tasks, which the LL scheduler would be running now */
+	while (count-- && p->pipe_task &&
+	       (p->trigger.cmd != COMP_TRIGGER_NO_ACTION || p->status == COMP_STATE_ACTIVE))
+		if (task_run(p->pipe_task) != SOF_TASK_STATE_RESCHEDULE)
+			break;
+}
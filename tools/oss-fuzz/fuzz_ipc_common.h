@@ -0,0 +1,31 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2022 Intel Corporation. All rights reserved.
+ */
+
+#ifndef __FUZZ_IPC_COMMON_H__
+#define __FUZZ_IPC_COMMON_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* libFuzzer interface */
+int LLVMFuzzerTestOneInput(const uint8_t *Data, size_t Size);
+int LLVMFuzzerInitialize(int *argc, char ***argv);
+size_t LLVMFuzzerMutate(uint8_t *Data, size_t Size, size_t MaxSize);
+size_t LLVMFuzzerCustomMutator(uint8_t *Data, size_t Size, size_t MaxSize,
+			       unsigned int Seed);
+
+/* init firmware once and take the heap snapshot every input starts from */
+int fuzz_ipc_init(void);
+
+/* roll firmware state back to the snapshot taken by fuzz_ipc_init() */
+void fuzz_ipc_reset(void);
+
+/* deliver one IPC through the host mailbox path, returns reply error code */
+int fuzz_ipc_send(const void *msg, size_t size);
+
+/* run the pipeline task of pipeline comp_id as the LL scheduler would */
+void fuzz_ipc_run_pipeline(uint32_t comp_id, unsigned int count);
+
+#endif /* __FUZZ_IPC_COMMON_H__ */
@@ -0,0 +1,317 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+/*
+ * Structure aware IPC sequence fuzzer.
+ *
+ * Raw IPC bytes hardly ever make it past the first sanity checks, let alone
+ * build a topology the stream commands could work on. Here each input is a
+ * list of fixed size records, every record is turned into a well formed
+ * IPC3 message addressing a small set of object ids, so that consecutive
+ * messages refer to each other. Values, which are not essential for the
+ * message to be accepted, are still taken from the input.
+ *
+ * The custom mutator works on whole records, so the fuzzer can reorder,
+ * drop and repeat commands, and it seeds inputs with a complete playback
+ * sequence to get to the streaming states early.
+ */
+
+#include <sof/common.h>
+#include <sof/compiler_attributes.h>
+#include <sof/math/numbers.h>
+#include <sof/string.h>
+#include <ipc/header.h>
+#include <ipc/stream.h>
+#include <ipc/topology.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fuzz_ipc_common.h"
+
+#define FUZZ_OBJ_IDS		16
+#define FUZZ_PIPE_IDS		4
+#define FUZZ_MAX_RUNS		16
+
+enum fuzz_op_type {
+	FUZZ_OP_PIPE_NEW,
+	FUZZ_OP_COMP_NEW,
+	FUZZ_OP_BUFFER_NEW,
+	FUZZ_OP_CONNECT,
+	FUZZ_OP_PIPE_COMPLETE,
+	FUZZ_OP_PCM_PARAMS,
+	FUZZ_OP_TRIGGER,
+	FUZZ_OP_PCM_FREE,
+	FUZZ_OP_COMP_FREE,
+	FUZZ_OP_BUFFER_FREE,
+	FUZZ_OP_PIPE_FREE,
+	FUZZ_OP_RUN,
+	FUZZ_OP_COUNT,
+};
+
+/* one input record, a is always an object id */
+struct fuzz_op {
+	uint8_t op;
+	uint8_t a;
+	uint8_t b;
+	uint8_t c;
+	uint32_t x;
+	uint32_t y;
+	uint32_t z;
+} __packed;
+
+static const uint32_t fuzz_rates[] = {
+	8000, 16000, 44100, 48000, 96000, 192000, 0, 0xffffffff,
+};
+
+static const uint32_t fuzz_comp_types[] = {
+	SOF_COMP_HOST, SOF_COMP_DAI, SOF_COMP_SG_HOST, SOF_COMP_SG_DAI,
+	SOF_COMP_VOLUME, SOF_COMP_MIXER, SOF_COMP_MUX, SOF_COMP_SRC,
+	SOF_COMP_TONE, SOF_COMP_EQ_IIR, SOF_COMP_EQ_FIR, SOF_COMP_KPB,
+	SOF_COMP_SELECTOR, SOF_COMP_DEMUX, SOF_COMP_DCBLOCK, SOF_COMP_NONE,
+};
+
+static const uint32_t fuzz_triggers[] = {
+	SOF_IPC_STREAM_TRIG_START, SOF_IPC_STREAM_TRIG_STOP,
+	SOF_IPC_STREAM_TRIG_PAUSE, SOF_IPC_STREAM_TRIG_RELEASE,
+	SOF_IPC_STREAM_TRIG_DRAIN, SOF_IPC_STREAM_TRIG_XRUN,
+};
+
+/* host -> buffer -> dai playback pipeline driven by the dai */
+static const struct fuzz_op fuzz_playback[] = {
+	{ FUZZ_OP_PIPE_NEW, 0, 0, 0, 0, 0, 0 },
+	{ FUZZ_OP_COMP_NEW, 1, 0, 0, 3, 1, 0 },
+	{ FUZZ_OP_BUFFER_NEW, 2, 0, 0, 0, 3072, 0 },
+	{ FUZZ_OP_COMP_NEW, 3, 0, 1, 3, 1, 0 },
+	{ FUZZ_OP_CONNECT, 1, 2, 0, 0, 0, 0 },
+	{ FUZZ_OP_CONNECT, 2, 3, 0, 0, 0, 0 },
+	{ FUZZ_OP_PIPE_COMPLETE, 0, 0, 0, 0, 0, 0 },
+	{ FUZZ_OP_PCM_PARAMS, 1, 0, 0, 3, 1, 0 },
+	{ FUZZ_OP_TRIGGER, 1, 0, 0, 0, 0, 0 },
+	{ FUZZ_OP_RUN, 0, 4, 0, 0, 0, 0 },
+	{ FUZZ_OP_TRIGGER, 1, 1, 0, 0, 0, 0 },
+	{ FUZZ_OP_PCM_FREE, 1, 0, 0, 0, 0, 0 },
+};
+
+#define FUZZ_ID(v)	((v) % FUZZ_OBJ_IDS)
+#define FUZZ_PICK(t, v)	((t)[(v) % ARRAY_SIZE(t)])
+
+union fuzz_msg {
+	struct sof_ipc_cmd_hdr hdr;
+	struct sof_ipc_pipe_new pipe;
+	struct sof_ipc_pipe_ready ready;
+	struct sof_ipc_comp_file file;
+	struct sof_ipc_buffer buffer;
+	struct sof_ipc_pipe_comp_connect connect;
+	struct sof_ipc_pcm_params pcm;
+	struct sof_ipc_stream stream;
+	struct sof_ipc_free free;
+	uint8_t raw[SOF_IPC_MSG_MAX_SIZE];
+};
+
+static void fuzz_hdr(struct sof_ipc_cmd_hdr *hdr, uint32_t cmd, size_t size)
+{
+	hdr->cmd = cmd;
+	hdr->size = size;
+}
+
+static void fuzz_comp_new(union fuzz_msg *msg, const struct fuzz_op *op)
+{
+	struct sof_ipc_comp_file *file = &msg->file;
+
+	/* file endpoint layout is the largest common one, so use it for all */
+	fuzz_hdr(&file->comp.hdr, SOF_IPC_GLB_TPLG_MSG | SOF_IPC_TPLG_COMP_NEW,
+		 sizeof(*file));
+	file->comp.id = FUZZ_ID(op->a);
+	file->comp.pipeline_id = op->b % FUZZ_PIPE_IDS;
+	file->comp.type = FUZZ_PICK(fuzz_comp_types, op->c);
+	file->config.hdr.size = sizeof(file->config);
+	file->config.periods_sink = (op->z & 0x3) + 1;
+	file->config.periods_source = ((op->z >> 2) & 0x3) + 1;
+	file->config.frame_fmt = op->y >> 16;
+	file->rate = FUZZ_PICK(fuzz_rates, op->x);
+	file->channels = (op->y & 0xffff) % (SOF_IPC_MAX_CHANNELS + 1);
+	file->frame_fmt = op->y >> 16;
+	file->direction = (op->z >> 4) & 1;
+}
+
+static void fuzz_pcm_params(union fuzz_msg *msg, const struct fuzz_op *op)
+{
+	struct sof_ipc_pcm_params *pcm = &msg->pcm;
+	uint32_t frame_fmt = op->y >> 16;
+
+	fuzz_hdr(&pcm->hdr, SOF_IPC_GLB_STREAM_MSG | SOF_IPC_STREAM_PCM_PARAMS,
+		 sizeof(*pcm));
+	pcm->comp_id = FUZZ_ID(op->a);
+	pcm->params.hdr.size = sizeof(pcm->params);
+	pcm->params.direction = op->b & 1;
+	pcm->params.frame_fmt = frame_fmt;
+	pcm->params.rate = FUZZ_PICK(fuzz_rates, op->x);
+	pcm->params.channels = (op->y & 0xffff) % (SOF_IPC_MAX_CHANNELS + 1);
+	pcm->params.sample_container_bytes = frame_fmt == SOF_IPC_FRAME_S16_LE ? 2 : 4;
+	pcm->params.sample_valid_bytes = frame_fmt == SOF_IPC_FRAME_S16_LE ? 2 :
+					 frame_fmt == SOF_IPC_FRAME_S24_4LE ? 3 : 4;
+	pcm->params.host_period_bytes = op->z & 0xffff;
+	pcm->params.stream_tag = op->c;
+}
+
+/* returns false for records, which don't map to an IPC */
+static bool fuzz_build(union fuzz_msg *msg, const struct fuzz_op *op)
+{
+	memset(msg, 0, sizeof(*msg));
+
+	switch (op->op % FUZZ_OP_COUNT) {
+	case FUZZ_OP_PIPE_NEW:
+		fuzz_hdr(&msg->hdr, SOF_IPC_GLB_TPLG_MSG | SOF_IPC_TPLG_PIPE_NEW,
+			 sizeof(msg->pipe));
+		msg->pipe.comp_id = FUZZ_ID(op->a);
+		msg->pipe.pipeline_id = op->b % FUZZ_PIPE_IDS;
+		/* default to the dai of the canned playback sequence */
+		msg->pipe.sched_id = op->c ? FUZZ_ID(op->c) : 3;
+		msg->pipe.period = op->x ? op->x & 0xffff : 1000;
+		msg->pipe.priority = op->y % 11;
+		msg->pipe.frames_per_sched = op->z & 0xfff;
+		msg->pipe.time_domain = op->b >> 7 ? SOF_TIME_DOMAIN_TIMER :
+						     SOF_TIME_DOMAIN_DMA;
+		return true;
+	case FUZZ_OP_COMP_NEW:
+		fuzz_comp_new(msg, op);
+		return true;
+	case FUZZ_OP_BUFFER_NEW:
+		fuzz_hdr(&msg->hdr, SOF_IPC_GLB_TPLG_MSG | SOF_IPC_TPLG_BUFFER_NEW,
+			 sizeof(msg->buffer));
+		msg->buffer.comp.id = FUZZ_ID(op->a);
+		msg->buffer.comp.pipeline_id = op->b % FUZZ_PIPE_IDS;
+		msg->buffer.comp.type = SOF_COMP_BUFFER;
+		msg->buffer.size = op->y & 0xffff;
+		msg->buffer.caps = op->c ? op->x : SOF_MEM_CAPS_RAM;
+		msg->buffer.flags = op->z;
+		return true;
+	case FUZZ_OP_CONNECT:
+		fuzz_hdr(&msg->hdr, SOF_IPC_GLB_TPLG_MSG | SOF_IPC_TPLG_COMP_CONNECT,
+			 sizeof(msg->connect));
+		msg->connect.source_id = FUZZ_ID(op->a);
+		msg->connect.sink_id = FUZZ_ID(op->b);
+		return true;
+	case FUZZ_OP_PIPE_COMPLETE:
+		fuzz_hdr(&msg->hdr, SOF_IPC_GLB_TPLG_MSG | SOF_IPC_TPLG_PIPE_COMPLETE,
+			 sizeof(msg->ready));
+		msg->ready.comp_id = FUZZ_ID(op->a);
+		return true;
+	case FUZZ_OP_PCM_PARAMS:
+		fuzz_pcm_params(msg, op);
+		return true;
+	case FUZZ_OP_TRIGGER:
+		fuzz_hdr(&msg->hdr, SOF_IPC_GLB_STREAM_MSG | FUZZ_PICK(fuzz_triggers, op->b),
+			 sizeof(msg->stream));
+		msg->stream.comp_id = FUZZ_ID(op->a);
+		return true;
+	case FUZZ_OP_PCM_FREE:
+		fuzz_hdr(&msg->hdr, SOF_IPC_GLB_STREAM_MSG | SOF_IPC_STREAM_PCM_FREE,
+			 sizeof(msg->stream));
+		msg->stream.comp_id = FUZZ_ID(op->a);
+		return true;
+	case FUZZ_OP_COMP_FREE:
+		fuzz_hdr(&msg->hdr, SOF_IPC_GLB_TPLG_MSG | SOF_IPC_TPLG_COMP_FREE,
+			 sizeof(msg->free));
+		msg->free.id = FUZZ_ID(op->a);
+		return true;
+	case FUZZ_OP_BUFFER_FREE:
+		fuzz_hdr(&msg->hdr, SOF_IPC_GLB_TPLG_MSG | SOF_IPC_TPLG_BUFFER_FREE,
+			 sizeof(msg->free));
+		msg->free.id = FUZZ_ID(op->a);
+		return true;
+	case FUZZ_OP_PIPE_FREE:
+		fuzz_hdr(&msg->hdr, SOF_IPC_GLB_TPLG_MSG | SOF_IPC_TPLG_PIPE_FREE,
+			 sizeof(msg->free));
+		msg->free.id = FUZZ_ID(op->a);
+		return true;
+	default:
+		return false;
+	}
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *Data, size_t Size)
+{
+	static union fuzz_msg msg;
+	struct fuzz_op op;
+	size_t i;
+
+	for (i = 0; i + sizeof(op) <= Size; i += sizeof(op)) {
+		memcpy_s(&op, sizeof(op), Data + i, sizeof(op));
+
+		if (fuzz_build(&msg, &op))
+			fuzz_ipc_send(&msg, msg.hdr.size);
+		else
+			fuzz_ipc_run_pipeline(FUZZ_ID(op.a), op.b % FUZZ_MAX_RUNS + 1);
+	}
+
+	fuzz_ipc_reset();
+
+	return 0;
+}
+
+size_t LLVMFuzzerCustomMutator(uint8_t *Data, size_t Size, size_t MaxSize,
+			       unsigned int Seed)
+{
+	const size_t rec = sizeof(struct fuzz_op);
+	size_t count = Size / rec;
+	size_t max = MaxSize / rec;
+	size_t i, j;
+	uint8_t tmp[sizeof(struct fuzz_op)];
+
+	srand(Seed);
+
+	/* drop any partial trailing record */
+	Size = count * rec;
+
+	switch (count ? rand() % 6 : 5) {
+	case 0:
+		/* mutate a single record in place */
+		i = rand() % count;
+		LLVMFuzzerMutate(Data + i * rec, rec, rec);
+		break;
+	case 1:
+		/* remove a record */
+		i = rand() % count;
+		memmove(Data + i * rec, Data + (i + 1) * rec, (count - i - 1) * rec);
+		Size -= rec;
+		break;
+	case 2:
+		/* duplicate a record to another position */
+		if (count >= max)
+			break;
+		i = rand() % count;
+		j = rand() % (count + 1);
+		memcpy_s(tmp, rec, Data + i * rec, rec);
+		memmove(Data + (j + 1) * rec, Data + j * rec, (count - j) * rec);
+		memcpy_s(Data + j * rec, rec, tmp, rec);
+		Size += rec;
+		break;
+	case 3:
+		/* swap two records */
+		i = rand() % count;
+		j = rand() % count;
+		memcpy_s(tmp, rec, Data + i * rec, rec);
+		memmove(Data + i * rec, Data + j * rec, rec);
+		memcpy_s(Data + j * rec, rec, tmp, rec);
+		break;
+	case 4:
+		/* byte level mutation of the whole sequence */
+		Size = LLVMFuzzerMutate(Data, Size, max * rec) / rec * rec;
+		break;
+	default:
+		/* start over from the canned playback sequence */
+		Size = MIN(sizeof(fuzz_playback), max * rec);
+		memcpy_s(Data, MaxSize, fuzz_playback, Size);
+		break;
+	}
+
+	return Size;
+}
+
+int LLVMFuzzerInitialize(int *argc, char ***argv)
+{
+	return fuzz_ipc_init();
+}
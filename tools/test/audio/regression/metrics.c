@@ -0,0 +1,360 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+/*
+ * Test signals and objective quality metrics for the regression runner,
+ * a C counterpart of the measurements done by the Octave test scripts.
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "metrics.h"
+
+#define RG_METRIC_MAX_DB	200.0	/* reported for exact matches */
+#define RG_SINE_LEVEL_DB	-3.0
+#define RG_NOISE_LEVEL_DB	-20.0
+#define RG_SWEEP_LEVEL_DB	-6.0
+#define RG_SWEEP_START_HZ	20.0
+
+#define RG_FNV_OFFSET		0xcbf29ce484222325ULL
+#define RG_FNV_PRIME		0x100000001b3ULL
+
+int rg_format_bytes(enum rg_format fmt)
+{
+	return fmt == RG_FORMAT_S16LE ? 2 : 4;
+}
+
+const char *rg_format_testbench(enum rg_format fmt)
+{
+	switch (fmt) {
+	case RG_FORMAT_S16LE:
+		return "S16_LE";
+	case RG_FORMAT_S24LE:
+		return "S24_LE";
+	default:
+		return "S32_LE";
+	}
+}
+
+static double rg_format_scale(enum rg_format fmt)
+{
+	switch (fmt) {
+	case RG_FORMAT_S16LE:
+		return 32768.0;
+	case RG_FORMAT_S24LE:
+		return 8388608.0;
+	default:
+		return 2147483648.0;
+	}
+}
+
+/* round and saturate to the format, S24LE is sign extended to 32 bits */
+static int64_t rg_quantize(double x, enum rg_format fmt)
+{
+	double scale = rg_format_scale(fmt);
+	int64_t v = llround(x * scale);
+	int64_t max = (int64_t)scale - 1;
+
+	if (v > max)
+		return max;
+	if (v < -(int64_t)scale)
+		return -(int64_t)scale;
+	return v;
+}
+
+/* xorshift, the signals have to be identical on every run and host */
+static double rg_noise(uint32_t *state)
+{
+	uint32_t x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+
+	return (double)x / 4294967296.0 * 2.0 - 1.0;
+}
+
+int rg_signal_write(const char *fn, enum rg_signal signal, enum rg_format fmt,
+		    int rate, int channels, double seconds, double freq)
+{
+	size_t frames = (size_t)(seconds * rate);
+	double sweep_end = 0.45 * rate;
+	double sweep_k = log(sweep_end / RG_SWEEP_START_HZ) / seconds;
+	uint32_t seed = 0x12345678;
+	double level;
+	double x = 0;
+	double t;
+	int64_t v;
+	int16_t v16;
+	int32_t v32;
+	size_t i;
+	FILE *fh;
+	int ch;
+	int ret = 0;
+
+	fh = fopen(fn, "wb");
+	if (!fh)
+		return -errno;
+
+	for (i = 0; i < frames && !ret; i++) {
+		t = (double)i / rate;
+		for (ch = 0; ch < channels; ch++) {
+			switch (signal) {
+			case RG_SIGNAL_SINE:
+				/* channels differ in phase to catch swaps */
+				level = pow(10, RG_SINE_LEVEL_DB / 20);
+				x = level * sin(2 * M_PI * freq * t + ch * M_PI / 8);
+				break;
+			case RG_SIGNAL_NOISE:
+				level = pow(10, RG_NOISE_LEVEL_DB / 20);
+				x = level * rg_noise(&seed);
+				break;
+			case RG_SIGNAL_SWEEP:
+				level = pow(10, RG_SWEEP_LEVEL_DB / 20);
+				x = level * sin(2 * M_PI * RG_SWEEP_START_HZ *
+						(exp(sweep_k * t) - 1) / sweep_k);
+				break;
+			}
+
+			v = rg_quantize(x, fmt);
+			if (fmt == RG_FORMAT_S16LE) {
+				v16 = v;
+				ret = fwrite(&v16, sizeof(v16), 1, fh) != 1;
+			} else {
+				v32 = v;
+				ret = fwrite(&v32, sizeof(v32), 1, fh) != 1;
+			}
+		}
+	}
+
+	if (fclose(fh) || ret)
+		return -EIO;
+
+	return 0;
+}
+
+int rg_audio_read(const char *fn, enum rg_format fmt, int channels,
+		  struct rg_audio *audio)
+{
+	int bytes = rg_format_bytes(fmt);
+	double scale = rg_format_scale(fmt);
+	size_t samples;
+	int16_t v16;
+	int32_t v32;
+	long size;
+	size_t i;
+	FILE *fh;
+
+	memset(audio, 0, sizeof(*audio));
+
+	fh = fopen(fn, "rb");
+	if (!fh)
+		return -errno;
+
+	if (fseek(fh, 0, SEEK_END)) {
+		fclose(fh);
+		return -EIO;
+	}
+
+	size = ftell(fh);
+	if (size < 0 || fseek(fh, 0, SEEK_SET)) {
+		fclose(fh);
+		return -EIO;
+	}
+
+	audio->channels = channels;
+	audio->frames = size / bytes / channels;
+	samples = audio->frames * channels;
+	audio->data = malloc((samples ? samples : 1) * sizeof(double));
+	if (!audio->data) {
+		fclose(fh);
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < samples; i++) {
+		if (bytes == 2) {
+			if (fread(&v16, sizeof(v16), 1, fh) != 1)
+				break;
+			audio->data[i] = v16 / scale;
+		} else {
+			if (fread(&v32, sizeof(v32), 1, fh) != 1)
+				break;
+			/* only the 24 LSBs are significant */
+			if (fmt == RG_FORMAT_S24LE)
+				v32 = (int32_t)((uint32_t)v32 << 8) >> 8;
+			audio->data[i] = v32 / scale;
+		}
+	}
+
+	fclose(fh);
+
+	if (i != samples) {
+		rg_audio_free(audio);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+void rg_audio_free(struct rg_audio *audio)
+{
+	free(audio->data);
+	audio->data = NULL;
+	audio->frames = 0;
+}
+
+int rg_file_hash(const char *fn, uint64_t *hash)
+{
+	*hash = RG_FNV_OFFSET;
+	return rg_file_hash_update(fn, hash);
+}
+
+int rg_file_hash_update(const char *fn, uint64_t *hash)
+{
+	uint64_t h = *hash;
+	unsigned char buf[4096];
+	size_t n;
+	size_t i;
+	FILE *fh;
+
+	fh = fopen(fn, "rb");
+	if (!fh)
+		return -errno;
+
+	while ((n = fread(buf, 1, sizeof(buf), fh)) > 0)
+		for (i = 0; i < n; i++)
+			h = (h ^ buf[i]) * RG_FNV_PRIME;
+
+	fclose(fh);
+	*hash = h;
+	return 0;
+}
+
+static double rg_db(double num, double den)
+{
+	if (den <= 0)
+		return RG_METRIC_MAX_DB;
+
+	if (num <= 0)
+		return -RG_METRIC_MAX_DB;
+
+	return 10 * log10(num / den);
+}
+
+/* solve 3x3 linear system m * x = v with Cramer's rule */
+static int rg_solve3(double m[3][3], const double v[3], double x[3])
+{
+	double det = m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) -
+		     m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+		     m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+	double t[3][3];
+	int i, j, k;
+
+	if (fabs(det) < 1e-12)
+		return -EINVAL;
+
+	for (k = 0; k < 3; k++) {
+		for (i = 0; i < 3; i++)
+			for (j = 0; j < 3; j++)
+				t[i][j] = j == k ? v[i] : m[i][j];
+
+		x[k] = (t[0][0] * (t[1][1] * t[2][2] - t[1][2] * t[2][1]) -
+			t[0][1] * (t[1][0] * t[2][2] - t[1][2] * t[2][0]) +
+			t[0][2] * (t[1][0] * t[2][1] - t[1][1] * t[2][0])) / det;
+	}
+
+	return 0;
+}
+
+double rg_thdn(const struct rg_audio *audio, int rate, double freq, double skip)
+{
+	size_t start = (size_t)(skip * rate);
+	double worst = -RG_METRIC_MAX_DB;
+	double w = 2 * M_PI * freq / rate;
+	double m[3][3];
+	double v[3];
+	double c[3];
+	double b[3];
+	double fund;
+	double res;
+	double fit;
+	double x;
+	size_t n;
+	int ch, i, j;
+
+	/* need 100 ms of signal at least after settling */
+	if (audio->frames < start + rate / 10)
+		return RG_METRIC_MAX_DB;
+
+	for (ch = 0; ch < audio->channels; ch++) {
+		memset(m, 0, sizeof(m));
+		memset(v, 0, sizeof(v));
+
+		for (n = start; n < audio->frames; n++) {
+			b[0] = cos(w * n);
+			b[1] = sin(w * n);
+			b[2] = 1.0;
+			x = audio->data[n * audio->channels + ch];
+			for (i = 0; i < 3; i++) {
+				v[i] += b[i] * x;
+				for (j = 0; j < 3; j++)
+					m[i][j] += b[i] * b[j];
+			}
+		}
+
+		if (rg_solve3(m, v, c) < 0)
+			return RG_METRIC_MAX_DB;
+
+		fund = 0;
+		res = 0;
+		for (n = start; n < audio->frames; n++) {
+			fit = c[0] * cos(w * n) + c[1] * sin(w * n);
+			x = audio->data[n * audio->channels + ch] - fit - c[2];
+			fund += fit * fit;
+			res += x * x;
+		}
+
+		/* no fundamental at all is the worst result */
+		x = rg_db(res, fund);
+		if (x > worst)
+			worst = x;
+	}
+
+	return worst;
+}
+
+double rg_snr(const struct rg_audio *audio, const struct rg_audio *ref)
+{
+	double worst = RG_METRIC_MAX_DB;
+	double signal;
+	double noise;
+	double d;
+	double x;
+	size_t n;
+	int ch;
+
+	if (audio->channels != ref->channels || audio->frames != ref->frames)
+		return -RG_METRIC_MAX_DB;
+
+	for (ch = 0; ch < audio->channels; ch++) {
+		signal = 0;
+		noise = 0;
+		for (n = 0; n < audio->frames; n++) {
+			x = ref->data[n * ref->channels + ch];
+			d = audio->data[n * audio->channels + ch] - x;
+			signal += x * x;
+			noise += d * d;
+		}
+
+		x = rg_db(signal, noise);
+		if (x < worst)
+			worst = x;
+	}
+
+	return worst;
+}
@@ -0,0 +1,62 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2022 Intel Corporation. All rights reserved.
+ */
+
+#ifndef __REGRESSION_METRICS_H__
+#define __REGRESSION_METRICS_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* sample formats as used in test topology names */
+enum rg_format {
+	RG_FORMAT_S16LE,
+	RG_FORMAT_S24LE,
+	RG_FORMAT_S32LE,
+};
+
+/* test signal types */
+enum rg_signal {
+	RG_SIGNAL_SINE,		/* sine, allows THD+N measurement */
+	RG_SIGNAL_NOISE,	/* deterministic white noise */
+	RG_SIGNAL_SWEEP,	/* logarithmic sweep over the whole band */
+};
+
+/* audio samples converted to doubles in range [-1, 1), interleaved */
+struct rg_audio {
+	double *data;
+	size_t frames;
+	int channels;
+};
+
+int rg_format_bytes(enum rg_format fmt);
+const char *rg_format_testbench(enum rg_format fmt);
+
+/* generate a test signal and write it to a raw file in given format */
+int rg_signal_write(const char *fn, enum rg_signal signal, enum rg_format fmt,
+		    int rate, int channels, double seconds, double freq);
+
+/* read a raw file written by testbench */
+int rg_audio_read(const char *fn, enum rg_format fmt, int channels,
+		  struct rg_audio *audio);
+void rg_audio_free(struct rg_audio *audio);
+
+/* FNV-1a hash of a file */
+int rg_file_hash(const char *fn, uint64_t *hash);
+
+/* continue a hash with another file, for cases with several outputs */
+int rg_file_hash_update(const char *fn, uint64_t *hash);
+
+/*
+ * THD+N in dB of a sine of known frequency, worst of all channels. The
+ * fundamental is least squares fitted and removed, the remainder is
+ * distortion and noise. The first skip seconds of output are ignored to
+ * let filters settle.
+ */
+double rg_thdn(const struct rg_audio *audio, int rate, double freq, double skip);
+
+/* SNR in dB of audio against a golden reference, worst of all channels */
+double rg_snr(const struct rg_audio *audio, const struct rg_audio *ref);
+
+#endif /* __REGRESSION_METRICS_H__ */
@@ -0,0 +1,698 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+/*
+ * Golden vector regression runner for the processing components.
+ *
+ * Every case runs one component test topology through the testbench with a
+ * generated test signal. The output is checked against a stored hash for
+ * bit exactness. If the hash differs and a golden output file is available
+ * the output is accepted when its SNR against the golden file is good
+ * enough. Sine inputs are additionally checked for THD+N. Cases run as
+ * parallel processes, one per host core by default.
+ *
+ * Usage: sof-tb-regression [-j jobs] [-f filter] [-u]
+ * See README.md in this directory for all options.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "metrics.h"
+
+#define RG_MAX_CASES		512
+#define RG_NAME_LEN		64
+#define RG_PATH_LEN		512
+/* room for a directory plus a name with decorations */
+#define RG_FILE_LEN		(RG_PATH_LEN + 4 * RG_NAME_LEN)
+#define RG_MSG_LEN		(RG_FILE_LEN + 64)
+
+#define RG_SINE_HZ		997.0
+#define RG_SETTLE_S		0.1
+#define RG_LENGTH_TOLERANCE	0.1
+#define RG_TIMEOUT_S		60	/* per testbench run */
+#define RG_MAX_OUTPUTS		4	/* crossover sinks */
+
+struct rg_case {
+	char name[RG_NAME_LEN];
+	char comp[RG_NAME_LEN];
+	char direction[RG_NAME_LEN];
+	enum rg_format fmt_in;
+	enum rg_format fmt_out;
+	int fs_in;
+	int fs_out;
+	int ch_in;
+	int ch_out;
+	int outputs;		/* <n>way-crossover has one output per sink */
+	enum rg_signal signal;
+	double thdn_max;	/* dB */
+	double snr_min;		/* dB, against golden output file */
+	bool golden;		/* golden hash known */
+	uint64_t golden_hash;
+};
+
+enum rg_status {
+	RG_NOT_RUN = 0,
+	RG_BIT_EXACT,		/* matches the golden hash */
+	RG_TOLERANCE,		/* within SNR tolerance of golden file */
+	RG_NO_GOLDEN,		/* nothing to compare with, metrics passed */
+	RG_UPDATED,		/* golden hash refreshed */
+	RG_FAIL,
+};
+
+/* written by workers, lives in memory shared with them */
+struct rg_result {
+	enum rg_status status;
+	uint64_t hash;
+	double thdn;
+	double snr;
+	char msg[RG_MSG_LEN];
+};
+
+struct rg_config {
+	char testbench_dir[RG_PATH_LEN];
+	char topology_dir[RG_PATH_LEN];
+	char case_file[RG_PATH_LEN];
+	char golden_file[RG_PATH_LEN];
+	char golden_dir[RG_PATH_LEN];	/* optional golden output files */
+	char work_dir[RG_PATH_LEN];
+	const char *filter;
+	double seconds;
+	int jobs;
+	bool update;
+	bool keep;
+	bool verbose;
+};
+
+static struct rg_case cases[RG_MAX_CASES];
+static int num_cases;
+
+static const char * const rg_format_names[] = {
+	[RG_FORMAT_S16LE] = "s16le",
+	[RG_FORMAT_S24LE] = "s24le",
+	[RG_FORMAT_S32LE] = "s32le",
+};
+
+static const char * const rg_signal_names[] = {
+	[RG_SIGNAL_SINE] = "sine",
+	[RG_SIGNAL_NOISE] = "noise",
+	[RG_SIGNAL_SWEEP] = "sweep",
+};
+
+static const char * const rg_status_names[] = {
+	[RG_NOT_RUN] = "NOT RUN",
+	[RG_BIT_EXACT] = "PASS bit-exact",
+	[RG_TOLERANCE] = "PASS tolerance",
+	[RG_NO_GOLDEN] = "PASS no golden",
+	[RG_UPDATED] = "UPDATED",
+	[RG_FAIL] = "FAIL",
+};
+
+static int rg_lookup(const char * const *names, int count, const char *name)
+{
+	int i;
+
+	for (i = 0; i < count; i++)
+		if (!strcmp(names[i], name))
+			return i;
+
+	return -EINVAL;
+}
+
+#define ARRAY_SIZE(a)	(sizeof(a) / sizeof((a)[0]))
+#define RG_LOOKUP(names, name)	rg_lookup(names, ARRAY_SIZE(names), name)
+
+/*
+ * Case file line:
+ * name comp direction fmt_in fmt_out fs_in fs_out ch_in ch_out signal thdn_max snr_min
+ */
+static int rg_load_cases(const char *fn)
+{
+	char fmt_in[RG_NAME_LEN], fmt_out[RG_NAME_LEN], signal[RG_NAME_LEN];
+	struct rg_case *c;
+	char line[512];
+	int lineno = 0;
+	FILE *fh;
+	int ret;
+
+	fh = fopen(fn, "r");
+	if (!fh) {
+		fprintf(stderr, "error: can't open case file %s\n", fn);
+		return -errno;
+	}
+
+	while (fgets(line, sizeof(line), fh)) {
+		lineno++;
+		if (line[0] == '#' || strspn(line, " \t\r\n") == strlen(line))
+			continue;
+
+		if (num_cases == RG_MAX_CASES) {
+			fprintf(stderr, "error: too many cases in %s\n", fn);
+			fclose(fh);
+			return -EINVAL;
+		}
+
+		c = &cases[num_cases];
+		ret = sscanf(line, "%63s %63s %63s %63s %63s %d %d %d %d %63s %lf %lf",
+			     c->name, c->comp, c->direction, fmt_in, fmt_out,
+			     &c->fs_in, &c->fs_out, &c->ch_in, &c->ch_out,
+			     signal, &c->thdn_max, &c->snr_min);
+		if (ret != 12 || RG_LOOKUP(rg_format_names, fmt_in) < 0 ||
+		    RG_LOOKUP(rg_format_names, fmt_out) < 0 ||
+		    RG_LOOKUP(rg_signal_names, signal) < 0 ||
+		    c->fs_in <= 0 || c->fs_out <= 0 || c->ch_in <= 0 || c->ch_out <= 0) {
+			fprintf(stderr, "error: %s:%d: invalid case\n", fn, lineno);
+			fclose(fh);
+			return -EINVAL;
+		}
+
+		c->fmt_in = RG_LOOKUP(rg_format_names, fmt_in);
+		c->fmt_out = RG_LOOKUP(rg_format_names, fmt_out);
+		c->signal = RG_LOOKUP(rg_signal_names, signal);
+
+		/* the sinks of a crossover are the pipelines 1 to n */
+		if (sscanf(c->comp, "%dway-", &c->outputs) != 1)
+			c->outputs = 1;
+
+		if (c->outputs < 1 || c->outputs > RG_MAX_OUTPUTS ||
+		    (c->outputs > 1 && strcmp(c->direction, "playback"))) {
+			fprintf(stderr, "error: %s:%d: invalid outputs\n", fn, lineno);
+			fclose(fh);
+			return -EINVAL;
+		}
+
+		num_cases++;
+	}
+
+	fclose(fh);
+	return 0;
+}
+
+static struct rg_case *rg_find_case(const char *name)
+{
+	int i;
+
+	for (i = 0; i < num_cases; i++)
+		if (!strcmp(cases[i].name, name))
+			return &cases[i];
+
+	return NULL;
+}
+
+/* golden manifest line: name hash, hashes of unknown cases are ignored */
+static int rg_load_golden(const char *fn)
+{
+	char name[RG_NAME_LEN];
+	struct rg_case *c;
+	char line[256];
+	uint64_t hash;
+	FILE *fh;
+
+	fh = fopen(fn, "r");
+	if (!fh)
+		return 0;
+
+	while (fgets(line, sizeof(line), fh)) {
+		if (line[0] == '#')
+			continue;
+
+		if (sscanf(line, "%63s %" SCNx64, name, &hash) != 2)
+			continue;
+
+		c = rg_find_case(name);
+		if (c) {
+			c->golden = true;
+			c->golden_hash = hash;
+		}
+	}
+
+	fclose(fh);
+	return 0;
+}
+
+static int rg_save_golden(const char *fn, const struct rg_result *results)
+{
+	char tmp[RG_PATH_LEN + 8];
+	FILE *fh;
+	int i;
+
+	snprintf(tmp, sizeof(tmp), "%s.tmp", fn);
+	fh = fopen(tmp, "w");
+	if (!fh) {
+		fprintf(stderr, "error: can't write %s\n", tmp);
+		return -errno;
+	}
+
+	fprintf(fh, "# Golden output hashes, generated with sof-tb-regression -u\n");
+	for (i = 0; i < num_cases; i++) {
+		if (results[i].status == RG_UPDATED)
+			fprintf(fh, "%s %016" PRIx64 "\n", cases[i].name,
+				results[i].hash);
+		else if (cases[i].golden)
+			fprintf(fh, "%s %016" PRIx64 "\n", cases[i].name,
+				cases[i].golden_hash);
+	}
+
+	if (fclose(fh))
+		return -EIO;
+
+	return rename(tmp, fn) ? -errno : 0;
+}
+
+static int rg_copy_file(const char *src, const char *dst)
+{
+	char buf[4096];
+	FILE *in, *out;
+	size_t n;
+	int ret = 0;
+
+	in = fopen(src, "rb");
+	if (!in)
+		return -errno;
+
+	out = fopen(dst, "wb");
+	if (!out) {
+		fclose(in);
+		return -errno;
+	}
+
+	while ((n = fread(buf, 1, sizeof(buf), in)) > 0)
+		if (fwrite(buf, 1, n, out) != n)
+			ret = -EIO;
+
+	fclose(in);
+	if (fclose(out))
+		ret = -EIO;
+
+	return ret;
+}
+
+/* output file of a crossover sink, the first one is the case output */
+static void rg_output_name(const struct rg_config *cfg, const struct rg_case *c,
+			   int i, char *fn, size_t size)
+{
+	if (i)
+		snprintf(fn, size, "%s/%s_out%d.raw", cfg->work_dir, c->name, i + 1);
+	else
+		snprintf(fn, size, "%s/%s_out.raw", cfg->work_dir, c->name);
+}
+
+/* run testbench for the case, output goes to log */
+static int rg_run_testbench(const struct rg_config *cfg, const struct rg_case *c,
+			    const char *in, const char *log)
+{
+	char exe[RG_FILE_LEN], tplg[RG_FILE_LEN];
+	char libs[2 * RG_FILE_LEN];
+	char outs[RG_MAX_OUTPUTS * (RG_FILE_LEN + 1)];
+	char fn[RG_FILE_LEN];
+	char fs_in[16], fs_out[16], ch_in[16], ch_out[16];
+	/* the test topologies put playback in pipeline 1 and capture in 2 */
+	char pipelines[2 * RG_MAX_OUTPUTS] = "2";
+	size_t len = 0;
+	pid_t pid;
+	int status;
+	int fd;
+	int i;
+
+	for (i = 0; i < c->outputs; i++) {
+		rg_output_name(cfg, c, i, fn, sizeof(fn));
+		len += snprintf(outs + len, sizeof(outs) - len, "%s%s", i ? "," : "", fn);
+	}
+
+	if (strcmp(c->direction, "capture"))
+		for (i = 0, len = 0; i < c->outputs; i++)
+			len += snprintf(pipelines + len, sizeof(pipelines) - len, "%s%d",
+					i ? "," : "", i + 1);
+
+	snprintf(exe, sizeof(exe), "%s/install/bin/testbench", cfg->testbench_dir);
+	snprintf(tplg, sizeof(tplg),
+		 "%s/test-%s-ssp5-mclk-0-I2S-%s-%s-%s-48k-24576k-codec.tplg",
+		 cfg->topology_dir, c->direction, c->comp,
+		 rg_format_names[c->fmt_in], rg_format_names[c->fmt_out]);
+	snprintf(libs, sizeof(libs), "%s/sof_ep/install/lib:%s/sof_parser/install/lib",
+		 cfg->testbench_dir, cfg->testbench_dir);
+	snprintf(fs_in, sizeof(fs_in), "%d", c->fs_in);
+	snprintf(fs_out, sizeof(fs_out), "%d", c->fs_out);
+	snprintf(ch_in, sizeof(ch_in), "%d", c->ch_in);
+	snprintf(ch_out, sizeof(ch_out), "%d", c->ch_out);
+
+	pid = fork();
+	if (pid < 0)
+		return -errno;
+
+	if (!pid) {
+		fd = open(log, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if (fd >= 0) {
+			dup2(fd, STDOUT_FILENO);
+			dup2(fd, STDERR_FILENO);
+			close(fd);
+		}
+
+		setenv("LD_LIBRARY_PATH", libs, 1);
+		/* a stuck testbench must not stall the whole run */
+		alarm(RG_TIMEOUT_S);
+		execl(exe, exe, "-q", "-r", fs_in, "-R", fs_out, "-c", ch_in,
+		      "-n", ch_out, "-b", rg_format_testbench(c->fmt_in),
+		      "-p", pipelines, "-t", tplg, "-i", in, "-o", outs, (char *)NULL);
+		fprintf(stderr, "error: can't execute %s\n", exe);
+		_exit(127);
+	}
+
+	if (waitpid(pid, &status, 0) < 0)
+		return -errno;
+
+	if (WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM)
+		return -ETIMEDOUT;
+
+	return WIFEXITED(status) ? WEXITSTATUS(status) : -EINTR;
+}
+
+static void rg_fail(struct rg_result *r, const char *msg)
+{
+	r->status = RG_FAIL;
+	snprintf(r->msg, sizeof(r->msg), "%s", msg);
+}
+
+/* executed in a worker process */
+static void rg_run_case(const struct rg_config *cfg, const struct rg_case *c,
+			struct rg_result *r)
+{
+	char in[RG_FILE_LEN], out[RG_FILE_LEN], log[RG_FILE_LEN], ref[RG_FILE_LEN];
+	char fn[RG_FILE_LEN];
+	struct rg_audio audio, golden;
+	size_t expected;
+	int ret;
+	int i;
+
+	r->thdn = 0;
+	r->snr = 0;
+
+	snprintf(in, sizeof(in), "%s/%s_in.raw", cfg->work_dir, c->name);
+	rg_output_name(cfg, c, 0, out, sizeof(out));
+	snprintf(log, sizeof(log), "%s/%s.log", cfg->work_dir, c->name);
+	snprintf(ref, sizeof(ref), "%s/%s.raw", cfg->golden_dir, c->name);
+
+	if (rg_signal_write(in, c->signal, c->fmt_in, c->fs_in, c->ch_in,
+			    cfg->seconds, RG_SINE_HZ) < 0) {
+		rg_fail(r, "can't write input");
+		return;
+	}
+
+	for (i = 0; i < c->outputs; i++) {
+		rg_output_name(cfg, c, i, fn, sizeof(fn));
+		unlink(fn);
+	}
+
+	ret = rg_run_testbench(cfg, c, in, log);
+	if (ret == -ETIMEDOUT) {
+		snprintf(r->msg, sizeof(r->msg), "testbench timed out, see %s", log);
+		r->status = RG_FAIL;
+		return;
+	}
+
+	if (ret) {
+		snprintf(r->msg, sizeof(r->msg), "testbench returned %d, see %s", ret, log);
+		r->status = RG_FAIL;
+		return;
+	}
+
+	if (rg_audio_read(out, c->fmt_out, c->ch_out, &audio) < 0) {
+		rg_fail(r, "can't read output");
+		return;
+	}
+
+	/* the pipeline may hold back some frames, but not much more */
+	expected = (size_t)(cfg->seconds * c->fs_out);
+	if (audio.frames < expected * (1 - RG_LENGTH_TOLERANCE) ||
+	    audio.frames > expected * (1 + RG_LENGTH_TOLERANCE)) {
+		snprintf(r->msg, sizeof(r->msg), "output has %zu frames, expected %zu",
+			 audio.frames, expected);
+		r->status = RG_FAIL;
+		goto out;
+	}
+
+	/* metrics use the first output, the hash covers all of them */
+	rg_file_hash(out, &r->hash);
+	for (i = 1; i < c->outputs; i++) {
+		rg_output_name(cfg, c, i, fn, sizeof(fn));
+		if (rg_file_hash_update(fn, &r->hash) < 0) {
+			snprintf(r->msg, sizeof(r->msg), "can't read output %s", fn);
+			r->status = RG_FAIL;
+			goto out;
+		}
+	}
+
+	if (c->signal == RG_SIGNAL_SINE) {
+		r->thdn = rg_thdn(&audio, c->fs_out, RG_SINE_HZ, RG_SETTLE_S);
+		if (r->thdn > c->thdn_max) {
+			snprintf(r->msg, sizeof(r->msg), "THD+N %.1f dB above %.1f dB",
+				 r->thdn, c->thdn_max);
+			r->status = RG_FAIL;
+			goto out;
+		}
+	}
+
+	if (c->golden && c->golden_hash == r->hash) {
+		r->status = RG_BIT_EXACT;
+		goto out;
+	}
+
+	if (cfg->update) {
+		r->status = RG_UPDATED;
+		if (cfg->golden_dir[0] && rg_copy_file(out, ref) < 0)
+			rg_fail(r, "can't write golden output");
+		goto out;
+	}
+
+	if (cfg->golden_dir[0] &&
+	    !rg_audio_read(ref, c->fmt_out, c->ch_out, &golden)) {
+		r->snr = rg_snr(&audio, &golden);
+		rg_audio_free(&golden);
+		if (r->snr < c->snr_min) {
+			snprintf(r->msg, sizeof(r->msg), "SNR %.1f dB below %.1f dB",
+				 r->snr, c->snr_min);
+			r->status = RG_FAIL;
+		} else {
+			r->status = RG_TOLERANCE;
+		}
+		goto out;
+	}
+
+	if (c->golden)
+		rg_fail(r, "hash mismatch, no golden output to compare with");
+	else
+		r->status = RG_NO_GOLDEN;
+
+out:
+	rg_audio_free(&audio);
+
+	if (!cfg->keep && r->status != RG_FAIL) {
+		unlink(in);
+		for (i = 0; i < c->outputs; i++) {
+			rg_output_name(cfg, c, i, fn, sizeof(fn));
+			unlink(fn);
+		}
+		unlink(log);
+	}
+}
+
+static int rg_run_all(const struct rg_config *cfg, struct rg_result *results)
+{
+	int running = 0;
+	int next = 0;
+	pid_t pid;
+
+	while (next < num_cases || running) {
+		/* skip filtered out cases */
+		if (next < num_cases && cfg->filter &&
+		    !strstr(cases[next].name, cfg->filter)) {
+			next++;
+			continue;
+		}
+
+		if (next < num_cases && running < cfg->jobs) {
+			pid = fork();
+			if (pid < 0) {
+				perror("fork");
+				return -errno;
+			}
+
+			if (!pid) {
+				rg_run_case(cfg, &cases[next], &results[next]);
+				_exit(0);
+			}
+
+			if (cfg->verbose)
+				printf("started %s\n", cases[next].name);
+
+			running++;
+			next++;
+			continue;
+		}
+
+		if (wait(NULL) > 0)
+			running--;
+	}
+
+	return 0;
+}
+
+static void rg_usage(const char *exe)
+{
+	printf("Usage: %s <options>\n\n", exe);
+	printf("  -b <dir>     testbench build directory\n");
+	printf("  -t <dir>     test topologies directory\n");
+	printf("  -c <file>    test case list\n");
+	printf("  -g <file>    golden hashes\n");
+	printf("  -G <dir>     golden output files, for tolerance checks\n");
+	printf("  -w <dir>     work directory\n");
+	printf("  -j <n>       number of parallel jobs, default is number of cores\n");
+	printf("  -f <string>  run only cases with name containing string\n");
+	printf("  -s <seconds> test signal length\n");
+	printf("  -u           update golden hashes (and files with -G)\n");
+	printf("  -k           keep input, output and log of passed cases\n");
+	printf("  -v           verbose\n");
+	printf("  -h           help\n");
+}
+
+int main(int argc, char **argv)
+{
+	struct rg_config cfg = {
+		.seconds = 1.0,
+		.jobs = sysconf(_SC_NPROCESSORS_ONLN),
+	};
+	struct rg_result *results;
+	struct rg_result *r;
+	int counts[RG_FAIL + 1] = { 0 };
+	int opt;
+	int ret;
+	int i;
+
+	snprintf(cfg.testbench_dir, sizeof(cfg.testbench_dir), "%s",
+		 SOF_TOOLS_DIR "/testbench/build_testbench");
+	snprintf(cfg.topology_dir, sizeof(cfg.topology_dir), "%s",
+		 SOF_TOOLS_DIR "/build_tools/test/topology");
+	snprintf(cfg.case_file, sizeof(cfg.case_file), "%s",
+		 SOF_TOOLS_DIR "/test/audio/regression/cases.txt");
+	snprintf(cfg.golden_file, sizeof(cfg.golden_file), "%s",
+		 SOF_TOOLS_DIR "/test/audio/regression/golden.txt");
+	snprintf(cfg.work_dir, sizeof(cfg.work_dir), "regression_out");
+
+	while ((opt = getopt(argc, argv, "b:t:c:g:G:w:j:f:s:ukvh")) != -1) {
+		switch (opt) {
+		case 'b':
+			snprintf(cfg.testbench_dir, sizeof(cfg.testbench_dir), "%s", optarg);
+			break;
+		case 't':
+			snprintf(cfg.topology_dir, sizeof(cfg.topology_dir), "%s", optarg);
+			break;
+		case 'c':
+			snprintf(cfg.case_file, sizeof(cfg.case_file), "%s", optarg);
+			break;
+		case 'g':
+			snprintf(cfg.golden_file, sizeof(cfg.golden_file), "%s", optarg);
+			break;
+		case 'G':
+			snprintf(cfg.golden_dir, sizeof(cfg.golden_dir), "%s", optarg);
+			break;
+		case 'w':
+			snprintf(cfg.work_dir, sizeof(cfg.work_dir), "%s", optarg);
+			break;
+		case 'j':
+			cfg.jobs = atoi(optarg);
+			break;
+		case 'f':
+			cfg.filter = optarg;
+			break;
+		case 's':
+			cfg.seconds = atof(optarg);
+			break;
+		case 'u':
+			cfg.update = true;
+			break;
+		case 'k':
+			cfg.keep = true;
+			break;
+		case 'v':
+			cfg.verbose = true;
+			break;
+		case 'h':
+			rg_usage(argv[0]);
+			return 0;
+		default:
+			rg_usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (cfg.jobs < 1)
+		cfg.jobs = 1;
+
+	if (cfg.seconds < 2 * RG_SETTLE_S) {
+		fprintf(stderr, "error: signal length must be at least %.1f s\n",
+			2 * RG_SETTLE_S);
+		return 1;
+	}
+
+	ret = rg_load_cases(cfg.case_file);
+	if (ret < 0)
+		return 1;
+
+	rg_load_golden(cfg.golden_file);
+
+	if (mkdir(cfg.work_dir, 0755) && errno != EEXIST) {
+		fprintf(stderr, "error: can't create %s\n", cfg.work_dir);
+		return 1;
+	}
+
+	if (cfg.golden_dir[0] && cfg.update &&
+	    mkdir(cfg.golden_dir, 0755) && errno != EEXIST) {
+		fprintf(stderr, "error: can't create %s\n", cfg.golden_dir);
+		return 1;
+	}
+
+	results = mmap(NULL, num_cases * sizeof(*results) + 1, PROT_READ | PROT_WRITE,
+		       MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (results == MAP_FAILED) {
+		perror("mmap");
+		return 1;
+	}
+
+	ret = rg_run_all(&cfg, results);
+	if (ret < 0)
+		return 1;
+
+	printf("%-40s %-16s %10s %10s  %s\n", "case", "result", "THD+N dB", "SNR dB",
+	       "");
+	for (i = 0; i < num_cases; i++) {
+		r = &results[i];
+		if (cfg.filter && !strstr(cases[i].name, cfg.filter))
+			continue;
+
+		counts[r->status]++;
+		printf("%-40s %-16s %10.1f %10.1f  %s\n", cases[i].name,
+		       rg_status_names[r->status], r->thdn, r->snr, r->msg);
+	}
+
+	printf("\n%d bit-exact, %d within tolerance, %d without golden, ",
+	       counts[RG_BIT_EXACT], counts[RG_TOLERANCE], counts[RG_NO_GOLDEN]);
+	printf("%d updated, %d failed, %d not run\n",
+	       counts[RG_UPDATED], counts[RG_FAIL], counts[RG_NOT_RUN]);
+
+	if (cfg.update && counts[RG_UPDATED] &&
+	    rg_save_golden(cfg.golden_file, results) < 0)
+		return 1;
+
+	return counts[RG_FAIL] || counts[RG_NOT_RUN] ? 1 : 0;
+}
@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+""" Round trip of testbench WAV input and output against libsndfile.
+
+    The reference files are written and the testbench output is read with
+    libsndfile, through the soundfile module, and the samples are compared
+    bit-exactly through a pass-through demux topology. libsndfile has no
+    24 bit in 32 bit container writer, so the 24 bit case feeds the
+    testbench a text file and checks the WAV output with libsndfile, then
+    reads that WAV back into the testbench.
+"""
+
+# pylint: disable=invalid-name
+# pylint: disable=missing-function-docstring
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+import numpy as np
+import soundfile as sf
+
+TOOLS_DIR = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '../..'))
+RATE = 48000
+CHANNELS = 2
+
+def parse_args():
+    parser = argparse.ArgumentParser(description='testbench WAV round trip')
+    parser.add_argument('-b', dest='testbench_dir',
+                        default=os.path.join(TOOLS_DIR, 'testbench/build_testbench'),
+                        help='testbench build directory')
+    parser.add_argument('-t', dest='topology_dir',
+                        default=os.path.join(TOOLS_DIR, 'build_tools/test/topology'),
+                        help='test topologies directory')
+    return parser.parse_args()
+
+def sine(bits):
+    """ -6 dBFS 997 Hz in the valid bits, like the other audio tests """
+    n = np.arange(RATE // 10)
+    x = np.round(0.5 * np.sin(2 * np.pi * 997 * n / RATE) * (2 ** (bits - 1) - 1))
+    return np.repeat(x.astype(np.int32)[:, np.newaxis], CHANNELS, axis=1)
+
+def testbench(args, bits, fn_in, fn_out):
+    tplg = os.path.join(args.topology_dir,
+                        f'test-playback-ssp5-mclk-0-I2S-demux-s{bits}le-s{bits}le'
+                        '-48k-24576k-codec.tplg')
+    env = dict(os.environ)
+    env['LD_LIBRARY_PATH'] = (os.path.join(args.testbench_dir, 'sof_ep/install/lib') + ':' +
+                              os.path.join(args.testbench_dir, 'sof_parser/install/lib'))
+    cmd = [os.path.join(args.testbench_dir, 'install/bin/testbench'), '-q',
+           '-r', str(RATE), '-R', str(RATE), '-c', str(CHANNELS), '-n', str(CHANNELS),
+           '-b', f'S{bits}_LE', '-t', tplg, '-i', fn_in, '-o', fn_out]
+    subprocess.run(cmd, env=env, check=True, stdout=subprocess.DEVNULL,
+                   stderr=subprocess.DEVNULL)
+
+def check(name, ok):
+    print(f'{name:32} {"pass" if ok else "FAIL"}')
+    return ok
+
+def test_pcm(args, work, bits, subtype):
+    """ libsndfile WAV in, testbench WAV out, read back with libsndfile """
+    x = sine(bits) << (32 - bits)
+    fn_in = os.path.join(work, f's{bits}_in.wav')
+    fn_out = os.path.join(work, f's{bits}_out.wav')
+    sf.write(fn_in, x, RATE, subtype=subtype)
+    testbench(args, bits, fn_in, fn_out)
+    y, _ = sf.read(fn_out, dtype='int32')
+    return check(f'wav s{bits} round trip', np.array_equal(x, y))
+
+def test_s24(args, work):
+    """ testbench S24_4LE WAV out, read with libsndfile and the testbench """
+    x = sine(24)
+    fn_txt = os.path.join(work, 's24_in.txt')
+    fn_wav = os.path.join(work, 's24_out.wav')
+    fn_back = os.path.join(work, 's24_back.txt')
+    np.savetxt(fn_txt, x.reshape(-1), fmt='%d')
+    testbench(args, 24, fn_txt, fn_wav)
+
+    # the valid bits are the most significant ones of the container
+    info = sf.info(fn_wav)
+    y, _ = sf.read(fn_wav, dtype='int32')
+    ok = check('wav s24 in 32 write', info.channels == CHANNELS and
+               np.array_equal(x << 8, y))
+
+    testbench(args, 24, fn_wav, fn_back)
+    z = np.loadtxt(fn_back, dtype=np.int32).reshape(-1, CHANNELS)
+    return check('wav s24 in 32 read', np.array_equal(x, z)) and ok
+
+def main():
+    args = parse_args()
+    with tempfile.TemporaryDirectory() as work:
+        ok = test_pcm(args, work, 16, 'PCM_16')
+        ok = test_pcm(args, work, 32, 'PCM_32') and ok
+        ok = test_s24(args, work) and ok
+    return 0 if ok else 1
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -5,6 +5,13 @@
 ifelse(TEST_PIPE_NAME, `eq-iir', `define(PIPELINE_FILTER1, `eq_iir_coef_loudness.m4')')
 ifelse(TEST_PIPE_NAME, `eq-fir', `define(PIPELINE_FILTER2, `eq_fir_coef_loudness.m4')')
 
+# ASRC, the testbench file DAI has no timestamps to track the drift from
+ifelse(TEST_PIPE_NAME, `asrc', `define(`ASRC_ASYNCHRONOUS_MODE', `0')')
+
+# Crossover, the sinks are assigned to the test pipelines 1 to TEST_PIPE_AMOUNT
+ifelse(TEST_PIPE_NAME, `crossover',
+`define(PIPELINE_FILTER1, `crossover_coef_'TEST_PIPE_AMOUNT`way_test.m4')')
+
 # TDFB test pipelines with different names for different configurations
 
 # line array 2 mic
@@ -242,6 +242,8 @@ done
 ALG_SINGLE_MODE_TESTS=(asrc eq-fir eq-iir src dcblock drc multiband-drc tdfb
 		       tdfb_line4_28mm_pm90deg_48khz tdfb_circular8_100mm_pm30deg_48khz)
 ALG_SINGLE_SIMPLE_TESTS=(test-capture test-playback)
+ALG_PLAYBACK_MODE_TESTS=(demux selector)
+ALG_PLAYBACK_SIMPLE_TESTS=(test-playback)
 ALG_MULTI_MODE_TESTS=(crossover)
 ALG_MULTI_SIMPLE_TESTS=(test-playback)
 ALG_MULTI_PIPE_AMOUNT=(2 3 4)
@@ -262,6 +264,19 @@ do
 				simple_test codec $mode "SSP${ssp}-Codec" s32le SSP $ssp s32le 32 32 3072000 24576000 $protocol $mclk_id 1 ALG_SINGLE_SIMPLE_TESTS[@]
 			done
 
+			for mode in ${ALG_PLAYBACK_MODE_TESTS[@]}
+			do
+				simple_test codec $mode "SSP${ssp}-Codec" s16le SSP $ssp \
+					s16le 16 16 1536000 24576000 \
+					$protocol $mclk_id 1 ALG_PLAYBACK_SIMPLE_TESTS[@]
+				simple_test codec $mode "SSP${ssp}-Codec" s24le SSP $ssp \
+					s24le 32 24 3072000 24576000 \
+					$protocol $mclk_id 1 ALG_PLAYBACK_SIMPLE_TESTS[@]
+				simple_test codec $mode "SSP${ssp}-Codec" s32le SSP $ssp \
+					s32le 32 32 3072000 24576000 \
+					$protocol $mclk_id 1 ALG_PLAYBACK_SIMPLE_TESTS[@]
+			done
+
 			for mode in ${ALG_MULTI_MODE_TESTS[@]}
 			do
 				for pipe_num in ${ALG_MULTI_PIPE_AMOUNT[@]}
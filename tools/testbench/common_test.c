@@ -212,6 +212,7 @@ int tb_pipeline_params(struct ipc *ipc, struct pipeline *p,
 		params.params.sample_valid_bytes = 3;
 		break;
 	case SOF_IPC_FRAME_S32_LE:
+	case SOF_IPC_FRAME_FLOAT:
 		params.params.sample_container_bytes = 4;
 		params.params.sample_valid_bytes = 4;
 		break;
@@ -286,6 +287,118 @@ int get_index_by_uuid(struct sof_ipc_comp_ext *comp_ext,
 	return -EINVAL;
 }
 
+static struct tb_buffer_size *tb_find_buffer(struct testbench_prm *tp, const char *name)
+{
+	struct tb_buffer_size *sizes;
+	int i;
+
+	for (i = 0; i < tp->buffer_size_num; i++) {
+		if (!strcmp(tp->buffer_sizes[i].name, name))
+			return &tp->buffer_sizes[i];
+	}
+
+	sizes = realloc(tp->buffer_sizes, sizeof(*sizes) * (tp->buffer_size_num + 1));
+	if (!sizes)
+		return NULL;
+
+	tp->buffer_sizes = sizes;
+	sizes = &tp->buffer_sizes[tp->buffer_size_num];
+	sizes->name = strdup(name);
+	if (!sizes->name)
+		return NULL;
+
+	sizes->id = -1;
+	sizes->size = 0;
+	tp->buffer_size_num++;
+
+	return sizes;
+}
+
+/*
+ * Reads a buffer sizes patch as written by the calibration, one
+ * "<buffer widget name> <size in bytes>" line per buffer.
+ */
+int tb_read_buffer_sizes(struct testbench_prm *tp, const char *fn)
+{
+	struct tb_buffer_size *b;
+	char line[DEBUG_MSG_LEN];
+	char name[DEBUG_MSG_LEN];
+	unsigned int size;
+	FILE *file;
+	int ret = 0;
+
+	file = fopen(fn, "r");
+	if (!file) {
+		fprintf(stderr, "error: opening buffer sizes %s\n", fn);
+		return -errno;
+	}
+
+	while (fgets(line, sizeof(line), file)) {
+		if (line[0] == '#' || line[0] == '\n')
+			continue;
+
+		if (sscanf(line, "%1023s %u", name, &size) != 2 || !size) {
+			fprintf(stderr, "error: invalid buffer size in %s: %s", fn, line);
+			ret = -EINVAL;
+			break;
+		}
+
+		b = tb_find_buffer(tp, name);
+		if (!b) {
+			ret = -ENOMEM;
+			break;
+		}
+
+		b->size = size;
+	}
+
+	fclose(file);
+	return ret;
+}
+
+/* records a buffer loaded from the topology and applies its patched size */
+int tb_buffer_new(struct testbench_prm *tp, const char *name, int id)
+{
+	struct comp_buffer __sparse_cache *buffer_c;
+	struct tb_buffer_size *b;
+	struct ipc_comp_dev *icd;
+	int ret;
+
+	b = tb_find_buffer(tp, name);
+	if (!b)
+		return -ENOMEM;
+
+	b->id = id;
+	if (!b->size)
+		return 0;
+
+	icd = ipc_get_comp_by_id(sof_get()->ipc, id);
+	if (!icd || icd->type != COMP_TYPE_BUFFER) {
+		fprintf(stderr, "error: buffer %s not found\n", name);
+		return -EINVAL;
+	}
+
+	buffer_c = buffer_acquire(icd->cb);
+	ret = buffer_set_size(buffer_c, b->size);
+	buffer_release(buffer_c);
+	if (ret < 0)
+		fprintf(stderr, "error: buffer %s can't be %u bytes\n", name, b->size);
+
+	return ret;
+}
+
+void tb_free_buffer_sizes(struct testbench_prm *tp)
+{
+	int i;
+
+	for (i = 0; i < tp->buffer_size_num; i++)
+		free(tp->buffer_sizes[i].name);
+
+	free(tp->buffer_sizes);
+	tp->buffer_sizes = NULL;
+	tp->buffer_size_num = 0;
+}
+
 /* The following definitions are to satisfy libsof linker errors */
 
 struct dai *dai_get(uint32_t type, uint32_t index, uint32_t flags)
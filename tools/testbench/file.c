@@ -10,8 +10,15 @@
 #include <stdlib.h>
 #include <errno.h>
 #include <inttypes.h>
+#include <math.h>
+#include <strings.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sof/sof.h>
 #include <sof/list.h>
+#include <sof/string.h>
 #include <sof/audio/stream.h>
 #include <sof/audio/ipc-config.h>
 #include <sof/lib/clk.h>
@@ -79,6 +86,592 @@ static void sign_extend_source_s24(const struct audio_stream *source, int sample
 	}
 }
 
+/*
+ * The 24 valid bits of a WAV sample in a 32 bit container are the most
+ * significant ones. They are shifted to the LSB side of S24_4LE, with the
+ * sign extended, when read and back to the MSB side when written.
+ */
+
+static void wav_to_sink_s24(const struct audio_stream *sink, int samples)
+{
+	int32_t *snk = (int32_t *)sink->w_ptr;
+	size_t bytes = samples * sizeof(int32_t);
+	size_t bytes_snk;
+	int samples_avail;
+	int i;
+
+	while (bytes) {
+		bytes_snk = audio_stream_bytes_without_wrap(sink, snk);
+		samples_avail = FILE_BYTES_TO_S32_SAMPLES(MIN(bytes, bytes_snk));
+		for (i = 0; i < samples_avail; i++) {
+			*snk = *snk >> 8;
+			snk++;
+		}
+
+		bytes -= samples_avail * sizeof(int32_t);
+		snk = audio_stream_wrap(sink, snk);
+	}
+}
+
+static void source_to_wav_s24(const struct audio_stream *source, int samples)
+{
+	int32_t *src = (int32_t *)source->r_ptr;
+	size_t bytes = samples * sizeof(int32_t);
+	size_t bytes_src;
+	int samples_avail;
+	int i;
+
+	while (bytes) {
+		bytes_src = audio_stream_bytes_without_wrap(source, src);
+		samples_avail = FILE_BYTES_TO_S32_SAMPLES(MIN(bytes, bytes_src));
+		for (i = 0; i < samples_avail; i++) {
+			*src = (uint32_t)*src << 8;
+			src++;
+		}
+
+		bytes -= samples_avail * sizeof(int32_t);
+		src = audio_stream_wrap(source, src);
+	}
+}
+
+/*
+ * Memory mapped input. Raw and WAV files are mapped as a whole and the
+ * samples are copied from the mapping straight into the sink stream.
+ */
+
+static int file_map(const char *fn, uint8_t **map, size_t *size)
+{
+	struct stat st;
+	void *addr;
+	int fd;
+
+	fd = open(fn, O_RDONLY);
+	if (fd < 0)
+		return -errno;
+
+	if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode) || !st.st_size) {
+		close(fd);
+		return -EINVAL;
+	}
+
+	addr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (addr == MAP_FAILED)
+		return -errno;
+
+	madvise(addr, st.st_size, MADV_SEQUENTIAL);
+	*map = addr;
+	*size = st.st_size;
+	return 0;
+}
+
+static int read_mapped(struct file_comp_data *cd, const struct audio_stream *sink, int samples,
+		       size_t sample_bytes)
+{
+	uint8_t *snk = sink->w_ptr;
+	size_t bytes = MIN(samples * sample_bytes, cd->fs.map_end - cd->fs.map_pos);
+	size_t bytes_snk;
+	size_t copied = 0;
+
+	/* a truncated last sample is not read */
+	bytes -= bytes % sample_bytes;
+	if (!bytes) {
+		cd->fs.reached_eof = true;
+		return 0;
+	}
+
+	while (bytes) {
+		bytes_snk = MIN(bytes, audio_stream_bytes_without_wrap(sink, snk));
+		memcpy_s(snk, bytes_snk, cd->fs.map + cd->fs.map_pos, bytes_snk);
+		cd->fs.map_pos += bytes_snk;
+		copied += bytes_snk;
+		bytes -= bytes_snk;
+		snk = audio_stream_wrap(sink, snk + bytes_snk);
+	}
+
+	return copied / sample_bytes;
+}
+
+/*
+ * WAV files, both RIFF and the RF64 variant for data over 4 GB. PCM
+ * in 16 bit, 24 bit in 32 bit container and 32 bit is supported. The
+ * 24 bit samples are left-justified in the container, as in any other
+ * tool, and converted to and from S24_4LE on read and write.
+ */
+
+#define FILE_WAV_FORMAT_PCM		0x0001
+#define FILE_WAV_FORMAT_FLOAT		0x0003
+#define FILE_WAV_FORMAT_EXTENSIBLE	0xfffe
+#define FILE_WAV_FMT_BYTES		16
+#define FILE_WAV_FMT_EXT_BYTES		40
+#define FILE_WAV_DS64_BYTES		28
+#define FILE_WAV_SIZE_RF64		0xffffffff
+
+/* chunk offsets of the header written to output files */
+#define FILE_WAV_JUNK_OFFSET		12
+#define FILE_WAV_FMT_OFFSET		(FILE_WAV_JUNK_OFFSET + 8 + FILE_WAV_DS64_BYTES)
+
+/* KSDATAFORMAT_SUBTYPE_PCM */
+static const uint8_t file_wav_subtype_pcm[16] = {
+	0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00,
+	0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71,
+};
+
+static uint16_t get_le16(const uint8_t *p)
+{
+	return p[0] | p[1] << 8;
+}
+
+static uint32_t get_le32(const uint8_t *p)
+{
+	return get_le16(p) | (uint32_t)get_le16(p + 2) << 16;
+}
+
+static uint64_t get_le64(const uint8_t *p)
+{
+	return get_le32(p) | (uint64_t)get_le32(p + 4) << 32;
+}
+
+static uint8_t *put_le16(uint8_t *p, uint16_t v)
+{
+	p[0] = v;
+	p[1] = v >> 8;
+	return p + 2;
+}
+
+static uint8_t *put_le32(uint8_t *p, uint32_t v)
+{
+	put_le16(p, v);
+	return put_le16(p + 2, v >> 16);
+}
+
+static uint8_t *put_le64(uint8_t *p, uint64_t v)
+{
+	put_le32(p, v);
+	return put_le32(p + 4, v >> 32);
+}
+
+static uint8_t *put_id(uint8_t *p, const char *id)
+{
+	memcpy_s(p, 4, id, 4);
+	return p + 4;
+}
+
+static int file_wav_parse_fmt(const uint8_t *fmt, uint64_t size, struct file_wav_info *wav)
+{
+	uint16_t tag = get_le16(fmt);
+	uint16_t block_align;
+	uint16_t bits;
+	uint32_t container;
+
+	if (size < FILE_WAV_FMT_BYTES)
+		return -EINVAL;
+
+	wav->channels = get_le16(fmt + 2);
+	wav->rate = get_le32(fmt + 4);
+	block_align = get_le16(fmt + 12);
+	bits = get_le16(fmt + 14);
+
+	/* extensible format carries the valid bits and the real format tag */
+	if (tag == FILE_WAV_FORMAT_EXTENSIBLE && size >= FILE_WAV_FMT_EXT_BYTES) {
+		bits = get_le16(fmt + 18);
+		tag = get_le16(fmt + 24);
+	}
+
+	if ((tag != FILE_WAV_FORMAT_PCM && tag != FILE_WAV_FORMAT_FLOAT) ||
+	    !wav->channels || !wav->rate)
+		return -EINVAL;
+
+	container = block_align / wav->channels;
+	if (tag == FILE_WAV_FORMAT_FLOAT) {
+		if (container != 4 || bits != 32)
+			return -EINVAL;
+		wav->frame_fmt = SOF_IPC_FRAME_FLOAT;
+	} else if (container == 2 && bits == 16)
+		wav->frame_fmt = SOF_IPC_FRAME_S16_LE;
+	else if (container == 4 && bits == 24)
+		wav->frame_fmt = SOF_IPC_FRAME_S24_4LE;
+	else if (container == 4 && bits == 32)
+		wav->frame_fmt = SOF_IPC_FRAME_S32_LE;
+	else
+		return -EINVAL;
+
+	return 0;
+}
+
+static int file_wav_parse(const uint8_t *map, size_t size, struct file_wav_info *wav)
+{
+	const uint8_t *chunk;
+	uint64_t ds64_data_size = 0;
+	uint64_t chunk_size;
+	size_t pos = 12;
+	bool have_fmt = false;
+	bool rf64;
+	int ret;
+
+	if (size < pos || memcmp(map + 8, "WAVE", 4))
+		return -EINVAL;
+
+	if (!memcmp(map, "RF64", 4))
+		rf64 = true;
+	else if (!memcmp(map, "RIFF", 4))
+		rf64 = false;
+	else
+		return -EINVAL;
+
+	while (pos + 8 <= size) {
+		chunk = map + pos;
+		chunk_size = get_le32(chunk + 4);
+		pos += 8;
+
+		if (!memcmp(chunk, "ds64", 4) && chunk_size >= 24 && pos + 24 <= size) {
+			ds64_data_size = get_le64(chunk + 16);
+		} else if (!memcmp(chunk, "fmt ", 4) && pos + chunk_size <= size) {
+			ret = file_wav_parse_fmt(chunk + 8, chunk_size, wav);
+			if (ret < 0)
+				return ret;
+			have_fmt = true;
+		} else if (!memcmp(chunk, "data", 4)) {
+			if (!have_fmt)
+				return -EINVAL;
+
+			if (rf64 && chunk_size == FILE_WAV_SIZE_RF64)
+				chunk_size = ds64_data_size;
+
+			/* tolerate files truncated during capture */
+			wav->data_offset = pos;
+			wav->data_size = MIN(chunk_size, size - pos);
+			return 0;
+		}
+
+		/* chunks are word aligned */
+		pos += chunk_size + (chunk_size & 1);
+	}
+
+	return -EINVAL;
+}
+
+int file_wav_probe(const char *fn, struct file_wav_info *wav)
+{
+	uint8_t *map = NULL;
+	size_t size = 0;
+	int ret;
+
+	ret = file_map(fn, &map, &size);
+	if (ret < 0)
+		return ret;
+
+	ret = file_wav_parse(map, size, wav);
+	munmap(map, size);
+	return ret;
+}
+
+/*
+ * The header has a JUNK chunk reserving room for the ds64 chunk, it's
+ * converted to RF64 on close if the data went over the RIFF size limit.
+ */
+static int file_wav_write_header(struct file_comp_data *cd, const struct audio_stream *stream)
+{
+	uint8_t header[FILE_WAV_FMT_OFFSET + 8 + FILE_WAV_FMT_EXT_BYTES + 8] = { 0 };
+	uint32_t bytes = get_sample_bytes(stream->frame_fmt);
+	uint32_t bits = stream->frame_fmt == SOF_IPC_FRAME_S24_4LE ? 24 : bytes * 8;
+	bool extensible = bits != bytes * 8;
+	uint8_t *p = header;
+
+	p = put_id(p, "RIFF");
+	p = put_le32(p, 0);
+	p = put_id(p, "WAVE");
+	p = put_id(p, "JUNK");
+	p = put_le32(p, FILE_WAV_DS64_BYTES);
+	p += FILE_WAV_DS64_BYTES;
+
+	p = put_id(p, "fmt ");
+	p = put_le32(p, extensible ? FILE_WAV_FMT_EXT_BYTES : FILE_WAV_FMT_BYTES);
+	if (extensible)
+		p = put_le16(p, FILE_WAV_FORMAT_EXTENSIBLE);
+	else if (stream->frame_fmt == SOF_IPC_FRAME_FLOAT)
+		p = put_le16(p, FILE_WAV_FORMAT_FLOAT);
+	else
+		p = put_le16(p, FILE_WAV_FORMAT_PCM);
+	p = put_le16(p, stream->channels);
+	p = put_le32(p, stream->rate);
+	p = put_le32(p, stream->rate * stream->channels * bytes);
+	p = put_le16(p, stream->channels * bytes);
+	p = put_le16(p, bytes * 8);
+	if (extensible) {
+		p = put_le16(p, FILE_WAV_FMT_EXT_BYTES - FILE_WAV_FMT_BYTES - 2);
+		p = put_le16(p, bits);
+		p = put_le32(p, 0);
+		memcpy_s(p, sizeof(file_wav_subtype_pcm), file_wav_subtype_pcm,
+			 sizeof(file_wav_subtype_pcm));
+		p += sizeof(file_wav_subtype_pcm);
+	}
+
+	p = put_id(p, "data");
+	p = put_le32(p, 0);
+
+	cd->fs.wav_header_bytes = p - header;
+	if (fwrite(header, cd->fs.wav_header_bytes, 1, cd->fs.wfh) != 1) {
+		cd->fs.write_failed = true;
+		return -EIO;
+	}
+
+	return 0;
+}
+
+/* patches the chunk sizes once the length of the data is known */
+static void file_wav_finish(struct file_comp_data *cd)
+{
+	uint8_t ds64[8 + FILE_WAV_DS64_BYTES];
+	uint8_t size[4];
+	uint64_t data_bytes;
+	uint64_t riff_bytes;
+	long end;
+	uint8_t *p;
+
+	end = ftell(cd->fs.wfh);
+	if (end < 0)
+		return;
+
+	data_bytes = end - cd->fs.wav_header_bytes;
+	if (data_bytes & 1) {
+		fputc(0, cd->fs.wfh);
+		end++;
+	}
+
+	riff_bytes = end - 8;
+	if (riff_bytes <= UINT32_MAX - 1) {
+		put_le32(size, riff_bytes);
+		fseek(cd->fs.wfh, 4, SEEK_SET);
+		fwrite(size, sizeof(size), 1, cd->fs.wfh);
+		put_le32(size, data_bytes);
+	} else {
+		fseek(cd->fs.wfh, 0, SEEK_SET);
+		fwrite("RF64", 4, 1, cd->fs.wfh);
+		put_le32(size, FILE_WAV_SIZE_RF64);
+		fwrite(size, sizeof(size), 1, cd->fs.wfh);
+
+		p = put_id(ds64, "ds64");
+		p = put_le32(p, FILE_WAV_DS64_BYTES);
+		p = put_le64(p, riff_bytes);
+		p = put_le64(p, data_bytes);
+		p = put_le64(p, 0);	/* sample count, only needed for non PCM */
+		put_le32(p, 0);		/* table length */
+		fseek(cd->fs.wfh, FILE_WAV_JUNK_OFFSET, SEEK_SET);
+		fwrite(ds64, sizeof(ds64), 1, cd->fs.wfh);
+	}
+
+	fseek(cd->fs.wfh, cd->fs.wav_header_bytes - 4, SEEK_SET);
+	fwrite(size, sizeof(size), 1, cd->fs.wfh);
+}
+
+/*
+ * Signal generator input. Instead of a file name the input can be
+ *
+ *   sine:<f>[:<seconds>]                 same sine on every channel
+ *   multitone:<f1>+<f2>+...[:<seconds>]  sum of sines on every channel
+ *   sweep:<f1>+<f2>[:<seconds>]          logarithmic sweep from f1 to f2
+ *
+ * with frequencies in Hz. The peak level is -6 dBFS and the default
+ * length is one second. The signals come from the firmware oscillator
+ * bank, so a generated input costs no disk access.
+ */
+static const char * const file_gen_names[] = {
+	[FILE_GEN_SINE] = "sine:",
+	[FILE_GEN_MULTITONE] = "multitone:",
+	[FILE_GEN_SWEEP] = "sweep:",
+};
+
+static bool file_gen_match(const char *spec)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(file_gen_names); i++)
+		if (!strncmp(spec, file_gen_names[i], strlen(file_gen_names[i])))
+			return true;
+
+	return false;
+}
+
+static int file_gen_parse(const char *spec, struct file_gen *gen)
+{
+	const char *p = NULL;
+	char *end;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(file_gen_names); i++) {
+		if (!strncmp(spec, file_gen_names[i], strlen(file_gen_names[i]))) {
+			p = spec + strlen(file_gen_names[i]);
+			break;
+		}
+	}
+
+	if (!p)
+		return -EINVAL;
+
+	gen->type = i;
+	gen->num_freq = 0;
+	gen->duration = FILE_GEN_DURATION;
+	do {
+		if (gen->num_freq == FILE_GEN_MAX_TONES)
+			return -EINVAL;
+
+		gen->freq[gen->num_freq] = strtod(p, &end);
+		if (end == p || gen->freq[gen->num_freq] <= 0)
+			return -EINVAL;
+
+		gen->num_freq++;
+		p = end + 1;
+	} while (*end == '+');
+
+	if (*end == ':') {
+		gen->duration = strtod(p, &end);
+		if (end == p || gen->duration <= 0)
+			return -EINVAL;
+	}
+
+	if (*end)
+		return -EINVAL;
+
+	switch (gen->type) {
+	case FILE_GEN_SINE:
+		return gen->num_freq == 1 ? 0 : -EINVAL;
+	case FILE_GEN_SWEEP:
+		return gen->num_freq == 2 ? 0 : -EINVAL;
+	default:
+		return 0;
+	}
+}
+
+static int32_t file_gen_freq(double f)
+{
+	return Q_CONVERT_FLOAT(f, 16);
+}
+
+static int file_gen_init(struct file_gen *gen, uint32_t rate, uint32_t channels)
+{
+	int32_t amplitude = Q_CONVERT_FLOAT(FILE_GEN_AMPLITUDE, 31);
+	int i;
+
+	if (!rate || !channels)
+		return -EINVAL;
+
+	gen->rate = rate;
+	gen->frames_left = gen->duration * rate;
+	switch (gen->type) {
+	case FILE_GEN_SINE:
+		/* one oscillator per channel for the bank */
+		if (channels > FILE_GEN_MAX_TONES)
+			return -EINVAL;
+
+		gen->num_osc = channels;
+		for (i = 0; i < gen->num_osc; i++)
+			osc_init(&gen->osc[i], file_gen_freq(gen->freq[0]), rate, amplitude);
+		break;
+	case FILE_GEN_MULTITONE:
+		gen->num_osc = gen->num_freq;
+		for (i = 0; i < gen->num_osc; i++)
+			osc_init(&gen->osc[i], file_gen_freq(gen->freq[i]), rate,
+				 amplitude / gen->num_osc);
+		break;
+	case FILE_GEN_SWEEP:
+		gen->num_osc = 1;
+		gen->sweep_frames = MAX(rate / FILE_GEN_SWEEP_UPDATE, 1);
+		gen->sweep_count = 0;
+		gen->sweep_freq = gen->freq[0];
+		gen->sweep_coef = pow(gen->freq[1] / gen->freq[0],
+				      (double)gen->sweep_frames / MAX(gen->frames_left, 1));
+		osc_init(&gen->osc[0], file_gen_freq(gen->sweep_freq), rate, amplitude);
+		break;
+	}
+
+	return 0;
+}
+
+/* generates frames of nch interleaved Q1.31 samples */
+static void file_gen_block(struct file_gen *gen, int32_t *y, int nch, int frames)
+{
+	int n;
+	int i;
+	int j;
+
+	switch (gen->type) {
+	case FILE_GEN_SINE:
+		osc_bank_sin(gen->osc, nch, y, frames);
+		return;
+	case FILE_GEN_MULTITONE:
+		osc_bank_sum(gen->osc, gen->num_osc, y, nch, frames);
+		break;
+	case FILE_GEN_SWEEP:
+		for (i = 0; i < frames; i += n) {
+			n = MIN(frames - i, gen->sweep_frames - gen->sweep_count);
+			osc_sin_block(&gen->osc[0], y + i * nch, nch, n);
+			gen->sweep_count += n;
+			if (gen->sweep_count == gen->sweep_frames) {
+				gen->sweep_count = 0;
+				gen->sweep_freq *= gen->sweep_coef;
+				osc_set_freq(&gen->osc[0], file_gen_freq(gen->sweep_freq),
+					     gen->rate);
+			}
+		}
+		break;
+	}
+
+	/* copy the first channel to the others */
+	for (i = 0; i < frames; i++)
+		for (j = 1; j < nch; j++)
+			y[i * nch + j] = y[i * nch];
+}
+
+static int read_generated(struct file_comp_data *cd, const struct audio_stream *sink, int samples,
+			  int fmt)
+{
+	int32_t buf[FILE_GEN_BLOCK_SAMPLES];
+	struct file_gen *gen = &cd->fs.gen;
+	int nch = sink->channels;
+	int16_t *snk16 = sink->w_ptr;
+	int32_t *snk32 = sink->w_ptr;
+	int frames = samples / nch;
+	int samples_copied = 0;
+	int n;
+	int i;
+
+	frames = MIN(frames, gen->frames_left);
+	while (frames) {
+		n = MIN(frames, FILE_GEN_BLOCK_SAMPLES / nch);
+		file_gen_block(gen, buf, nch, n);
+		for (i = 0; i < n * nch; i++) {
+			switch (fmt) {
+			case SOF_IPC_FRAME_S16_LE:
+				*snk16 = sat_int16(Q_SHIFT_RND(buf[i], 31, 15));
+				snk16 = audio_stream_wrap(sink, snk16 + 1);
+				break;
+			case SOF_IPC_FRAME_S24_4LE:
+				*snk32 = sat_int24(Q_SHIFT_RND(buf[i], 31, 23));
+				snk32 = audio_stream_wrap(sink, snk32 + 1);
+				break;
+			case SOF_IPC_FRAME_FLOAT:
+				*(float *)snk32 = ldexpf(buf[i], -31);
+				snk32 = audio_stream_wrap(sink, snk32 + 1);
+				break;
+			default:
+				*snk32 = buf[i];
+				snk32 = audio_stream_wrap(sink, snk32 + 1);
+				break;
+			}
+		}
+
+		samples_copied += n * nch;
+		gen->frames_left -= n;
+		frames -= n;
+	}
+
+	if (!gen->frames_left)
+		cd->fs.reached_eof = 1;
+
+	return samples_copied;
+}
+
 /*
  * Read 32-bit samples from binary file
  */
@@ -204,19 +797,30 @@ static int read_samples_s32(struct file_comp_data *cd, const struct audio_stream
 
 	switch (cd->fs.f_format) {
 	case FILE_RAW:
-		/* raw input file */
-		n_samples = read_binary_s32(cd, sink, samples);
+	case FILE_WAV:
+		/* raw or wav input file */
+		if (cd->fs.map)
+			n_samples = read_mapped(cd, sink, samples, sizeof(int32_t));
+		else
+			n_samples = read_binary_s32(cd, sink, samples);
 		break;
 	case FILE_TEXT:
 		/* text input file */
 		n_samples = read_text_s32(cd, sink, samples);
 		break;
+	case FILE_GEN:
+		n_samples = read_generated(cd, sink, samples, fmt);
+		break;
 	default:
 		return -EINVAL;
 	}
 
-	if (fmt == SOF_IPC_FRAME_S24_4LE)
-		mask_sink_s24(sink, samples);
+	if (fmt == SOF_IPC_FRAME_S24_4LE) {
+		if (cd->fs.f_format == FILE_WAV)
+			wav_to_sink_s24(sink, n_samples);
+		else
+			mask_sink_s24(sink, samples);
+	}
 
 	return n_samples;
 }
@@ -229,12 +833,17 @@ static int write_samples_s32(struct file_comp_data *cd, struct audio_stream *sou
 {
 	int samples_written;
 
-	if (fmt == SOF_IPC_FRAME_S24_4LE)
-		sign_extend_source_s24(source, samples);
+	if (fmt == SOF_IPC_FRAME_S24_4LE) {
+		if (cd->fs.f_format == FILE_WAV)
+			source_to_wav_s24(source, samples);
+		else
+			sign_extend_source_s24(source, samples);
+	}
 
 	switch (cd->fs.f_format) {
 	case FILE_RAW:
-		/* raw input file */
+	case FILE_WAV:
+		/* raw or wav output file */
 		samples_written = write_binary_s32(cd, source, samples);
 		break;
 	case FILE_TEXT:
@@ -373,13 +982,20 @@ static int read_samples_s16(struct file_comp_data *cd, const struct audio_stream
 
 	switch (cd->fs.f_format) {
 	case FILE_RAW:
-		/* raw input file */
-		n_samples = read_binary_s16(cd, sink, samples);
+	case FILE_WAV:
+		/* raw or wav input file */
+		if (cd->fs.map)
+			n_samples = read_mapped(cd, sink, samples, sizeof(int16_t));
+		else
+			n_samples = read_binary_s16(cd, sink, samples);
 		break;
 	case FILE_TEXT:
 		/* text input file */
 		n_samples = read_text_s16(cd, sink, samples);
 		break;
+	case FILE_GEN:
+		n_samples = read_generated(cd, sink, samples, SOF_IPC_FRAME_S16_LE);
+		break;
 	default:
 		return -EINVAL;
 	}
@@ -396,7 +1012,8 @@ static int write_samples_s16(struct file_comp_data *cd, struct audio_stream *sou
 
 	switch (cd->fs.f_format) {
 	case FILE_RAW:
-		/* raw input file */
+	case FILE_WAV:
+		/* raw or wav output file */
 		samples_written = write_binary_s16(cd, source, samples);
 		break;
 	case FILE_TEXT:
@@ -451,6 +1068,40 @@ static int file_s32(struct comp_dev *dev, struct audio_stream *sink,
 	return n_samples;
 }
 
+/* function for processing float samples, raw and wav files are copied as is */
+static int file_float(struct comp_dev *dev, struct audio_stream *sink,
+		      struct audio_stream *source, uint32_t frames)
+{
+	struct dai_data *dd = comp_get_drvdata(dev);
+	struct file_comp_data *cd = comp_get_drvdata(dd->dai);
+	int nch;
+	int n_samples = 0;
+
+	switch (cd->fs.mode) {
+	case FILE_READ:
+		/* read samples */
+		nch = sink->channels;
+		n_samples = read_samples_s32(cd, sink, frames * nch, SOF_IPC_FRAME_FLOAT);
+		break;
+	case FILE_WRITE:
+		/* write samples */
+		nch = source->channels;
+		n_samples = write_samples_s32(cd, source, frames * nch, SOF_IPC_FRAME_FLOAT);
+		break;
+	default:
+		/* TODO: duplex mode */
+		fprintf(stderr, "Error: Unknown file mode %d\n", cd->fs.mode);
+		return -EINVAL;
+	}
+
+	/* update sample counter and check if we have a sample limit */
+	cd->fs.n += n_samples;
+	if (cd->max_samples && cd->fs.n >= cd->max_samples)
+		cd->fs.reached_eof = 1;
+
+	return n_samples;
+}
+
 /* function for processing 16-bit samples */
 static int file_s16(struct comp_dev *dev, struct audio_stream *sink,
 		    struct audio_stream *source, uint32_t frames)
@@ -523,15 +1174,59 @@ static enum file_format get_file_format(char *filename)
 {
 	char *ext = strrchr(filename, '.');
 
+	if (file_gen_match(filename))
+		return FILE_GEN;
+
 	if (!ext)
 		return FILE_RAW;
 
 	if (!strcmp(ext, ".txt"))
 		return FILE_TEXT;
 
+	if (!strcasecmp(ext, ".wav"))
+		return FILE_WAV;
+
 	return FILE_RAW;
 }
 
+/*
+ * Maps raw and wav input, text is read with stdio. Raw input that can't
+ * be mapped, e.g. a pipe, falls back to stdio too.
+ */
+static int file_open_mapped(struct file_comp_data *cd)
+{
+	int ret;
+
+	if (cd->fs.f_format == FILE_TEXT)
+		return 0;
+
+	ret = file_map(cd->fs.fn, &cd->fs.map, &cd->fs.map_size);
+	if (ret < 0) {
+		if (cd->fs.f_format == FILE_RAW)
+			return 0;
+
+		fprintf(stderr, "error: mapping file %s - %s\n", cd->fs.fn, strerror(-ret));
+		return ret;
+	}
+
+	cd->fs.map_pos = 0;
+	cd->fs.map_end = cd->fs.map_size;
+	if (cd->fs.f_format != FILE_WAV)
+		return 0;
+
+	ret = file_wav_parse(cd->fs.map, cd->fs.map_size, &cd->fs.wav);
+	if (ret < 0) {
+		fprintf(stderr, "error: %s is not a supported PCM wav file\n", cd->fs.fn);
+		munmap(cd->fs.map, cd->fs.map_size);
+		cd->fs.map = NULL;
+		return ret;
+	}
+
+	cd->fs.map_pos = cd->fs.wav.data_offset;
+	cd->fs.map_end = cd->fs.wav.data_offset + cd->fs.wav.data_size;
+	return 0;
+}
+
 static struct comp_dev *file_new(const struct comp_driver *drv,
 				 struct comp_ipc_config *config,
 				 void *spec)
@@ -592,20 +1287,39 @@ static struct comp_dev *file_new(const struct comp_driver *drv,
 	/* open file handle(s) depending on mode */
 	switch (cd->fs.mode) {
 	case FILE_READ:
+		if (cd->fs.f_format == FILE_GEN) {
+			if (file_gen_parse(cd->fs.fn, &cd->fs.gen) < 0) {
+				fprintf(stderr, "error: invalid signal %s\n", cd->fs.fn);
+				goto error;
+			}
+			break;
+		}
+
 		cd->fs.rfh = fopen(cd->fs.fn, "r");
 		if (!cd->fs.rfh) {
 			fprintf(stderr, "error: opening file %s for reading - %s\n",
 				cd->fs.fn, strerror(errno));
 			goto error;
 		}
+
+		if (file_open_mapped(cd) < 0)
+			goto error_close;
 		break;
 	case FILE_WRITE:
+		if (cd->fs.f_format == FILE_GEN) {
+			fprintf(stderr, "error: signal %s can't be an output\n", cd->fs.fn);
+			goto error;
+		}
+
 		cd->fs.wfh = fopen(cd->fs.fn, "w+");
 		if (!cd->fs.wfh) {
 			fprintf(stderr, "error: opening file %s for writing - %s\n",
 				cd->fs.fn, strerror(errno));
 			goto error;
 		}
+
+		/* write to disk in large blocks */
+		setvbuf(cd->fs.wfh, NULL, _IOFBF, FILE_WRITE_BUF_SIZE);
 		break;
 	default:
 		/* TODO: duplex mode */
@@ -620,7 +1334,11 @@ static struct comp_dev *file_new(const struct comp_driver *drv,
 	dev->state = COMP_STATE_READY;
 	return dev;
 
+error_close:
+	fclose(cd->fs.rfh);
+
 error:
+	free(cd->fs.fn);
 	free(cd);
 
 error_skip_cd:
@@ -644,10 +1362,16 @@ static void file_free(struct comp_dev *dev)
 
 	comp_dbg(dev, "file_free()");
 
-	if (cd->fs.mode == FILE_READ)
-		fclose(cd->fs.rfh);
-	else
+	if (cd->fs.mode == FILE_READ) {
+		if (cd->fs.map)
+			munmap(cd->fs.map, cd->fs.map_size);
+		if (cd->fs.rfh)
+			fclose(cd->fs.rfh);
+	} else {
+		if (cd->fs.f_format == FILE_WAV && cd->fs.wav_header_bytes)
+			file_wav_finish(cd);
 		fclose(cd->fs.wfh);
+	}
 
 	free(cd->fs.fn);
 	free(cd);
@@ -750,6 +1474,21 @@ static int file_params(struct comp_dev *dev,
 		/* set file function */
 		cd->file_func = file_s32;
 		break;
+	case SOF_IPC_FRAME_FLOAT:
+		if (cd->fs.f_format == FILE_TEXT) {
+			fprintf(stderr, "error: text files are not supported for float\n");
+			return -EINVAL;
+		}
+
+		ret = buffer_set_size(buffer, samples * sizeof(float));
+		if (ret < 0) {
+			fprintf(stderr, "error: file buffer size set\n");
+			return ret;
+		}
+
+		/* set file function */
+		cd->file_func = file_float;
+		break;
 	default:
 		fprintf(stderr, "Warning: Unknown file sample format %d\n",
 			dev->ipc_config.frame_fmt);
@@ -759,6 +1498,38 @@ static int file_params(struct comp_dev *dev,
 	cd->sample_container_bytes = get_sample_bytes(stream->frame_fmt);
 	buffer_reset_pos(buffer, NULL);
 
+	if (cd->fs.f_format == FILE_GEN) {
+		if (cd->fs.mode != FILE_READ ||
+		    file_gen_init(&cd->fs.gen, stream->rate, stream->channels) < 0) {
+			fprintf(stderr, "error: can't generate %s with %u channels at %u Hz\n",
+				cd->fs.fn, stream->channels, stream->rate);
+			return -EINVAL;
+		}
+		return 0;
+	}
+
+	if (cd->fs.f_format != FILE_WAV)
+		return 0;
+
+	if (cd->fs.mode == FILE_WRITE) {
+		if (!cd->fs.wav_header_bytes)
+			return file_wav_write_header(cd, stream);
+		return 0;
+	}
+
+	/* the stream must match the wav, no conversion is done */
+	if (cd->fs.wav.frame_fmt != stream->frame_fmt ||
+	    cd->fs.wav.channels != stream->channels) {
+		fprintf(stderr, "error: %s has format %d with %u channels, stream %d with %u\n",
+			cd->fs.fn, cd->fs.wav.frame_fmt, cd->fs.wav.channels,
+			stream->frame_fmt, stream->channels);
+		return -EINVAL;
+	}
+
+	if (cd->fs.wav.rate != stream->rate)
+		fprintf(stderr, "warning: %s has rate %u, stream %u\n",
+			cd->fs.fn, cd->fs.wav.rate, stream->rate);
+
 	return 0;
 }
 
@@ -794,6 +1565,36 @@ static int file_cmd(struct comp_dev *dev, int cmd, void *data,
 	return ret;
 }
 
+/*
+ * Frames a copy may move when simulating DMA jitter. Each copy deviates
+ * randomly from the period by up to jitter_frames, and the frames moved
+ * ahead of or behind the period are paid back so the average rate stays
+ * the nominal one.
+ */
+static int file_jitter_frames(struct comp_dev *dev, struct file_comp_data *cd)
+{
+	int jitter = cd->jitter_frames;
+	int frames;
+
+	frames = (int)dev->frames - cd->fs.jitter_debt + rand() % (2 * jitter + 1) - jitter;
+
+	return MIN(MAX(frames, 0), (int)dev->frames + 2 * jitter);
+}
+
+/* a stalled side catches up by at most a period and the jitter */
+static void file_jitter_update(struct comp_dev *dev, struct file_comp_data *cd,
+			       int samples, int channels)
+{
+	int limit = dev->frames + cd->jitter_frames;
+	int debt;
+
+	if (!cd->jitter_frames || samples < 0 || !channels)
+		return;
+
+	debt = cd->fs.jitter_debt + samples / channels - (int)dev->frames;
+	cd->fs.jitter_debt = MIN(MAX(debt, -limit), limit);
+}
+
 /*
  * copy and process stream samples
  * returns the number of bytes copied
@@ -815,7 +1616,8 @@ static int file_copy(struct comp_dev *dev)
 					 source_list);
 
 		/* test sink has enough free frames */
-		snk_frames = MIN(audio_stream_get_free_frames(&buffer->stream), dev->frames);
+		snk_frames = cd->jitter_frames ? file_jitter_frames(dev, cd) : dev->frames;
+		snk_frames = MIN(audio_stream_get_free_frames(&buffer->stream), snk_frames);
 		if (snk_frames > 0 && !cd->fs.reached_eof) {
 			/* read PCM samples from file */
 			ret = cd->file_func(dev, &buffer->stream, NULL,
@@ -826,6 +1628,7 @@ static int file_copy(struct comp_dev *dev)
 				comp_update_buffer_produce(buffer,
 							   ret * bytes);
 		}
+		file_jitter_update(dev, cd, ret, buffer->stream.channels);
 		break;
 	case FILE_WRITE:
 		/* file component source buffer */
@@ -834,6 +1637,8 @@ static int file_copy(struct comp_dev *dev)
 
 		/* test source has enough free frames */
 		src_frames = audio_stream_get_avail_frames(&buffer->stream);
+		if (cd->jitter_frames)
+			src_frames = MIN(src_frames, file_jitter_frames(dev, cd));
 		if (src_frames > 0) {
 			/* write PCM samples into file */
 			ret = cd->file_func(dev, NULL, &buffer->stream,
@@ -844,6 +1649,7 @@ static int file_copy(struct comp_dev *dev)
 				comp_update_buffer_consume(buffer,
 							   ret * bytes);
 		}
+		file_jitter_update(dev, cd, ret, buffer->stream.channels);
 		break;
 	default:
 		/* TODO: duplex mode */
@@ -25,10 +25,17 @@
 #define MAX_OUTPUT_FILE_NUM	16
 
 /* number of widgets types supported in testbench */
-#define NUM_WIDGETS_SUPPORTED	15
+#define NUM_WIDGETS_SUPPORTED	16
 
 struct tplg_context;
 
+/* topology buffer, for the buffer size calibration */
+struct tb_buffer_size {
+	char *name;	/* buffer widget name */
+	int id;		/* component id, -1 if not loaded */
+	uint32_t size;	/* size from the -S patch, 0 keeps the topology size */
+};
+
 /*
  * Global testbench data.
  *
@@ -68,6 +75,12 @@ struct testbench_prm {
 	uint32_t cmd_fs_out;
 	uint32_t cmd_channels_in;
 	uint32_t cmd_channels_out;
+
+	/* buffer size calibration */
+	int jitter_frames; /* simulated DMA jitter of the file components */
+	char *calib_file; /* buffer sizes patch to write, NULL if not calibrating */
+	struct tb_buffer_size *buffer_sizes; /* buffers of the patch and topology */
+	int buffer_size_num;
 };
 
 struct shared_lib_table {
@@ -103,6 +116,12 @@ int tb_pipeline_reset(struct ipc *ipc, struct pipeline *p);
 
 void debug_print(char *message);
 
+int tb_read_buffer_sizes(struct testbench_prm *tp, const char *fn);
+
+int tb_buffer_new(struct testbench_prm *tp, const char *name, int id);
+
+void tb_free_buffer_sizes(struct testbench_prm *tp);
+
 int get_index_by_name(char *comp_name,
 		      struct shared_lib_table *lib_table);
 
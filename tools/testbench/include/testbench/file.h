@@ -11,6 +11,8 @@
 #ifndef _FILE_H
 #define _FILE_H
 
+#include <sof/math/oscillator.h>
+
 /**< Convert with right shift a bytes count to samples count */
 #define FILE_BYTES_TO_S16_SAMPLES(s)	((s) >> 1)
 #define FILE_BYTES_TO_S32_SAMPLES(s)	((s) >> 2)
@@ -25,18 +27,69 @@ enum file_mode {
 enum file_format {
 	FILE_TEXT = 0,
 	FILE_RAW,
+	FILE_WAV,	/* RIFF or RF64 */
+	FILE_GEN,	/* signal generator, see file_gen_parse() */
+};
+
+/* generated signals */
+enum file_gen_type {
+	FILE_GEN_SINE = 0,	/* same sine on every channel */
+	FILE_GEN_MULTITONE,	/* sum of sines on every channel */
+	FILE_GEN_SWEEP,		/* logarithmic sweep on every channel */
+};
+
+#define FILE_GEN_MAX_TONES	16
+#define FILE_GEN_DURATION	1.0	/* default length in seconds */
+#define FILE_GEN_AMPLITUDE	0.5	/* peak of the signal, -6 dBFS */
+#define FILE_GEN_SWEEP_UPDATE	1000	/* sweep frequency updates per second */
+#define FILE_GEN_BLOCK_SAMPLES	1024	/* samples generated per pass */
+
+/* signal generator state, the oscillators are set up at params */
+struct file_gen {
+	enum file_gen_type type;
+	double freq[FILE_GEN_MAX_TONES];	/* Hz, sweep start and end */
+	int num_freq;
+	double duration;			/* seconds */
+	struct osc_state osc[FILE_GEN_MAX_TONES];
+	int num_osc;
+	uint32_t rate;
+	uint64_t frames_left;
+	uint32_t sweep_frames;			/* frames between sweep updates */
+	uint32_t sweep_count;
+	double sweep_coef;			/* frequency multiplier per update */
+	double sweep_freq;
+};
+
+/* stdio buffer of output files */
+#define FILE_WRITE_BUF_SIZE	(1024 * 1024)
+
+/* format of a WAV file as found in its header */
+struct file_wav_info {
+	uint32_t rate;
+	uint32_t channels;
+	enum sof_ipc_frame frame_fmt;
+	size_t data_offset;
+	uint64_t data_size;
 };
 
 /* file component state */
 struct file_state {
 	char *fn;
 	FILE *rfh, *wfh; /* read/write file handle */
+	uint8_t *map;		/* input file mapped for reading, NULL if not mapped */
+	size_t map_size;
+	size_t map_pos;		/* next sample byte to read */
+	size_t map_end;		/* end of sample data */
+	struct file_wav_info wav;
+	struct file_gen gen;
+	size_t wav_header_bytes; /* header written to WAV output, 0 if not yet */
 	bool reached_eof;
 	bool write_failed;
 	int n;
 	enum file_mode mode;
 	enum file_format f_format;
 	int copy_count;
+	int jitter_debt;	/* frames moved ahead of the nominal rate */
 };
 
 /* file comp data */
@@ -52,6 +105,17 @@ struct file_comp_data {
 	/* maximum limits */
 	int max_samples;
 	int max_copies;
+
+	/* simulated DMA jitter, random deviation of the frames per copy */
+	int jitter_frames;
 };
 
+/**
+ * \brief Reads the format of a WAV file.
+ * \param[in] fn File name.
+ * \param[out] wav Format and location of the sample data.
+ * \return Error code.
+ */
+int file_wav_probe(const char *fn, struct file_wav_info *wav);
+
 #endif
@@ -16,6 +16,7 @@
 #include "testbench/trace.h"
 #include "testbench/file.h"
 #include <limits.h>
+#include <strings.h>
 
 #ifdef TESTBENCH_CACHE_CHECK
 #include <arch/lib/cache.h>
@@ -62,6 +63,9 @@ DECLARE_SOF_TB_UUID("mux", mux_uuid, 0xc607ff4d, 0x9cb6, 0x49dc,
 DECLARE_SOF_TB_UUID("demux", demux_uuid, 0xc4b26868, 0x1430, 0x470e,
 		    0xa0, 0x89, 0x15, 0xd1, 0xc7, 0x7f, 0x85, 0x1a);
 
+DECLARE_SOF_TB_UUID("selector", selector_uuid, 0x55a88ed5, 0x3d18, 0x46ca,
+		    0x88, 0xf1, 0x0e, 0xe6, 0xea, 0xe9, 0x93, 0x0f);
+
 DECLARE_SOF_TB_UUID("google-rtc-audio-processing", google_rtc_audio_processing_uuid,
 		    0xb780a0a6, 0x269f, 0x466f, 0xb4, 0x77, 0x23, 0xdf, 0xa0,
 		    0x5a, 0xf7, 0x58);
@@ -91,6 +95,7 @@ struct shared_lib_table lib_table[NUM_WIDGETS_SUPPORTED] = {
 	{"mixer", "libsof_mixer.so", SOF_COMP_MIXER, NULL, 0, NULL},
 	{"mux", "libsof_mux.so", SOF_COMP_MUX, SOF_TB_UUID(mux_uuid), 0, NULL},
 	{"demux", "libsof_mux.so", SOF_COMP_DEMUX, SOF_TB_UUID(demux_uuid), 0, NULL},
+	{"selector", "libsof_selector.so", SOF_COMP_SELECTOR, SOF_TB_UUID(selector_uuid), 0, NULL},
 	{"google-rtc-audio-processing", "libsof_google-rtc-audio-processing.so", SOF_COMP_NONE,
 		SOF_TB_UUID(google_rtc_audio_processing_uuid), 0, NULL},
 };
@@ -228,6 +233,38 @@ static int parse_libraries(char *libs)
 	return 0;
 }
 
+static void test_probe_wav_input(struct testbench_prm *tp)
+{
+	static const struct frame_types wav_formats[] = {
+		{"S16_LE", SOF_IPC_FRAME_S16_LE},
+		{"S24_LE", SOF_IPC_FRAME_S24_4LE},
+		{"S32_LE", SOF_IPC_FRAME_S32_LE},
+		{"FLOAT_LE", SOF_IPC_FRAME_FLOAT},
+	};
+	struct file_wav_info wav;
+	char *ext = strrchr(tp->input_file[0], '.');
+	int i;
+
+	if (!ext || strcasecmp(ext, ".wav") || file_wav_probe(tp->input_file[0], &wav) < 0)
+		return;
+
+	if (!tp->cmd_fs_in)
+		tp->cmd_fs_in = wav.rate;
+
+	if (!tp->cmd_channels_in)
+		tp->cmd_channels_in = wav.channels;
+
+	if (tp->bits_in)
+		return;
+
+	for (i = 0; i < ARRAY_SIZE(wav_formats); i++) {
+		if (wav_formats[i].frame == wav.frame_fmt) {
+			tp->bits_in = strdup(wav_formats[i].name);
+			tp->cmd_frame_fmt = wav.frame_fmt;
+		}
+	}
+}
+
 /* print usage for testbench */
 static void print_usage(char *executable)
 {
@@ -245,13 +282,21 @@ static void print_usage(char *executable)
 	printf("  -D <pipeline duration in ms>\n");
 	printf("  -P <number of dynamic pipeline iterations>\n");
 	printf("  -T <microseconds for tick, 0 for batch mode>\n");
-	printf("  -V <number of virtual cores>\n\n");
-	printf("Options for input and output format override:\n");
-	printf("  -b <input_format>, S16_LE, S24_LE, or S32_LE\n");
+	printf("  -V <number of virtual cores>\n");
+	printf("  -J <frames>, simulated DMA jitter of the file read and write per copy\n");
+	printf("  -B <buffer sizes file>, calibrate and write the smallest safe buffer sizes\n");
+	printf("  -S <buffer sizes file>, override the topology buffer sizes\n\n");
+	printf("Options for input and output format override, the format of\n");
+	printf("a .wav input is taken from its header by default:\n");
+	printf("  -b <input_format>, S16_LE, S24_LE, S32_LE or FLOAT_LE\n");
 	printf("  -c <input channels>\n");
 	printf("  -n <output channels>\n");
 	printf("  -r <input rate>\n");
 	printf("  -R <output rate>\n\n");
+	printf("Signals to use as input instead of a file, frequencies in Hz:\n");
+	printf("  sine:<f>[:<seconds>]\n");
+	printf("  multitone:<f1>+<f2>+...[:<seconds>]\n");
+	printf("  sweep:<f1>+<f2>[:<seconds>]\n\n");
 	printf("Environment variables\n");
 	printf("  SOF_HOST_CORE0=<i> - Map DSP core 0..N to host i..i+N\n");
 	printf("Help:\n");
@@ -345,6 +390,88 @@ static void test_pipeline_set_test_limits(int pipeline_id, int max_copies,
 	}
 }
 
+static void test_pipeline_set_jitter(int pipeline_id, int jitter_frames)
+{
+	struct list_item *clist;
+	struct ipc_comp_dev *icd;
+	struct comp_dev *cd;
+	struct dai_data *dd;
+	struct file_comp_data *fcd;
+
+	/* the file components stand in for the DMA of the pipeline */
+	list_for_item(clist, &sof_get()->ipc->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+		if (icd->type != COMP_TYPE_COMPONENT)
+			continue;
+
+		cd = icd->cd;
+		if (cd->pipeline->pipeline_id != pipeline_id)
+			continue;
+
+		switch (cd->drv->type) {
+		case SOF_COMP_HOST:
+		case SOF_COMP_DAI:
+		case SOF_COMP_FILEREAD:
+		case SOF_COMP_FILEWRITE:
+			dd = comp_get_drvdata(cd);
+			fcd = comp_get_drvdata(dd->dai);
+			fcd->jitter_frames = jitter_frames;
+			fcd->fs.jitter_debt = 0;
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+#if CONFIG_BUFFER_CALIBRATION
+/*
+ * Prints the fill levels of the topology buffers and writes their
+ * smallest safe sizes in the format -S reads. Editing the buffer sizes
+ * of the topology source to match is left to the user.
+ */
+static void test_pipeline_buffer_calib(struct testbench_prm *tp)
+{
+	struct comp_buffer __sparse_cache *buffer_c;
+	struct tb_buffer_size *b;
+	struct ipc_comp_dev *icd;
+	FILE *file;
+	uint32_t size;
+	int i;
+
+	file = fopen(tp->calib_file, "w");
+	if (!file) {
+		fprintf(stderr, "error: opening %s for writing - %s\n",
+			tp->calib_file, strerror(errno));
+		return;
+	}
+
+	fprintf(file, "# buffer widget, size in bytes\n");
+	printf("Buffer calibration, %d frames of jitter:\n", tp->jitter_frames);
+	for (i = 0; i < tp->buffer_size_num; i++) {
+		b = &tp->buffer_sizes[i];
+		icd = ipc_get_comp_by_id(sof_get()->ipc, b->id);
+		if (!icd || icd->type != COMP_TYPE_BUFFER)
+			continue;
+
+		buffer_c = buffer_acquire(icd->cb);
+		size = buffer_calib_size(buffer_c);
+		printf("%s: size %u fill %u..%u produce %u..%u consume %u..%u full %u -> %u\n",
+		       b->name, buffer_c->stream.size,
+		       buffer_c->calib.fill_min, buffer_c->calib.fill_max,
+		       buffer_c->calib.produce_min, buffer_c->calib.produce_max,
+		       buffer_c->calib.consume_min, buffer_c->calib.consume_max,
+		       buffer_c->calib.full, size);
+		buffer_release(buffer_c);
+
+		fprintf(file, "%s %u\n", b->name, size);
+	}
+
+	fclose(file);
+	printf("Buffer sizes written to \"%s\"\n", tp->calib_file);
+}
+#endif
+
 static void test_pipeline_get_file_stats(int pipeline_id)
 {
 	struct list_item *clist;
@@ -395,7 +522,7 @@ static int parse_input_args(int argc, char **argv, struct testbench_prm *tp)
 	int option = 0;
 	int ret = 0;
 
-	while ((option = getopt(argc, argv, "hdqi:o:t:b:a:r:R:c:n:C:P:Vp:T:D:")) != -1) {
+	while ((option = getopt(argc, argv, "hdqi:o:t:b:a:r:R:c:n:C:P:Vp:T:D:J:B:S:")) != -1) {
 		switch (option) {
 		/* input sample file */
 		case 'i':
@@ -483,6 +610,26 @@ static int parse_input_args(int argc, char **argv, struct testbench_prm *tp)
 			tp->pipeline_duration_ms = atoi(optarg);
 			break;
 
+		/* simulated DMA jitter in frames */
+		case 'J':
+			tp->jitter_frames = atoi(optarg);
+			break;
+
+		/* calibrate buffer sizes */
+		case 'B':
+#if CONFIG_BUFFER_CALIBRATION
+			tp->calib_file = strdup(optarg);
+#else
+			fprintf(stderr, "error: calibration needs CONFIG_BUFFER_CALIBRATION\n");
+			ret = -EINVAL;
+#endif
+			break;
+
+		/* buffer sizes patch */
+		case 'S':
+			ret = tb_read_buffer_sizes(tp, optarg);
+			break;
+
 		/* print usage */
 		default:
 			fprintf(stderr, "unknown option %c\n", option);
@@ -509,15 +656,44 @@ static struct pipeline *get_pipeline_by_id(int id)
 	return pcm_dev->cd->pipeline;
 }
 
+/* pipelines fed by another pipeline (e.g. crossover sinks) are run by it */
+static bool test_pipeline_is_connected(int id)
+{
+	struct ipc_comp_dev *pcm_dev;
+	struct ipc *ipc = sof_get()->ipc;
+
+	pcm_dev = ipc_get_ppl_src_comp(ipc, id);
+	return pcm_dev && !list_is_empty(comp_buffer_list(pcm_dev->cd, PPL_DIR_UPSTREAM));
+}
+
 static int test_pipeline_stop(struct pipeline_thread_data *ptdata)
 {
 	struct testbench_prm *tp = ptdata->tp;
 	struct pipeline *p;
 	struct ipc *ipc = sof_get()->ipc;
+	struct timespec ts = { .tv_nsec = 100000 };
 	int ret = 0;
 	int i;
 
+	/* the connected pipelines copy on after the source pipeline reached
+	 * EOF, stop their tasks too before the pipelines are walked
+	 */
 	for (i = 0; i < tp->pipeline_num; i++) {
+		p = get_pipeline_by_id(tp->pipelines[i]);
+		if (task_is_active(p->pipe_task))
+			schedule_task_cancel(p->pipe_task);
+	}
+
+	for (i = 0; i < tp->pipeline_num; i++) {
+		p = get_pipeline_by_id(tp->pipelines[i]);
+		while (task_is_active(p->pipe_task))
+			nanosleep(&ts, NULL);
+	}
+
+	for (i = 0; i < tp->pipeline_num; i++) {
+		if (test_pipeline_is_connected(tp->pipelines[i]))
+			continue;
+
 		p = get_pipeline_by_id(tp->pipelines[i]);
 		ret = tb_pipeline_stop(ipc, p);
 		if (ret < 0)
@@ -536,6 +712,9 @@ static int test_pipeline_reset(struct pipeline_thread_data *ptdata)
 	int i;
 
 	for (i = 0; i < tp->pipeline_num; i++) {
+		if (test_pipeline_is_connected(tp->pipelines[i]))
+			continue;
+
 		p = get_pipeline_by_id(tp->pipelines[i]);
 		ret = tb_pipeline_reset(ipc, p);
 		if (ret < 0)
@@ -573,6 +752,9 @@ static int test_pipeline_params(struct pipeline_thread_data *ptdata, struct tplg
 			return -EINVAL;
 		}
 
+		if (test_pipeline_is_connected(tp->pipelines[i]))
+			continue;
+
 		/* set up pipeline params */
 		p = pcm_dev->cd->pipeline;
 
@@ -604,12 +786,18 @@ static int test_pipeline_start(struct pipeline_thread_data *ptdata)
 
 	/* Run pipeline until EOF from fileread */
 	for (i = 0; i < tp->pipeline_num; i++) {
+		if (test_pipeline_is_connected(tp->pipelines[i]))
+			continue;
+
 		p = get_pipeline_by_id(tp->pipelines[i]);
 
 		/* do we need to apply copy count limit ? */
 		if (tp->copy_check)
 			test_pipeline_set_test_limits(tp->pipelines[i], tp->copy_iterations, 0);
 
+		if (tp->jitter_frames)
+			test_pipeline_set_jitter(tp->pipelines[i], tp->jitter_frames);
+
 		/* set pipeline params and trigger start */
 		if (tb_pipeline_start(ipc, p) < 0) {
 			fprintf(stderr, "error: pipeline params\n");
@@ -673,6 +861,9 @@ static void test_pipeline_stats(struct pipeline_thread_data *ptdata,
 	struct dai_data *dd;
 	struct pipeline *p;
 	struct file_comp_data *frcd, *fwcd;
+#if CONFIG_PIPELINE_LATENCY
+	struct sof_ipc_stream_latency latency;
+#endif
 	int n_in, n_out;
 	int i;
 
@@ -731,6 +922,20 @@ static void test_pipeline_stats(struct pipeline_thread_data *ptdata,
 	}
 	printf("Input sample (frame) count: %d (%d)\n", n_in, n_in / ctx->channels_in);
 	printf("Output sample (frame) count: %d (%d)\n", n_out, n_out / ctx->channels_out);
+#if CONFIG_PIPELINE_LATENCY
+	/*
+	 * latency up to the filewrite, in pipeline periods of simulated time,
+	 * measured on one tagged frame at a time
+	 */
+	icd = ipc_get_comp_by_id(sof_get()->ipc, tp->fw_id);
+	pipeline_get_latency(icd->cd->pipeline, &latency);
+	printf("Latency: min %u us, avg %u us, max %u us over %u tagged frames\n",
+	       latency.min_us, latency.avg_us, latency.max_us, latency.count);
+#endif
+#if CONFIG_BUFFER_CALIBRATION
+	if (tp->calib_file)
+		test_pipeline_buffer_calib(tp);
+#endif
 	printf("Total execution time: %zu us, %.2f x realtime\n\n",
 	       delta, (double)((double)n_out / ctx->channels_out / ctx->fs_out) * 1000000 / delta);
 }
@@ -864,7 +1069,7 @@ int main(int argc, char **argv)
 	for (i = 0; i < MAX_INPUT_FILE_NUM; i++)
 		tp.input_file[i] = NULL;
 
-	tp.cmd_channels_in = TESTBENCH_NCH;
+	tp.cmd_channels_in = 0;
 	tp.cmd_channels_out = 0;
 	tp.max_pipeline_id = 0;
 	tp.copy_check = false;
@@ -883,6 +1088,13 @@ int main(int argc, char **argv)
 	if (err < 0)
 		goto out;
 
+	/* wav input sets what is not given on the command line */
+	if (tp.input_file_num)
+		test_probe_wav_input(&tp);
+
+	if (!tp.cmd_channels_in)
+		tp.cmd_channels_in = TESTBENCH_NCH;
+
 	if (!tp.cmd_channels_out)
 		tp.cmd_channels_out = tp.cmd_channels_in;
 
@@ -964,6 +1176,8 @@ out:
 		free(tp.input_file[i]);
 
 	free(tp.pipeline_string);
+	free(tp.calib_file);
+	tb_free_buffer_sizes(&tp);
 
 #ifdef TESTBENCH_CACHE_CHECK
 	_cache_free_all();
@@ -353,6 +353,17 @@ static int get_next_hdr(struct tplg_context *ctx, struct snd_soc_tplg_hdr *hdr,
 	return 1;
 }
 
+/* records a loaded buffer for the calibration and applies its patched size */
+static int load_buffer_size(struct tplg_context *ctx)
+{
+	struct comp_info *info = &ctx->info[ctx->info_index];
+
+	if (info->type != SND_SOC_TPLG_DAPM_BUFFER)
+		return 0;
+
+	return tb_buffer_new(ctx->tp, info->name, ctx->comp_id);
+}
+
 /* parse topology file and set up pipeline */
 int parse_topology(struct tplg_context *ctx)
 {
@@ -473,8 +484,12 @@ int parse_topology(struct tplg_context *ctx)
 				if (ret < 0) {
 					printf("error: loading widget\n");
 					goto finish;
-				} else if (ret > 0)
+				} else if (ret > 0) {
+					ret = load_buffer_size(ctx);
+					if (ret < 0)
+						goto finish;
 					ctx->comp_id++;
+				}
 			}
 			break;
 
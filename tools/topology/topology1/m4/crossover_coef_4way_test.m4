@@ -0,0 +1,33 @@
+# Exported Control Bytes 18-Oct-2026
+CONTROLBYTES_PRIV(CROSSOVER_priv,
+`       bytes "0x53,0x4f,0x46,0x00,0x00,0x00,0x00,0x00,'
+`       0xd0,0x00,0x00,0x00,0x00,0xf0,0x00,0x03,'
+`       0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,'
+`       0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,'
+`       0xd0,0x00,0x00,0x00,0x04,0x00,0x00,0x00,'
+`       0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,'
+`       0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,'
+`       0x01,0x00,0x00,0x00,0x02,0x00,0x00,0x00,'
+`       0x03,0x00,0x00,0x00,0x04,0x00,0x00,0x00,'
+`       0x6f,0x82,0x53,0xc2,0x3e,0x77,0xa1,0x7d,'
+`       0x95,0xc1,0x02,0x00,0x2a,0x83,0x05,0x00,'
+`       0x95,0xc1,0x02,0x00,0x00,0x00,0x00,0x00,'
+`       0x00,0x40,0x00,0x00,0x6f,0x82,0x53,0xc2,'
+`       0x3e,0x77,0xa1,0x7d,0x34,0x7d,0xd3,0x3e,'
+`       0x99,0x05,0x59,0x82,0x34,0x7d,0xd3,0x3e,'
+`       0x00,0x00,0x00,0x00,0x00,0x40,0x00,0x00,'
+`       0xef,0xcd,0xd0,0xca,0x5d,0x8c,0x2e,0x74,'
+`       0x6d,0x29,0x40,0x00,0xda,0x52,0x80,0x00,'
+`       0x6d,0x29,0x40,0x00,0x00,0x00,0x00,0x00,'
+`       0x00,0x40,0x00,0x00,0xef,0xcd,0xd0,0xca,'
+`       0x5d,0x8c,0x2e,0x74,0x9c,0x6f,0x57,0x3a,'
+`       0xc9,0x20,0x51,0x8b,0x9c,0x6f,0x57,0x3a,'
+`       0x00,0x00,0x00,0x00,0x00,0x40,0x00,0x00,'
+`       0xd0,0x91,0x42,0xdb,0xb1,0x53,0x12,0x5d,'
+`       0xa0,0xc6,0xea,0x01,0x3f,0x8d,0xd5,0x03,'
+`       0xa0,0xc6,0xea,0x01,0x00,0x00,0x00,0x00,'
+`       0x00,0x40,0x00,0x00,0xd0,0x91,0x42,0xdb,'
+`       0xb1,0x53,0x12,0x5d,0x78,0xf0,0x73,0x30,'
+`       0x10,0x1f,0x18,0x9f,0x78,0xf0,0x73,0x30,'
+`       0x00,0x00,0x00,0x00,0x00,0x40,0x00,0x00"'
+)
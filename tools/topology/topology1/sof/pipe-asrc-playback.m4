@@ -30,9 +30,10 @@ W_PCM_PLAYBACK(PCM_ID, ASRC Playback, 2, 0, SCHEDULE_CORE)
 
 define(MY_ASRC_TOKENS, concat(`asrc_tokens_', PIPELINE_ID))
 define(MY_ASRC_CONF, concat(`asrc_conf_', PIPELINE_ID))
+ifdef(`ASRC_ASYNCHRONOUS_MODE', , `define(`ASRC_ASYNCHRONOUS_MODE', `1')')
 W_VENDORTUPLES(MY_ASRC_TOKENS, sof_asrc_tokens,
 LIST(`		', `SOF_TKN_ASRC_RATE_OUT "PIPELINE_RATE"'
-     `		', `SOF_TKN_ASRC_ASYNCHRONOUS_MODE "1"'
+     `		', `SOF_TKN_ASRC_ASYNCHRONOUS_MODE "ASRC_ASYNCHRONOUS_MODE"'
      `		', `SOF_TKN_ASRC_OPERATION_MODE "0"'))
 
 W_DATA(MY_ASRC_CONF, MY_ASRC_TOKENS)
@@ -0,0 +1,88 @@
+# Low Latency Passthrough with channel selector Pipeline and PCM
+#
+# Pipeline Endpoints for connection are :-
+#
+#  host PCM_P --> B0 --> Channel Selector --> B1 --> sink DAI0
+
+# Include topology builder
+include(`utils.m4')
+include(`buffer.m4')
+include(`pcm.m4')
+include(`dai.m4')
+include(`bytecontrol.m4')
+include(`pipeline.m4')
+include(`ch_sel.m4')
+
+#
+# Controls
+#
+
+define(SELECTOR_priv, concat(`selector_bytes_', PIPELINE_ID))
+define(MY_SELECTOR_CTRL, concat(`selector_control_', PIPELINE_ID))
+
+# Selector initial parameters, picks the first channel of a stereo stream
+CONTROLBYTES_PRIV(SELECTOR_priv,
+`       bytes "0x53,0x4f,0x46,0x00,0x00,0x00,0x00,0x00,'
+`       0x0c,0x00,0x00,0x00,0x00,0x10,0x00,0x03,'
+`       0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,'
+`       0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,'
+`       0x02,0x00,0x00,0x00,0x01,0x00,0x00,0x00,'
+`       0x00,0x00,0x00,0x00"'
+)
+
+# Selector Bytes control with max value of 304
+C_CONTROLBYTES(MY_SELECTOR_CTRL, PIPELINE_ID,
+	CONTROLBYTES_OPS(bytes, 258 binds the mixer control to bytes get/put handlers, 258, 258),
+	CONTROLBYTES_EXTOPS(258 binds the mixer control to bytes get/put handlers, 258, 258),
+	, , ,
+	CONTROLBYTES_MAX(, 304),
+	,
+	SELECTOR_priv)
+
+#
+# Components and Buffers
+#
+
+# Host "Selector Playback" PCM
+# with 2 sink and 0 source periods
+W_PCM_PLAYBACK(PCM_ID, Selector Playback, 2, 0, SCHEDULE_CORE)
+
+# "Channel Selector" has 2 source and 2 sink periods
+W_SELECTOR(0, PIPELINE_FORMAT, 2, 2, SCHEDULE_CORE,
+	LIST(`		', "MY_SELECTOR_CTRL"))
+
+# Playback Buffers
+W_BUFFER(0, COMP_BUFFER_SIZE(2,
+	COMP_SAMPLE_SIZE(PIPELINE_FORMAT), PIPELINE_CHANNELS,
+	COMP_PERIOD_FRAMES(PCM_MAX_RATE, SCHEDULE_PERIOD)),
+	PLATFORM_HOST_MEM_CAP)
+W_BUFFER(1, COMP_BUFFER_SIZE(DAI_PERIODS,
+	COMP_SAMPLE_SIZE(PIPELINE_FORMAT), PIPELINE_CHANNELS,
+	COMP_PERIOD_FRAMES(PCM_MAX_RATE, SCHEDULE_PERIOD)),
+	PLATFORM_DAI_MEM_CAP)
+
+#
+# Pipeline Graph
+#
+#  host PCM_P --> B0 --> Channel Selector 0 --> B1 --> sink DAI0
+
+P_GRAPH(pipe-selector-playback, PIPELINE_ID,
+	LIST(`		',
+	`dapm(N_BUFFER(0), N_PCMP(PCM_ID))',
+	`dapm(N_SELECTOR(0), N_BUFFER(0))',
+	`dapm(N_BUFFER(1), N_SELECTOR(0))'))
+
+#
+# Pipeline Source and Sinks
+#
+indir(`define', concat(`PIPELINE_SOURCE_', PIPELINE_ID), N_BUFFER(1))
+indir(`define', concat(`PIPELINE_PCM_', PIPELINE_ID), Selector Playback PCM_ID)
+
+#
+# PCM Configuration
+#
+PCM_CAPABILITIES(Selector Playback PCM_ID, CAPABILITY_FORMAT_NAME(PIPELINE_FORMAT), PCM_MIN_RATE,
+	PCM_MAX_RATE, 2, PIPELINE_CHANNELS, 2, 16, 192, 16384, 65536, 65536)
+
+undefine(`MY_SELECTOR_CTRL')
+undefine(`SELECTOR_priv')
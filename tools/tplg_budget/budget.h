@@ -0,0 +1,91 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2022 Intel Corporation. All rights reserved.
+ */
+
+#ifndef _TPLG_BUDGET_H
+#define _TPLG_BUDGET_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <ipc/stream.h>
+#include <ipc/topology.h>
+#include <sound/asoc.h>
+#include <tplg_parser/topology.h>
+
+/* period used for buffer sizing when the pipeline doesn't set one */
+#define BUDGET_DEFAULT_PERIOD_US	1000
+
+/* buffers are sized for double buffering of one period */
+#define BUDGET_BUFFER_PERIODS		2
+
+/*
+ * Cost of a component class. Processing cost is given in cycles per
+ * sample, i.e. per frame and channel, the static state in bytes per
+ * channel. The numbers in the built in table are estimates, they are
+ * replaced with the measured worst case of a bench log.
+ */
+struct budget_cost {
+	const char *name;		/* class name used in reports */
+	const char *widget;		/* widget name prefix of effect widgets */
+	const char *bench;		/* kernel name prefix in bench logs */
+	double cycles_per_sample;
+	uint32_t state_bytes;		/* per channel */
+	bool measured;			/* cycles come from a bench log */
+};
+
+struct budget_comp {
+	char name[SNDRV_CTL_ELEM_ID_NAME_MAXLEN];
+	const struct budget_cost *cost;
+	uint32_t pipeline_id;
+	uint32_t rate;			/* processing rate, 0 for the default */
+	uint32_t blob_bytes;		/* configuration blobs of bytes controls */
+	double mcps;
+	uint32_t mem;
+};
+
+struct budget_pipeline {
+	uint32_t pipeline_id;
+	uint32_t core;
+	uint32_t period;		/* us */
+	uint32_t num_buffers;
+	uint32_t tplg_buffer_bytes;	/* sum of buffer sizes in topology */
+	double mcps;
+	double measured_mcps;		/* part of mcps from bench results */
+	uint32_t mem;
+	uint32_t suggested_core;
+};
+
+struct budget {
+	/* stream parameters */
+	uint32_t rate;
+	uint32_t channels;
+	enum sof_ipc_frame frame_fmt;
+
+	/* per core limits */
+	double mcps_budget;
+	uint32_t num_cores;
+
+	/* costs come from a bench log measured on the target core */
+	bool calibrated;
+
+	struct budget_comp *comps;
+	int num_comps;
+	struct budget_pipeline *pipelines;
+	int num_pipelines;
+
+	struct tplg_context ctx;
+};
+
+/* cost classes */
+const struct budget_cost *budget_cost_get(const char *name);
+const struct budget_cost *budget_cost_find_widget(const char *widget_name);
+int budget_cost_load_bench(const char *file, enum sof_ipc_frame frame_fmt,
+			   const char *target, bool *calibrated);
+void budget_cost_print(void);
+
+/* topology walk */
+int budget_parse_topology(struct budget *b, const char *tplg_file);
+void budget_free(struct budget *b);
+
+#endif
@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+/* Component cost model */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sof/common.h>
+
+#include "budget.h"
+
+#define BUDGET_LINE_LEN		256
+#define BUDGET_KERNEL_LEN	64
+
+/*
+ * Built in costs. These are estimates, rough cycles per sample figures
+ * for the generic C versions of the components that no benchmark run
+ * has confirmed. The bench column names the kernels of
+ * test/cmocka/src/bench that replace the estimate of a class. The last entry is the fallback
+ * for effect widgets that are not recognized.
+ */
+static struct budget_cost budget_costs[] = {
+	/* name		widget			bench		cycles	state */
+	{ "host",	NULL,			NULL,		10,	0 },
+	{ "dai",	NULL,			NULL,		10,	0 },
+	{ "volume",	NULL,			"vol_",		40,	32 },
+	{ "mixer",	NULL,			"mixer_",	20,	0 },
+	{ "src",	NULL,			"src_polyphase", 1000,	6144 },
+	{ "asrc",	NULL,			NULL,		1500,	8192 },
+	{ "eq-iir",	"EQIIR",		"eq_iir_s32",	120,	128 },
+	{ "eq-fir",	"EQFIR",		"eq_fir",	200,	1024 },
+	{ "dcblock",	"DCBLOCK",		NULL,		20,	16 },
+	{ "multiband-drc", "MULTIBAND_DRC",	NULL,		1200,	4096 },
+	{ "drc",	"DRC",			"drc_",		250,	1024 },
+	{ "crossover",	"CROSSOVER",		"crossover_",	360,	384 },
+	{ "tdfb",	"TDFB",			NULL,		800,	2048 },
+	{ "selector",	"SELECTOR",		NULL,		10,	0 },
+	{ "mux",	"MUXDEMUX",		NULL,		20,	0 },
+	{ "kpb",	"KPBM",			NULL,		20,	32768 },
+	{ "detect",	"DETECT",		NULL,		400,	8192 },
+	{ "tone",	"TONE",			NULL,		40,	64 },
+	{ "effect",	NULL,			NULL,		500,	1024 },
+};
+
+const struct budget_cost *budget_cost_get(const char *name)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(budget_costs); i++)
+		if (!strcmp(budget_costs[i].name, name))
+			return &budget_costs[i];
+
+	return NULL;
+}
+
+const struct budget_cost *budget_cost_find_widget(const char *widget_name)
+{
+	const struct budget_cost *cost;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(budget_costs); i++) {
+		cost = &budget_costs[i];
+		if (cost->widget && !strncmp(widget_name, cost->widget, strlen(cost->widget)))
+			return cost;
+	}
+
+	return budget_cost_get("effect");
+}
+
+/* kernels named with a sample format only apply to that format */
+static bool budget_kernel_format_match(const char *kernel, enum sof_ipc_frame frame_fmt)
+{
+	static const struct {
+		const char *suffix;
+		enum sof_ipc_frame frame_fmt;
+	} formats[] = {
+		{ "_s16", SOF_IPC_FRAME_S16_LE },
+		{ "_s24", SOF_IPC_FRAME_S24_4LE },
+		{ "_s32", SOF_IPC_FRAME_S32_LE },
+	};
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(formats); i++)
+		if (strstr(kernel, formats[i].suffix))
+			return formats[i].frame_fmt == frame_fmt;
+
+	return true;
+}
+
+/*
+ * Replaces the cycle costs with results from a bench log, the output of
+ * the cmocka kernel benchmarks. Each class takes the worst case over all
+ * block sizes and channel counts of the kernels matching its prefix.
+ * The log is calibrated for a target when every result in it was
+ * measured on that target, host results never are.
+ */
+int budget_cost_load_bench(const char *file, enum sof_ipc_frame frame_fmt,
+			   const char *target, bool *calibrated)
+{
+	double measured[ARRAY_SIZE(budget_costs)] = { 0 };
+	char line[BUDGET_LINE_LEN];
+	char kernel[BUDGET_KERNEL_LEN];
+	char bench_target[BUDGET_KERNEL_LEN];
+	struct budget_cost *cost;
+	unsigned int frames;
+	unsigned int channels;
+	bool target_seen = false;
+	double cps;
+	FILE *fh;
+	int n = 0;
+	int i;
+
+	fh = fopen(file, "r");
+	if (!fh) {
+		fprintf(stderr, "error: can't open bench log %s\n", file);
+		return -errno;
+	}
+
+	*calibrated = !!target;
+
+	while (fgets(line, sizeof(line), fh)) {
+		if (sscanf(line, "bench target %63s", bench_target) == 1) {
+			target_seen = true;
+			if (!target || strcmp(bench_target, target) ||
+			    !strcmp(bench_target, "host"))
+				*calibrated = false;
+			continue;
+		}
+
+		if (sscanf(line, "bench %63s frames %u ch %u: %lf cycles/sample",
+			   kernel, &frames, &channels, &cps) != 4)
+			continue;
+
+		if (!budget_kernel_format_match(kernel, frame_fmt))
+			continue;
+
+		for (i = 0; i < ARRAY_SIZE(budget_costs); i++) {
+			cost = &budget_costs[i];
+			if (cost->bench && !strncmp(kernel, cost->bench, strlen(cost->bench)) &&
+			    cps > measured[i])
+				measured[i] = cps;
+		}
+		n++;
+	}
+
+	fclose(fh);
+
+	if (!n) {
+		fprintf(stderr, "error: no benchmark results in %s\n", file);
+		return -EINVAL;
+	}
+
+	/* a log without a target line can't be trusted for any target */
+	if (!target_seen)
+		*calibrated = false;
+
+	for (i = 0; i < ARRAY_SIZE(budget_costs); i++) {
+		if (measured[i] > 0) {
+			budget_costs[i].cycles_per_sample = measured[i];
+			budget_costs[i].measured = true;
+		}
+	}
+
+	return 0;
+}
+
+void budget_cost_print(void)
+{
+	const struct budget_cost *cost;
+	int i;
+
+	printf("%-16s %16s %14s %9s\n", "class", "cycles/sample", "state/ch", "source");
+	for (i = 0; i < ARRAY_SIZE(budget_costs); i++) {
+		cost = &budget_costs[i];
+		printf("%-16s %16.2f %14u %9s\n", cost->name, cost->cycles_per_sample,
+		       cost->state_bytes, cost->measured ? "bench" : "estimate");
+	}
+}
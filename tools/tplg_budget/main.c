@@ -0,0 +1,295 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+/*
+ * Offline MCPS and memory estimate for a topology. Loads the pipelines
+ * of a topology without instantiating anything, applies the per sample
+ * cost of each component class for the given stream parameters and
+ * checks the load of every core against a budget.
+ */
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sof/common.h>
+#include <sof/math/numbers.h>
+
+#include "budget.h"
+
+#define BUDGET_DEFAULT_RATE	48000
+#define BUDGET_DEFAULT_CHANNELS	2
+#define BUDGET_DEFAULT_MCPS	400
+#define BUDGET_DEFAULT_CORES	1
+
+static void print_usage(char *executable)
+{
+	printf("Usage: %s -t <topology> [options]\n\n", executable);
+	printf("Estimates per component and per core MCPS and memory of a topology\n\n");
+	printf("Options:\n");
+	printf("  -t file    topology file\n");
+	printf("  -r rate    sample rate, default %d\n", BUDGET_DEFAULT_RATE);
+	printf("  -c ch      channels, default %d\n", BUDGET_DEFAULT_CHANNELS);
+	printf("  -f fmt     sample format s16le, s24le or s32le, default s32le\n");
+	printf("  -m mcps    budget per core in MCPS, default %d\n", BUDGET_DEFAULT_MCPS);
+	printf("  -n cores   cores available for assignment, default %d or\n",
+	       BUDGET_DEFAULT_CORES);
+	printf("             as many as the topology uses\n");
+	printf("  -b file    bench log of the cmocka kernel benchmarks to use\n");
+	printf("             instead of the built in estimates\n");
+	printf("  -T core    xtensa core the topology is for, a bench log\n");
+	printf("             measured on it is calibrated\n");
+	printf("  -l         list the cost classes and exit\n");
+	printf("  -h         print this help\n\n");
+	printf("Exits with 1 if the costs measured on the target core alone take a\n");
+	printf("core of the topology over budget.\n");
+}
+
+static uint32_t budget_sample_bytes(enum sof_ipc_frame frame_fmt)
+{
+	return frame_fmt == SOF_IPC_FRAME_S16_LE ? 2 : 4;
+}
+
+static void budget_estimate(struct budget *b)
+{
+	struct budget_pipeline *p;
+	struct budget_comp *comp;
+	uint32_t buffer_bytes;
+	uint32_t frames;
+	uint32_t rate;
+	int i;
+	int j;
+
+	for (i = 0; i < b->num_comps; i++) {
+		comp = &b->comps[i];
+		rate = comp->rate ? comp->rate : b->rate;
+		comp->mcps = comp->cost->cycles_per_sample * rate * b->channels / 1e6;
+		comp->mem = comp->cost->state_bytes * b->channels + comp->blob_bytes;
+	}
+
+	for (i = 0; i < b->num_pipelines; i++) {
+		p = &b->pipelines[i];
+		for (j = 0; j < b->num_comps; j++) {
+			comp = &b->comps[j];
+			if (comp->pipeline_id != p->pipeline_id)
+				continue;
+
+			p->mcps += comp->mcps;
+			p->mem += comp->mem;
+			if (comp->cost->measured)
+				p->measured_mcps += comp->mcps;
+		}
+
+		/* topology buffer sizes are for its own format, take the larger */
+		frames = ((uint64_t)b->rate * p->period + 999999) / 1000000;
+		buffer_bytes = p->num_buffers * BUDGET_BUFFER_PERIODS * frames * b->channels *
+			       budget_sample_bytes(b->frame_fmt);
+		p->mem += MAX(buffer_bytes, p->tplg_buffer_bytes);
+
+		if (p->core >= b->num_cores)
+			b->num_cores = p->core + 1;
+	}
+}
+
+/*
+ * Longest processing time first: pipelines are placed by decreasing
+ * load, each on the core with the least load so far. A pipeline can't
+ * be split between cores.
+ */
+static void budget_suggest(struct budget *b, double *core_mcps)
+{
+	struct budget_pipeline *p;
+	struct budget_pipeline *max;
+	bool *placed;
+	uint32_t core;
+	uint32_t c;
+	int i;
+	int j;
+
+	placed = calloc(b->num_pipelines, sizeof(*placed));
+	if (!placed)
+		return;
+
+	for (i = 0; i < b->num_pipelines; i++) {
+		max = NULL;
+		for (j = 0; j < b->num_pipelines; j++) {
+			p = &b->pipelines[j];
+			if (!placed[j] && (!max || p->mcps > max->mcps))
+				max = p;
+		}
+
+		core = 0;
+		for (c = 1; c < b->num_cores; c++)
+			if (core_mcps[c] < core_mcps[core])
+				core = c;
+
+		placed[max - b->pipelines] = true;
+		max->suggested_core = core;
+		core_mcps[core] += max->mcps;
+	}
+
+	free(placed);
+}
+
+static int budget_report(struct budget *b)
+{
+	struct budget_pipeline *p;
+	struct budget_comp *comp;
+	double *core_measured;
+	double *core_mcps;
+	uint32_t *core_mem;
+	int over = 0;
+	uint32_t c;
+	int i;
+
+	core_mcps = calloc(b->num_cores * 2, sizeof(*core_mcps));
+	core_measured = calloc(b->num_cores, sizeof(*core_measured));
+	core_mem = calloc(b->num_cores, sizeof(*core_mem));
+	if (!core_mcps || !core_measured || !core_mem) {
+		free(core_mcps);
+		free(core_measured);
+		free(core_mem);
+		return -ENOMEM;
+	}
+
+	printf("%-32s %-14s %4s %7s %9s %9s %9s\n", "component", "class", "pipe", "rate",
+	       "MCPS", "bytes", "cost");
+	for (i = 0; i < b->num_comps; i++) {
+		comp = &b->comps[i];
+		printf("%-32s %-14s %4u %7u %9.2f %9u %9s\n", comp->name, comp->cost->name,
+		       comp->pipeline_id, comp->rate ? comp->rate : b->rate, comp->mcps,
+		       comp->mem, comp->cost->measured ? "bench" : "estimate");
+	}
+
+	printf("\n%-8s %4s %8s %9s %9s\n", "pipeline", "core", "period", "MCPS", "bytes");
+	for (i = 0; i < b->num_pipelines; i++) {
+		p = &b->pipelines[i];
+		printf("%-8u %4u %8u %9.2f %9u\n", p->pipeline_id, p->core, p->period,
+		       p->mcps, p->mem);
+		core_mcps[p->core] += p->mcps;
+		core_measured[p->core] += p->measured_mcps;
+		core_mem[p->core] += p->mem;
+	}
+
+	printf("\n%-8s %9s %9s %6s %9s\n", "core", "MCPS", "budget", "load", "bytes");
+	for (c = 0; c < b->num_cores; c++) {
+		printf("%-8u %9.2f %9.2f %5.0f%% %9u%s\n", c, core_mcps[c], b->mcps_budget,
+		       100.0 * core_mcps[c] / b->mcps_budget, core_mem[c],
+		       core_mcps[c] > b->mcps_budget ? "  OVER BUDGET" : "");
+		/* only calibrated figures can reject a topology */
+		if (core_mcps[c] > b->mcps_budget) {
+			if (b->calibrated && core_measured[c] > b->mcps_budget)
+				over = 1;
+			else
+				printf("%-8s %9.2f MCPS measured on the target, not failing\n", "",
+				       b->calibrated ? core_measured[c] : 0.0);
+		}
+	}
+
+	/* second half of the array holds the suggested assignment */
+	budget_suggest(b, core_mcps + b->num_cores);
+
+	printf("\nsuggested assignment on %u core(s):\n", b->num_cores);
+	for (i = 0; i < b->num_pipelines; i++) {
+		p = &b->pipelines[i];
+		printf("  pipeline %u: core %u%s\n", p->pipeline_id, p->suggested_core,
+		       p->suggested_core != p->core ? " (moved)" : "");
+	}
+
+	for (c = 0; c < b->num_cores; c++) {
+		printf("  core %u: %.2f MCPS%s\n", c, core_mcps[b->num_cores + c],
+		       core_mcps[b->num_cores + c] > b->mcps_budget ? "  OVER BUDGET" : "");
+	}
+
+	free(core_mcps);
+	free(core_measured);
+	free(core_mem);
+	return over;
+}
+
+int main(int argc, char **argv)
+{
+	struct budget b = {
+		.rate = BUDGET_DEFAULT_RATE,
+		.channels = BUDGET_DEFAULT_CHANNELS,
+		.frame_fmt = SOF_IPC_FRAME_S32_LE,
+		.mcps_budget = BUDGET_DEFAULT_MCPS,
+		.num_cores = BUDGET_DEFAULT_CORES,
+	};
+	char *tplg_file = NULL;
+	char *bench_file = NULL;
+	char *target = NULL;
+	int option;
+	int ret;
+
+	while ((option = getopt(argc, argv, "ht:r:c:f:m:n:b:T:l")) != -1) {
+		switch (option) {
+		case 't':
+			tplg_file = optarg;
+			break;
+		case 'r':
+			b.rate = atoi(optarg);
+			break;
+		case 'c':
+			b.channels = atoi(optarg);
+			break;
+		case 'f':
+			b.frame_fmt = find_format(optarg);
+			break;
+		case 'm':
+			b.mcps_budget = atof(optarg);
+			break;
+		case 'n':
+			b.num_cores = atoi(optarg);
+			break;
+		case 'b':
+			bench_file = optarg;
+			break;
+		case 'T':
+			target = optarg;
+			break;
+		case 'l':
+			budget_cost_print();
+			exit(EXIT_SUCCESS);
+		case 'h':
+			print_usage(argv[0]);
+			exit(EXIT_SUCCESS);
+		default:
+			print_usage(argv[0]);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	if (!tplg_file || !b.rate || !b.channels || b.mcps_budget <= 0 || !b.num_cores) {
+		print_usage(argv[0]);
+		exit(EXIT_FAILURE);
+	}
+
+	if (b.frame_fmt != SOF_IPC_FRAME_S16_LE && b.frame_fmt != SOF_IPC_FRAME_S24_4LE &&
+	    b.frame_fmt != SOF_IPC_FRAME_S32_LE) {
+		fprintf(stderr, "error: unsupported sample format\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (bench_file &&
+	    budget_cost_load_bench(bench_file, b.frame_fmt, target, &b.calibrated) < 0)
+		exit(EXIT_FAILURE);
+
+	ret = budget_parse_topology(&b, tplg_file);
+	if (ret < 0) {
+		fprintf(stderr, "error: parsing topology %s: %d\n", tplg_file, ret);
+		budget_free(&b);
+		exit(EXIT_FAILURE);
+	}
+
+	budget_estimate(&b);
+	ret = budget_report(&b);
+	budget_free(&b);
+
+	if (ret < 0)
+		exit(EXIT_FAILURE);
+
+	return ret;
+}
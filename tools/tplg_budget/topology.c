@@ -0,0 +1,432 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2022 Intel Corporation. All rights reserved.
+
+/* Topology walk collecting the components and pipelines to estimate */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ipc/topology.h>
+#include <ipc/stream.h>
+#include <sof/common.h>
+#include <sof/lib/uuid.h>
+#include <sof/math/numbers.h>
+#include <sof/ipc/topology.h>
+#include <tplg_parser/topology.h>
+
+#include "budget.h"
+
+static const struct sof_dai_types sof_dais[] = {
+	{"SSP", SOF_DAI_INTEL_SSP},
+	{"HDA", SOF_DAI_INTEL_HDA},
+	{"DMIC", SOF_DAI_INTEL_DMIC},
+};
+
+/* find dai type */
+enum sof_ipc_dai_type find_dai(const char *name)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(sof_dais); i++) {
+		if (strcmp(name, sof_dais[i].name) == 0)
+			return sof_dais[i].type;
+	}
+
+	return SOF_DAI_INTEL_NONE;
+}
+
+/*
+ * Nothing is instantiated, the estimator only uses the tplg_create_*()
+ * helpers. The rest of the parser interface is stubbed out.
+ */
+void register_comp(int comp_type, struct sof_ipc_comp_ext *comp_ext) {}
+
+int find_widget(struct comp_info *temp_comp_list, int count, char *name)
+{
+	return -EINVAL;
+}
+
+int load_aif_in_out(struct tplg_context *ctx, int dir)
+{
+	return -EINVAL;
+}
+
+int load_dai_in_out(struct tplg_context *ctx, int dir)
+{
+	return -EINVAL;
+}
+
+int ipc_pipeline_complete(struct ipc *ipc, uint32_t comp_id)
+{
+	return 0;
+}
+
+int ipc_comp_connect(struct ipc *ipc, ipc_pipe_comp_connect *_connect)
+{
+	return 0;
+}
+
+int ipc_buffer_new(struct ipc *ipc, const struct sof_ipc_buffer *desc)
+{
+	return 0;
+}
+
+int ipc_pipeline_new(struct ipc *ipc, ipc_pipe_new *_pipe_desc)
+{
+	return 0;
+}
+
+int ipc_comp_new(struct ipc *ipc, ipc_comp *_comp)
+{
+	return 0;
+}
+
+static struct budget_pipeline *budget_get_pipeline(struct budget *b, uint32_t pipeline_id)
+{
+	struct budget_pipeline *p;
+	int i;
+
+	for (i = 0; i < b->num_pipelines; i++)
+		if (b->pipelines[i].pipeline_id == pipeline_id)
+			return &b->pipelines[i];
+
+	p = realloc(b->pipelines, (b->num_pipelines + 1) * sizeof(*p));
+	if (!p)
+		return NULL;
+
+	b->pipelines = p;
+	p = &b->pipelines[b->num_pipelines++];
+	memset(p, 0, sizeof(*p));
+	p->pipeline_id = pipeline_id;
+	p->period = BUDGET_DEFAULT_PERIOD_US;
+
+	return p;
+}
+
+static struct budget_comp *budget_add_comp(struct budget *b, const struct budget_cost *cost)
+{
+	struct tplg_context *ctx = &b->ctx;
+	struct budget_comp *comp;
+
+	comp = realloc(b->comps, (b->num_comps + 1) * sizeof(*comp));
+	if (!comp)
+		return NULL;
+
+	b->comps = comp;
+	comp = &b->comps[b->num_comps++];
+	memset(comp, 0, sizeof(*comp));
+	snprintf(comp->name, sizeof(comp->name), "%s", ctx->widget->name);
+	comp->cost = cost;
+	comp->pipeline_id = ctx->pipeline_id;
+
+	/* make sure the pipeline is listed even if its scheduler is missing */
+	if (!budget_get_pipeline(b, ctx->pipeline_id))
+		return NULL;
+
+	return comp;
+}
+
+static int budget_load_pcm(struct budget *b, int dir)
+{
+	struct sof_ipc_comp_host host = {0};
+	int ret;
+
+	ret = tplg_create_pcm(&b->ctx, dir, &host);
+	if (ret < 0)
+		return ret;
+
+	return budget_add_comp(b, budget_cost_get("host")) ? 0 : -ENOMEM;
+}
+
+static int budget_load_dai(struct budget *b)
+{
+	struct sof_ipc_comp_dai dai = {0};
+	int ret;
+
+	ret = tplg_create_dai(&b->ctx, &dai);
+	if (ret < 0)
+		return ret;
+
+	return budget_add_comp(b, budget_cost_get("dai")) ? 0 : -ENOMEM;
+}
+
+static int budget_load_pga(struct budget *b)
+{
+	struct sof_ipc_comp_volume *volume;
+	int ret;
+
+	/* the uuid is appended after the IPC */
+	volume = calloc(1, sizeof(*volume) + UUID_SIZE);
+	if (!volume)
+		return -ENOMEM;
+
+	ret = tplg_create_pga(&b->ctx, volume);
+	free(volume);
+	if (ret < 0)
+		return ret;
+
+	return budget_add_comp(b, budget_cost_get("volume")) ? 0 : -ENOMEM;
+}
+
+static int budget_load_src(struct budget *b)
+{
+	struct sof_ipc_comp_src src = {0};
+	struct budget_comp *comp;
+	int ret;
+
+	ret = tplg_create_src(&b->ctx, &src);
+	if (ret < 0)
+		return ret;
+
+	comp = budget_add_comp(b, budget_cost_get("src"));
+	if (!comp)
+		return -ENOMEM;
+
+	/* polyphase cost scales with the output rate */
+	comp->rate = src.sink_rate;
+	return 0;
+}
+
+static int budget_load_asrc(struct budget *b)
+{
+	struct sof_ipc_comp_asrc asrc = {0};
+	struct budget_comp *comp;
+	int ret;
+
+	ret = tplg_create_asrc(&b->ctx, &asrc);
+	if (ret < 0)
+		return ret;
+
+	comp = budget_add_comp(b, budget_cost_get("asrc"));
+	if (!comp)
+		return -ENOMEM;
+
+	comp->rate = MAX(asrc.source_rate, asrc.sink_rate);
+	return 0;
+}
+
+static int budget_load_mixer(struct budget *b)
+{
+	struct sof_ipc_comp_mixer mixer = {0};
+	int ret;
+
+	ret = tplg_create_mixer(&b->ctx, &mixer);
+	if (ret < 0)
+		return ret;
+
+	return budget_add_comp(b, budget_cost_get("mixer")) ? 0 : -ENOMEM;
+}
+
+static int budget_load_process(struct budget *b)
+{
+	struct sof_ipc_comp_process *process;
+	struct sof_ipc_comp_ext comp_ext;
+	int ret;
+
+	process = calloc(1, sizeof(*process) + UUID_SIZE);
+	if (!process)
+		return -ENOMEM;
+
+	ret = tplg_create_process(&b->ctx, process, &comp_ext);
+	free(process);
+	if (ret < 0)
+		return ret;
+
+	/* most processing types are only known by uuid, go by widget name */
+	return budget_add_comp(b, budget_cost_find_widget(b->ctx.widget->name)) ? 0 : -ENOMEM;
+}
+
+static int budget_load_buffer(struct budget *b)
+{
+	struct sof_ipc_buffer buffer = {0};
+	struct budget_pipeline *p;
+	int ret;
+
+	ret = tplg_create_buffer(&b->ctx, &buffer);
+	if (ret < 0)
+		return ret;
+
+	p = budget_get_pipeline(b, b->ctx.pipeline_id);
+	if (!p)
+		return -ENOMEM;
+
+	p->num_buffers++;
+	p->tplg_buffer_bytes += buffer.size;
+	return 0;
+}
+
+static int budget_load_pipeline(struct budget *b)
+{
+	struct sof_ipc_pipe_new pipeline = {0};
+	struct budget_pipeline *p;
+	int ret;
+
+	ret = tplg_create_pipeline(&b->ctx, &pipeline);
+	if (ret < 0)
+		return ret;
+
+	p = budget_get_pipeline(b, b->ctx.pipeline_id);
+	if (!p)
+		return -ENOMEM;
+
+	p->core = pipeline.core;
+	if (pipeline.period)
+		p->period = pipeline.period;
+
+	return 0;
+}
+
+/* bytes controls carry the configuration blobs kept by the component */
+static int budget_load_controls(struct budget *b, struct budget_comp *comp)
+{
+	struct tplg_context *ctx = &b->ctx;
+	struct snd_soc_tplg_ctl_hdr *ctl;
+	char *priv_data;
+	int ret;
+	int i;
+
+	for (i = 0; i < ctx->widget->num_kcontrols; i++) {
+		ret = tplg_create_single_control(&ctl, &priv_data, ctx->file);
+		if (ret < 0) {
+			fprintf(stderr, "error: failed control load\n");
+			return ret;
+		}
+
+		if (priv_data && comp)
+			comp->blob_bytes += ((struct snd_soc_tplg_bytes_control *)ctl)->priv.size;
+
+		free(ctl);
+		free(priv_data);
+	}
+
+	return 0;
+}
+
+static int budget_load_widget(struct budget *b)
+{
+	struct tplg_context *ctx = &b->ctx;
+	int num_comps = b->num_comps;
+	int ret;
+
+	ctx->widget_size = sizeof(struct snd_soc_tplg_dapm_widget);
+	ctx->widget = malloc(ctx->widget_size);
+	if (!ctx->widget)
+		return -ENOMEM;
+
+	if (fread(ctx->widget, ctx->widget_size, 1, ctx->file) != 1) {
+		ret = -EINVAL;
+		goto out;
+	}
+
+	switch (ctx->widget->id) {
+	case SND_SOC_TPLG_DAPM_AIF_IN:
+		ret = budget_load_pcm(b, SOF_IPC_STREAM_PLAYBACK);
+		break;
+	case SND_SOC_TPLG_DAPM_AIF_OUT:
+		ret = budget_load_pcm(b, SOF_IPC_STREAM_CAPTURE);
+		break;
+	case SND_SOC_TPLG_DAPM_DAI_IN:
+	case SND_SOC_TPLG_DAPM_DAI_OUT:
+		ret = budget_load_dai(b);
+		break;
+	case SND_SOC_TPLG_DAPM_PGA:
+		ret = budget_load_pga(b);
+		break;
+	case SND_SOC_TPLG_DAPM_SRC:
+		ret = budget_load_src(b);
+		break;
+	case SND_SOC_TPLG_DAPM_ASRC:
+		ret = budget_load_asrc(b);
+		break;
+	case SND_SOC_TPLG_DAPM_MIXER:
+		ret = budget_load_mixer(b);
+		break;
+	case SND_SOC_TPLG_DAPM_EFFECT:
+		ret = budget_load_process(b);
+		break;
+	case SND_SOC_TPLG_DAPM_BUFFER:
+		ret = budget_load_buffer(b);
+		break;
+	case SND_SOC_TPLG_DAPM_SCHEDULER:
+		ret = budget_load_pipeline(b);
+		break;
+	default:
+		/* widgets without a firmware component */
+		ret = fseek(ctx->file, ctx->widget->priv.size, SEEK_CUR) ? -errno : 0;
+		break;
+	}
+
+	if (ret < 0) {
+		fprintf(stderr, "error: loading widget %s\n", ctx->widget->name);
+		goto out;
+	}
+
+	ret = budget_load_controls(b, b->num_comps > num_comps ?
+				   &b->comps[b->num_comps - 1] : NULL);
+
+out:
+	free(ctx->widget);
+	ctx->widget = NULL;
+	return ret;
+}
+
+int budget_parse_topology(struct budget *b, const char *tplg_file)
+{
+	struct tplg_context *ctx = &b->ctx;
+	struct snd_soc_tplg_hdr hdr;
+	int ret = 0;
+	int i;
+
+	ctx->tplg_file = tplg_file;
+	ctx->file = fopen(tplg_file, "rb");
+	if (!ctx->file) {
+		fprintf(stderr, "error: opening file %s\n", tplg_file);
+		return -errno;
+	}
+
+	while (fread(&hdr, sizeof(hdr), 1, ctx->file) == 1) {
+		ctx->hdr = &hdr;
+
+		if (hdr.magic != SND_SOC_TPLG_MAGIC) {
+			fprintf(stderr, "error: %s is not a topology file\n", tplg_file);
+			ret = -EINVAL;
+			break;
+		}
+
+		if (hdr.type != SND_SOC_TPLG_TYPE_DAPM_WIDGET) {
+			if (fseek(ctx->file, hdr.payload_size, SEEK_CUR)) {
+				ret = -errno;
+				break;
+			}
+			continue;
+		}
+
+		/* widget blocks are indexed by pipeline id */
+		ctx->pipeline_id = hdr.index;
+		for (i = 0; i < hdr.count; i++) {
+			ret = budget_load_widget(b);
+			if (ret < 0)
+				goto out;
+
+			ctx->comp_id++;
+		}
+	}
+
+out:
+	fclose(ctx->file);
+	ctx->file = NULL;
+	return ret;
+}
+
+void budget_free(struct budget *b)
+{
+	free(b->comps);
+	free(b->pipelines);
+	b->comps = NULL;
+	b->pipelines = NULL;
+	b->num_comps = 0;
+	b->num_pipelines = 0;
+}
@@ -175,7 +175,7 @@ static const struct sof_topology_token asrc_tokens[] = {
 int tplg_create_asrc(struct tplg_context *ctx, struct sof_ipc_comp_asrc *asrc)
 {
 	struct snd_soc_tplg_vendor_array *array = NULL;
-	size_t total_array_size = 0, read_size, size = ctx->widget_size;
+	size_t total_array_size = 0, read_size, size = ctx->widget->priv.size;
 	FILE *file = ctx->file;
 	int ret, comp_id = ctx->comp_id;
 